@@ -0,0 +1,160 @@
+#include "BacktrackingSolver.h"
+#include "CandidateGrid.h"
+#include "IPuzzleMarker.h"
+#include "Puzzle.h"
+
+#include "Log.h"
+
+namespace Sudoku
+{
+
+namespace
+{
+
+/**
+ * Pick the unsolved Cell with the fewest candidates
+ * @pre g is not solved
+ */
+size_t FewestCandidates( const CandidateGrid &g )
+{
+    Bitboard open = g.GetUnsolved();
+    size_t best = open.First();
+    unsigned bestCount = 10;
+    while ( open.Any() )
+    {
+        size_t i = open.PopFirst();
+        unsigned count = __builtin_popcount( g.GetCandidates( i ) );
+        if ( count < bestCount )
+        {
+            best = i;
+            bestCount = count;
+            // singles are already placed so two is as good as it gets
+            if ( count <= 2 )
+            {
+                break;
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * Search which is free to change the board it is given
+ * Each guess works on its own copy so backing out costs nothing
+ */
+size_t SearchFrom( CandidateGrid &g, size_t limit, CandidateGrid *solution )
+{
+    if ( limit == 0 || !g.PlaceSingles() )
+    {
+        return 0;
+    }
+    if ( g.IsSolved() )
+    {
+        if ( solution )
+        {
+            *solution = g;
+        }
+        return 1;
+    }
+
+    size_t i = FewestCandidates( g );
+    size_t found = 0;
+    for ( unsigned short left = g.GetCandidates( i ); left; left &= left - 1 )
+    {
+        CandidateGrid next( g );
+        if ( next.Place( i, __builtin_ctz( left ) + 1 ) )
+        {
+            found += SearchFrom( next, limit - found,
+                                 found == 0 ? solution : NULL );
+            if ( found >= limit )
+            {
+                break;
+            }
+        }
+    }
+    return found;
+}
+
+}
+
+void BacktrackingSolver::Solve( std::shared_ptr<Puzzle> p )
+{
+    if ( !_marker )
+    {
+        throw std::runtime_error( "Need PuzzleMarker" );
+    }
+    Puzzle::ChangeTransaction changes( p );
+
+    _marker->UpdateMarks( p );
+    FILE_LOG(logINFO) << "Added appropriate marks";
+
+    // displayed values first, then narrow down to the marked candidates
+    CandidateGrid start;
+    Puzzle::View all = p->GetAllView();
+    size_t i = 0;
+    for ( Puzzle::View::iterator it = all.begin(); it != all.end(); ++it, ++i )
+    {
+        if ( (*it)->DisplayedValue() != 0 )
+        {
+            start.Place( i, (*it)->DisplayedValue() );
+        }
+    }
+    i = 0;
+    for ( Puzzle::View::iterator it = all.begin(); it != all.end(); ++it, ++i )
+    {
+        if ( start.GetValue( i ) == 0 )
+        {
+            const Cell::MarkContainer &marks = (*it)->GetMarkContainer();
+            for ( int value = 1; value <= 9; value++ )
+            {
+                if ( !marks[value] )
+                {
+                    start.Eliminate( i, value );
+                }
+            }
+        }
+    }
+
+    CandidateGrid solution;
+    if ( !start.IsConsistent() || Search( start, 1, &solution ) == 0 )
+    {
+        FILE_LOG(logERROR) << "Could not solve Puzzle.";
+        throw std::runtime_error( "Could not solve Puzzle" );
+    }
+
+    i = 0;
+    for ( Puzzle::View::iterator it = all.begin(); it != all.end(); ++it, ++i )
+    {
+        if ( (*it)->CanGuess() && (*it)->DisplayedValue() == 0 )
+        {
+            (*it)->SetGuess( solution.GetValue( i ) );
+            (*it)->ClearMarks();
+        }
+    }
+    FILE_LOG(logINFO) << "Solved Puzzle by search.";
+}
+
+void BacktrackingSolver::CommitGuesses( std::shared_ptr<Puzzle> p )
+{
+    Puzzle::ChangeTransaction changes( p );
+    Puzzle::View all = p->GetAllView();
+    FILE_LOG(logINFO) << "Committing Guesses to correct answers.";
+    for ( Puzzle::View::iterator it = all.begin(); it != all.end(); ++it )
+    {
+        if ( (*it)->CanGuess() && (*it)->DisplayedValue() != 0 )
+        {
+            (*it)->SetCorrect( (*it)->DisplayedValue() );
+            (*it)->SetGuess( 0 );
+            (*it)->ClearMarks();
+        }
+    }
+}
+
+size_t BacktrackingSolver::Search( const CandidateGrid &g, size_t limit,
+                                   CandidateGrid *solution )
+{
+    CandidateGrid current( g );
+    return SearchFrom( current, limit, solution );
+}
+
+}
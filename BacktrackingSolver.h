@@ -0,0 +1,73 @@
+#ifndef SUDOKU_BACKTRACKING_SOLVER_H
+#define SUDOKU_BACKTRACKING_SOLVER_H
+
+#include "ISolver.h"
+#include <cstddef>
+
+namespace Sudoku
+{
+
+class CandidateGrid;
+class IPuzzleMarker;
+
+/**
+ * Solves any valid Puzzle by search
+ * Depth first search over a CandidateGrid: all naked and hidden singles are
+ * placed, then the Cell with the fewest candidates (MRV) is tried with each
+ * of its candidates in turn.  Every step is a few bit operations on a copy
+ * of the board, so backing out of a wrong guess is free.
+ *
+ * Unlike MethodSolver this does not explain its steps (it cannot be used to
+ * generate Puzzles) but it never gets stuck.
+ */
+class BacktrackingSolver : public ISolver
+{
+public:
+    /**
+     * Create a solver
+     * @param marker Sets the initial candidates on the Puzzle
+     */
+    BacktrackingSolver( std::shared_ptr<IPuzzleMarker> marker )
+        : _marker( marker ) {}
+
+    /**
+     * Solve a Puzzle
+     * Displayed values (givens and guesses) are kept, candidates come from
+     * the marks set by the IPuzzleMarker
+     * @pre Puzzle has a solution with the displayed values
+     * @post Every blank Cell has its Guess set and no marks
+     * @throw std::runtime_error if there is no solution
+     * @param p Puzzle to solve
+     */
+    virtual void Solve( std::shared_ptr<Puzzle> p );
+
+    /**
+     * Change all of the guesses the Correct Values of Cells
+     * @pre Puzzle has Guesses (which are correct)
+     * @post Guesses are now CorrectValues (hidden), Guesses are blank
+     */
+    virtual void CommitGuesses( std::shared_ptr<Puzzle> p );
+
+    /**
+     * Search for solutions of a board
+     * @param g Board to start from
+     * @param limit Stop once this many solutions are found
+     * @param solution If not NULL, set to the first solution found
+     * @return number of solutions found, never more than limit
+     */
+    static size_t Search( const CandidateGrid &g, size_t limit,
+                          CandidateGrid *solution );
+
+    virtual ~BacktrackingSolver() {}
+
+private:
+    BacktrackingSolver( const BacktrackingSolver & );
+    BacktrackingSolver & operator=( const BacktrackingSolver & );
+
+    /// Sets marks appropriately
+    std::shared_ptr<IPuzzleMarker> _marker;
+};
+
+}
+
+#endif
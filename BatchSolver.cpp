@@ -0,0 +1,129 @@
+#include "BatchSolver.h"
+#include "Puzzle.h"
+#include "BacktrackingSolver.h"
+#include "MethodSolver.h"
+#include "PuzzleBatch.h"
+#include "PuzzleMarker.h"
+#include "SimpleValidator.h"
+#include "SolutionMethodFactory.h"
+#include "SolverHelper.h"
+
+#include <exception>
+
+#include "Log.h"
+
+namespace Sudoku
+{
+
+namespace
+{
+
+/**
+ * Solves one Puzzle of the batch with the solver of the worker running it
+ */
+class SolveTask : public WorkStealingPool::Task
+{
+public:
+    SolveTask( const std::vector<Grid> &puzzles,
+               const std::vector<size_t> &items,
+               std::vector<BatchSolver::Result> &results,
+               std::vector<std::shared_ptr<ISolver> > &solvers )
+        : _puzzles( puzzles ), _items( items ), _results( results ),
+          _solvers( solvers ) {}
+
+    virtual void Execute( size_t worker, size_t task )
+    {
+        size_t item = _items[task];
+        std::shared_ptr<Puzzle> p( new Puzzle );
+        _puzzles[item].CopyTo( *p );
+        BatchSolver::Result &r = _results[item];
+        try
+        {
+            _solvers[worker]->Solve( p );
+            r.solved = true;
+        }
+        catch ( std::exception &e )
+        {
+            // whatever one Puzzle throws, the rest of the batch goes on
+            FILE_LOG(logWARNING) << "Puzzle " << item << ": " << e.what();
+            r.solved = false;
+        }
+        r.grid = Grid( *p );
+    }
+
+private:
+    const std::vector<Grid> &_puzzles;
+    /// Puzzles left for the solvers
+    const std::vector<size_t> &_items;
+    std::vector<BatchSolver::Result> &_results;
+    std::vector<std::shared_ptr<ISolver> > &_solvers;
+};
+
+}
+
+BatchSolver::BatchSolver( size_t threads )
+    : _pool( threads )
+{
+    for ( size_t w = 0; w < _pool.GetThreadCount(); w++ )
+    {
+        _solvers.push_back( CreateSolver() );
+    }
+}
+
+std::vector<BatchSolver::Result> BatchSolver::Solve(
+    const std::vector<Grid> &puzzles )
+{
+    std::vector<Result> results( puzzles.size() );
+
+    // most Puzzles fall to singles, do those 16 at a time first
+    PuzzleBatch batch;
+    for ( std::vector<Grid>::const_iterator it = puzzles.begin();
+          it != puzzles.end();
+          ++it )
+    {
+        batch.Add( *it );
+    }
+    batch.Solve();
+    std::vector<size_t> items;
+    unsigned char values[Units::CELL_COUNT];
+    for ( size_t n = 0; n < puzzles.size(); n++ )
+    {
+        if ( batch.IsSolved( n ) )
+        {
+            for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+            {
+                values[i] = batch.GetValue( n, i );
+            }
+            // a Puzzle without a solution may fill with repeats
+            if ( SimpleValidator::IsValid( values ) )
+            {
+                batch.CopyTo( n, results[n].grid );
+                results[n].solved = true;
+                continue;
+            }
+        }
+        items.push_back( n );
+    }
+
+    SolveTask task( puzzles, items, results, _solvers );
+    _pool.Run( items.size(), task );
+    return results;
+}
+
+std::shared_ptr<ISolver> BatchSolver::CreateSolver()
+{
+    std::shared_ptr<IPuzzleMarker> marker( new PuzzleMarker );
+    std::shared_ptr<SolutionMethodFactory> factory(
+        new SolutionMethodFactory );
+    std::shared_ptr<SolverHelper> helper( new SolverHelper( factory ) );
+    std::shared_ptr<IValidator> validator =
+        SimpleValidator::CreateGuessValidator();
+
+    std::shared_ptr<MethodSolver> solver(
+        new MethodSolver( helper, marker, validator ) );
+    solver->SetFallback(
+        std::shared_ptr<ISolver>( new BacktrackingSolver( marker ) ) );
+    return solver;
+}
+
+}
@@ -0,0 +1,76 @@
+#ifndef SUDOKU_BATCH_SOLVER_H
+#define SUDOKU_BATCH_SOLVER_H
+
+#include <memory>
+#include <vector>
+
+#include "Grid.h"
+#include "WorkStealingPool.h"
+
+namespace Sudoku
+{
+
+class ISolver;
+
+/**
+ * Solves many Puzzles in parallel
+ * Every worker thread has its own solver stack (MethodSolver with its own
+ * SolverHelper, PuzzleMarker and validator, and a BacktrackingSolver
+ * fallback) so no solver state is shared between threads.  Results come
+ * back in input order no matter which thread solved which Puzzle.
+ *
+ * All Puzzles first go through a PuzzleBatch, only the ones singles do
+ * not solve are handed to the workers.
+ */
+class BatchSolver
+{
+public:
+    /**
+     * Outcome for a single Puzzle
+     */
+    struct Result
+    {
+        /// Values after solving (as far as the solver got if it failed)
+        Grid grid;
+        /// true if the solver finished the Puzzle
+        bool solved;
+    };
+
+    /**
+     * Create a solver with a MethodSolver per worker
+     * @param threads Number of worker threads, 0 for one per hardware thread
+     */
+    explicit BatchSolver( size_t threads = 0 );
+
+    /**
+     * Accessor
+     * @return number of worker threads
+     */
+    size_t GetThreadCount() const { return _pool.GetThreadCount(); }
+
+    /**
+     * Solve every Puzzle
+     * @param puzzles Puzzles with givens set
+     * @return one Result per Puzzle, in the same order
+     */
+    std::vector<Result> Solve( const std::vector<Grid> &puzzles );
+
+    /**
+     * Create the solver stack used by each worker
+     * @return a MethodSolver with its own helper, marker and validator,
+     *         falling back to a BacktrackingSolver
+     */
+    static std::shared_ptr<ISolver> CreateSolver();
+
+private:
+    BatchSolver( const BatchSolver & );
+    BatchSolver & operator=( const BatchSolver & );
+
+    WorkStealingPool _pool;
+    /// One solver per worker, indexed by worker number
+    std::vector<std::shared_ptr<ISolver> > _solvers;
+};
+
+}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef SUDOKU_BITBOARD_H
+#define SUDOKU_BITBOARD_H
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace Sudoku
+{
+
+/**
+ * Set of Cells on the board as an 81-bit mask
+ * Bit i is the Cell with index i (see Units), stored in two 64-bit words so
+ * intersections, unions and counts are a couple of instructions each
+ */
+struct Bitboard
+{
+    /// Cells 0-63
+    uint64_t lo;
+    /// Cells 64-80
+    uint64_t hi;
+
+    /// Valid bits of the high word
+    static const uint64_t HI_MASK = ( uint64_t( 1 ) << 17 ) - 1;
+
+    /**
+     * Empty set
+     */
+    static Bitboard None()
+    {
+        Bitboard b = { 0, 0 };
+        return b;
+    }
+
+    /**
+     * Every Cell on the board
+     */
+    static Bitboard All()
+    {
+        Bitboard b = { ~uint64_t( 0 ), HI_MASK };
+        return b;
+    }
+
+    /**
+     * Set with a single Cell
+     * @param i Cell index in range [0,80]
+     */
+    static Bitboard Single( size_t i )
+    {
+        Bitboard b = None();
+        b.Set( i );
+        return b;
+    }
+
+    bool Test( size_t i ) const
+    {
+        return ( i < 64 ) ? ( ( lo >> i ) & 1 ) : ( ( hi >> ( i - 64 ) ) & 1 );
+    }
+
+    void Set( size_t i )
+    {
+        if ( i < 64 ) { lo |= uint64_t( 1 ) << i; }
+        else { hi |= uint64_t( 1 ) << ( i - 64 ); }
+    }
+
+    void Reset( size_t i )
+    {
+        if ( i < 64 ) { lo &= ~( uint64_t( 1 ) << i ); }
+        else { hi &= ~( uint64_t( 1 ) << ( i - 64 ) ); }
+    }
+
+    /**
+     * Number of Cells in the set
+     */
+    unsigned Count() const
+    {
+        return __builtin_popcountll( lo ) + __builtin_popcountll( hi );
+    }
+
+    bool Any() const { return ( lo | hi ) != 0; }
+    bool Empty() const { return ( lo | hi ) == 0; }
+
+    /**
+     * Lowest Cell index in the set
+     * @pre set is not empty
+     */
+    size_t First() const
+    {
+        return lo ? __builtin_ctzll( lo ) : 64 + __builtin_ctzll( hi );
+    }
+
+    /**
+     * Remove and return the lowest Cell index, for iterating a set
+     * @pre set is not empty
+     */
+    size_t PopFirst()
+    {
+        size_t i = First();
+        if ( lo ) { lo &= lo - 1; }
+        else { hi &= hi - 1; }
+        return i;
+    }
+
+    Bitboard operator&( const Bitboard &b ) const
+    {
+        Bitboard r = { lo & b.lo, hi & b.hi };
+        return r;
+    }
+
+    Bitboard operator|( const Bitboard &b ) const
+    {
+        Bitboard r = { lo | b.lo, hi | b.hi };
+        return r;
+    }
+
+    Bitboard operator^( const Bitboard &b ) const
+    {
+        Bitboard r = { lo ^ b.lo, hi ^ b.hi };
+        return r;
+    }
+
+    /// Complement within the 81 Cells of the board
+    Bitboard operator~() const
+    {
+        Bitboard r = { ~lo, ~hi & HI_MASK };
+        return r;
+    }
+
+    Bitboard& operator&=( const Bitboard &b )
+    {
+        lo &= b.lo;
+        hi &= b.hi;
+        return *this;
+    }
+
+    Bitboard& operator|=( const Bitboard &b )
+    {
+        lo |= b.lo;
+        hi |= b.hi;
+        return *this;
+    }
+
+    bool operator==( const Bitboard &b ) const
+    {
+        return lo == b.lo && hi == b.hi;
+    }
+
+    bool operator!=( const Bitboard &b ) const
+    {
+        return !( *this == b );
+    }
+};
+
+}
+
+#endif
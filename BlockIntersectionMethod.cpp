@@ -6,11 +6,14 @@
 namespace Sudoku
 {
 
-BlockIntersectionMethod::BlockIntersectionMethod( std::shared_ptr<Cell> c,
-                                                  unsigned mark,
-                                                  Puzzle::Container primary,
-                                                  Puzzle::Container secondary )
-    : _cell( c ), _mark( mark ), _primary( primary ), _secondary( secondary )
+BlockIntersectionMethod::BlockIntersectionMethod(
+    std::shared_ptr<Cell> c,
+    unsigned mark,
+    const Puzzle::Container &primary,
+    const Puzzle::Container &secondary )
+    : _cell( c ), _mark( mark ),
+      _primary( primary.begin(), primary.end() ),
+      _secondary( secondary.begin(), secondary.end() )
 {
     verifyGeometry();
 }
@@ -19,7 +22,7 @@ void BlockIntersectionMethod::ExecuteForward()
 {
     //std::for_each( _primary.begin(), _primary.end(),
     //               std::bind2nd( std::mem_fun_ref( &Cell::Unmark ), _mark ) );
-    for ( Puzzle::Container::iterator it = _primary.begin();
+    for ( CellArray<Units::UNIT_SIZE>::const_iterator it = _primary.begin();
           it != _primary.end();
           ++it )
     {
@@ -37,7 +40,7 @@ bool BlockIntersectionMethod::VerifyForwardConditions()
         return false;
     }
     // secondary does not have mark
-    for ( Puzzle::Container::iterator it = _secondary.begin();
+    for ( CellArray<Units::UNIT_SIZE>::const_iterator it = _secondary.begin();
           it != _secondary.end();
           ++it )
     {
@@ -47,7 +50,7 @@ bool BlockIntersectionMethod::VerifyForwardConditions()
         }
     }
     // primary has mark somewhere
-    for ( Puzzle::Container::iterator it = _primary.begin();
+    for ( CellArray<Units::UNIT_SIZE>::const_iterator it = _primary.begin();
           it != _primary.end();
           ++it )
     {
@@ -62,7 +65,7 @@ bool BlockIntersectionMethod::VerifyForwardConditions()
 void BlockIntersectionMethod::ExecuteReverse()
 
 {
-    for ( Puzzle::Container::iterator it = _primary.begin();
+    for ( CellArray<Units::UNIT_SIZE>::const_iterator it = _primary.begin();
           it != _primary.end();
           ++it )
     {
@@ -80,7 +83,7 @@ bool BlockIntersectionMethod::VerifyReverseConditions()
         return false;
     }
     // secondary does not have mark
-    for ( Puzzle::Container::iterator it = _secondary.begin();
+    for ( CellArray<Units::UNIT_SIZE>::const_iterator it = _secondary.begin();
           it != _secondary.end();
           ++it )
     {
@@ -91,7 +94,7 @@ bool BlockIntersectionMethod::VerifyReverseConditions()
     }
     // primary does not have mark, but has some marks
     bool has_some_mark = false;
-    for ( Puzzle::Container::iterator it = _primary.begin();
+    for ( CellArray<Units::UNIT_SIZE>::const_iterator it = _primary.begin();
           it != _primary.end();
           ++it )
     {
@@ -101,7 +104,7 @@ bool BlockIntersectionMethod::VerifyReverseConditions()
             {
                 return false;
             }
-            if ( !(*it)->GetMarkedValues().empty() ) 
+            if ( (*it)->CountMarks() != 0 )
             {
                 has_some_mark = true;
             }
@@ -118,11 +121,11 @@ void BlockIntersectionMethod::verifyGeometry()
             "Block Intersection Method requires sets of size 6." );
     }
     // check for overlap
-    Puzzle::Container temp;
+    CellArray<Units::UNIT_SIZE> temp;
     std::set_intersection( _primary.begin(), _primary.end(),
                            _secondary.begin(), _secondary.end(),
-                           std::inserter( temp, temp.begin() ),
-                           _primary.value_comp() );
+                           std::back_inserter( temp ),
+                           CellSorter() );
     if ( !temp.empty() )
     {
         throw std::logic_error(
@@ -3,7 +3,9 @@
 
 #include <memory>
 #include "SolutionMethod.h"
+#include "CellArray.h"
 #include "Puzzle.h"
+#include "Units.h"
 
 namespace Sudoku
 {
@@ -18,8 +20,8 @@ public:
      */
     BlockIntersectionMethod( std::shared_ptr<Cell> c,
                              unsigned mark,
-                             Puzzle::Container primary,
-                             Puzzle::Container secondary );
+                             const Puzzle::Container &primary,
+                             const Puzzle::Container &secondary );
 
     /**
      * This will remove the mark from all cells in the primary group
@@ -75,9 +77,9 @@ private:
     /// The mark we are using
     unsigned _mark;
     /// The (sector - 3 common Cells) which contains the mark
-    Puzzle::Container _primary;
+    CellArray<Units::UNIT_SIZE> _primary;
     /// The (sector - 3 common Cells) which does not contain the mark
-    Puzzle::Container _secondary;
+    CellArray<Units::UNIT_SIZE> _secondary;
 };
 
 }
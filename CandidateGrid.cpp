@@ -0,0 +1,183 @@
+#include "CandidateGrid.h"
+#include "Grid.h"
+
+namespace Sudoku
+{
+
+CandidateGrid::CandidateGrid()
+    : _unsolved( Bitboard::All() ),
+      _consistent( true )
+{
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        _values[i] = 0;
+        _candidates[i] = Grid::ALL_MARKS;
+    }
+    for ( size_t d = 0; d < Units::UNIT_SIZE; d++ )
+    {
+        _valueCells[d] = Bitboard::All();
+    }
+    for ( size_t u = 0; u < Units::UNIT_COUNT; u++ )
+    {
+        _placed[u] = 0;
+        for ( size_t d = 0; d < Units::UNIT_SIZE; d++ )
+        {
+            _positions[u][d] = Grid::ALL_MARKS;
+        }
+    }
+}
+
+CandidateGrid::CandidateGrid( const Grid &g )
+{
+    *this = CandidateGrid();
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        if ( g[i].value != 0 )
+        {
+            Place( i, g[i].value );
+        }
+    }
+}
+
+void CandidateGrid::CopyTo( Grid &g ) const
+{
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        g[i].value = _values[i];
+        g[i].marks = _candidates[i];
+    }
+}
+
+bool CandidateGrid::Place( size_t i, int value )
+{
+    unsigned short bit = 1 << ( value - 1 );
+    if ( _values[i] != 0 || !( _candidates[i] & bit ) )
+    {
+        _consistent = false;
+        return false;
+    }
+
+    _values[i] = value;
+    _unsolved.Reset( i );
+    // mark the units first so removing the value from this Cell is not
+    // mistaken for the unit running out of places
+    const unsigned char *units = Units::CELL_UNITS[i];
+    for ( size_t k = 0; k < Units::UNITS_PER_CELL; k++ )
+    {
+        _placed[units[k]] |= bit;
+    }
+    for ( unsigned short left = _candidates[i]; left; left &= left - 1 )
+    {
+        RemoveCandidate( i, __builtin_ctz( left ) + 1 );
+    }
+
+    // only the peers which still have the value need to change
+    Bitboard peers = Units::PEER_BOARDS[i] & _valueCells[value - 1];
+    while ( peers.Any() )
+    {
+        RemoveCandidate( peers.PopFirst(), value );
+    }
+    return _consistent;
+}
+
+bool CandidateGrid::Eliminate( size_t i, int value )
+{
+    if ( !( _candidates[i] & ( 1 << ( value - 1 ) ) ) )
+    {
+        return false;
+    }
+    RemoveCandidate( i, value );
+    return true;
+}
+
+void CandidateGrid::RemoveCandidate( size_t i, int d )
+{
+    unsigned short bit = 1 << ( d - 1 );
+    _candidates[i] &= ~bit;
+    _valueCells[d - 1].Reset( i );
+    const unsigned char *units = Units::CELL_UNITS[i];
+    for ( size_t k = 0; k < Units::UNITS_PER_CELL; k++ )
+    {
+        unsigned short &pos = _positions[units[k]][d - 1];
+        pos &= ~( 1 << Units::PositionInUnit( i, k ) );
+        if ( pos == 0 && !( _placed[units[k]] & bit ) )
+        {
+            _consistent = false;
+        }
+    }
+    if ( _candidates[i] == 0 && _values[i] == 0 )
+    {
+        _consistent = false;
+    }
+}
+
+bool CandidateGrid::PlaceSingles()
+{
+    unsigned char values[Units::CELL_COUNT];
+    bool progress = true;
+    while ( _consistent && progress )
+    {
+        progress = false;
+        Bitboard naked = GetNakedSingles();
+        while ( _consistent && naked.Any() )
+        {
+            size_t i = naked.PopFirst();
+            // an earlier placement may have emptied this Cell
+            if ( _candidates[i] )
+            {
+                Place( i, __builtin_ctz( _candidates[i] ) + 1 );
+                progress = true;
+            }
+        }
+        if ( !_consistent )
+        {
+            break;
+        }
+        Bitboard hidden = GetHiddenSingles( values );
+        while ( _consistent && hidden.Any() )
+        {
+            size_t i = hidden.PopFirst();
+            Place( i, values[i] );
+            progress = true;
+        }
+    }
+    return _consistent;
+}
+
+Bitboard CandidateGrid::GetNakedSingles() const
+{
+    // cells seen at least once and at least twice across the value boards
+    Bitboard once = Bitboard::None();
+    Bitboard twice = Bitboard::None();
+    for ( size_t d = 0; d < Units::UNIT_SIZE; d++ )
+    {
+        twice |= once & _valueCells[d];
+        once |= _valueCells[d];
+    }
+    return once & ~twice & _unsolved;
+}
+
+Bitboard CandidateGrid::GetHiddenSingles(
+    unsigned char values[Units::CELL_COUNT] ) const
+{
+    Bitboard result = Bitboard::None();
+    for ( size_t u = 0; u < Units::UNIT_COUNT; u++ )
+    {
+        for ( size_t d = 0; d < Units::UNIT_SIZE; d++ )
+        {
+            unsigned short pos = _positions[u][d];
+            if ( pos != 0 && ( pos & ( pos - 1 ) ) == 0 )
+            {
+                size_t i = Units::UNIT_CELLS[u][__builtin_ctz( pos )];
+                if ( !result.Test( i ) )
+                {
+                    result.Set( i );
+                    values[i] = d + 1;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,166 @@
+#ifndef SUDOKU_CANDIDATEGRID_H
+#define SUDOKU_CANDIDATEGRID_H
+
+#include <cstddef>
+#include "Bitboard.h"
+#include "Units.h"
+
+namespace Sudoku
+{
+
+class Grid;
+
+/**
+ * Bitboard candidate engine
+ * Keeps the candidates of a board in three redundant forms which are all
+ * updated incrementally when a value is placed or a candidate eliminated:
+ *  - a 9-bit candidate mask per Cell
+ *  - an 81-bit Bitboard per value of the Cells where that value can go
+ *  - a 9-bit mask per unit and value of the positions left in the unit
+ *
+ * Placing a value only touches the Cell and its 20 peers, so candidates never
+ * need to be recomputed from scratch, and naked or hidden singles fall out of
+ * a few AND / popcount operations instead of scanning Cells and building sets.
+ *
+ * A contradiction (a Cell or a unit with no place left for a value) is
+ * remembered, see IsConsistent().
+ * @note masks use bit (d - 1) for the value d, same as GridCell
+ */
+class CandidateGrid
+{
+public:
+    /**
+     * Create a blank board with every candidate possible
+     */
+    CandidateGrid();
+
+    /**
+     * Place the displayed values of a Grid (the marks of the Grid are ignored)
+     * @param g Grid to load
+     * @post IsConsistent() is false if the values of g conflict
+     */
+    explicit CandidateGrid( const Grid &g );
+
+    /**
+     * Write the values and candidates back into a Grid
+     * @param g Grid to update
+     * @post values and marks of g match this board, given flags are unchanged
+     */
+    void CopyTo( Grid &g ) const;
+
+    /**
+     * Place a value and eliminate it from every peer
+     * @param i Cell index
+     * @param value Value to place
+     * @pre i < Units::CELL_COUNT and value is in {1...9}
+     * @return false if the board is no longer consistent
+     */
+    bool Place( size_t i, int value );
+
+    /**
+     * Remove a single candidate from a Cell
+     * @param i Cell index
+     * @param value Candidate to remove
+     * @pre i < Units::CELL_COUNT and value is in {1...9}
+     * @return true if the candidate was there
+     */
+    bool Eliminate( size_t i, int value );
+
+    /**
+     * Repeatedly place every naked and hidden single
+     * @return false if this leads to a contradiction
+     */
+    bool PlaceSingles();
+
+    /**
+     * Candidates of a Cell
+     * @param i Cell index
+     * @return 9-bit mask, 0 once the Cell has a value
+     */
+    unsigned short GetCandidates( size_t i ) const { return _candidates[i]; }
+
+    /**
+     * Value of a Cell
+     * @param i Cell index
+     * @return value {1...9}, 0 if none placed
+     */
+    int GetValue( size_t i ) const { return _values[i]; }
+
+    /**
+     * Cells where a value is still a candidate
+     * @param value Value to look up
+     * @pre value is in {1...9}
+     */
+    const Bitboard& GetValueCells( int value ) const
+    {
+        return _valueCells[value - 1];
+    }
+
+    /**
+     * Positions where a value is still a candidate inside a unit
+     * @param u Unit number (see Units)
+     * @param value Value to look up
+     * @return 9-bit mask, bit k is the Cell Units::UNIT_CELLS[u][k]
+     */
+    unsigned short GetUnitPositions( size_t u, int value ) const
+    {
+        return _positions[u][value - 1];
+    }
+
+    /**
+     * Values placed in a unit
+     * @param u Unit number (see Units)
+     * @return 9-bit mask of values
+     */
+    unsigned short GetUnitValues( size_t u ) const { return _placed[u]; }
+
+    /**
+     * Cells without a value
+     */
+    const Bitboard& GetUnsolved() const { return _unsolved; }
+
+    bool IsSolved() const { return _unsolved.Empty(); }
+
+    /**
+     * Check that no contradiction has been found
+     * @return false once any Cell or unit has run out of candidates
+     */
+    bool IsConsistent() const { return _consistent; }
+
+    /**
+     * Find every Cell without a value and with exactly one candidate
+     * @return set of Cells
+     */
+    Bitboard GetNakedSingles() const;
+
+    /**
+     * Find every Cell which is the only place left for a value in some unit
+     * @param values Filled with the value for each Cell in the result
+     * @return set of Cells
+     */
+    Bitboard GetHiddenSingles( unsigned char values[Units::CELL_COUNT] ) const;
+
+private:
+    /**
+     * Remove a candidate which is known to be set and check for contradiction
+     */
+    void RemoveCandidate( size_t i, int d );
+
+    /// Placed value per Cell, 0 for none
+    unsigned char _values[Units::CELL_COUNT];
+    /// Candidate mask per Cell
+    unsigned short _candidates[Units::CELL_COUNT];
+    /// Cells where each value is a candidate, indexed by value - 1
+    Bitboard _valueCells[Units::UNIT_SIZE];
+    /// Candidate positions per unit and value - 1
+    unsigned short _positions[Units::UNIT_COUNT][Units::UNIT_SIZE];
+    /// Values placed per unit
+    unsigned short _placed[Units::UNIT_COUNT];
+    /// Cells without a value
+    Bitboard _unsolved;
+    bool _consistent;
+};
+
+}
+
+#endif
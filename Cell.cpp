@@ -1,5 +1,6 @@
 
 #include "Cell.h"
+#include "CellHistory.h"
 #include "ICellObserver.h"
 #include <iostream>
 #include <algorithm>
@@ -11,10 +12,14 @@ Cell::Cell()
     : _pos( 0, 0 ),
       _correctVal( 0 ),
       _guessedVal( 0 ),
-      _displayCorrect( false )
+      _displayCorrect( false ),
+      _changed( NULL ),
+      _history( NULL )
 {}
 
 Cell::Cell( const Cell &c )
+    : _changed( NULL ),
+      _history( NULL )
 {
     *this = c;
 }
@@ -52,7 +57,7 @@ void Cell::SetCorrect( int correct )
     Validate( correct, 0, 9 );
     if ( _correctVal != correct )
     {
-        NotifyObservers();
+        changing();
     }
     _correctVal = correct;
 }
@@ -64,7 +69,7 @@ void Cell::SetGuess( int guess )
     {
         if ( _guessedVal != guess )
         {
-            NotifyObservers();
+            changing();
         }
         _guessedVal = guess;
     }
@@ -78,7 +83,7 @@ void Cell::Display( bool display )
 {
     if ( _displayCorrect != display )
     {
-        NotifyObservers();
+        changing();
     }
     _displayCorrect = display;
 }
@@ -87,7 +92,7 @@ void Cell::Mark( int mark )
 {
     if ( !_marks.test( mark ) )
     {
-        NotifyObservers();
+        changing();
     }
     _marks.set( mark );
 }
@@ -96,7 +101,7 @@ void Cell::Unmark( int mark )
 {
     if ( _marks.test( mark ) )
     {
-        NotifyObservers();
+        changing();
     }
     _marks.reset( mark );
 }
@@ -105,7 +110,7 @@ void Cell::ClearMarks()
 {
     if ( _marks.any() )
     {
-        NotifyObservers();
+        changing();
     }
     _marks.reset();
 }
@@ -114,7 +119,7 @@ void Cell::MarkAll()
 {
     if ( _marks.count() < _marks.size() )
     {
-        NotifyObservers();
+        changing();
     }
     _marks.set();
 }
@@ -141,7 +146,7 @@ void Cell::SetMarkContainer( const Cell::MarkContainer &m )
 {
     if ( _marks != m )
     {
-        NotifyObservers();
+        changing();
     }
     _marks &= m;
     _marks |= m;
@@ -164,6 +169,31 @@ Cell::MarkedValues Cell::GetMarkedValues() const
     return M;
 }
 
+Cell::State Cell::GetState() const
+{
+    return static_cast<State>( _marks.to_ulong() ) |
+        ( static_cast<State>( _correctVal ) << 10 ) |
+        ( static_cast<State>( _guessedVal ) << 14 ) |
+        ( _displayCorrect ? 1u << 18 : 0u );
+}
+
+void Cell::SetState( Cell::State s )
+{
+    int correct = ( s >> 10 ) & 0xF;
+    int guess = ( s >> 14 ) & 0xF;
+    Validate( correct, 0, 9 );
+    Validate( guess, 0, 9 );
+    if ( s == GetState() )
+    {
+        return;
+    }
+    changing();
+    _marks = MarkContainer( s & 0x3FF );
+    _correctVal = correct;
+    _guessedVal = guess;
+    _displayCorrect = ( s >> 18 ) & 1;
+}
+
 void Cell::AddObserver( std::shared_ptr<ICellObserver> o )
 {
     if ( !o )
@@ -192,6 +222,11 @@ void Cell::RemoveObserver( std::shared_ptr<ICellObserver> o )
 
 void Cell::NotifyObservers()
 {
+    if ( _changed )
+    {
+        _changed->Set( ( _pos.y - 1 ) * 9 + ( _pos.x - 1 ) );
+        return;
+    }
     for ( ObserverContainer::iterator it = _observers.begin();
           it != _observers.end();
           ++it )
@@ -200,6 +235,15 @@ void Cell::NotifyObservers()
     }
 }
 
+void Cell::changing()
+{
+    if ( _history )
+    {
+        _history->Save( *this );
+    }
+    NotifyObservers();
+}
+
 bool Cell::operator==( const Cell& c ) const
 {
     return ( c._pos.x == _pos.x &&
@@ -7,9 +7,12 @@
 #include <stdexcept>
 #include <vector>
 
+#include "Bitboard.h"
+
 namespace Sudoku
 {
 
+class  CellHistory;
 class  ICellObserver;
 
 struct Position
@@ -36,6 +39,8 @@ class Cell
 public:
     
     typedef std::bitset<10> MarkContainer;
+    /// Everything but the position packed in 19 bits, see GetState
+    typedef unsigned int State;
     typedef std::set<int> MarkedValues;
     typedef std::vector<std::shared_ptr<ICellObserver> > ObserverContainer;
 
@@ -203,6 +208,33 @@ public:
      */
     MarkedValues GetMarkedValues() const;
 
+    /**
+     * Pack the values, display flag and marks of this Cell
+     * Bits 0-9 are the marks, 10-13 the correct value, 14-17 the guess and
+     * 18 the display flag, so a change can be stored in a few bytes
+     * @return the packed state, the position is not included
+     */
+    State GetState() const;
+
+    /**
+     * Set the values, display flag and marks from a packed state
+     * @param s State from GetState (of this or any other Cell)
+     * @throw std::range_error if a value in s is out of range
+     * @post The Cell is like the one s was taken from, except its position
+     * @post Notify observers if changed
+     */
+    void SetState( State s );
+
+    /**
+     * Count the values that are marked without building a set
+     * @note ignore mark on 0
+     * @return number of marks on values {1...9}
+     */
+    size_t CountMarks() const
+    {
+        return _marks.count() - ( _marks[0] ? 1 : 0 );
+    }
+
     /**
      * Add an observer to listen for changes to this Cell
      * @param o Observer to add
@@ -220,11 +252,28 @@ public:
 
     /**
      * Notify all observers that something in this Cell changed
+     * While notifications are deferred the Cell is only added to the
+     * deferred set, see DeferNotifications
      * @pre Cell changed
      * @post All observers listening get notified
      */
     void NotifyObservers();
 
+    /**
+     * Hold back notifications, for changing many Cells at once
+     * @param changed Set of Cells (by index, see Units) to add this Cell to
+     *        instead of notifying, NULL to notify right away again
+     * @see Puzzle::BeginChanges
+     */
+    void DeferNotifications( Bitboard *changed ) { _changed = changed; }
+
+    /**
+     * Keep the old state of this Cell whenever it changes
+     * @param history History to save to, NULL to stop
+     * @see Puzzle::TakeSnapshot
+     */
+    void SetHistory( CellHistory *history ) { _history = history; }
+
     /**
      * Check for ABSOLUTE equality
      * @param c The Cell to compare with
@@ -253,6 +302,12 @@ private:
      */
     friend std::ostream& operator<<( std::ostream &os, const Cell &c );
 
+    /**
+     * Called right before any value or mark changes
+     * Saves the old state to the history and notifies observers
+     */
+    void changing();
+
     /// x,y location on the Sudoku board {1...9}
     Position _pos;
     /// The correct value for this Cell which a user should try to guess
@@ -265,6 +320,10 @@ private:
     MarkContainer _marks;
 
     ObserverContainer _observers;
+    /// Where changes are recorded while notifications are deferred
+    Bitboard *_changed;
+    /// Where the old state goes before a change, may be NULL
+    CellHistory *_history;
 };
 
 // Attempt to inline this for performance
@@ -0,0 +1,74 @@
+#ifndef SUDOKU_CELL_ARRAY_H
+#define SUDOKU_CELL_ARRAY_H
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+namespace Sudoku
+{
+
+class Cell;
+
+/**
+ * A list of at most N Cells stored inline
+ * SolutionMethods keep the Cells they work on in these instead of a
+ * Puzzle::Container, so building one does not allocate a set node per Cell.
+ * Cells keep the order they were added in; copied from a Container that is
+ * CellSorter order, so the STL set algorithms still work on them.
+ * @param N Capacity, a unit (9) or the peers of a Cell (20)
+ */
+template <size_t N>
+class CellArray
+{
+public:
+    typedef std::shared_ptr<Cell> value_type;
+    typedef const value_type& const_reference;
+    typedef const_reference reference;
+    typedef const value_type* const_iterator;
+    typedef const_iterator iterator;
+    typedef size_t size_type;
+
+    CellArray() : _size( 0 ) {}
+
+    /**
+     * Copy Cells from any range
+     * @throw std::length_error if there are more than N
+     */
+    template <class Iterator>
+    CellArray( Iterator first, Iterator last ) : _size( 0 )
+    {
+        for ( ; first != last; ++first )
+        {
+            push_back( *first );
+        }
+    }
+
+    /**
+     * Add a Cell at the end
+     * @throw std::length_error if the array is full
+     */
+    void push_back( const value_type &c )
+    {
+        if ( _size == N )
+        {
+            throw std::length_error( "Too many Cells for CellArray." );
+        }
+        _cells[_size++] = c;
+    }
+
+    const_reference operator[]( size_t k ) const { return _cells[k]; }
+
+    const_iterator begin() const { return _cells; }
+    const_iterator end() const { return _cells + _size; }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+private:
+    value_type _cells[N];
+    size_t _size;
+};
+
+}
+
+#endif
@@ -0,0 +1,120 @@
+#include "CellHistory.h"
+#include "Units.h"
+
+#include <stdexcept>
+
+namespace Sudoku
+{
+
+unsigned CellHistory::Take()
+{
+    Version v;
+    v.id = _nextId++;
+    v.saved = Bitboard::None();
+    _versions.push_back( v );
+    return v.id;
+}
+
+void CellHistory::Save( const Cell &c )
+{
+    if ( _versions.empty() )
+    {
+        return;
+    }
+    Version &v = _versions.back();
+    size_t i = Units::Index( c.GetX(), c.GetY() );
+    if ( !v.saved.Test( i ) )
+    {
+        v.saved.Set( i );
+        v.cells.push_back( c );
+    }
+}
+
+Bitboard CellHistory::Restore( unsigned id, const std::shared_ptr<Cell> *cells )
+{
+    size_t k = find( id );
+    if ( k == _versions.size() )
+    {
+        throw std::logic_error( "Cannot restore a dropped Puzzle version." );
+    }
+    Bitboard restored = Bitboard::None();
+    // newest first so the oldest saved state of each Cell is the one left
+    for ( size_t n = _versions.size(); n-- > k; )
+    {
+        Version &v = _versions[n];
+        for ( std::vector<Cell>::const_iterator it = v.cells.begin();
+              it != v.cells.end();
+              ++it )
+        {
+            *cells[Units::Index( it->GetX(), it->GetY() )] = *it;
+        }
+        restored |= v.saved;
+    }
+    _versions.resize( k + 1 );
+    _versions[k].saved = Bitboard::None();
+    _versions[k].cells.clear();
+    return restored;
+}
+
+void CellHistory::Release( unsigned id )
+{
+    size_t k = find( id );
+    if ( k == _versions.size() )
+    {
+        return;
+    }
+    if ( k > 0 )
+    {
+        // the version before needs whatever was saved here and not there
+        Version &older = _versions[k - 1];
+        Version &v = _versions[k];
+        for ( std::vector<Cell>::const_iterator it = v.cells.begin();
+              it != v.cells.end();
+              ++it )
+        {
+            size_t i = Units::Index( it->GetX(), it->GetY() );
+            if ( !older.saved.Test( i ) )
+            {
+                older.saved.Set( i );
+                older.cells.push_back( *it );
+            }
+        }
+    }
+    _versions.erase( _versions.begin() + k );
+}
+
+bool CellHistory::Has( unsigned id ) const
+{
+    return find( id ) != _versions.size();
+}
+
+Bitboard CellHistory::ChangedSince( unsigned id ) const
+{
+    size_t k = find( id );
+    if ( k == _versions.size() )
+    {
+        throw std::logic_error(
+            "Cannot compare with a dropped Puzzle version." );
+    }
+    Bitboard changed = Bitboard::None();
+    for ( ; k < _versions.size(); k++ )
+    {
+        changed |= _versions[k].saved;
+    }
+    return changed;
+}
+
+size_t CellHistory::find( unsigned id ) const
+{
+    // the version wanted is nearly always the newest
+    for ( size_t n = _versions.size(); n-- > 0; )
+    {
+        if ( _versions[n].id == id )
+        {
+            return n;
+        }
+    }
+    return _versions.size();
+}
+
+}
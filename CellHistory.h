@@ -0,0 +1,127 @@
+#ifndef SUDOKU_CELL_HISTORY_H
+#define SUDOKU_CELL_HISTORY_H
+
+#include <memory>
+#include <vector>
+
+#include "Bitboard.h"
+#include "Cell.h"
+
+namespace Sudoku
+{
+
+/**
+ * Copy-on-write history of the Cells of one Puzzle
+ * Taking a version costs nothing, the old state of a Cell is only copied the
+ * first time it changes after the newest version was taken (the Cells call
+ * Save right before they change).  Versions are kept as a stack, so an
+ * older version is the newer versions' saved Cells plus its own.
+ *
+ * Going back to a version only touches the Cells which changed since, and
+ * versions nobody needs anymore are merged into the one before them.
+ */
+class CellHistory
+{
+public:
+    CellHistory() : _nextId( 0 ) {}
+
+    /**
+     * Start a new version
+     * @return id of the version, to Restore or Release it
+     */
+    unsigned Take();
+
+    /**
+     * Remember a Cell before it changes
+     * @param c Cell which is about to change
+     * @post the newest version has the state of c, if it did not already
+     */
+    void Save( const Cell &c );
+
+    /**
+     * Put the Cells back the way they were when a version was taken
+     * Versions taken after it are dropped, the version itself stays
+     * @param id Version to go back to
+     * @param cells The 81 Cells of the Puzzle, indexed as in Units
+     * @throw std::logic_error if the version was dropped or released
+     * @return Cells which were put back (by index, see Units)
+     * @note Cells are assigned without notifying their observers
+     */
+    Bitboard Restore( unsigned id, const std::shared_ptr<Cell> *cells );
+
+    /**
+     * Forget a version
+     * @param id Version which is no longer needed, may already be dropped
+     */
+    void Release( unsigned id );
+
+    /**
+     * Check if a version can still be restored
+     * @param id Version to look for
+     */
+    bool Has( unsigned id ) const;
+
+    /**
+     * Find the Cells which changed since a version was taken
+     * @param id Version to compare with
+     * @throw std::logic_error if the version was dropped or released
+     * @return Cells by index, a Cell may have been changed back
+     */
+    Bitboard ChangedSince( unsigned id ) const;
+
+private:
+    CellHistory( const CellHistory & );
+    CellHistory & operator=( const CellHistory & );
+
+    struct Version
+    {
+        unsigned id;
+        /// Cells with their state saved in this version
+        Bitboard saved;
+        /// Saved Cells in the order they were saved
+        std::vector<Cell> cells;
+    };
+    typedef std::vector<Version> VersionContainer;
+
+    /**
+     * Position of a version in the stack
+     * @return _versions.size() if it is not there
+     */
+    size_t find( unsigned id ) const;
+
+    /// Oldest version first
+    VersionContainer _versions;
+    unsigned _nextId;
+};
+
+/**
+ * Handle to a version of a Puzzle, see Puzzle::TakeSnapshot
+ * The version is released when the last handle goes away.
+ */
+class PuzzleSnapshot
+{
+public:
+    PuzzleSnapshot( std::shared_ptr<CellHistory> history, unsigned id )
+        : _history( history ), _id( id ) {}
+
+    /**
+     * Check if the Puzzle can still go back to this snapshot
+     * @return false once the Puzzle was restored to an older snapshot
+     */
+    bool IsValid() const { return _history->Has( _id ); }
+
+    ~PuzzleSnapshot() { _history->Release( _id ); }
+
+private:
+    PuzzleSnapshot( const PuzzleSnapshot & );
+    PuzzleSnapshot & operator=( const PuzzleSnapshot & );
+
+    friend class Puzzle;
+
+    std::shared_ptr<CellHistory> _history;
+    unsigned _id;
+};
+
+}
+
+#endif
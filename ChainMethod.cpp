@@ -0,0 +1,205 @@
+#include "ChainMethod.h"
+#include "Cell.h"
+
+namespace Sudoku
+{
+
+namespace
+{
+
+bool IsOpen( const std::shared_ptr<Cell> &c )
+{
+    return c->CanGuess() && c->DisplayedValue() == 0;
+}
+
+/**
+ * Two nodes can be linked if they are one Cell or one digit in peers
+ */
+bool CanLink( const Chains::Node &a, const Chains::Node &b )
+{
+    if ( a.cell == b.cell )
+    {
+        return a.digit != b.digit;
+    }
+    return a.digit == b.digit && Units::PEER_BOARDS[a.cell].Test( b.cell );
+}
+
+}
+
+ChainMethod::ChainMethod( std::shared_ptr<Puzzle> p,
+                          const Chains::Chain &chain )
+    : _puzzle( p ), _kind( chain.kind ), _mark( chain.digit ),
+      _length( chain.length )
+{
+    if ( _mark < 1 || _mark > 9 || _length > Chains::MAX_NODES )
+    {
+        throw std::logic_error( "Chain Method requires a mark from 1 to 9." );
+    }
+    for ( size_t k = 0; k < _length; k++ )
+    {
+        _nodes[k] = chain.nodes[k];
+        size_t i = _nodes[k].cell;
+        _cells.push_back( p->GetCell( i % 9 + 1, i / 9 + 1 ) );
+    }
+    bool linked = true;
+    if ( _kind == Chains::XYZ_WING )
+    {
+        // pivot and two pincers which see it, all on the mark
+        linked = _length == 3 &&
+            Units::PEER_BOARDS[_nodes[0].cell].Test( _nodes[1].cell ) &&
+            Units::PEER_BOARDS[_nodes[0].cell].Test( _nodes[2].cell );
+        for ( size_t k = 0; k < _length; k++ )
+        {
+            linked = linked && _nodes[k].digit == _mark;
+        }
+    }
+    else
+    {
+        // an even number of nodes, ends on the mark
+        linked = _length >= 2 && _length % 2 == 0 &&
+            _nodes[0].digit == _mark && _nodes[_length - 1].digit == _mark;
+        for ( size_t k = 0; linked && k + 1 < _length; k++ )
+        {
+            linked = CanLink( _nodes[k], _nodes[k + 1] );
+        }
+    }
+    if ( !linked )
+    {
+        throw std::logic_error( "Chain Method nodes are not a chain." );
+    }
+    for ( Bitboard targets = chain.targets; targets.Any(); )
+    {
+        size_t i = targets.PopFirst();
+        _targets.push_back( p->GetCell( i % 9 + 1, i / 9 + 1 ) );
+    }
+}
+
+void ChainMethod::ExecuteForward()
+{
+    for ( CellArray<Units::PEER_COUNT>::const_iterator it = _targets.begin();
+          it != _targets.end();
+          ++it )
+    {
+        if ( (*it)->CanGuess() )
+        {
+            (*it)->Unmark( _mark );
+        }
+    }
+}
+
+bool ChainMethod::VerifyForwardConditions()
+{
+    if ( !isChain() )
+    {
+        return false;
+    }
+    for ( CellArray<Units::PEER_COUNT>::const_iterator it = _targets.begin();
+          it != _targets.end();
+          ++it )
+    {
+        if ( IsOpen( *it ) && (*it)->GetMarkContainer()[_mark] )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ChainMethod::ExecuteReverse()
+{
+    for ( CellArray<Units::PEER_COUNT>::const_iterator it = _targets.begin();
+          it != _targets.end();
+          ++it )
+    {
+        if ( IsOpen( *it ) )
+        {
+            (*it)->Mark( _mark );
+        }
+    }
+}
+
+bool ChainMethod::VerifyReverseConditions()
+{
+    if ( !isChain() )
+    {
+        return false;
+    }
+    bool hasOpen = false;
+    for ( CellArray<Units::PEER_COUNT>::const_iterator it = _targets.begin();
+          it != _targets.end();
+          ++it )
+    {
+        if ( (*it)->DisplayedValue() == static_cast<int>( _mark ) ||
+             ( IsOpen( *it ) && (*it)->GetMarkContainer()[_mark] ) )
+        {
+            return false;
+        }
+        hasOpen = hasOpen || IsOpen( *it );
+    }
+    return hasOpen;
+}
+
+bool ChainMethod::isChain() const
+{
+    for ( size_t k = 0; k < _length; k++ )
+    {
+        if ( !IsOpen( _cells[k] ) ||
+             !_cells[k]->GetMarkContainer()[_nodes[k].digit] )
+        {
+            return false;
+        }
+    }
+    if ( _kind == Chains::XYZ_WING )
+    {
+        // pincers are two of the pivot's three marks, sharing the mark
+        Cell::MarkContainer pivot = _cells[0]->GetMarkContainer();
+        Cell::MarkContainer a = _cells[1]->GetMarkContainer();
+        Cell::MarkContainer b = _cells[2]->GetMarkContainer();
+        return pivot.count() == 3 && a.count() == 2 && b.count() == 2 &&
+            a != b && ( a | b ) == pivot;
+    }
+    for ( size_t k = 0; k + 1 < _length; k += 2 )
+    {
+        bool strong = _nodes[k].cell == _nodes[k + 1].cell ?
+            isBivalue( k, _nodes[k].digit, _nodes[k + 1].digit ) :
+            isConjugate( k, k + 1, _nodes[k].digit );
+        if ( !strong )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ChainMethod::isBivalue( size_t k, int a, int b ) const
+{
+    const Cell::MarkContainer &marks = _cells[k]->GetMarkContainer();
+    return marks.count() == 2 && marks[a] && marks[b];
+}
+
+bool ChainMethod::isConjugate( size_t j, size_t k, int mark ) const
+{
+    const unsigned char *units = Units::CELL_UNITS[_nodes[j].cell];
+    for ( size_t u = 0; u < Units::UNITS_PER_CELL; u++ )
+    {
+        if ( !Units::UNIT_BOARDS[units[u]].Test( _nodes[k].cell ) )
+        {
+            continue;
+        }
+        size_t places = 0;
+        Puzzle::View unit = _puzzle->GetUnitView( units[u] );
+        for ( Puzzle::View::iterator it = unit.begin();
+              it != unit.end();
+              ++it )
+        {
+            places += IsOpen( *it ) && (*it)->GetMarkContainer()[mark];
+        }
+        if ( places == 2 )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,103 @@
+#ifndef SUDOKU_CHAIN_METHOD_H
+#define SUDOKU_CHAIN_METHOD_H
+
+#include <memory>
+#include "SolutionMethod.h"
+#include "CellArray.h"
+#include "Chains.h"
+#include "Puzzle.h"
+#include "Units.h"
+
+namespace Sudoku
+{
+
+/**
+ * Simple coloring, X-Chains, XY-Wings, XYZ-Wings and remote pairs
+ * The chain (see Chains) shows a mark is true in one of its ends, so it can
+ * be removed from the Cells which see both.  The chain is checked against
+ * the Cells each time, so a Method found before other Methods ran is only
+ * executed if its strong links still hold.
+ */
+class ChainMethod : public SolutionMethod
+{
+public:
+    /**
+     * Create the method for a chain
+     * @param p Puzzle the chain is in
+     * @param chain Nodes, mark and targets
+     * @throw std::logic_error if the nodes are not linked as the kind needs
+     */
+    ChainMethod( std::shared_ptr<Puzzle> p, const Chains::Chain &chain );
+
+    /**
+     * This will remove the mark from the targets
+     * @pre VerifyForwardConditions
+     * @post Targets do not have the mark
+     */
+    virtual void ExecuteForward();
+
+    /**
+     * Verify that the strong links of the chain hold
+     * Verify that a target has the mark
+     * @return true if the precondition holds
+     */
+    virtual bool VerifyForwardConditions();
+
+    /**
+     * This will mark the mark on the targets without a value
+     * @pre VerifyReverseConditions
+     * @post Targets have the mark
+     */
+    virtual void ExecuteReverse();
+
+    /**
+     * Verify that the strong links of the chain hold
+     * Verify that no target has the mark or the value, and one has no value
+     * @return true if the precondition holds
+     */
+    virtual bool VerifyReverseConditions();
+
+    /**
+     * Which kind of chain this is
+     */
+    Chains::Kind GetKind() const { return _kind; }
+
+    /**
+     * Do nothing
+     */
+    virtual ~ChainMethod() {}
+
+private:
+    ChainMethod( const ChainMethod & );
+    ChainMethod & operator=( const ChainMethod & );
+
+    /**
+     * Check the links which must be strong
+     */
+    bool isChain() const;
+
+    /**
+     * Check that a Cell's only marks are two digits
+     */
+    bool isBivalue( size_t k, int a, int b ) const;
+
+    /**
+     * Check that a mark is only in two Cells of a unit they share
+     */
+    bool isConjugate( size_t j, size_t k, int mark ) const;
+
+    std::shared_ptr<Puzzle> _puzzle;
+    Chains::Kind _kind;
+    /// The mark we are using
+    unsigned _mark;
+    size_t _length;
+    Chains::Node _nodes[Chains::MAX_NODES];
+    /// Cell of each node
+    CellArray<Chains::MAX_NODES> _cells;
+    /// Cells to remove the mark from
+    CellArray<Units::PEER_COUNT> _targets;
+};
+
+}
+
+#endif
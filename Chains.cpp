@@ -0,0 +1,456 @@
+#include "Chains.h"
+#include "LinkGraph.h"
+
+namespace Sudoku
+{
+
+namespace
+{
+
+typedef Chains::Chain Chain;
+
+/// BFS states are a Cell and whether it was reached by a strong link
+const size_t STATE_COUNT = Units::CELL_COUNT * 2;
+
+/**
+ * Keep a chain if it removes something no chain before it did
+ * @param taken Cells already removed from, per digit
+ */
+void Add( Chain &c, Bitboard targets, Bitboard taken[Units::UNIT_SIZE],
+          Chains::ChainContainer &found )
+{
+    targets &= ~taken[c.digit - 1];
+    if ( targets.Empty() )
+    {
+        return;
+    }
+    taken[c.digit - 1] |= targets;
+    c.targets = targets;
+    found.push_back( c );
+}
+
+void AddNode( Chain &c, size_t cell, int digit )
+{
+    c.nodes[c.length].cell = cell;
+    c.nodes[c.length].digit = digit;
+    ++c.length;
+}
+
+/**
+ * Cells of a path back to the root of a BFS tree over Cells
+ * @param path Filled from cell to the root
+ * @return Number of Cells, 0 if more than max
+ */
+size_t PathToRoot( const short parent[Units::CELL_COUNT], size_t cell,
+                   unsigned char path[Units::CELL_COUNT], size_t max )
+{
+    size_t n = 0;
+    while ( true )
+    {
+        if ( n == max )
+        {
+            return 0;
+        }
+        path[n++] = cell;
+        if ( static_cast<size_t>( parent[cell] ) == cell )
+        {
+            return n;
+        }
+        cell = parent[cell];
+    }
+}
+
+int Digit( unsigned short candidates )
+{
+    return __builtin_ctz( candidates ) + 1;
+}
+
+/**
+ * Color the clusters of conjugate pairs of a digit, a Cell seeing both
+ * colors of a cluster cannot have the digit
+ */
+void FindColoring( const LinkGraph &g, int digit,
+                   Bitboard taken[Units::UNIT_SIZE],
+                   Chains::ChainContainer &found )
+{
+    const Bitboard &cells = g.GetCells( digit );
+    short parent[Units::CELL_COUNT];
+    unsigned char queue[Units::CELL_COUNT];
+    Bitboard seen = Bitboard::None();
+    for ( Bitboard starts = cells; starts.Any(); )
+    {
+        size_t s = starts.PopFirst();
+        if ( seen.Test( s ) || g.GetConjugates( digit, s ).Empty() )
+        {
+            continue;
+        }
+        Bitboard colors[2] = { Bitboard::Single( s ), Bitboard::None() };
+        Bitboard cluster = Bitboard::Single( s );
+        parent[s] = s;
+        size_t head = 0;
+        size_t tail = 0;
+        queue[tail++] = s;
+        while ( head < tail )
+        {
+            size_t c = queue[head++];
+            size_t color = colors[1].Test( c );
+            Bitboard next = g.GetConjugates( digit, c ) & ~cluster;
+            while ( next.Any() )
+            {
+                size_t j = next.PopFirst();
+                parent[j] = c;
+                cluster.Set( j );
+                colors[1 - color].Set( j );
+                queue[tail++] = j;
+            }
+        }
+        seen |= cluster;
+
+        Bitboard open = cells & ~cluster & ~taken[digit - 1];
+        while ( open.Any() )
+        {
+            size_t t = open.PopFirst();
+            Bitboard a = Units::PEER_BOARDS[t] & colors[0];
+            Bitboard b = Units::PEER_BOARDS[t] & colors[1];
+            if ( a.Empty() || b.Empty() )
+            {
+                continue;
+            }
+            // path through the tree, up from one end to where the other
+            // end's path joins it
+            unsigned char up[Units::CELL_COUNT];
+            unsigned char down[Units::CELL_COUNT];
+            size_t p = a.First();
+            size_t q = b.First();
+            size_t nUp = PathToRoot( parent, p, up, Units::CELL_COUNT );
+            size_t nDown = PathToRoot( parent, q, down, Units::CELL_COUNT );
+            while ( nUp > 1 && nDown > 1 &&
+                    up[nUp - 2] == down[nDown - 2] )
+            {
+                --nUp;
+                --nDown;
+            }
+            if ( nUp + nDown - 1 > Chains::MAX_NODES )
+            {
+                continue;
+            }
+            Chain c;
+            c.kind = Chains::SIMPLE_COLORING;
+            c.digit = digit;
+            c.length = 0;
+            Bitboard path = Bitboard::None();
+            for ( size_t k = 0; k < nUp; k++ )
+            {
+                AddNode( c, up[k], digit );
+                path.Set( up[k] );
+            }
+            for ( size_t k = nDown - 1; k-- > 0; )
+            {
+                AddNode( c, down[k], digit );
+                path.Set( down[k] );
+            }
+            Add( c, Units::PEER_BOARDS[p] & Units::PEER_BOARDS[q] & cells &
+                 ~path, taken, found );
+            open &= ~taken[digit - 1];
+        }
+    }
+}
+
+/**
+ * Chains of one digit from each Cell with a conjugate pair, alternating
+ * conjugate pairs and any peers
+ */
+void FindXChains( const LinkGraph &g, int digit,
+                  Bitboard taken[Units::UNIT_SIZE],
+                  Chains::ChainContainer &found )
+{
+    const Bitboard &cells = g.GetCells( digit );
+    short parent[STATE_COUNT];
+    short queue[STATE_COUNT];
+    for ( Bitboard starts = cells; starts.Any(); )
+    {
+        size_t s = starts.PopFirst();
+        if ( g.GetConjugates( digit, s ).Empty() )
+        {
+            continue;
+        }
+        for ( size_t k = 0; k < STATE_COUNT; k++ )
+        {
+            parent[k] = -1;
+        }
+        size_t head = 0;
+        size_t tail = 0;
+        parent[s * 2] = s * 2;
+        queue[tail++] = s * 2;
+        while ( head < tail )
+        {
+            size_t x = queue[head++];
+            size_t strong = x % 2;
+            // from a weak end take a strong link, and the other way round
+            Bitboard next = strong ? g.GetWeak( digit, x / 2 ) :
+                g.GetConjugates( digit, x / 2 );
+            while ( next.Any() )
+            {
+                size_t j = next.PopFirst();
+                size_t y = j * 2 + ( 1 - strong );
+                if ( parent[y] >= 0 )
+                {
+                    continue;
+                }
+                parent[y] = x;
+                queue[tail++] = y;
+                // a chain ends with a strong link, each is found from its
+                // lower end and needs 3 links to be more than a pair
+                if ( strong || j <= s )
+                {
+                    continue;
+                }
+                unsigned char cellsUp[STATE_COUNT];
+                size_t n = 0;
+                Bitboard path = Bitboard::None();
+                bool simple = true;
+                for ( size_t z = y; n <= Chains::MAX_NODES;
+                      z = parent[z] )
+                {
+                    simple = simple && !path.Test( z / 2 );
+                    path.Set( z / 2 );
+                    cellsUp[n++] = z / 2;
+                    if ( static_cast<size_t>( parent[z] ) == z )
+                    {
+                        break;
+                    }
+                }
+                if ( !simple || n < 4 || n > Chains::MAX_NODES )
+                {
+                    continue;
+                }
+                Chain c;
+                c.kind = Chains::X_CHAIN;
+                c.digit = digit;
+                c.length = 0;
+                for ( size_t k = n; k-- > 0; )
+                {
+                    AddNode( c, cellsUp[k], digit );
+                }
+                Add( c, Units::PEER_BOARDS[s] & Units::PEER_BOARDS[j] &
+                     cells & ~path, taken, found );
+            }
+        }
+    }
+}
+
+/**
+ * Bivalue pivot xy with bivalue peers xz and yz
+ */
+void FindXYWings( const LinkGraph &g, Bitboard taken[Units::UNIT_SIZE],
+                  Chains::ChainContainer &found )
+{
+    const Bitboard &bivalue = g.GetBivalue();
+    for ( Bitboard pivots = bivalue; pivots.Any(); )
+    {
+        size_t p = pivots.PopFirst();
+        unsigned short cp = g.GetCandidates( p );
+        Bitboard wings = Units::PEER_BOARDS[p] & bivalue;
+        for ( Bitboard first = wings; first.Any(); )
+        {
+            size_t a = first.PopFirst();
+            unsigned short ca = g.GetCandidates( a );
+            unsigned short shared = ca & cp;
+            if ( __builtin_popcount( shared ) != 1 )
+            {
+                continue;
+            }
+            unsigned short z = ca & ~cp;
+            unsigned short other = cp & ~shared;
+            for ( Bitboard second = wings; second.Any(); )
+            {
+                size_t b = second.PopFirst();
+                if ( g.GetCandidates( b ) != ( other | z ) )
+                {
+                    continue;
+                }
+                Chain c;
+                c.kind = Chains::XY_WING;
+                c.digit = Digit( z );
+                c.length = 0;
+                AddNode( c, a, Digit( z ) );
+                AddNode( c, a, Digit( shared ) );
+                AddNode( c, p, Digit( shared ) );
+                AddNode( c, p, Digit( other ) );
+                AddNode( c, b, Digit( other ) );
+                AddNode( c, b, Digit( z ) );
+                Bitboard chain = Bitboard::Single( a ) |
+                    Bitboard::Single( b ) | Bitboard::Single( p );
+                Add( c, Units::PEER_BOARDS[a] & Units::PEER_BOARDS[b] &
+                     g.GetCells( c.digit ) & ~chain, taken, found );
+            }
+        }
+    }
+}
+
+/**
+ * Pivot xyz with bivalue peers xz and yz
+ */
+void FindXYZWings( const LinkGraph &g, Bitboard taken[Units::UNIT_SIZE],
+                   Chains::ChainContainer &found )
+{
+    const Bitboard &bivalue = g.GetBivalue();
+    for ( size_t p = 0; p < Units::CELL_COUNT; p++ )
+    {
+        unsigned short cp = g.GetCandidates( p );
+        if ( __builtin_popcount( cp ) != 3 )
+        {
+            continue;
+        }
+        Bitboard wings = Units::PEER_BOARDS[p] & bivalue;
+        for ( Bitboard first = wings; first.Any(); )
+        {
+            size_t a = first.PopFirst();
+            unsigned short ca = g.GetCandidates( a );
+            if ( ca & ~cp )
+            {
+                continue;
+            }
+            for ( Bitboard second = first; second.Any(); )
+            {
+                size_t b = second.PopFirst();
+                unsigned short cb = g.GetCandidates( b );
+                if ( ( cb & ~cp ) || cb == ca )
+                {
+                    continue;
+                }
+                Chain c;
+                c.kind = Chains::XYZ_WING;
+                c.digit = Digit( ca & cb );
+                c.length = 0;
+                AddNode( c, p, c.digit );
+                AddNode( c, a, c.digit );
+                AddNode( c, b, c.digit );
+                Add( c, Units::PEER_BOARDS[p] & Units::PEER_BOARDS[a] &
+                     Units::PEER_BOARDS[b] & g.GetCells( c.digit ),
+                     taken, found );
+            }
+        }
+    }
+}
+
+/**
+ * Bivalue Cells with the same pair joined as peers, an odd number of links
+ * apart (at least 3)
+ */
+void FindRemotePairs( const LinkGraph &g, Bitboard taken[Units::UNIT_SIZE],
+                      Chains::ChainContainer &found )
+{
+    const Bitboard &bivalue = g.GetBivalue();
+    short parent[Units::CELL_COUNT];
+    unsigned char depth[Units::CELL_COUNT];
+    unsigned char queue[Units::CELL_COUNT];
+    for ( Bitboard starts = bivalue; starts.Any(); )
+    {
+        size_t s = starts.PopFirst();
+        unsigned short pair = g.GetCandidates( s );
+        Bitboard same = Bitboard::None();
+        for ( Bitboard b = bivalue; b.Any(); )
+        {
+            size_t i = b.PopFirst();
+            if ( g.GetCandidates( i ) == pair )
+            {
+                same.Set( i );
+            }
+        }
+        Bitboard reached = Bitboard::Single( s );
+        parent[s] = s;
+        depth[s] = 0;
+        size_t head = 0;
+        size_t tail = 0;
+        queue[tail++] = s;
+        while ( head < tail )
+        {
+            size_t c = queue[head++];
+            Bitboard next = Units::PEER_BOARDS[c] & same & ~reached;
+            while ( next.Any() )
+            {
+                size_t e = next.PopFirst();
+                parent[e] = c;
+                depth[e] = depth[c] + 1;
+                reached.Set( e );
+                queue[tail++] = e;
+                if ( depth[e] < 3 || depth[e] % 2 == 0 || e <= s )
+                {
+                    continue;
+                }
+                unsigned char up[Units::CELL_COUNT];
+                size_t n = PathToRoot( parent, e, up,
+                                       Chains::MAX_NODES / 2 );
+                if ( n == 0 )
+                {
+                    continue;
+                }
+                Bitboard path = Bitboard::None();
+                for ( size_t k = 0; k < n; k++ )
+                {
+                    path.Set( up[k] );
+                }
+                // once for each digit of the pair
+                for ( unsigned short d = pair; d; d &= d - 1 )
+                {
+                    int a = Digit( d );
+                    int b = Digit( pair & ~( 1 << ( a - 1 ) ) );
+                    Chain c;
+                    c.kind = Chains::REMOTE_PAIR;
+                    c.digit = a;
+                    c.length = 0;
+                    for ( size_t k = n; k-- > 0; )
+                    {
+                        bool even = ( n - 1 - k ) % 2 == 0;
+                        AddNode( c, up[k], even ? a : b );
+                        AddNode( c, up[k], even ? b : a );
+                    }
+                    Add( c, Units::PEER_BOARDS[s] & Units::PEER_BOARDS[e] &
+                         g.GetCells( a ) & ~path, taken, found );
+                }
+            }
+        }
+    }
+}
+
+}
+
+const size_t Chains::MAX_NODES;
+
+size_t Chains::Find( const LinkGraph &g, Kind kind, unsigned short digits,
+                     ChainContainer &found )
+{
+    size_t before = found.size();
+    Bitboard taken[Units::UNIT_SIZE];
+    for ( size_t d = 0; d < Units::UNIT_SIZE; d++ )
+    {
+        taken[d] = Bitboard::None();
+    }
+    digits &= 0x1FF;
+    for ( unsigned short left = digits; left; left &= left - 1 )
+    {
+        int digit = Digit( left );
+        if ( kind == SIMPLE_COLORING )
+        {
+            FindColoring( g, digit, taken, found );
+        }
+        else if ( kind == X_CHAIN )
+        {
+            FindXChains( g, digit, taken, found );
+        }
+    }
+    if ( digits )
+    {
+        switch ( kind )
+        {
+        case XY_WING: FindXYWings( g, taken, found ); break;
+        case XYZ_WING: FindXYZWings( g, taken, found ); break;
+        case REMOTE_PAIR: FindRemotePairs( g, taken, found ); break;
+        default: break;
+        }
+    }
+    return found.size() - before;
+}
+
+}
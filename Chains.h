@@ -0,0 +1,95 @@
+#ifndef SUDOKU_CHAINS_H
+#define SUDOKU_CHAINS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Bitboard.h"
+#include "Units.h"
+
+namespace Sudoku
+{
+
+class LinkGraph;
+
+/**
+ * Finds chains of links between candidates which remove a candidate
+ * Every kind but the XYZ-Wing is an alternating inference chain: the links
+ * between nodes 0-1, 2-3, ... are strong, those between 1-2, 3-4, ... weak,
+ * so one of the two end nodes is true and a Cell seeing both of them cannot
+ * have their digit.
+ *
+ * Chains are found by breadth first search over the LinkGraph, each node
+ * being reached at most once per start (as the end of a strong link, and
+ * as the end of a weak one), so a search is linear in the links instead of
+ * trying every path.  The chain found is the shortest from its start.
+ */
+class Chains
+{
+public:
+    /// Longest chain kept
+    static const size_t MAX_NODES = 20;
+
+    /// Kinds of chains, easiest first
+    enum Kind
+    {
+        /// One digit, conjugate pairs only, ends of opposite colors
+        SIMPLE_COLORING,
+        /// One digit, conjugate pairs joined by any peers
+        X_CHAIN,
+        /// A bivalue Cell xy with bivalue peers xz and yz, removes z
+        XY_WING,
+        /// A Cell xyz with bivalue peers xz and yz, removes z from Cells
+        /// seeing all three
+        XYZ_WING,
+        /// Bivalue Cells with the same pair, an odd number of links apart
+        REMOTE_PAIR,
+        KIND_COUNT
+    };
+
+    /// A candidate
+    struct Node
+    {
+        unsigned char cell;
+        unsigned char digit;
+    };
+
+    /**
+     * A chain which removes a digit
+     * For an XYZ_WING the nodes are the pivot and the two pincers, all with
+     * the digit removed.
+     */
+    struct Chain
+    {
+        Kind kind;
+        /// Digit removed, in range [1,9]
+        int digit;
+        size_t length;
+        Node nodes[MAX_NODES];
+        /// Cells the digit is removed from
+        Bitboard targets;
+    };
+
+    typedef std::vector<Chain> ChainContainer;
+
+    /**
+     * Find the chains of a kind which remove a candidate
+     * A candidate is only removed by the first chain found for it.
+     * @param g Links of the board
+     * @param kind Kind of chain to look for
+     * @param digits Digits whose links changed (bit value - 1).  One digit
+     *        kinds only look at these, the bivalue ones look at every digit
+     *        if any changed, since a Cell can become bivalue from any digit
+     * @param found Chains are appended
+     * @return Number of chains appended
+     */
+    static size_t Find( const LinkGraph &g, Kind kind, unsigned short digits,
+                        ChainContainer &found );
+
+private:
+    Chains();
+};
+
+}
+
+#endif
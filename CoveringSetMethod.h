@@ -3,7 +3,9 @@
 
 #include <memory>
 #include "SolutionMethod.h"
+#include "CellArray.h"
 #include "Puzzle.h"
+#include "Units.h"
 
 namespace Sudoku
 {
@@ -16,7 +18,8 @@ public:
     /**
      * Create the method for a specific subset of a sector
      */
-    CoveringSetMethod( Puzzle::Container sector, Puzzle::Container subset );
+    CoveringSetMethod( const Puzzle::Container &sector,
+                       const Puzzle::Container &subset );
 
     /**
      * This will remove the marks contained in subset from sector\subset
@@ -59,10 +62,10 @@ private:
     CoveringSetMethod( const CoveringSetMethod & );
     CoveringSetMethod & operator=( const CoveringSetMethod & );
 
-    Puzzle::Container _sector;
-    Puzzle::Container _subset;
-    Puzzle::Container _diff;
-    Cell::MarkedValues _subMarks;
+    CellArray<Units::UNIT_SIZE> _sector;
+    CellArray<Units::UNIT_SIZE> _subset;
+    CellArray<Units::UNIT_SIZE> _diff;
+    Cell::MarkContainer _subMarks;
 };
 
 }
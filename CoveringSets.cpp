@@ -0,0 +1,212 @@
+#include "CoveringSets.h"
+
+#include <stdexcept>
+
+namespace Sudoku
+{
+
+namespace
+{
+
+/**
+ * Cells of some lines of one kind
+ * @param first Unit number of the first line (Units::FIRST_ROW or FIRST_COL)
+ * @param lines Bit k for the line first + k
+ */
+Bitboard Lines( size_t first, unsigned short lines )
+{
+    Bitboard b = Bitboard::None();
+    for ( ; lines; lines &= lines - 1 )
+    {
+        b |= Units::UNIT_BOARDS[first + __builtin_ctz( lines )];
+    }
+    return b;
+}
+
+}
+
+const size_t CoveringSets::MIN_SIZE;
+const size_t CoveringSets::MAX_SIZE;
+
+// these tables were generated once and are checked by CoveringSetsTest
+
+const unsigned short CoveringSets::PAIRS[36] =
+{
+    0x003, 0x005, 0x006, 0x009, 0x00A, 0x00C, 0x011, 0x012,
+    0x014, 0x018, 0x021, 0x022, 0x024, 0x028, 0x030, 0x041,
+    0x042, 0x044, 0x048, 0x050, 0x060, 0x081, 0x082, 0x084,
+    0x088, 0x090, 0x0A0, 0x0C0, 0x101, 0x102, 0x104, 0x108,
+    0x110, 0x120, 0x140, 0x180
+};
+
+const unsigned short CoveringSets::TRIPLES[84] =
+{
+    0x007, 0x00B, 0x00D, 0x00E, 0x013, 0x015, 0x016, 0x019,
+    0x01A, 0x01C, 0x023, 0x025, 0x026, 0x029, 0x02A, 0x02C,
+    0x031, 0x032, 0x034, 0x038, 0x043, 0x045, 0x046, 0x049,
+    0x04A, 0x04C, 0x051, 0x052, 0x054, 0x058, 0x061, 0x062,
+    0x064, 0x068, 0x070, 0x083, 0x085, 0x086, 0x089, 0x08A,
+    0x08C, 0x091, 0x092, 0x094, 0x098, 0x0A1, 0x0A2, 0x0A4,
+    0x0A8, 0x0B0, 0x0C1, 0x0C2, 0x0C4, 0x0C8, 0x0D0, 0x0E0,
+    0x103, 0x105, 0x106, 0x109, 0x10A, 0x10C, 0x111, 0x112,
+    0x114, 0x118, 0x121, 0x122, 0x124, 0x128, 0x130, 0x141,
+    0x142, 0x144, 0x148, 0x150, 0x160, 0x181, 0x182, 0x184,
+    0x188, 0x190, 0x1A0, 0x1C0
+};
+
+const unsigned short CoveringSets::QUADS[126] =
+{
+    0x00F, 0x017, 0x01B, 0x01D, 0x01E, 0x027, 0x02B, 0x02D,
+    0x02E, 0x033, 0x035, 0x036, 0x039, 0x03A, 0x03C, 0x047,
+    0x04B, 0x04D, 0x04E, 0x053, 0x055, 0x056, 0x059, 0x05A,
+    0x05C, 0x063, 0x065, 0x066, 0x069, 0x06A, 0x06C, 0x071,
+    0x072, 0x074, 0x078, 0x087, 0x08B, 0x08D, 0x08E, 0x093,
+    0x095, 0x096, 0x099, 0x09A, 0x09C, 0x0A3, 0x0A5, 0x0A6,
+    0x0A9, 0x0AA, 0x0AC, 0x0B1, 0x0B2, 0x0B4, 0x0B8, 0x0C3,
+    0x0C5, 0x0C6, 0x0C9, 0x0CA, 0x0CC, 0x0D1, 0x0D2, 0x0D4,
+    0x0D8, 0x0E1, 0x0E2, 0x0E4, 0x0E8, 0x0F0, 0x107, 0x10B,
+    0x10D, 0x10E, 0x113, 0x115, 0x116, 0x119, 0x11A, 0x11C,
+    0x123, 0x125, 0x126, 0x129, 0x12A, 0x12C, 0x131, 0x132,
+    0x134, 0x138, 0x143, 0x145, 0x146, 0x149, 0x14A, 0x14C,
+    0x151, 0x152, 0x154, 0x158, 0x161, 0x162, 0x164, 0x168,
+    0x170, 0x183, 0x185, 0x186, 0x189, 0x18A, 0x18C, 0x191,
+    0x192, 0x194, 0x198, 0x1A1, 0x1A2, 0x1A4, 0x1A8, 0x1B0,
+    0x1C1, 0x1C2, 0x1C4, 0x1C8, 0x1D0, 0x1E0
+};
+
+const unsigned short
+CoveringSets::CHOOSE[Units::UNIT_SIZE + 1][MAX_SIZE + 1] =
+{
+    { 1, 0,  0,   0,   0 },
+    { 1, 1,  0,   0,   0 },
+    { 1, 2,  1,   0,   0 },
+    { 1, 3,  3,   1,   0 },
+    { 1, 4,  6,   4,   1 },
+    { 1, 5, 10,  10,   5 },
+    { 1, 6, 15,  20,  15 },
+    { 1, 7, 21,  35,  35 },
+    { 1, 8, 28,  56,  70 },
+    { 1, 9, 36,  84, 126 }
+};
+
+const unsigned short * CoveringSets::Combinations( size_t size )
+{
+    switch ( size )
+    {
+    case 2: return PAIRS;
+    case 3: return TRIPLES;
+    case 4: return QUADS;
+    default:
+        throw std::invalid_argument( "Covering sets are 2 to 4 Cells." );
+    }
+}
+
+size_t CoveringSets::Find( const unsigned short candidates[Units::UNIT_SIZE],
+                           size_t size,
+                           SetContainer &found )
+{
+    const unsigned short *combinations = Combinations( size );
+
+    // pack the open positions, and transpose to the positions of each value
+    unsigned char cellAt[Units::UNIT_SIZE];
+    size_t cellCount = 0;
+    unsigned short places[Units::UNIT_SIZE] = { 0 };
+    for ( size_t k = 0; k < Units::UNIT_SIZE; k++ )
+    {
+        unsigned short c = candidates[k] & 0x1FF;
+        if ( c )
+        {
+            cellAt[cellCount++] = k;
+            for ( ; c; c &= c - 1 )
+            {
+                places[__builtin_ctz( c )] |= 1 << k;
+            }
+        }
+    }
+    unsigned char valueAt[Units::UNIT_SIZE];
+    size_t valueCount = 0;
+    for ( size_t v = 0; v < Units::UNIT_SIZE; v++ )
+    {
+        if ( places[v] )
+        {
+            valueAt[valueCount++] = v;
+        }
+    }
+
+    size_t before = found.size();
+    const unsigned short openCells = ( 1 << cellCount ) - 1;
+    for ( size_t n = 0; n < CHOOSE[cellCount][size]; n++ )
+    {
+        unsigned short cells = 0;
+        unsigned short values = 0;
+        for ( unsigned short b = combinations[n]; b; b &= b - 1 )
+        {
+            size_t k = cellAt[__builtin_ctz( b )];
+            cells |= 1 << k;
+            values |= candidates[k];
+        }
+        values &= 0x1FF;
+        if ( static_cast<size_t>( __builtin_popcount( values ) ) != size )
+        {
+            continue;
+        }
+        unsigned short rest = 0;
+        for ( unsigned short b = openCells & ~combinations[n]; b; b &= b - 1 )
+        {
+            rest |= candidates[cellAt[__builtin_ctz( b )]];
+        }
+        if ( rest & values )
+        {
+            Set s = { cells, values, false };
+            found.push_back( s );
+        }
+    }
+
+    for ( size_t n = 0; n < CHOOSE[valueCount][size]; n++ )
+    {
+        unsigned short cells = 0;
+        unsigned short values = 0;
+        for ( unsigned short b = combinations[n]; b; b &= b - 1 )
+        {
+            size_t v = valueAt[__builtin_ctz( b )];
+            values |= 1 << v;
+            cells |= places[v];
+        }
+        if ( static_cast<size_t>( __builtin_popcount( cells ) ) != size )
+        {
+            continue;
+        }
+        unsigned short others = 0;
+        for ( unsigned short b = cells; b; b &= b - 1 )
+        {
+            others |= candidates[__builtin_ctz( b )];
+        }
+        if ( others & ~values & 0x1FF )
+        {
+            Set s = { cells, values, true };
+            found.push_back( s );
+        }
+    }
+    return found.size() - before;
+}
+
+size_t CoveringSets::FindFish( const unsigned short rows[Units::UNIT_SIZE],
+                               size_t size,
+                               FishContainer &found )
+{
+    SetContainer sets;
+    Find( rows, size, sets );
+    for ( SetContainer::const_iterator it = sets.begin();
+          it != sets.end();
+          ++it )
+    {
+        Bitboard rowCells = Lines( Units::FIRST_ROW, it->cells );
+        Bitboard colCells = Lines( Units::FIRST_COL, it->values );
+        Fish f = { it->hidden ? colCells : rowCells,
+                   it->hidden ? rowCells : colCells };
+        found.push_back( f );
+    }
+    return sets.size();
+}
+
+}
@@ -0,0 +1,116 @@
+#ifndef SUDOKU_COVERING_SETS_H
+#define SUDOKU_COVERING_SETS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Bitboard.h"
+#include "Units.h"
+
+namespace Sudoku
+{
+
+/**
+ * Finds covering sets in one unit with 9-bit masks
+ * A naked set is n Cells with only n candidates between them, which can be
+ * removed from the rest of the unit.  A hidden set is n candidates found in
+ * only n Cells, which can have every other candidate removed.
+ *
+ * Both work on one mask per position of the unit (bit value - 1, like
+ * CandidateGrid) and on its transpose, the positions of each value.  Open
+ * positions (or values) are packed to the low bits first, so the subsets
+ * to try are exactly the first CHOOSE[n][k] masks of the constant
+ * combination tables and each one costs a few bit operations.
+ *
+ * A fish (X-Wing, Swordfish, Jellyfish for 2, 3, 4 lines) is the same
+ * search on one digit: the rows play the positions and the columns the
+ * values.  n rows with the digit in only n columns are a naked set, n
+ * columns with the digit in only n rows a hidden one.
+ */
+class CoveringSets
+{
+public:
+    /// Smallest and largest sets looked for
+    static const size_t MIN_SIZE = 2;
+    static const size_t MAX_SIZE = 4;
+
+    /// Masks of 9 bits with 2, 3 and 4 bits set, in increasing order
+    static const unsigned short PAIRS[36];
+    static const unsigned short TRIPLES[84];
+    static const unsigned short QUADS[126];
+
+    /// Ways to choose k of n, for n up to the unit size and k up to MAX_SIZE
+    static const unsigned short CHOOSE[Units::UNIT_SIZE + 1][MAX_SIZE + 1];
+
+    /**
+     * A covering set found in a unit
+     * cells are positions in the unit (bit k for the k-th Cell), values use
+     * bit value - 1.  A naked set removes values from the open Cells outside
+     * cells, a hidden set removes everything but values from cells.
+     */
+    struct Set
+    {
+        unsigned short cells;
+        unsigned short values;
+        bool hidden;
+    };
+
+    typedef std::vector<Set> SetContainer;
+
+    /**
+     * A fish on one digit
+     * Every candidate for the digit in the base lines is in the cover lines,
+     * so the digit can be removed from the rest of the cover lines.
+     */
+    struct Fish
+    {
+        /// Cells of the base lines (rows or columns)
+        Bitboard base;
+        /// Cells of the cover lines, the other kind
+        Bitboard cover;
+    };
+
+    typedef std::vector<Fish> FishContainer;
+
+    /**
+     * Combination table for a size
+     * @param size In range [MIN_SIZE, MAX_SIZE]
+     * @return CHOOSE[9][size] masks in increasing order
+     * @throw std::invalid_argument if size is out of range
+     */
+    static const unsigned short * Combinations( size_t size );
+
+    /**
+     * Find every naked and hidden set of a size which removes a candidate
+     * @param candidates Candidates of each position of the unit, 0 for
+     *        Cells with a value
+     * @param size Number of Cells (and values) in the set
+     * @param found Sets are appended, naked ones first
+     * @return Number of sets appended
+     * @throw std::invalid_argument if size is out of range
+     */
+    static size_t Find( const unsigned short candidates[Units::UNIT_SIZE],
+                        size_t size,
+                        SetContainer &found );
+
+    /**
+     * Find every fish of a size on a digit which removes a candidate
+     * @param rows Columns where the digit is a candidate in each row (bit
+     *        column - 1), with the rows and columns where it is placed left
+     *        empty
+     * @param size Number of base (and cover) lines
+     * @param found Fish are appended, row based ones first
+     * @return Number of fish appended
+     * @throw std::invalid_argument if size is out of range
+     */
+    static size_t FindFish( const unsigned short rows[Units::UNIT_SIZE],
+                            size_t size,
+                            FishContainer &found );
+
+private:
+    CoveringSets();
+};
+
+}
+
+#endif
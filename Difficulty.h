@@ -0,0 +1,27 @@
+#ifndef SUDOKU_DIFFICULTY_H
+#define SUDOKU_DIFFICULTY_H
+
+namespace Sudoku
+{
+
+/**
+ * How hard a Puzzle is, by the hardest kind of Method needed to solve it
+ * The levels follow the order MethodSolver tries its Methods in, so each
+ * level allows every Method of the levels below it
+ */
+enum Difficulty
+{
+    /// Single candidates, exclusion and hidden singles only
+    DIFFICULTY_EASY,
+    /// Needs block intersections
+    DIFFICULTY_MEDIUM,
+    /// Needs covering sets or fish (X-Wing, Swordfish, Jellyfish)
+    DIFFICULTY_HARD,
+    /// Needs chains (coloring, X-Chains, wings, remote pairs), or the
+    /// Methods get stuck and it needs search
+    DIFFICULTY_EXPERT
+};
+
+}
+
+#endif
@@ -0,0 +1,415 @@
+#include "DifficultyRater.h"
+#include "CandidateGrid.h"
+#include "Chains.h"
+#include "CoveringSets.h"
+#include "Grid.h"
+#include "LinkGraph.h"
+#include "Puzzle.h"
+
+#include <stdexcept>
+
+namespace Sudoku
+{
+
+namespace
+{
+
+/**
+ * Remove a value from every Cell of a set
+ */
+void EliminateAll( CandidateGrid &g, Bitboard cells, int value )
+{
+    while ( cells.Any() )
+    {
+        g.Eliminate( cells.PopFirst(), value );
+    }
+}
+
+/**
+ * Place every naked single
+ * @return number of values placed
+ */
+size_t PlaceSingleCandidates( CandidateGrid &g, size_t &exclusions )
+{
+    size_t placed = 0;
+    Bitboard singles = g.GetNakedSingles();
+    while ( singles.Any() && g.IsConsistent() )
+    {
+        size_t i = singles.PopFirst();
+        unsigned short candidates = g.GetCandidates( i );
+        if ( candidates == 0 )
+        {
+            // taken by a single placed before it, IsConsistent is now false
+            continue;
+        }
+        int value = __builtin_ctz( candidates ) + 1;
+        if ( ( Units::PEER_BOARDS[i] & g.GetValueCells( value ) ).Any() )
+        {
+            ++exclusions;
+        }
+        g.Place( i, value );
+        ++placed;
+    }
+    return placed;
+}
+
+/**
+ * Place every hidden single found in one scan
+ * A single can be taken by one placed before it, those are skipped.
+ * @return number of values placed
+ */
+size_t PlaceHiddenSingles( CandidateGrid &g, size_t &exclusions )
+{
+    size_t placed = 0;
+    unsigned char values[Units::CELL_COUNT];
+    Bitboard singles = g.GetHiddenSingles( values );
+    while ( singles.Any() && g.IsConsistent() )
+    {
+        size_t i = singles.PopFirst();
+        int value = values[i];
+        if ( !( g.GetCandidates( i ) & ( 1 << ( value - 1 ) ) ) )
+        {
+            continue;
+        }
+        if ( ( Units::PEER_BOARDS[i] & g.GetValueCells( value ) ).Any() )
+        {
+            ++exclusions;
+        }
+        g.Place( i, value );
+        ++placed;
+    }
+    return placed;
+}
+
+/**
+ * Find one block intersection which removes a mark and do it
+ * A value confined to one line inside a block is removed from the rest of
+ * the line, and a value confined to one block inside a line from the rest
+ * of the block.
+ * @return true if a mark was removed
+ */
+bool ExecuteBlockIntersection( CandidateGrid &g )
+{
+    for ( int value = 1; value <= 9; value++ )
+    {
+        const Bitboard &cells = g.GetValueCells( value );
+        for ( size_t line = Units::FIRST_ROW; line < Units::FIRST_BLOCK;
+              line++ )
+        {
+            const Bitboard &lineBoard = Units::UNIT_BOARDS[line];
+            Bitboard inLine = cells & lineBoard;
+            if ( inLine.Empty() )
+            {
+                continue;
+            }
+            // a line crosses three blocks, at its Cells 0, 3 and 6
+            for ( size_t k = 0; k < Units::UNIT_SIZE; k += 3 )
+            {
+                size_t block =
+                    Units::CELL_UNITS[Units::UNIT_CELLS[line][k]][2];
+                const Bitboard &blockBoard = Units::UNIT_BOARDS[block];
+                Bitboard inBlock = cells & blockBoard;
+                if ( inBlock.Empty() )
+                {
+                    continue;
+                }
+                Bitboard remove = Bitboard::None();
+                if ( ( inBlock & ~lineBoard ).Empty() )
+                {
+                    remove = inLine & ~blockBoard;
+                }
+                else if ( ( inLine & ~blockBoard ).Empty() )
+                {
+                    remove = inBlock & ~lineBoard;
+                }
+                if ( remove.Any() )
+                {
+                    EliminateAll( g, remove, value );
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Find one covering set of a size which removes a mark and do it
+ * A covering set is that many blank Cells of a unit with only that many
+ * candidates between them, which can be removed from the rest of the unit,
+ * or that many candidates found in only that many Cells of a unit, which
+ * can have every other candidate removed.
+ * @return true if a mark was removed
+ */
+bool ExecuteCoveringSet( CandidateGrid &g, size_t size )
+{
+    CoveringSets::SetContainer found;
+    for ( size_t u = 0; u < Units::UNIT_COUNT; u++ )
+    {
+        const unsigned char *cells = Units::UNIT_CELLS[u];
+        unsigned short candidates[Units::UNIT_SIZE];
+        for ( size_t k = 0; k < Units::UNIT_SIZE; k++ )
+        {
+            candidates[k] = g.GetValue( cells[k] ) == 0 ?
+                g.GetCandidates( cells[k] ) : 0;
+        }
+        if ( CoveringSets::Find( candidates, size, found ) == 0 )
+        {
+            continue;
+        }
+        const CoveringSets::Set &s = found.front();
+        for ( size_t k = 0; k < Units::UNIT_SIZE; k++ )
+        {
+            // naked sets remove their values outside, hidden ones the
+            // other values inside
+            bool inside = ( s.cells >> k ) & 1;
+            if ( !candidates[k] || inside != s.hidden )
+            {
+                continue;
+            }
+            unsigned short remove = candidates[k] &
+                ( s.hidden ? ~s.values : s.values );
+            for ( ; remove; remove &= remove - 1 )
+            {
+                g.Eliminate( cells[k], __builtin_ctz( remove ) + 1 );
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Find one fish of a size which removes a mark and do it
+ * A fish is that many rows with a value only in that many columns, which
+ * can have it removed from their other rows, or the same with rows and
+ * columns swapped.
+ * @return true if a mark was removed
+ */
+bool ExecuteFish( CandidateGrid &g, size_t size )
+{
+    CoveringSets::FishContainer found;
+    for ( int value = 1; value <= 9; value++ )
+    {
+        // placing a value removes it from its row and column
+        unsigned short rows[Units::UNIT_SIZE];
+        for ( size_t r = 0; r < Units::UNIT_SIZE; r++ )
+        {
+            rows[r] = g.GetUnitPositions( Units::Row( r + 1 ), value );
+        }
+        if ( CoveringSets::FindFish( rows, size, found ) == 0 )
+        {
+            continue;
+        }
+        const CoveringSets::Fish &f = found.front();
+        EliminateAll( g, f.cover & ~f.base & g.GetValueCells( value ),
+                      value );
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Find the easiest chain which removes a mark and do it
+ * @param graph Links of the last call, brought up to date with g first
+ * @return Kind of the chain, Chains::KIND_COUNT if there is none
+ */
+Chains::Kind ExecuteChain( CandidateGrid &g, LinkGraph &graph )
+{
+    unsigned short candidates[Units::CELL_COUNT];
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        candidates[i] = g.GetValue( i ) == 0 ? g.GetCandidates( i ) : 0;
+    }
+    graph.Update( candidates );
+    Chains::ChainContainer found;
+    for ( size_t k = 0; k < Chains::KIND_COUNT; k++ )
+    {
+        Chains::Kind kind = static_cast<Chains::Kind>( k );
+        if ( Chains::Find( graph, kind, 0x1FF, found ) > 0 )
+        {
+            EliminateAll( g, found.front().targets, found.front().digit );
+            return kind;
+        }
+    }
+    return Chains::KIND_COUNT;
+}
+
+}
+
+const size_t DifficultyRater::MAX_COVERING_SET;
+const size_t DifficultyRater::MAX_FISH;
+const unsigned DifficultyRater::SINGLE_CANDIDATE_SCORE;
+const unsigned DifficultyRater::HIDDEN_SINGLE_SCORE;
+const unsigned DifficultyRater::BLOCK_INTERSECTION_SCORE;
+const unsigned DifficultyRater::COVERING_SET_SCORE;
+const unsigned DifficultyRater::FISH_SCORE;
+const unsigned DifficultyRater::CHAIN_SCORE;
+const unsigned DifficultyRater::STUCK_SCORE;
+const unsigned DifficultyRater::STUCK_CELL_SCORE;
+
+DifficultyRater::Rating::Rating()
+    : singleCandidates( 0 ), hiddenSingles( 0 ), exclusions( 0 ),
+      blockIntersections( 0 ), largestCoveringSet( 0 ), largestFish( 0 ),
+      unsolved( 0 ), solved( false ), score( 0 ), tier( DIFFICULTY_EASY )
+{
+    for ( size_t k = 0; k <= MAX_COVERING_SET; k++ )
+    {
+        coveringSets[k] = 0;
+    }
+    for ( size_t k = 0; k <= MAX_FISH; k++ )
+    {
+        fish[k] = 0;
+    }
+    for ( size_t k = 0; k < Chains::KIND_COUNT; k++ )
+    {
+        chains[k] = 0;
+    }
+}
+
+DifficultyRater::Rating DifficultyRater::Rate( const Grid &g ) const
+{
+    CandidateGrid c;
+    for ( size_t i = 0; i < Grid::ARRAY_SIZE && c.IsConsistent(); i++ )
+    {
+        if ( g[i].given && g[i].value != 0 )
+        {
+            c.Place( i, g[i].value );
+        }
+    }
+    return Rate( c );
+}
+
+DifficultyRater::Rating DifficultyRater::Rate(
+    std::shared_ptr<const Puzzle> p ) const
+{
+    if ( !p )
+    {
+        throw std::runtime_error( "Cannot rate NULL Puzzle." );
+    }
+    CandidateGrid c;
+    Puzzle::ConstView all = p->GetAllView();
+    size_t i = 0;
+    for ( Puzzle::ConstView::iterator it = all.begin();
+          it != all.end() && c.IsConsistent();
+          ++it, ++i )
+    {
+        if ( !(*it)->CanGuess() && (*it)->DisplayedValue() != 0 )
+        {
+            c.Place( i, (*it)->DisplayedValue() );
+        }
+    }
+    return Rate( c );
+}
+
+DifficultyRater::Rating DifficultyRater::Rate( CandidateGrid &g ) const
+{
+    Rating r;
+    LinkGraph graph;
+    // same order as the MethodSolver, but any progress starts over with the
+    // easiest Method so only the steps which are really needed are counted
+    while ( g.IsConsistent() && !g.IsSolved() )
+    {
+        size_t placed = PlaceSingleCandidates( g, r.exclusions );
+        if ( placed > 0 )
+        {
+            r.singleCandidates += placed;
+            continue;
+        }
+        placed = PlaceHiddenSingles( g, r.exclusions );
+        if ( placed > 0 )
+        {
+            r.hiddenSingles += placed;
+            continue;
+        }
+        if ( ExecuteBlockIntersection( g ) )
+        {
+            ++r.blockIntersections;
+            continue;
+        }
+        size_t size = 2;
+        while ( size <= MAX_COVERING_SET && !ExecuteCoveringSet( g, size ) )
+        {
+            ++size;
+        }
+        if ( size <= MAX_COVERING_SET )
+        {
+            ++r.coveringSets[size];
+            if ( size > r.largestCoveringSet )
+            {
+                r.largestCoveringSet = size;
+            }
+            continue;
+        }
+        size = 2;
+        while ( size <= MAX_FISH && !ExecuteFish( g, size ) )
+        {
+            ++size;
+        }
+        if ( size <= MAX_FISH )
+        {
+            ++r.fish[size];
+            if ( size > r.largestFish )
+            {
+                r.largestFish = size;
+            }
+            continue;
+        }
+        Chains::Kind kind = ExecuteChain( g, graph );
+        if ( kind == Chains::KIND_COUNT )
+        {
+            // stuck
+            break;
+        }
+        ++r.chains[kind];
+    }
+
+    r.solved = g.IsConsistent() && g.IsSolved();
+    r.unsolved = g.GetUnsolved().Count();
+    Score( r );
+    return r;
+}
+
+void DifficultyRater::Score( Rating &r )
+{
+    r.score = r.singleCandidates * SINGLE_CANDIDATE_SCORE +
+        r.hiddenSingles * HIDDEN_SINGLE_SCORE +
+        r.blockIntersections * BLOCK_INTERSECTION_SCORE;
+    for ( size_t k = 2; k <= MAX_COVERING_SET; k++ )
+    {
+        r.score += r.coveringSets[k] * k * COVERING_SET_SCORE;
+    }
+    for ( size_t k = 2; k <= MAX_FISH; k++ )
+    {
+        r.score += r.fish[k] * k * FISH_SCORE;
+    }
+    size_t chains = 0;
+    for ( size_t k = 0; k < Chains::KIND_COUNT; k++ )
+    {
+        chains += r.chains[k];
+    }
+    r.score += chains * CHAIN_SCORE;
+    if ( !r.solved )
+    {
+        r.score += STUCK_SCORE + r.unsolved * STUCK_CELL_SCORE;
+        r.tier = DIFFICULTY_EXPERT;
+    }
+    else if ( chains > 0 )
+    {
+        r.tier = DIFFICULTY_EXPERT;
+    }
+    else if ( r.largestCoveringSet > 0 || r.largestFish > 0 )
+    {
+        r.tier = DIFFICULTY_HARD;
+    }
+    else if ( r.blockIntersections > 0 )
+    {
+        r.tier = DIFFICULTY_MEDIUM;
+    }
+    else
+    {
+        r.tier = DIFFICULTY_EASY;
+    }
+}
+
+}
@@ -0,0 +1,128 @@
+#ifndef SUDOKU_DIFFICULTY_RATER_H
+#define SUDOKU_DIFFICULTY_RATER_H
+
+#include <cstddef>
+#include <memory>
+
+#include "Chains.h"
+#include "Difficulty.h"
+
+namespace Sudoku
+{
+
+class CandidateGrid;
+class Grid;
+class Puzzle;
+
+/**
+ * Rates how hard a Puzzle is by how it gets solved
+ * This follows the MethodSolver: single candidates (with exclusion of the
+ * placed value from the peers), hidden singles, block intersections,
+ * covering sets of 2 to 4 Cells, fish of 2 to 4 lines and chains, always
+ * going back to the easiest Method after any progress.  A Puzzle which
+ * needs chains is solved at DIFFICULTY_EXPERT, one where they get stuck as
+ * well is not solved.
+ * Every step is recorded in a Rating, which is then mapped to a score and a
+ * Difficulty tier.
+ *
+ * The Methods are run straight on a CandidateGrid instead of a Puzzle, so
+ * no Cells are changed, no observers are notified and nothing is logged.
+ * That makes it cheap enough to rate every Puzzle of an import (thousands
+ * per second), while the tier still matches the MethodSolver: a Puzzle rated
+ * at some Difficulty is solved by a MethodSolver limited to it.
+ */
+class DifficultyRater
+{
+public:
+    /// Largest covering set the Methods look for
+    static const size_t MAX_COVERING_SET = 4;
+    /// Most lines of a fish the Methods look for
+    static const size_t MAX_FISH = 4;
+
+    /// Score of each step, covering sets count this per Cell of the set
+    static const unsigned SINGLE_CANDIDATE_SCORE = 1;
+    static const unsigned HIDDEN_SINGLE_SCORE = 2;
+    static const unsigned BLOCK_INTERSECTION_SCORE = 5;
+    static const unsigned COVERING_SET_SCORE = 10;
+    /// Score of a fish, per line
+    static const unsigned FISH_SCORE = 15;
+    /// Score of a chain of any kind
+    static const unsigned CHAIN_SCORE = 25;
+    /// Score for getting stuck, plus STUCK_CELL_SCORE per unsolved Cell
+    static const unsigned STUCK_SCORE = 100;
+    static const unsigned STUCK_CELL_SCORE = 5;
+
+    /**
+     * Trace of the Methods used on a Puzzle and what it adds up to
+     */
+    struct Rating
+    {
+        Rating();
+
+        /// Cells solved by having a single candidate left
+        size_t singleCandidates;
+        /// Cells solved by being the only place left for a value in a unit
+        size_t hiddenSingles;
+        /// Placed values which removed marks from their peers
+        size_t exclusions;
+        /// Block intersections which removed marks
+        size_t blockIntersections;
+        /// Covering sets which removed marks, indexed by size (2 to 4)
+        size_t coveringSets[MAX_COVERING_SET + 1];
+        /// Size of the largest covering set used, 0 for none
+        size_t largestCoveringSet;
+        /// Fish which removed marks, indexed by number of lines (2 to 4)
+        size_t fish[MAX_FISH + 1];
+        /// Lines of the largest fish used, 0 for none
+        size_t largestFish;
+        /// Chains which removed marks, indexed by Chains::Kind
+        size_t chains[Chains::KIND_COUNT];
+        /// Cells left blank when the Methods got stuck
+        size_t unsolved;
+        /// true if the Methods solved the whole Puzzle
+        bool solved;
+        /// Weighted sum of the steps, higher is harder
+        unsigned score;
+        /// Hardest kind of Method needed
+        Difficulty tier;
+    };
+
+    DifficultyRater() {}
+
+    /**
+     * Rate a Grid
+     * @param g Grid to rate, only values marked as given count
+     * @return the trace, with score and tier set (DIFFICULTY_EXPERT if the
+     *         givens conflict or the Methods get stuck)
+     */
+    Rating Rate( const Grid &g ) const;
+
+    /**
+     * Rate a Puzzle
+     * @param p Puzzle to rate, only givens count (Cells displaying their
+     *        correct value), it is only read
+     * @return the trace, with score and tier set
+     * @throw std::runtime_error if p is NULL
+     */
+    Rating Rate( std::shared_ptr<const Puzzle> p ) const;
+
+    /**
+     * Fill in the score and tier of a trace
+     * @param r Rating with the steps counted
+     * @post r.score and r.tier are set from the other fields
+     */
+    static void Score( Rating &r );
+
+private:
+    DifficultyRater( const DifficultyRater & );
+    DifficultyRater & operator=( const DifficultyRater & );
+
+    /**
+     * Run the Methods on a board and score the result
+     */
+    Rating Rate( CandidateGrid &g ) const;
+};
+
+}
+
+#endif
@@ -28,18 +28,17 @@ ExclusionMethod::ExclusionMethod( std::shared_ptr<Puzzle> p,
     : _cell( c ),
       _guessVal( c->DisplayedValue() )
 {
-    Puzzle::Container temp = p->GetNeighbors( c );
-    // remove Cell from neighbors
-    temp.erase( _cell );
+    // peers do not include the Cell itself
+    Puzzle::View peers = p->GetPeerView( c->GetX(), c->GetY() );
     // remove solved and already guessed cells
-    std::remove_copy_if( temp.begin(), temp.end(),
-                         std::inserter( _neighbors, _neighbors.begin() ),
+    std::remove_copy_if( peers.begin(), peers.end(),
+                         std::back_inserter( _neighbors ),
                          std::not1( CanGuessCheck() ) );
 }
 
 void ExclusionMethod::ExecuteForward()
 {
-    for ( Puzzle::Container::iterator it = _neighbors.begin();
+    for ( CellArray<Units::PEER_COUNT>::const_iterator it = _neighbors.begin();
           it != _neighbors.end();
           ++it )
     {
@@ -57,11 +56,11 @@ bool ExclusionMethod::VerifyForwardConditions()
 
 void ExclusionMethod::ExecuteReverse()
 {
-    for ( Puzzle::Container::iterator it = _neighbors.begin();
+    for ( CellArray<Units::PEER_COUNT>::const_iterator it = _neighbors.begin();
           it != _neighbors.end();
           ++it )
     {
-        if ( (*it)->CanGuess() && !(*it)->GetMarkedValues().empty() )
+        if ( (*it)->CanGuess() && (*it)->CountMarks() != 0 )
         {
             (*it)->Mark( _guessVal );
         }
@@ -3,7 +3,9 @@
 
 #include <memory>
 #include "SolutionMethod.h"
+#include "CellArray.h"
 #include "Puzzle.h"
+#include "Units.h"
 
 namespace Sudoku
 {
@@ -55,7 +57,8 @@ private:
     ExclusionMethod( const ExclusionMethod & );
     ExclusionMethod & operator=( const ExclusionMethod & );
 
-    Puzzle::Container _neighbors;
+    /// Peers with no value yet
+    CellArray<Units::PEER_COUNT> _neighbors;
     std::shared_ptr<Cell> _cell;
     int _guessVal;
 };
@@ -0,0 +1,148 @@
+#include "FishMethod.h"
+#include "Cell.h"
+
+namespace Sudoku
+{
+
+namespace
+{
+
+bool IsOpen( const std::shared_ptr<Cell> &c )
+{
+    return c->CanGuess() && c->DisplayedValue() == 0;
+}
+
+}
+
+const size_t FishMethod::MIN_SIZE;
+const size_t FishMethod::MAX_SIZE;
+
+FishMethod::FishMethod( std::shared_ptr<Puzzle> p,
+                        unsigned mark,
+                        const Bitboard &base,
+                        const Bitboard &cover )
+    : _mark( mark ), _size( base.Count() / Units::UNIT_SIZE )
+{
+    if ( mark < 1 || mark > 9 )
+    {
+        throw std::logic_error( "Fish Method requires a mark from 1 to 9." );
+    }
+    // n rows and n columns, crossing in n * n Cells
+    if ( _size < MIN_SIZE || _size > MAX_SIZE ||
+         base.Count() != _size * Units::UNIT_SIZE ||
+         cover.Count() != base.Count() ||
+         ( base & cover ).Count() != _size * _size )
+    {
+        throw std::logic_error(
+            "Fish Method requires 2 to 4 rows and as many columns." );
+    }
+    Bitboard cells = base | cover;
+    while ( cells.Any() )
+    {
+        size_t i = cells.PopFirst();
+        std::shared_ptr<Cell> c = p->GetCell( i % 9 + 1, i / 9 + 1 );
+        if ( !cover.Test( i ) )
+        {
+            _base.push_back( c );
+        }
+        else if ( base.Test( i ) )
+        {
+            _corners.push_back( c );
+        }
+        else
+        {
+            _cover.push_back( c );
+        }
+    }
+}
+
+void FishMethod::ExecuteForward()
+{
+    for ( Cells::const_iterator it = _cover.begin();
+          it != _cover.end();
+          ++it )
+    {
+        if ( (*it)->CanGuess() )
+        {
+            (*it)->Unmark( _mark );
+        }
+    }
+}
+
+bool FishMethod::VerifyForwardConditions()
+{
+    if ( !isFish() )
+    {
+        return false;
+    }
+    for ( Cells::const_iterator it = _cover.begin();
+          it != _cover.end();
+          ++it )
+    {
+        if ( IsOpen( *it ) && (*it)->GetMarkContainer()[_mark] )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FishMethod::ExecuteReverse()
+{
+    for ( Cells::const_iterator it = _cover.begin();
+          it != _cover.end();
+          ++it )
+    {
+        if ( IsOpen( *it ) )
+        {
+            (*it)->Mark( _mark );
+        }
+    }
+}
+
+bool FishMethod::VerifyReverseConditions()
+{
+    if ( !isFish() )
+    {
+        return false;
+    }
+    bool hasOpen = false;
+    for ( Cells::const_iterator it = _cover.begin();
+          it != _cover.end();
+          ++it )
+    {
+        if ( (*it)->DisplayedValue() == static_cast<int>( _mark ) ||
+             ( IsOpen( *it ) && (*it)->GetMarkContainer()[_mark] ) )
+        {
+            return false;
+        }
+        hasOpen = hasOpen || IsOpen( *it );
+    }
+    return hasOpen;
+}
+
+bool FishMethod::isFish() const
+{
+    for ( Cells::const_iterator it = _base.begin();
+          it != _base.end();
+          ++it )
+    {
+        if ( (*it)->DisplayedValue() == static_cast<int>( _mark ) ||
+             ( IsOpen( *it ) && (*it)->GetMarkContainer()[_mark] ) )
+        {
+            return false;
+        }
+    }
+    for ( Cells::const_iterator it = _corners.begin();
+          it != _corners.end();
+          ++it )
+    {
+        if ( (*it)->DisplayedValue() == static_cast<int>( _mark ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
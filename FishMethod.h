@@ -0,0 +1,107 @@
+#ifndef SUDOKU_FISH_METHOD_H
+#define SUDOKU_FISH_METHOD_H
+
+#include <memory>
+#include "SolutionMethod.h"
+#include "Bitboard.h"
+#include "CellArray.h"
+#include "Puzzle.h"
+#include "Units.h"
+
+namespace Sudoku
+{
+
+/**
+ * X-Wing, Swordfish and Jellyfish (2, 3 and 4 lines)
+ * If a mark is found in n rows only in n columns, it must be in those
+ * columns in those rows, so it can be removed from the rest of the columns.
+ * The same goes with rows and columns swapped.
+ */
+class FishMethod : public SolutionMethod
+{
+public:
+    /// Fewest and most lines
+    static const size_t MIN_SIZE = 2;
+    static const size_t MAX_SIZE = 4;
+
+    /**
+     * Create the method for a mark and some lines
+     * @param p Puzzle the lines are in
+     * @param mark The mark we are using
+     * @param base Cells of the base lines (rows or columns)
+     * @param cover Cells of as many lines of the other kind
+     * @throw std::logic_error if the lines do not make a fish
+     */
+    FishMethod( std::shared_ptr<Puzzle> p,
+                unsigned mark,
+                const Bitboard &base,
+                const Bitboard &cover );
+
+    /**
+     * This will remove the mark from the cover lines outside the base lines
+     * @pre VerifyForwardConditions
+     * @post Only the Cells where the lines cross have the mark
+     */
+    virtual void ExecuteForward();
+
+    /**
+     * Verify that the base lines have the mark only where they cross the
+     * cover lines, and do not have it as a value
+     * Verify that the rest of the cover lines have the mark somewhere
+     * @return true if the precondition holds
+     */
+    virtual bool VerifyForwardConditions();
+
+    /**
+     * This will mark the mark on the cover lines outside the base lines,
+     * in Cells without a value
+     * @pre VerifyReverseConditions
+     * @post The rest of the cover lines have the mark
+     */
+    virtual void ExecuteReverse();
+
+    /**
+     * Verify that the base lines have the mark only where they cross the
+     * cover lines, and do not have it as a value
+     * Verify that the rest of the cover lines have neither the mark nor the
+     * value, and have a Cell without a value
+     * @return true if the precondition holds
+     */
+    virtual bool VerifyReverseConditions();
+
+    /**
+     * Number of base lines, 2 for an X-Wing up to 4 for a Jellyfish
+     */
+    size_t GetSize() const { return _size; }
+
+    /**
+     * Do nothing
+     */
+    virtual ~FishMethod() {}
+
+private:
+    FishMethod( const FishMethod & );
+    FishMethod & operator=( const FishMethod & );
+
+    /**
+     * Check that the base lines could only have the mark in the cover lines
+     */
+    bool isFish() const;
+
+    typedef CellArray<MAX_SIZE * Units::UNIT_SIZE> Cells;
+
+    /// The mark we are using
+    unsigned _mark;
+    /// Number of base lines
+    size_t _size;
+    /// Base lines outside the cover lines
+    Cells _base;
+    /// Where the lines cross
+    Cells _corners;
+    /// Cover lines outside the base lines
+    Cells _cover;
+};
+
+}
+
+#endif
@@ -31,6 +31,16 @@ bool GameController::ImportFromFile( const std::string &filename )
     return _importer->ImportFromFile( filename );
 }
 
+bool GameController::SaveGame( const std::string &filename )
+{
+    return _importer->SaveGame( filename );
+}
+
+bool GameController::LoadGame( const std::string &filename )
+{
+    return _importer->LoadGame( filename );
+}
+
 void GameController::NewPuzzle()
 {
     _importer->NewPuzzle();
@@ -38,6 +38,19 @@ public:
      */
     bool ImportFromFile( const std::string &filename );
 
+    /**
+     * Save the game in progress to a file
+     * @param filename The file to write
+     */
+    bool SaveGame( const std::string &filename );
+
+    /**
+     * Resume a saved game
+     * @param filename The file to load
+     * @post Puzzle pointer and undo/redo in GameManager are set on success
+     */
+    bool LoadGame( const std::string &filename );
+
     /**
      * Create a new Puzzle (resets what was there)
      * @post Puzzle pointer in GameManager will be reset
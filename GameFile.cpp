@@ -0,0 +1,168 @@
+#include "GameFile.h"
+#include "Cell.h"
+#include "MappedFile.h"
+#include "Puzzle.h"
+#include "UndoHistory.h"
+#include "Units.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace Sudoku
+{
+
+const char GameFile::MAGIC[4] = { 'S', 'D', 'K', 'G' };
+const uint32_t GameFile::VERSION;
+
+namespace
+{
+
+/**
+ * Offset of the deltas, after the step counts
+ */
+size_t deltaOffset( size_t stepCount )
+{
+    size_t end = sizeof( GameFile::Header ) +
+        Units::CELL_COUNT * sizeof( uint32_t ) +
+        stepCount * sizeof( uint32_t );
+    return ( end + sizeof( uint64_t ) - 1 ) & ~( sizeof( uint64_t ) - 1 );
+}
+
+/**
+ * Check a packed Cell state holds values Cell::SetState accepts
+ */
+bool validState( uint32_t s )
+{
+    return ( s >> 19 ) == 0 &&
+        ( ( s >> 10 ) & 0xF ) <= 9 &&
+        ( ( s >> 14 ) & 0xF ) <= 9;
+}
+
+}
+
+void GameFile::Save( const std::string &filename, const Puzzle &p,
+                     UndoHistory &history )
+{
+    UndoHistory::DeltaContainer deltas;
+    std::vector<uint32_t> counts;
+    size_t undoable = 0;
+    history.Export( deltas, counts, undoable );
+
+    Header h;
+    std::memset( &h, 0, sizeof( h ) );
+    std::memcpy( h.magic, MAGIC, sizeof( h.magic ) );
+    h.version = VERSION;
+    h.headerSize = sizeof( Header );
+    h.cellCount = Units::CELL_COUNT;
+    h.stepCount = static_cast<uint32_t>( counts.size() );
+    h.undoSteps = static_cast<uint32_t>( undoable );
+    h.deltaCount = static_cast<uint32_t>( deltas.size() );
+
+    std::vector<uint32_t> states;
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        states.push_back( p.GetCell( i % 9 + 1, i / 9 + 1 )->GetState() );
+    }
+
+    std::string temp = filename + ".tmp";
+    {
+        std::ofstream out( temp.c_str(), std::ios::binary | std::ios::trunc );
+        out.write( reinterpret_cast<const char *>( &h ), sizeof( h ) );
+        out.write( reinterpret_cast<const char *>( &states[0] ),
+                   states.size() * sizeof( uint32_t ) );
+        if ( !counts.empty() )
+        {
+            out.write( reinterpret_cast<const char *>( &counts[0] ),
+                       counts.size() * sizeof( uint32_t ) );
+        }
+        static const char padding[sizeof( uint64_t )] = { 0 };
+        out.write( padding, deltaOffset( counts.size() ) -
+                   sizeof( h ) - ( states.size() + counts.size() ) *
+                   sizeof( uint32_t ) );
+        if ( !deltas.empty() )
+        {
+            out.write( reinterpret_cast<const char *>( &deltas[0] ),
+                       deltas.size() * sizeof( UndoHistory::Delta ) );
+        }
+        out.close();
+        if ( !out )
+        {
+            std::remove( temp.c_str() );
+            throw std::runtime_error( "Cannot write saved game " + filename );
+        }
+    }
+    if ( std::rename( temp.c_str(), filename.c_str() ) != 0 )
+    {
+        std::remove( temp.c_str() );
+        throw std::runtime_error( "Cannot replace saved game " + filename );
+    }
+}
+
+std::shared_ptr<Puzzle> GameFile::Load( const std::string &filename,
+                                        UndoHistory &history )
+{
+    MappedFile file( filename );
+    const char *data = file.Data();
+
+    if ( file.Size() < sizeof( Header ) )
+    {
+        throw std::runtime_error( "Saved game is cut short: " + filename );
+    }
+    const Header &h = *reinterpret_cast<const Header *>( data );
+    if ( std::memcmp( h.magic, MAGIC, sizeof( h.magic ) ) != 0 )
+    {
+        throw std::runtime_error( "Not a saved game: " + filename );
+    }
+    if ( h.version != VERSION || h.headerSize != sizeof( Header ) ||
+         h.cellCount != Units::CELL_COUNT || h.undoSteps > h.stepCount )
+    {
+        throw std::runtime_error( "Unsupported saved game: " + filename );
+    }
+    size_t deltasAt = deltaOffset( h.stepCount );
+    if ( file.Size() !=
+         deltasAt + h.deltaCount * sizeof( UndoHistory::Delta ) )
+    {
+        throw std::runtime_error( "Saved game is cut short: " + filename );
+    }
+
+    const uint32_t *states =
+        reinterpret_cast<const uint32_t *>( data + sizeof( Header ) );
+    const uint32_t *counts = states + Units::CELL_COUNT;
+    const UndoHistory::Delta *deltas =
+        reinterpret_cast<const UndoHistory::Delta *>( data + deltasAt );
+
+    // the history is only checked, not copied, until it is known to be good
+    size_t total = 0;
+    for ( size_t s = 0; s < h.stepCount; s++ )
+    {
+        total += counts[s];
+    }
+    bool valid = ( total == h.deltaCount );
+    for ( size_t i = 0; valid && i < h.deltaCount; i++ )
+    {
+        valid = UndoHistory::GetIndex( deltas[i] ) < Units::CELL_COUNT &&
+            validState( UndoHistory::GetBefore( deltas[i] ) ) &&
+            validState( UndoHistory::GetAfter( deltas[i] ) );
+    }
+    for ( size_t i = 0; valid && i < Units::CELL_COUNT; i++ )
+    {
+        valid = validState( states[i] );
+    }
+    if ( !valid )
+    {
+        throw std::runtime_error( "Saved game is corrupt: " + filename );
+    }
+
+    std::shared_ptr<Puzzle> p( new Puzzle );
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        p->GetCell( i % 9 + 1, i / 9 + 1 )->SetState( states[i] );
+    }
+    history.Import( deltas, counts, h.stepCount, h.undoSteps );
+    return p;
+}
+
+}
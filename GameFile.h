@@ -0,0 +1,85 @@
+#ifndef SUDOKU_GAME_FILE_H
+#define SUDOKU_GAME_FILE_H
+
+#include <memory>
+#include <stdint.h>
+#include <string>
+
+namespace Sudoku
+{
+
+class Puzzle;
+class UndoHistory;
+
+/**
+ * Saves and restores a game in progress: every Cell (givens, guesses,
+ * marks) and the undo/redo history
+ *
+ * The file is laid out so it can be used where it is mapped, nothing is
+ * parsed (all values are in host byte order, aligned to their size):
+ *  - Header (32 bytes)
+ *  - 81 Cell states (uint32_t, see Cell::GetState), indexed as in Units
+ *  - the number of deltas in each history step (uint32_t), oldest first
+ *  - padding to 8 bytes
+ *  - the deltas of all steps (uint64_t, see UndoHistory::Delta)
+ *
+ * The version changes whenever the layout or the packing of a Cell state
+ * or delta changes, older versions are refused.
+ */
+class GameFile
+{
+public:
+    /// First bytes of every save
+    static const char MAGIC[4];
+    /// Current layout
+    static const uint32_t VERSION = 1;
+
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        /// Size of this Header, so it may grow in later versions
+        uint32_t headerSize;
+        uint32_t cellCount;
+        /// Steps in the history, the first undoSteps of them can be undone
+        uint32_t stepCount;
+        uint32_t undoSteps;
+        /// Deltas of all steps together
+        uint32_t deltaCount;
+        uint32_t reserved;
+    };
+
+    /**
+     * Write a game to a file
+     * The file is written beside and renamed over, so an old save stays
+     * whole if this fails part way
+     * @param filename File to write
+     * @param p Puzzle to save
+     * @param history Undo/redo history to save (non-const, it may read its
+     *        spill file)
+     * @throw std::runtime_error if the file cannot be written
+     */
+    static void Save( const std::string &filename, const Puzzle &p,
+                      UndoHistory &history );
+
+    /**
+     * Read a game from a file written by Save
+     * The file is mapped, Cells and history are set straight from it
+     * @param filename File to read
+     * @param history Set to the saved history, untouched on failure
+     * @return The saved Puzzle
+     * @throw std::runtime_error if the file cannot be read, is not a save,
+     *        is of another version or is cut short
+     */
+    static std::shared_ptr<Puzzle> Load( const std::string &filename,
+                                         UndoHistory &history );
+
+private:
+    GameFile();
+    GameFile( const GameFile & );
+    GameFile & operator=( const GameFile & );
+};
+
+}
+
+#endif
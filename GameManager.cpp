@@ -1,22 +1,28 @@
 #include "GameManager.h"
 
+#include "BacktrackingSolver.h"
 #include "Cell.h"
 #include "CellController.h"
 #include "Command.h"
 #include "GameController.h"
+#include "GameFile.h"
 #include "MethodSolver.h"
 #include "Puzzle.h"
 #include "PuzzleController.h"
 #include "PuzzleMarker.h"
 #include "SimplePuzzleImporter.h"
 #include "SimpleValidator.h"
+#include "SolutionCounter.h"
 #include "SolutionMethodFactory.h"
 #include "SolvedPuzzleImporter.h"
 #include "SolverHelper.h"
+#include "Units.h"
 
 #include <fstream>
 #include <stdexcept>
 
+#include "Log.h"
+
 namespace Sudoku
 {
 
@@ -33,11 +39,13 @@ std::shared_ptr<GameManager> GameManager::Create()
     std::shared_ptr<IValidator> validator =
         Sudoku::SimpleValidator::CreateGuessValidator();
 
-    std::shared_ptr<ISolver> solver(
+    std::shared_ptr<MethodSolver> solver(
         new MethodSolver( helper, marker, validator ) );
+    solver->SetFallback(
+        std::shared_ptr<ISolver>( new BacktrackingSolver( marker ) ) );
 
     std::shared_ptr<PuzzleController> pc(
-        new PuzzleController( gm, gm, marker, solver ) );
+        new PuzzleController( gm, gm, marker, solver, gm->_counter ) );
 
     std::shared_ptr<CellController> cc( new CellController( gm, gm ) );
 
@@ -49,7 +57,10 @@ std::shared_ptr<GameManager> GameManager::Create()
 }
 
 GameManager::GameManager()
-    : _lastExecuted( false ), _isExecute( false )
+    : _lastExecuted( false ), _isExecute( false ),
+      _counter( new SolutionCounter ),
+      _rejectNonUnique( false ),
+      _importedSolutions( 0 )
 {
     std::shared_ptr<IPuzzleImporter> temp( new SolvedPuzzleImporter );
     _importers.push_back( temp );
@@ -76,10 +87,21 @@ bool GameManager::ImportFromFile( const std::string &filename )
                 std::shared_ptr<Puzzle> p = (*it)->Import( filestream );
                 if ( p )
                 {
+                    size_t solutions = _counter->CountSolutions( p, 2 );
+                    if ( _rejectNonUnique && solutions != 1 )
+                    {
+                        FILE_LOG(logWARNING) << "Rejected " << filename
+                                             << ", solutions: " << solutions;
+                        return false;
+                    }
+                    _importedSolutions = solutions;
+                    _importedRating = _rater.Rate( p );
+                    FILE_LOG(logINFO) << "Imported " << filename
+                                      << ", score: "
+                                      << _importedRating.score;
                     _puzzle.reset();
                     _puzzle = p;
-                    clearUndo();
-                    clearRedo();
+                    clearHistory();
                     attachAllCellObservers();
                     return true;
                 }
@@ -95,11 +117,52 @@ bool GameManager::ImportFromFile( const std::string &filename )
     return false;
 }
 
+bool GameManager::SaveGame( const std::string &filename )
+{
+    if ( !_puzzle )
+    {
+        return false;
+    }
+    try
+    {
+        GameFile::Save( filename, *_puzzle, _history );
+    }
+    catch ( std::exception &e )
+    {
+        FILE_LOG(logWARNING) << e.what();
+        return false;
+    }
+    return true;
+}
+
+bool GameManager::LoadGame( const std::string &filename )
+{
+    std::shared_ptr<Puzzle> p;
+    try
+    {
+        p = GameFile::Load( filename, _history );
+    }
+    catch ( std::exception &e )
+    {
+        FILE_LOG(logWARNING) << e.what();
+        return false;
+    }
+    // same checks as an import, or they would describe the previous Puzzle
+    _importedSolutions = _counter->CountSolutions( p, 2 );
+    _importedRating = _rater.Rate( p );
+    _puzzle = p;
+    notifyCanUndo( _history.CanUndo() );
+    notifyCanRedo( _history.CanRedo() );
+    attachAllCellObservers();
+    return true;
+}
+
 void GameManager::NewPuzzle()
 {
     _puzzle.reset( new Puzzle );
-    clearUndo();
-    clearRedo();
+    _importedSolutions = _counter->CountSolutions( _puzzle, 2 );
+    _importedRating = _rater.Rate( _puzzle );
+    clearHistory();
     attachAllCellObservers();
 }
 
@@ -109,14 +172,37 @@ bool GameManager::Execute( std::shared_ptr<CommandBase> command )
     {
         throw std::runtime_error( "Cannot execute Command without a Puzzle." );
     }
+    Cell::State before[Units::CELL_COUNT];
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        before[i] = _puzzle->GetCell( i % 9 + 1, i / 9 + 1 )->GetState();
+    }
     _lastExecuted = false;
     _isExecute = true;
-    command->Accept( *this );
+    Bitboard changed = Bitboard::None();
+    {
+        // a Command may change many Cells, notify each one once
+        Puzzle::ChangeTransaction changes( _puzzle );
+        command->Accept( *this );
+        changed = changes.End();
+    }
     if ( _lastExecuted )
     {
-        _undo.push( command );
-        // clear redo
-        clearRedo();
+        // keep only what changed, the Command and its memento can go
+        _deltas.clear();
+        while ( changed.Any() )
+        {
+            size_t i = changed.PopFirst();
+            Cell::State after =
+                _puzzle->GetCell( i % 9 + 1, i / 9 + 1 )->GetState();
+            if ( after != before[i] )
+            {
+                _deltas.push_back(
+                    UndoHistory::MakeDelta( i, before[i], after ) );
+            }
+        }
+        _history.Record( _deltas );
+        notifyCanRedo( false );
         notifyCanUndo( true );
     }
     return _lastExecuted;
@@ -128,23 +214,14 @@ bool GameManager::Undo()
     {
         throw std::runtime_error( "Cannot undo Command without a Puzzle." );
     }
-    if ( !CanUndo() )
+    if ( !_history.Undo( _deltas ) )
     {
         return false;
     }
-    std::shared_ptr<CommandBase> command = _undo.top();
-    _lastExecuted = false;
-    _isExecute = false;
-    command->Accept( *this );
-    if ( _lastExecuted )
-    {
-        // move to proper stack
-        _undo.pop();
-        _redo.push( command );
-        notifyCanRedo( true );
-        notifyCanUndo( !_undo.empty() );
-    }
-    return _lastExecuted;
+    applyDeltas( true );
+    notifyCanRedo( true );
+    notifyCanUndo( _history.CanUndo() );
+    return true;
 }
 
 bool GameManager::Redo()
@@ -153,23 +230,26 @@ bool GameManager::Redo()
     {
         throw std::runtime_error( "Cannot redo Command without a Puzzle." );
     }
-    if ( !CanRedo() )
+    if ( !_history.Redo( _deltas ) )
     {
         return false;
     }
-    std::shared_ptr<CommandBase> command = _redo.top();
-    _lastExecuted = false;
-    _isExecute = true;
-    command->Accept( *this );
-    if ( _lastExecuted )
-    {
-        // move to proper stack
-        _redo.pop();
-        _undo.push( command );
-        notifyCanRedo( !_redo.empty() );
-        notifyCanUndo( true );
-    }
-    return _lastExecuted;
+    applyDeltas( false );
+    notifyCanRedo( _history.CanRedo() );
+    notifyCanUndo( true );
+    return true;
+}
+
+void GameManager::SetHistoryLimit( size_t maxBytes )
+{
+    _history.SetMaxBytes( maxBytes );
+    clearHistory();
+}
+
+void GameManager::SetHistorySpillFile( const std::string &filename )
+{
+    _history.SetSpillFile( filename );
+    clearHistory();
 }
 
 void GameManager::AddObserver( std::shared_ptr<ICommandObserver> o )
@@ -297,16 +377,26 @@ void GameManager::notifyCanRedo( bool yes )
     }
 }
 
-void GameManager::clearUndo()
+void GameManager::clearHistory()
 {
-    while ( !_undo.empty() ) { _undo.pop(); }
+    _history.Clear();
     notifyCanUndo( false );
+    notifyCanRedo( false );
 }
 
-void GameManager::clearRedo()
+void GameManager::applyDeltas( bool before )
 {
-    while ( !_redo.empty() ) { _redo.pop(); }
-    notifyCanRedo( false );
+    Puzzle::ChangeTransaction changes( _puzzle );
+    for ( UndoHistory::DeltaContainer::const_iterator it = _deltas.begin();
+          it != _deltas.end();
+          ++it )
+    {
+        size_t i = UndoHistory::GetIndex( *it );
+        _puzzle->GetCell( i % 9 + 1, i / 9 + 1 )->SetState(
+            before ? UndoHistory::GetBefore( *it )
+                   : UndoHistory::GetAfter( *it ) );
+    }
+    changes.End();
 }
 
 void GameManager::attachAllCellObservers()
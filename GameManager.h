@@ -2,13 +2,14 @@
 #define SUDOKU_GAME_MANAGER_H
 
 #include <memory>
-#include <stack>
 #include <vector>
+#include "DifficultyRater.h"
 #include "ICommandDispatcher.h"
 #include "ICommandExecutor.h"
 #include "IPuzzleAccess.h"
 #include "IFileImporter.h"
 #include "ICommandObserver.h"
+#include "UndoHistory.h"
 
 namespace Sudoku
 {
@@ -18,6 +19,7 @@ class GameController;
 class PuzzleController;
 class ICommandDispatcher;
 class IPuzzleImporter;
+class ISolutionCounter;
 class Puzzle;
 class Cell;
 
@@ -37,9 +39,68 @@ public:
      * @param filename The file we will load and try to read
      * @return success or failure
      * @post If we succeed, Puzzle is set, else it is still NULL
+     * @post If rejecting non-unique Puzzles, a Puzzle without exactly one
+     *       solution is not loaded (and false is returned)
      */
     bool ImportFromFile( const std::string &filename );
 
+    /**
+     * Save the Puzzle and undo/redo history, see GameFile
+     * @param filename The file we will write
+     * @return success or failure (such as no Puzzle)
+     */
+    virtual bool SaveGame( const std::string &filename );
+
+    /**
+     * Resume a game from a file written by SaveGame
+     * @param filename The file we will load
+     * @return success or failure
+     * @post If we succeed, Puzzle and undo/redo history are the saved ones,
+     *       else nothing changed
+     */
+    virtual bool LoadGame( const std::string &filename );
+
+    /**
+     * Choose whether imports must have exactly one solution
+     * @param reject true to refuse Puzzles with zero or many solutions
+     */
+    void SetRejectNonUnique( bool reject ) { _rejectNonUnique = reject; }
+
+    /**
+     * Solutions of the current Puzzle, counted when it was imported, loaded
+     * or created
+     * @return 0, 1, or 2 (meaning 2 or more)
+     */
+    size_t GetImportedSolutionCount() const { return _importedSolutions; }
+
+    /**
+     * Difficulty of the current Puzzle, rated when it was imported, loaded
+     * or created
+     * @return trace of the Methods which solve it, with score and tier
+     */
+    const DifficultyRater::Rating& GetImportedRating() const
+    { return _importedRating; }
+
+    /**
+     * Cap the memory used to remember Commands for undo/redo
+     * @param maxBytes Cap, see UndoHistory::SetMaxBytes
+     * @post undo/redo history is cleared
+     */
+    void SetHistoryLimit( size_t maxBytes );
+
+    /**
+     * Keep undo history which goes over the cap in a file
+     * @param filename File to spill to, empty to drop old history instead
+     * @throw std::runtime_error if the file cannot be opened
+     * @post undo/redo history is cleared
+     */
+    void SetHistorySpillFile( const std::string &filename );
+
+    /**
+     * Undo/redo history, for its memory use and counts
+     */
+    const UndoHistory& GetHistory() const { return _history; }
+
     /**
      * Reset the puzzle pointer and clear what exists
      * @post Puzzle is blank
@@ -50,7 +111,8 @@ public:
      * Execute a command
      * @param command Command to execute
      * @return success or failure
-     * @post if success, command is pushed on undo stack, redo stack is cleared
+     * @post if success, the Cells command changed are recorded for undo and
+     *       redo history is cleared; the command itself is not kept
      */
     virtual bool Execute( std::shared_ptr<CommandBase> command );
 
@@ -58,13 +120,13 @@ public:
      * Check if there is anything to undo
      * @return false if no commands in undo stack
      */
-    virtual bool CanUndo() const { return !_undo.empty(); }
+    virtual bool CanUndo() const { return _history.CanUndo(); }
 
     /**
      * Attempt to undo the last command
      * @return success or failure (such as no undo commands remain)
-     * @post If not empty, last command executed is unexecuted and pushed on
-     *       to redo stack
+     * @post If not empty, Cells changed by the last command executed are put
+     *       back and it can be redone
      */
     virtual bool Undo();
 
@@ -72,13 +134,13 @@ public:
      * Check if there is anything to redo
      * @return false if no commands in redo stack
      */
-    virtual bool CanRedo() const { return !_redo.empty(); }
+    virtual bool CanRedo() const { return _history.CanRedo(); }
 
     /**
      * Attempt to redo the last command we undid
      * @return success or failure (such as no redo commands remain)
-     * @post If not empty, last command unexecuted is executed and pushed on
-     *       to undo stack
+     * @post If not empty, Cells changed by the last command undone are
+     *       changed again and it can be undone
      */
     virtual bool Redo();
 
@@ -208,14 +270,16 @@ private:
     GameManager & operator=( const GameManager & );
 
     /**
-     * Clear undo stack and notify
+     * Clear undo and redo history and notify
      */
-    void clearUndo();
+    void clearHistory();
 
     /**
-     * Clear redo stack and notify
+     * Set the Cells of the last undo/redo step
+     * @param before true to set the state before the step, else after it
+     * @post Cells in _deltas are set, observers notified once each
      */
-    void clearRedo();
+    void applyDeltas( bool before );
 
     /**
      * Whenever we have a new Puzzle, we need to reattach those that care
@@ -234,10 +298,10 @@ private:
     bool _isExecute;
     /// This is the entire Sudoku board
     std::shared_ptr<Puzzle> _puzzle;
-    /// Commands we can still undo
-    std::stack<std::shared_ptr<CommandBase> > _undo;
-    /// Commands we can still redo
-    std::stack<std::shared_ptr<CommandBase> > _redo;
+    /// Cells changed by the Commands we can still undo/redo
+    UndoHistory _history;
+    /// Reused for each step recorded or taken from _history
+    UndoHistory::DeltaContainer _deltas;
 
     /// Who cares about the command state
     typedef std::vector<std::shared_ptr<ICommandObserver> > ObserverContainer;
@@ -252,6 +316,17 @@ private:
     std::shared_ptr<PuzzleController> _puzzleController;
     std::shared_ptr<CellController> _cellController;
 
+    /// Checks imported Puzzles, shared with the PuzzleController
+    std::shared_ptr<ISolutionCounter> _counter;
+    /// Refuse to import Puzzles without a unique solution
+    bool _rejectNonUnique;
+    /// Solutions of the current Puzzle (up to 2)
+    size_t _importedSolutions;
+    /// Rates imported Puzzles
+    DifficultyRater _rater;
+    /// Rating of the current Puzzle
+    DifficultyRater::Rating _importedRating;
+
     /// These are used to import from a file
     typedef std::vector<std::shared_ptr<IPuzzleImporter> >  ImporterContainer;
     ImporterContainer _importers;
@@ -0,0 +1,128 @@
+#include "Grid.h"
+#include "Puzzle.h"
+#include <cstring>
+
+namespace Sudoku
+{
+
+Grid::Grid()
+{
+    std::memset( _cells, 0, sizeof( _cells ) );
+}
+
+Grid::Grid( const Puzzle &p )
+{
+    for ( size_t i = 0; i < ARRAY_SIZE; i++ )
+    {
+        std::shared_ptr<const Cell> c = p.GetCell( i % SECTOR_SIZE + 1,
+                                                   i / SECTOR_SIZE + 1 );
+        _cells[i].value = c->DisplayedValue();
+        _cells[i].given = !c->CanGuess();
+        // bit 0 of the MarkContainer is unused
+        _cells[i].marks = ( c->GetMarkContainer().to_ulong() >> 1 ) & ALL_MARKS;
+    }
+}
+
+void Grid::CopyTo( Puzzle &p ) const
+{
+    for ( size_t i = 0; i < ARRAY_SIZE; i++ )
+    {
+        std::shared_ptr<Cell> c = p.GetCell( i % SECTOR_SIZE + 1,
+                                             i / SECTOR_SIZE + 1 );
+        const GridCell &g = _cells[i];
+        c->Display( g.given != 0 );
+        if ( g.given )
+        {
+            c->SetCorrect( g.value );
+        }
+        else
+        {
+            c->SetGuess( g.value );
+        }
+        c->SetMarkContainer(
+            Cell::MarkContainer( static_cast<unsigned long>( g.marks ) << 1 ) );
+    }
+}
+
+GridCell& Grid::GetCell( size_t x, size_t y )
+{
+    Cell::Validate( x, 1, 9 );
+    Cell::Validate( y, 1, 9 );
+    return _cells[( y - 1 ) * SECTOR_SIZE + ( x - 1 )];
+}
+
+const GridCell& Grid::GetCell( size_t x, size_t y ) const
+{
+    Cell::Validate( x, 1, 9 );
+    Cell::Validate( y, 1, 9 );
+    return _cells[( y - 1 ) * SECTOR_SIZE + ( x - 1 )];
+}
+
+Grid::Sector Grid::GetRow( size_t r )
+{
+    Cell::Validate( r, 1, 9 );
+    return GetUnit( Units::Row( r ) );
+}
+
+Grid::ConstSector Grid::GetRow( size_t r ) const
+{
+    Cell::Validate( r, 1, 9 );
+    return GetUnit( Units::Row( r ) );
+}
+
+Grid::Sector Grid::GetCol( size_t c )
+{
+    Cell::Validate( c, 1, 9 );
+    return GetUnit( Units::Col( c ) );
+}
+
+Grid::ConstSector Grid::GetCol( size_t c ) const
+{
+    Cell::Validate( c, 1, 9 );
+    return GetUnit( Units::Col( c ) );
+}
+
+Grid::Sector Grid::GetBlock( size_t x, size_t y )
+{
+    Cell::Validate( x, 1, 3 );
+    Cell::Validate( y, 1, 3 );
+    return GetUnit( Units::Block( x, y ) );
+}
+
+Grid::ConstSector Grid::GetBlock( size_t x, size_t y ) const
+{
+    Cell::Validate( x, 1, 3 );
+    Cell::Validate( y, 1, 3 );
+    return GetUnit( Units::Block( x, y ) );
+}
+
+void Grid::UpdateMarks()
+{
+    // collect the values used in every unit first (one pass)
+    unsigned short used[Units::UNIT_COUNT] = { 0 };
+    for ( size_t i = 0; i < ARRAY_SIZE; i++ )
+    {
+        if ( _cells[i].value != 0 )
+        {
+            unsigned short bit = 1 << ( _cells[i].value - 1 );
+            const unsigned char *units = Units::CELL_UNITS[i];
+            used[units[0]] |= bit;
+            used[units[1]] |= bit;
+            used[units[2]] |= bit;
+        }
+    }
+    // then every record can be marked with what is left
+    for ( size_t i = 0; i < ARRAY_SIZE; i++ )
+    {
+        const unsigned char *units = Units::CELL_UNITS[i];
+        _cells[i].marks = ALL_MARKS &
+            ~( used[units[0]] | used[units[1]] | used[units[2]] );
+    }
+}
+
+bool Grid::operator==( const Grid &g ) const
+{
+    return ( std::memcmp( _cells, g._cells, sizeof( _cells ) ) == 0 );
+}
+
+}
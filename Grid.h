@@ -0,0 +1,240 @@
+#ifndef SUDOKU_GRID_H
+#define SUDOKU_GRID_H
+
+#include <cstddef>
+#include "Units.h"
+
+namespace Sudoku
+{
+
+class Puzzle;
+
+/**
+ * Compact record for a single square of a Grid
+ * This is everything a solver needs to know about a Cell in 4 bytes:
+ * the displayed value, whether it is a given, and the candidate marks
+ * @note marks uses bit (d - 1) for the value d, unlike Cell::MarkContainer
+ */
+struct GridCell
+{
+    /// Displayed value {0...9}, 0 for blank
+    unsigned char value;
+    /// Non-zero if the value is a given (correct value displayed)
+    unsigned char given;
+    /// 9-bit candidate mask
+    unsigned short marks;
+
+    /**
+     * Check for a candidate
+     * @param mark Value to check
+     * @pre mark is in {1...9}
+     * @return true if mark is set
+     */
+    bool HasMark( int mark ) const { return ( marks >> ( mark - 1 ) ) & 1; }
+
+    /**
+     * Set a candidate
+     * @param mark Value to set
+     * @pre mark is in {1...9}
+     */
+    void Mark( int mark ) { marks |= ( 1 << ( mark - 1 ) ); }
+
+    /**
+     * Clear a candidate
+     * @param mark Value to clear
+     * @pre mark is in {1...9}
+     */
+    void Unmark( int mark ) { marks &= ~( 1 << ( mark - 1 ) ); }
+
+    /**
+     * Count the candidates
+     * @return number of marks set
+     */
+    unsigned MarkCount() const { return __builtin_popcount( marks ); }
+
+    bool operator==( const GridCell &c ) const
+    {
+        return ( value == c.value && given == c.given && marks == c.marks );
+    }
+};
+
+/**
+ * Flat storage engine for a 9x9 board
+ * All 81 records live in one contiguous array (324 bytes, about five cache
+ * lines) so a Grid is a plain value type: copying is a memcpy and there is
+ * no heap allocation, no observers, and no pointer chasing.
+ *
+ * It mirrors the Puzzle accessors (x is the column, y the row, both starting
+ * from 1) and can be loaded from or stored back into a Puzzle, so solvers can
+ * work on a Grid and commit the result through the regular Cell API.
+ *
+ * Puzzle itself keeps its shared Cells: commands, controllers and the Qt
+ * views hold them and observe them one by one, which a flat record cannot
+ * support.  The flat storage is used by the bulk paths instead, which load
+ * a Grid once and never hand out Cells (CandidateGrid, PuzzleBatch, the
+ * BacktrackingSolver and the importers of whole files).
+ */
+class Grid
+{
+public:
+    /// Number of Cells in a Grid
+    static const size_t ARRAY_SIZE = 81;
+    /// Number of Cells in a row, column, or block
+    static const size_t SECTOR_SIZE = 9;
+    /// Candidate mask with every value marked
+    static const unsigned short ALL_MARKS = 0x1FF;
+
+    /**
+     * Non-owning view of the nine records in a row, column, or block
+     * Iterating a sector does not allocate, it walks a static Units table
+     */
+    template <class T>
+    class SectorView
+    {
+    public:
+        SectorView( T *cells, const unsigned char *index )
+            : _cells( cells ), _index( index ) {}
+        T& operator[]( size_t i ) const { return _cells[_index[i]]; }
+        size_t size() const { return SECTOR_SIZE; }
+    private:
+        T *_cells;
+        const unsigned char *_index;
+    };
+
+    typedef SectorView<GridCell> Sector;
+    typedef SectorView<const GridCell> ConstSector;
+
+    /**
+     * Create a blank board (no values, no marks)
+     */
+    Grid();
+
+    /**
+     * Load the displayed values, givens, and marks of a Puzzle
+     * @param p Puzzle to copy
+     * @post Each GridCell matches the Cell at the same position
+     */
+    explicit Grid( const Puzzle &p );
+
+    /**
+     * Write this Grid back into a Puzzle through the Cell API
+     * Givens become displayed correct values, other values become guesses
+     * @param p Puzzle to update
+     * @post Displayed values and marks of p match this Grid
+     * @post Observers of changed Cells are notified
+     */
+    void CopyTo( Puzzle &p ) const;
+
+    /**
+     * Get a record by position
+     * @param x X coordinate of Cell (starting from 1)
+     * @param y Y coordinate of Cell (starting from 1)
+     * @pre x and y are both in range [1,9]
+     * @return reference to the record at the given position
+     */
+    GridCell& GetCell( size_t x, size_t y );
+
+    /**
+     * Get a record by position, const version
+     * @overload GridCell& GetCell( size_t x, size_t y )
+     */
+    const GridCell& GetCell( size_t x, size_t y ) const;
+
+    /**
+     * Unchecked access by index
+     * @param i Index of the Cell, (y - 1) * 9 + (x - 1)
+     * @pre i < ARRAY_SIZE
+     * @return reference to the record
+     */
+    GridCell& operator[]( size_t i ) { return _cells[i]; }
+
+    /**
+     * Unchecked access by index, const version
+     * @overload GridCell& operator[]( size_t i )
+     */
+    const GridCell& operator[]( size_t i ) const { return _cells[i]; }
+
+    /**
+     * Get a row, column, or block by unit number
+     * @param u Unit number (see Units)
+     * @pre u is in range [0,26]
+     * @return view of the records in the given unit
+     */
+    Sector GetUnit( size_t u )
+    {
+        return Sector( _cells, Units::UNIT_CELLS[u] );
+    }
+
+    /**
+     * Get a unit by number, const version
+     * @overload Sector GetUnit( size_t u )
+     */
+    ConstSector GetUnit( size_t u ) const
+    {
+        return ConstSector( _cells, Units::UNIT_CELLS[u] );
+    }
+
+    /**
+     * Get a row by index
+     * @param r Row number
+     * @pre r is in range [1,9]
+     * @return view of the records in the given row
+     */
+    Sector GetRow( size_t r );
+
+    /**
+     * Get a row by index, const version
+     * @overload Sector GetRow( size_t r )
+     */
+    ConstSector GetRow( size_t r ) const;
+
+    /**
+     * Get a column by index
+     * @param c Column number
+     * @pre c is in range [1,9]
+     * @return view of the records in the given column
+     */
+    Sector GetCol( size_t c );
+
+    /**
+     * Get a column by index, const version
+     * @overload Sector GetCol( size_t c )
+     */
+    ConstSector GetCol( size_t c ) const;
+
+    /**
+     * Get a 3 by 3 block by coordinate
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @pre x, y are each in range [1,3]
+     * @return view of the records in the given block
+     */
+    Sector GetBlock( size_t x, size_t y );
+
+    /**
+     * Get a 3 by 3 block by coordinate, const version
+     * @overload Sector GetBlock( size_t x, size_t y )
+     */
+    ConstSector GetBlock( size_t x, size_t y ) const;
+
+    /**
+     * Recompute every candidate mask from the displayed values
+     * Same result as PuzzleMarker::UpdateMarks on the equivalent Puzzle
+     * @post Each record has every value not displayed by a neighbor marked
+     */
+    void UpdateMarks();
+
+    /**
+     * Check if two grids hold exactly the same records
+     * @param g Other grid to compare
+     * @return true if every record is the same
+     */
+    bool operator==( const Grid &g ) const;
+
+private:
+    GridCell _cells[ARRAY_SIZE];
+};
+
+}
+
+#endif
@@ -0,0 +1,122 @@
+#include "GridListImporter.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "Log.h"
+
+namespace Sudoku
+{
+
+namespace
+{
+
+bool IsValue( char c )
+{
+    return ( c == '.' || ( c >= '0' && c <= '9' ) );
+}
+
+bool IsSpace( char c )
+{
+    return ( c == ' ' || c == '\t' || c == '\r' );
+}
+
+/**
+ * Check if the first non-whitespace character of a line is a value
+ */
+bool StartsWithValue( const std::string &line )
+{
+    for ( std::string::const_iterator it = line.begin();
+          it != line.end();
+          ++it )
+    {
+        if ( !IsSpace( *it ) )
+        {
+            return IsValue( *it );
+        }
+    }
+    return false;
+}
+
+}
+
+std::vector<Grid> GridListImporter::Import( std::istream &in )
+{
+    std::vector<Grid> grids;
+    Grid current;
+    size_t filled = 0;
+    size_t lineNumber = 0;
+    std::string line;
+
+    FILE_LOG(logINFO) << "Begin parsing puzzle list.";
+
+    while ( std::getline( in, line ) )
+    {
+        ++lineNumber;
+        if ( filled == 0 && !StartsWithValue( line ) )
+        {
+            continue;
+        }
+        const bool starting = ( filled == 0 );
+        for ( std::string::const_iterator it = line.begin();
+              it != line.end();
+              ++it )
+        {
+            char c = *it;
+            if ( IsSpace( c ) )
+            {
+                continue;
+            }
+            if ( !IsValue( c ) )
+            {
+                std::ostringstream msg;
+                msg << "Found non-numeric value on line " << lineNumber;
+                FILE_LOG(logWARNING) << msg.str();
+                throw std::domain_error( msg.str() );
+            }
+            GridCell &cell = current[filled];
+            cell.value = ( c == '.' ) ? 0 : c - '0';
+            cell.given = ( cell.value != 0 );
+            if ( ++filled == Grid::ARRAY_SIZE )
+            {
+                grids.push_back( current );
+                current = Grid();
+                filled = 0;
+                // anything after a complete Puzzle is a comment
+                break;
+            }
+        }
+        if ( starting && filled > Grid::SECTOR_SIZE )
+        {
+            // more than a row of the 9x9 layout but not a whole line, the
+            // next line would be merged into this Puzzle
+            std::ostringstream msg;
+            msg << "Found an incomplete puzzle on line " << lineNumber;
+            FILE_LOG(logWARNING) << msg.str();
+            throw std::domain_error( msg.str() );
+        }
+    }
+
+    if ( filled != 0 )
+    {
+        FILE_LOG(logWARNING)
+            << "Reached end of file while still filling puzzle";
+        throw std::runtime_error( "End of file reached." );
+    }
+    FILE_LOG(logINFO) << "Read " << grids.size() << " puzzles.";
+    return grids;
+}
+
+void GridListImporter::Export( std::ostream &out, const Grid &g )
+{
+    char line[Grid::ARRAY_SIZE + 1];
+    for ( size_t i = 0; i < Grid::ARRAY_SIZE; i++ )
+    {
+        line[i] = '0' + g[i].value;
+    }
+    line[Grid::ARRAY_SIZE] = '\n';
+    out.write( line, sizeof( line ) );
+}
+
+}
@@ -0,0 +1,57 @@
+#ifndef SUDOKU_GRID_LIST_IMPORTER_H
+#define SUDOKU_GRID_LIST_IMPORTER_H
+
+#include <iostream>
+#include <vector>
+
+#include "Grid.h"
+
+namespace Sudoku
+{
+
+/**
+ * Imports a whole file of Puzzles as Grids
+ * Accepts both common layouts, even mixed in one file:
+ *  - one Puzzle per line, 81 characters
+ *  - the 9 lines of 9 values read by SimplePuzzleImporter, blank lines
+ *    between Puzzles
+ *
+ * Values are 1-9, a blank Cell is 0 or '.', whitespace is ignored.
+ * Once a Puzzle has 81 values the rest of that line is skipped (so a line
+ * may end with a comment).  Only the 9x9 layout carries a Puzzle over to
+ * the next line, its first line holds at most 9 values.  Between Puzzles, a line which does not start
+ * with a value is a label or comment and is skipped (e.g. "# hard", or the
+ * trailing difficulty name in qt/puzzle_hard).
+ *
+ * Values become givens in the Grid, nothing is marked.
+ */
+class GridListImporter
+{
+public:
+    GridListImporter() {}
+
+    /**
+     * Read every Puzzle from a stream
+     * @param in Input stream
+     * @return Puzzles in file order
+     * @throw std::domain_error on any other character, or a line of more
+     *        than 9 but fewer than 81 values, with the line number
+     * @throw std::runtime_error if the stream ends part way through a Puzzle
+     */
+    std::vector<Grid> Import( std::istream &in );
+
+    /**
+     * Write a Grid as a single line of 81 values, 0 for blank
+     * @param out Output stream
+     * @param g Grid to write
+     */
+    static void Export( std::ostream &out, const Grid &g );
+
+private:
+    GridListImporter( const GridListImporter & );
+    GridListImporter & operator=( const GridListImporter & );
+};
+
+}
+
+#endif
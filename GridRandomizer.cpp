@@ -0,0 +1,149 @@
+#include "GridRandomizer.h"
+#include "CandidateGrid.h"
+#include "Grid.h"
+
+#include <algorithm>
+
+namespace Sudoku
+{
+
+GridRandomizer::GridRandomizer( uint32_t seed )
+    : _engine( seed )
+{}
+
+void GridRandomizer::Fill( Grid &g )
+{
+    CandidateGrid blank;
+    CandidateGrid solution;
+    // a blank board always has a solution
+    FillFrom( blank, solution );
+
+    // relabel and rearrange it with a random symmetry of the board, each of
+    // which maps a solved grid to a solved grid
+    size_t rows[Grid::SECTOR_SIZE];
+    size_t cols[Grid::SECTOR_SIZE];
+    ShuffleLines( rows );
+    ShuffleLines( cols );
+    size_t digits[Grid::SECTOR_SIZE + 1];
+    for ( size_t d = 0; d <= Grid::SECTOR_SIZE; d++ )
+    {
+        digits[d] = d;
+    }
+    Shuffle( digits + 1, Grid::SECTOR_SIZE );
+    const bool transpose = ( Below( 2 ) == 1 );
+
+    for ( size_t y = 0; y < Grid::SECTOR_SIZE; y++ )
+    {
+        for ( size_t x = 0; x < Grid::SECTOR_SIZE; x++ )
+        {
+            size_t from = transpose
+                ? cols[x] * Grid::SECTOR_SIZE + rows[y]
+                : rows[y] * Grid::SECTOR_SIZE + cols[x];
+            GridCell &cell = g[y * Grid::SECTOR_SIZE + x];
+            cell.value = digits[solution.GetValue( from )];
+            cell.given = 1;
+            cell.marks = 0;
+        }
+    }
+}
+
+void GridRandomizer::Fill( Grid *grids, size_t count )
+{
+    for ( size_t n = 0; n < count; n++ )
+    {
+        Fill( grids[n] );
+    }
+}
+
+uint32_t GridRandomizer::Below( uint32_t n )
+{
+    // reject the top partial range so every value is equally likely
+    uint32_t limit = 0xFFFFFFFFu - ( 0xFFFFFFFFu % n + 1 ) % n;
+    uint32_t r;
+    do
+    {
+        r = static_cast<uint32_t>( _engine() );
+    } while ( r > limit );
+    return r % n;
+}
+
+void GridRandomizer::Shuffle( size_t *items, size_t n )
+{
+    for ( size_t k = n; k > 1; k-- )
+    {
+        std::swap( items[k - 1], items[Below( k )] );
+    }
+}
+
+void GridRandomizer::ShuffleLines( size_t *lines )
+{
+    size_t bands[3] = { 0, 1, 2 };
+    Shuffle( bands, 3 );
+    for ( size_t b = 0; b < 3; b++ )
+    {
+        size_t within[3] = { 0, 1, 2 };
+        Shuffle( within, 3 );
+        for ( size_t k = 0; k < 3; k++ )
+        {
+            lines[b * 3 + k] = bands[b] * 3 + within[k];
+        }
+    }
+}
+
+bool GridRandomizer::FillFrom( CandidateGrid &g, CandidateGrid &result )
+{
+    if ( !g.PlaceSingles() )
+    {
+        return false;
+    }
+    if ( g.IsSolved() )
+    {
+        result = g;
+        return true;
+    }
+
+    // fewest candidates, ties broken at random
+    Bitboard open = g.GetUnsolved();
+    size_t cell = 0;
+    unsigned best = 10;
+    unsigned ties = 0;
+    while ( open.Any() )
+    {
+        size_t i = open.PopFirst();
+        unsigned count = __builtin_popcount( g.GetCandidates( i ) );
+        if ( count < best )
+        {
+            best = count;
+            cell = i;
+            ties = 1;
+        }
+        else if ( count == best && Below( ++ties ) == 0 )
+        {
+            cell = i;
+        }
+    }
+
+    // try the candidates in random order
+    int values[9];
+    size_t n = 0;
+    for ( unsigned short left = g.GetCandidates( cell ); left;
+          left &= left - 1 )
+    {
+        values[n++] = __builtin_ctz( left ) + 1;
+    }
+    for ( size_t k = n; k > 1; k-- )
+    {
+        std::swap( values[k - 1], values[Below( k )] );
+    }
+    for ( size_t k = 0; k < n; k++ )
+    {
+        CandidateGrid next( g );
+        if ( next.Place( cell, values[k] ) && FillFrom( next, result ) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
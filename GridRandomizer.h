@@ -0,0 +1,103 @@
+#ifndef SUDOKU_GRID_RANDOMIZER_H
+#define SUDOKU_GRID_RANDOMIZER_H
+
+#include <cstddef>
+#include <random>
+#include <stdint.h>
+
+namespace Sudoku
+{
+
+class CandidateGrid;
+class Grid;
+
+/**
+ * Fast generator of random solved grids
+ * Fills a blank board by randomized backtracking over a CandidateGrid: the
+ * Cell with the fewest candidates is tried with its candidates in random
+ * order, and singles are placed between guesses, so almost every grid is
+ * found without backing out at all.
+ *
+ * The grid found is then relabelled and rearranged by a random symmetry of
+ * the board: a permutation of the digits, of the bands and the rows within
+ * each band, of the stacks and the columns within each stack, and a
+ * transpose.  Grids which are the same up to those symmetries are then
+ * equally likely, but the grids are not uniform over all solved grids: the
+ * search finds some classes of equivalent grids more often than others,
+ * which is no concern for generating Puzzles.
+ *
+ * The sequence of grids only depends on the seed (the random number engine
+ * and the way numbers are drawn from it are fully specified), so a seed
+ * reproduces the same grids on any platform.
+ */
+class GridRandomizer
+{
+public:
+    /**
+     * Create a generator
+     * @param seed Seed of the random sequence
+     */
+    explicit GridRandomizer( uint32_t seed );
+
+    /**
+     * Restart the random sequence
+     * @param seed Seed of the random sequence
+     * @post the next grids are the same as from GridRandomizer( seed )
+     */
+    void Seed( uint32_t seed ) { _engine.seed( seed ); }
+
+    /**
+     * Replace a Grid with the next random solved grid
+     * @param g Grid to fill
+     * @post every record has a value which is given, nothing is marked
+     */
+    void Fill( Grid &g );
+
+    /**
+     * Fill a buffer of Grids
+     * Same as calling Fill on each Grid in order, without any allocation
+     * @param grids First Grid of the buffer
+     * @param count Number of Grids in the buffer
+     */
+    void Fill( Grid *grids, size_t count );
+
+    /**
+     * Draw a random number
+     * @param n Upper bound
+     * @pre n > 0
+     * @return number in range [0,n), every value equally likely
+     */
+    uint32_t Below( uint32_t n );
+
+private:
+    GridRandomizer( const GridRandomizer & );
+    GridRandomizer & operator=( const GridRandomizer & );
+
+    /**
+     * Randomized search for a solution
+     * @param g Board to fill, may be changed
+     * @param result Set to the solution
+     * @return false if g has no solution
+     */
+    bool FillFrom( CandidateGrid &g, CandidateGrid &result );
+
+    /**
+     * Put items in random order, every order equally likely
+     * @param items Items to shuffle
+     * @param n Number of items
+     */
+    void Shuffle( size_t *items, size_t n );
+
+    /**
+     * Draw a random order of the rows (or columns) which keeps each band
+     * (or stack) together
+     * @param lines Set to the 9 line numbers in range [0,8] in new order
+     */
+    void ShuffleLines( size_t *lines );
+
+    std::mt19937 _engine;
+};
+
+}
+
+#endif
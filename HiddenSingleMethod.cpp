@@ -0,0 +1,73 @@
+#include "HiddenSingleMethod.h"
+
+namespace Sudoku
+{
+
+HiddenSingleMethod::HiddenSingleMethod( std::shared_ptr<Cell> c,
+                                        unsigned mark,
+                                        const Puzzle::View &sector )
+    : _cell( c ), _mark( mark )
+{
+    if ( mark < 1 || mark > 9 )
+    {
+        throw std::logic_error(
+            "Hidden Single Method requires a mark from 1 to 9." );
+    }
+    for ( Puzzle::View::iterator it = sector.begin();
+          it != sector.end();
+          ++it )
+    {
+        if ( *it != c )
+        {
+            _others.push_back( *it );
+        }
+    }
+}
+
+void HiddenSingleMethod::ExecuteForward()
+{
+    _removed = _cell->GetMarkContainer();
+    _removed.reset( _mark );
+    _cell->SetGuess( _mark );
+    _cell->ClearMarks();
+}
+
+bool HiddenSingleMethod::VerifyForwardConditions()
+{
+    return ( _cell->CanGuess() && _cell->DisplayedValue() == 0 &&
+             _cell->GetMarkContainer()[_mark] && isHidden() );
+}
+
+void HiddenSingleMethod::ExecuteReverse()
+{
+    Cell::MarkContainer marks = _removed;
+    marks.set( _mark );
+    _cell->SetGuess( 0 );
+    _cell->SetMarkContainer( marks );
+}
+
+bool HiddenSingleMethod::VerifyReverseConditions()
+{
+    return ( _cell->CanGuess() &&
+             _cell->DisplayedValue() == static_cast<int>( _mark ) &&
+             _cell->CountMarks() == 0 && isHidden() );
+}
+
+bool HiddenSingleMethod::isHidden() const
+{
+    for ( CellArray<Units::UNIT_SIZE>::const_iterator it = _others.begin();
+          it != _others.end();
+          ++it )
+    {
+        int value = (*it)->DisplayedValue();
+        if ( value == static_cast<int>( _mark ) ||
+             ( value == 0 && (*it)->CanGuess() &&
+               (*it)->GetMarkContainer()[_mark] ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,82 @@
+#ifndef SUDOKU_HIDDEN_SINGLE_METHOD_H
+#define SUDOKU_HIDDEN_SINGLE_METHOD_H
+
+#include <memory>
+#include "SolutionMethod.h"
+#include "Cell.h"
+#include "CellArray.h"
+#include "Puzzle.h"
+#include "Units.h"
+
+namespace Sudoku
+{
+
+class HiddenSingleMethod : public SolutionMethod
+{
+public:
+    /**
+     * Create the method for a Cell which is the only place for a mark
+     * @param c Cell to guess
+     * @param mark Value to guess
+     * @param sector Unit the mark is hidden in, including c
+     */
+    HiddenSingleMethod( std::shared_ptr<Cell> c,
+                        unsigned mark,
+                        const Puzzle::View &sector );
+
+    /**
+     * This will set the mark as the guess and remove the Cell's marks
+     * @pre VerifyForwardConditions
+     * @post Cell has the mark as a guess and no marks
+     */
+    virtual void ExecuteForward();
+
+    /**
+     * Verify that the Cell has the mark and no guess
+     * Verify that no other Cell of the sector has the mark or the value
+     * @return true if the precondition holds
+     */
+    virtual bool VerifyForwardConditions();
+
+    /**
+     * Remove the guess from the Cell and mark it again, along with the marks
+     * removed by ExecuteForward
+     * @pre VerifyReverseConditions
+     * @post Cell has the mark and no guess
+     */
+    virtual void ExecuteReverse();
+
+    /**
+     * Verify that the Cell has the mark as a guess and no marks
+     * Verify that no other Cell of the sector has the mark or the value
+     * @return true if the precondition holds
+     */
+    virtual bool VerifyReverseConditions();
+
+    /**
+     * Do nothing
+     */
+    virtual ~HiddenSingleMethod() {}
+
+private:
+    HiddenSingleMethod( const HiddenSingleMethod & );
+    HiddenSingleMethod & operator=( const HiddenSingleMethod & );
+
+    /**
+     * Check that no other Cell of the sector has the mark or the value
+     */
+    bool isHidden() const;
+
+    /// Cell we are looking at
+    std::shared_ptr<Cell> _cell;
+    /// The mark we are using
+    unsigned _mark;
+    /// The rest of the sector
+    CellArray<Units::UNIT_SIZE> _others;
+    /// Marks other than _mark removed from _cell by ExecuteForward
+    Cell::MarkContainer _removed;
+};
+
+}
+
+#endif
@@ -16,6 +16,20 @@ public:
      */
     virtual bool ImportFromFile( const std::string &filename ) = 0;
 
+    /**
+     * Save the game in progress, with its undo/redo history
+     * @param filename The file to write
+     * @return Success or failure
+     */
+    virtual bool SaveGame( const std::string &filename ) = 0;
+
+    /**
+     * Resume a game written by SaveGame
+     * @param filename The file to load
+     * @return Success or failure
+     */
+    virtual bool LoadGame( const std::string &filename ) = 0;
+
     /**
      * Reset the puzzle pointer and clear what exists
      */
@@ -0,0 +1,44 @@
+#ifndef SUDOKU_ISOLUTION_COUNTER_H
+#define SUDOKU_ISOLUTION_COUNTER_H
+
+#include <cstddef>
+#include <memory>
+
+namespace Sudoku
+{
+
+class Grid;
+class Puzzle;
+
+/**
+ * Interface which can tell how many solutions a Puzzle has
+ * Only the givens count (Cells displaying their correct value), guesses and
+ * marks are ignored.  Counting stops as soon as the limit is reached, so a
+ * uniqueness check is CountSolutions( p, 2 ) == 1.
+ */
+class ISolutionCounter
+{
+public:
+    /**
+     * Count the solutions of a Puzzle
+     * @param p Puzzle to check, it is only read (never copied or changed)
+     * @param limit Stop counting once this many solutions are found
+     * @return number of solutions, at most limit (0 if the givens conflict)
+     */
+    virtual size_t CountSolutions( std::shared_ptr<const Puzzle> p,
+                                   size_t limit ) = 0;
+
+    /**
+     * Count the solutions of a Grid
+     * @param g Grid to check, only values marked as given count
+     * @param limit Stop counting once this many solutions are found
+     * @return number of solutions, at most limit (0 if the givens conflict)
+     */
+    virtual size_t CountSolutions( const Grid &g, size_t limit ) = 0;
+
+    virtual ~ISolutionCounter() {}
+};
+
+}
+
+#endif
@@ -0,0 +1,76 @@
+#include "LinkGraph.h"
+
+#include <cstring>
+
+namespace Sudoku
+{
+
+LinkGraph::LinkGraph()
+    : _bivalue( Bitboard::None() )
+{
+    std::memset( _candidates, 0, sizeof( _candidates ) );
+    for ( size_t d = 0; d < Units::UNIT_SIZE; d++ )
+    {
+        _cells[d] = Bitboard::None();
+        for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+        {
+            _conjugates[d][i] = Bitboard::None();
+        }
+    }
+}
+
+unsigned short LinkGraph::Update(
+    const unsigned short candidates[Units::CELL_COUNT] )
+{
+    unsigned short changed = 0;
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        unsigned short c = candidates[i] & 0x1FF;
+        if ( c == _candidates[i] )
+        {
+            continue;
+        }
+        changed |= c ^ _candidates[i];
+        _candidates[i] = c;
+        if ( __builtin_popcount( c ) == 2 )
+        {
+            _bivalue.Set( i );
+        }
+        else
+        {
+            _bivalue.Reset( i );
+        }
+    }
+    for ( unsigned short left = changed; left; left &= left - 1 )
+    {
+        rebuild( __builtin_ctz( left ) );
+    }
+    return changed;
+}
+
+void LinkGraph::rebuild( size_t d )
+{
+    Bitboard &cells = _cells[d];
+    cells = Bitboard::None();
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        if ( _candidates[i] & ( 1 << d ) )
+        {
+            cells.Set( i );
+        }
+        _conjugates[d][i] = Bitboard::None();
+    }
+    for ( size_t u = 0; u < Units::UNIT_COUNT; u++ )
+    {
+        Bitboard places = Units::UNIT_BOARDS[u] & cells;
+        if ( places.Count() == 2 )
+        {
+            size_t a = places.PopFirst();
+            size_t b = places.First();
+            _conjugates[d][a].Set( b );
+            _conjugates[d][b].Set( a );
+        }
+    }
+}
+
+}
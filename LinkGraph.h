@@ -0,0 +1,93 @@
+#ifndef SUDOKU_LINK_GRAPH_H
+#define SUDOKU_LINK_GRAPH_H
+
+#include <cstddef>
+
+#include "Bitboard.h"
+#include "Units.h"
+
+namespace Sudoku
+{
+
+/**
+ * Links between the candidates of a board, for the chain Methods
+ * A strong link joins two candidates of which at least one is true: the
+ * only two places of a digit in a unit (a conjugate pair), or the only two
+ * candidates of a Cell (a bivalue Cell).  A weak link joins two candidates
+ * which cannot both be true: one digit in two peers, or two digits of one
+ * Cell.  Weak links are read straight from the peers and the candidate
+ * Cells of each digit, only the conjugate pairs are stored.
+ *
+ * Update compares the candidates with the last ones and only rebuilds the
+ * digits which changed, so following a solve costs little more than the
+ * comparison.
+ *
+ * Candidates use bit value - 1, like CandidateGrid.
+ */
+class LinkGraph
+{
+public:
+    LinkGraph();
+
+    /**
+     * Follow the candidates of a board
+     * @param candidates Candidates of each Cell, 0 for Cells with a value
+     * @return Digits whose candidate Cells changed, bit value - 1
+     */
+    unsigned short Update( const unsigned short candidates[Units::CELL_COUNT] );
+
+    /**
+     * Candidates of a Cell as of the last Update
+     */
+    unsigned short GetCandidates( size_t i ) const { return _candidates[i]; }
+
+    /**
+     * Cells with a digit as a candidate
+     * @param digit Digit in range [1,9]
+     */
+    const Bitboard& GetCells( int digit ) const { return _cells[digit - 1]; }
+
+    /**
+     * Cells with a strong link to a Cell on a digit (at most one per unit)
+     * @param digit Digit in range [1,9]
+     * @param i Cell index
+     */
+    const Bitboard& GetConjugates( int digit, size_t i ) const
+    {
+        return _conjugates[digit - 1][i];
+    }
+
+    /**
+     * Cells with a weak link to a Cell on a digit, its peers with it
+     * @param digit Digit in range [1,9]
+     * @param i Cell index
+     */
+    Bitboard GetWeak( int digit, size_t i ) const
+    {
+        return Units::PEER_BOARDS[i] & _cells[digit - 1];
+    }
+
+    /**
+     * Cells with exactly two candidates
+     */
+    const Bitboard& GetBivalue() const { return _bivalue; }
+
+private:
+    LinkGraph( const LinkGraph & );
+    LinkGraph & operator=( const LinkGraph & );
+
+    /**
+     * Find the candidate Cells and conjugate pairs of a digit again
+     * @param d Digit - 1
+     */
+    void rebuild( size_t d );
+
+    unsigned short _candidates[Units::CELL_COUNT];
+    Bitboard _cells[Units::UNIT_SIZE];
+    Bitboard _conjugates[Units::UNIT_SIZE][Units::CELL_COUNT];
+    Bitboard _bivalue;
+};
+
+}
+
+#endif
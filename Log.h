@@ -1,13 +1,28 @@
 /**
  * Logger class from the web
  * @url http://drdobbs.com/cpp/201804215
+ *
+ * Changes from the original:
+ *  - Levels above FILELOG_MAX_LEVEL compile to nothing, by default that is
+ *    logDEBUG4 but only logWARNING when NDEBUG is set (release builds)
+ *  - Every source file is a module with its own level which can be changed
+ *    at runtime (see LogModule), modules default to FILELog::ReportingLevel
+ *  - Messages are written by a background thread in batches with one
+ *    fflush per batch, see Output2FILE
  */
 
 #ifndef __LOG_H__
 #define __LOG_H__
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 #include <stdio.h>
 
 inline std::string NowTime();
@@ -21,6 +36,7 @@ public:
     Log();
     virtual ~Log();
     std::ostringstream& Get(TLogLevel level = logINFO);
+    std::ostringstream& Get(TLogLevel level, const std::string& module);
 public:
     static TLogLevel& ReportingLevel();
     static std::string ToString(TLogLevel level);
@@ -46,6 +62,13 @@ std::ostringstream& Log<T>::Get(TLogLevel level)
     return os;
 }
 
+template <typename T>
+std::ostringstream& Log<T>::Get(TLogLevel level, const std::string& module)
+{
+    Get(level) << "[" << module << "] ";
+    return os;
+}
+
 template <typename T>
 Log<T>::~Log()
 {
@@ -90,11 +113,35 @@ TLogLevel Log<T>::FromString(const std::string& level)
     return logINFO;
 }
 
+/**
+ * Writes log messages to a FILE
+ * By default messages are queued and a background thread writes whatever
+ * has piled up with one fwrite and one fflush, so logging never waits on
+ * the stream.  The queue is flushed at exit, call Flush() before closing or
+ * changing the Stream.
+ */
 class Output2FILE
 {
 public:
     static FILE*& Stream();
     static void Output(const std::string& msg);
+    /// Write every queued message now
+    static void Flush();
+    /// Set to false to write each message right away (before logging)
+    static bool& Async();
+private:
+    struct Writer
+    {
+        /// Held while writing to the Stream, taken before queueLock
+        std::mutex streamLock;
+        std::mutex queueLock;
+        std::condition_variable ready;
+        std::string queue;
+    };
+    static Writer& GetWriter();
+    static void Run();
+    /// Write one batch, streamLock must be held
+    static void WriteQueued();
 };
 
 inline FILE*& Output2FILE::Stream()
@@ -103,15 +150,90 @@ inline FILE*& Output2FILE::Stream()
     return pStream;
 }
 
-inline void Output2FILE::Output(const std::string& msg)
-{   
+inline bool& Output2FILE::Async()
+{
+    static bool async = true;
+    return async;
+}
+
+inline Output2FILE::Writer& Output2FILE::GetWriter()
+{
+    // never destroyed so messages logged during static destruction are safe,
+    // the thread is detached and whatever is left is flushed at exit
+    static Writer* writer = 0;
+    static std::once_flag started;
+    struct Start
+    {
+        static void Once()
+        {
+            writer = new Writer;
+            std::thread(&Output2FILE::Run).detach();
+            atexit(&Output2FILE::Flush);
+        }
+    };
+    std::call_once(started, &Start::Once);
+    return *writer;
+}
+
+inline void Output2FILE::Run()
+{
+    Writer& w = GetWriter();
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(w.queueLock);
+            while (w.queue.empty())
+                w.ready.wait(lock);
+        }
+        std::lock_guard<std::mutex> stream(w.streamLock);
+        WriteQueued();
+    }
+}
+
+inline void Output2FILE::WriteQueued()
+{
+    Writer& w = GetWriter();
+    std::string batch;
+    {
+        std::lock_guard<std::mutex> lock(w.queueLock);
+        batch.swap(w.queue);
+    }
     FILE* pStream = Stream();
-    if (!pStream)
+    if (!pStream || batch.empty())
         return;
-    fprintf(pStream, "%s", msg.c_str());
+    fwrite(batch.data(), 1, batch.size(), pStream);
     fflush(pStream);
 }
 
+inline void Output2FILE::Flush()
+{
+    std::lock_guard<std::mutex> stream(GetWriter().streamLock);
+    WriteQueued();
+}
+
+inline void Output2FILE::Output(const std::string& msg)
+{   
+    if (!Async())
+    {
+        FILE* pStream = Stream();
+        if (!pStream)
+            return;
+        fprintf(pStream, "%s", msg.c_str());
+        fflush(pStream);
+        return;
+    }
+    Writer& w = GetWriter();
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(w.queueLock);
+        wasEmpty = w.queue.empty();
+        w.queue += msg;
+    }
+    // the writer only sleeps on an empty queue
+    if (wasEmpty)
+        w.ready.notify_one();
+}
+
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32__)
 #   if defined (BUILDING_FILELOG_DLL)
 #       define FILELOG_DECLSPEC   __declspec (dllexport)
@@ -127,14 +249,160 @@ inline void Output2FILE::Output(const std::string& msg)
 class FILELOG_DECLSPEC FILELog : public Log<Output2FILE> {};
 //typedef Log<Output2FILE> FILELog;
 
+/**
+ * Runtime level of one module (a source file)
+ * A module follows FILELog::ReportingLevel() until a level is set for it by
+ * name, which can be done before the module logs anything, e.g.
+ *   LogModule::Configure("MethodSolver=DEBUG,GameManager=WARNING");
+ */
+class LogModule
+{
+public:
+    /**
+     * Register a module
+     * @param file Source file name, the module name is the file name without
+     *        directories and extension
+     */
+    explicit LogModule(const char* file);
+
+    TLogLevel Level() const
+    {
+        // checked by every FILE_LOG on any thread, set rarely under the lock
+        int level = _level.load(std::memory_order_relaxed);
+        return level < 0 ? FILELog::ReportingLevel()
+                         : static_cast<TLogLevel>(level);
+    }
+
+    const std::string& Name() const { return _name; }
+
+    /**
+     * Set the level of a module, also applies if it registers later
+     */
+    static void SetLevel(const std::string& name, TLogLevel level);
+
+    /**
+     * Make every module follow FILELog::ReportingLevel() again
+     */
+    static void ResetLevels();
+
+    /**
+     * Set levels from a list like "Module=LEVEL,Module=LEVEL"
+     * @param spec List to parse, NULL does nothing (e.g. from getenv)
+     */
+    static void Configure(const char* spec);
+
+private:
+    LogModule(const LogModule&);
+    LogModule& operator =(const LogModule&);
+
+    struct Registry
+    {
+        std::mutex lock;
+        std::map<std::string, int> levels;
+        std::vector<LogModule*> modules;
+    };
+    static Registry& GetRegistry();
+
+    std::string _name;
+    /// Level of this module, -1 to follow FILELog::ReportingLevel()
+    std::atomic<int> _level;
+};
+
+inline LogModule::LogModule(const char* file)
+    : _name(file), _level(-1)
+{
+    std::string::size_type slash = _name.find_last_of("/\\");
+    if (slash != std::string::npos)
+        _name.erase(0, slash + 1);
+    std::string::size_type dot = _name.find('.');
+    if (dot != std::string::npos)
+        _name.erase(dot);
+
+    Registry& r = GetRegistry();
+    std::lock_guard<std::mutex> lock(r.lock);
+    std::map<std::string, int>::iterator it = r.levels.find(_name);
+    if (it != r.levels.end())
+        _level.store(it->second, std::memory_order_relaxed);
+    r.modules.push_back(this);
+}
+
+inline LogModule::Registry& LogModule::GetRegistry()
+{
+    // never destroyed, modules may log during static destruction
+    static Registry* registry = new Registry;
+    return *registry;
+}
+
+inline void LogModule::SetLevel(const std::string& name, TLogLevel level)
+{
+    Registry& r = GetRegistry();
+    std::lock_guard<std::mutex> lock(r.lock);
+    r.levels[name] = level;
+    for (std::vector<LogModule*>::iterator it = r.modules.begin();
+         it != r.modules.end(); ++it)
+    {
+        if ((*it)->_name == name)
+            (*it)->_level.store(level, std::memory_order_relaxed);
+    }
+}
+
+inline void LogModule::ResetLevels()
+{
+    Registry& r = GetRegistry();
+    std::lock_guard<std::mutex> lock(r.lock);
+    r.levels.clear();
+    for (std::vector<LogModule*>::iterator it = r.modules.begin();
+         it != r.modules.end(); ++it)
+    {
+        (*it)->_level.store(-1, std::memory_order_relaxed);
+    }
+}
+
+inline void LogModule::Configure(const char* spec)
+{
+    if (!spec)
+        return;
+    std::istringstream in(spec);
+    std::string entry;
+    while (std::getline(in, entry, ','))
+    {
+        std::string::size_type eq = entry.find('=');
+        if (eq == std::string::npos || eq == 0)
+        {
+            FILELog().Get(logWARNING) << "Bad log level setting '" << entry
+                                      << "'";
+            continue;
+        }
+        SetLevel(entry.substr(0, eq), FILELog::FromString(entry.substr(eq + 1)));
+    }
+}
+
+namespace
+{
+// one module per source file, created the first time the file logs
+inline LogModule& FileLogModule()
+{
+#ifdef FILELOG_MODULE
+    static LogModule module(FILELOG_MODULE);
+#else
+    static LogModule module(__BASE_FILE__);
+#endif
+    return module;
+}
+}
+
 #ifndef FILELOG_MAX_LEVEL
-#define FILELOG_MAX_LEVEL logDEBUG4
+#   ifdef NDEBUG
+#       define FILELOG_MAX_LEVEL logWARNING
+#   else
+#       define FILELOG_MAX_LEVEL logDEBUG4
+#   endif
 #endif
 
 #define FILE_LOG(level) \
     if (level > FILELOG_MAX_LEVEL) ;\
-    else if (level > FILELog::ReportingLevel() || !Output2FILE::Stream()) ; \
-    else FILELog().Get(level)
+    else if (level > FileLogModule().Level() || !Output2FILE::Stream()) ; \
+    else FILELog().Get(level, FileLogModule().Name())
 
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32__)
 
@@ -160,13 +428,17 @@ inline std::string NowTime()
 
 inline std::string NowTime()
 {
-    char buffer[11];
-    time_t t;
-    time(&t);
-    tm r = {0};
-    strftime(buffer, sizeof(buffer), "%X", localtime_r(&t, &r));
+    // the time of day only changes once a second, keep it per thread
+    static __thread time_t second = -1;
+    static __thread char buffer[11];
     struct timeval tv;
     gettimeofday(&tv, 0);
+    if (tv.tv_sec != second)
+    {
+        second = tv.tv_sec;
+        tm r = {0};
+        strftime(buffer, sizeof(buffer), "%X", localtime_r(&second, &r));
+    }
     char result[100] = {0};
     std::sprintf(result, "%s.%03ld", buffer, (long)tv.tv_usec / 1000); 
     return result;
@@ -0,0 +1,54 @@
+#include "MappedFile.h"
+
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Sudoku
+{
+
+MappedFile::MappedFile( const std::string &filename )
+    : _data( NULL ), _size( 0 )
+{
+    int fd = open( filename.c_str(), O_RDONLY );
+    if ( fd < 0 )
+    {
+        throw std::runtime_error( "Cannot open " + filename );
+    }
+    struct stat st;
+    bool mapped = false;
+    if ( fstat( fd, &st ) == 0 )
+    {
+        _size = static_cast<size_t>( st.st_size );
+        mapped = ( _size == 0 );
+        if ( _size > 0 )
+        {
+            void *data = mmap( NULL, _size, PROT_READ, MAP_PRIVATE, fd, 0 );
+            if ( data != MAP_FAILED )
+            {
+                _data = static_cast<const char *>( data );
+                // files are mostly scanned front to back
+                madvise( data, _size, MADV_SEQUENTIAL );
+                mapped = true;
+            }
+        }
+    }
+    close( fd );
+    if ( !mapped )
+    {
+        throw std::runtime_error( "Cannot map " + filename );
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if ( _data )
+    {
+        munmap( const_cast<char *>( _data ), _size );
+    }
+}
+
+}
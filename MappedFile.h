@@ -0,0 +1,41 @@
+#ifndef SUDOKU_MAPPED_FILE_H
+#define SUDOKU_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace Sudoku
+{
+
+/**
+ * Read-only mapping of a whole file, unmapped when it goes away
+ * Pages are only read in as they are touched, nothing is copied.
+ */
+class MappedFile
+{
+public:
+    /**
+     * Map a file
+     * @param filename File to map
+     * @throw std::runtime_error if it cannot be opened or mapped
+     * @post an empty file maps to Data() == NULL and Size() == 0
+     */
+    explicit MappedFile( const std::string &filename );
+
+    ~MappedFile();
+
+    const char *Data() const { return _data; }
+
+    size_t Size() const { return _size; }
+
+private:
+    MappedFile( const MappedFile & );
+    MappedFile & operator=( const MappedFile & );
+
+    const char *_data;
+    size_t _size;
+};
+
+}
+
+#endif
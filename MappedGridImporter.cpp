@@ -0,0 +1,179 @@
+#include "MappedGridImporter.h"
+#include "MappedFile.h"
+
+#include <cstring>
+
+#include "Log.h"
+
+namespace Sudoku
+{
+
+namespace
+{
+
+bool IsValue( char c )
+{
+    return ( c == '.' || ( c >= '0' && c <= '9' ) );
+}
+
+bool IsSpace( char c )
+{
+    return ( c == ' ' || c == '\t' || c == '\r' );
+}
+
+/**
+ * Check if the first non-whitespace character of a line is a value
+ */
+bool StartsWithValue( const char *begin, const char *end )
+{
+    for ( const char *c = begin; c != end; ++c )
+    {
+        if ( !IsSpace( *c ) )
+        {
+            return IsValue( *c );
+        }
+    }
+    return false;
+}
+
+/**
+ * Convert 81 characters which should all be values
+ * No branches on the characters, so this loop vectorizes
+ * @param s At least 81 characters
+ * @param values Where the values go, garbage if this fails
+ * @return false if any character was not a value
+ */
+bool ScanLine( const char *s, unsigned char *values )
+{
+    unsigned char bad = 0;
+    for ( size_t i = 0; i < Grid::ARRAY_SIZE; i++ )
+    {
+        unsigned char c = s[i];
+        unsigned char v = c - '0';
+        unsigned char dot = ( c == '.' );
+        bad |= ( v > 9 ) & !dot;
+        values[i] = dot ? 0 : v;
+    }
+    return bad == 0;
+}
+
+}
+
+void GridRecord::CopyTo( Grid &g ) const
+{
+    for ( size_t i = 0; i < Grid::ARRAY_SIZE; i++ )
+    {
+        g[i].value = values[i];
+        g[i].given = ( values[i] != 0 );
+        g[i].marks = 0;
+    }
+}
+
+size_t MappedGridImporter::Import( const std::string &filename )
+{
+    MappedFile file( filename );
+    return Parse( file.Data(), file.Size() );
+}
+
+size_t MappedGridImporter::Parse( const char *data, size_t size )
+{
+    _records.clear();
+    _malformed.clear();
+    _malformedPositions.clear();
+    // most files are one Puzzle per line, this is rarely short
+    _records.reserve( size / ( Grid::ARRAY_SIZE + 1 ) + 1 );
+
+    GridRecord current;
+    size_t filled = 0;
+    size_t lineNumber = 0;
+    size_t startLine = 0;
+    const char *end = data + size;
+    const char *line = data;
+    while ( line < end )
+    {
+        const char *eol = static_cast<const char *>(
+            std::memchr( line, '\n', end - line ) );
+        if ( !eol )
+        {
+            eol = end;
+        }
+        ++lineNumber;
+
+        if ( filled == 0 )
+        {
+            // fast path, a whole Puzzle at the start of the line
+            if ( static_cast<size_t>( eol - line ) >= Grid::ARRAY_SIZE )
+            {
+                _records.push_back( GridRecord() );
+                if ( ScanLine( line, _records.back().values ) )
+                {
+                    line = eol + 1;
+                    continue;
+                }
+                _records.pop_back();
+            }
+            if ( !StartsWithValue( line, eol ) )
+            {
+                line = eol + 1;
+                continue;
+            }
+            startLine = lineNumber;
+        }
+
+        const bool starting = ( filled == 0 );
+        for ( const char *c = line; c != eol; ++c )
+        {
+            if ( IsSpace( *c ) )
+            {
+                continue;
+            }
+            if ( !IsValue( *c ) )
+            {
+                AddMalformed( startLine );
+                filled = 0;
+                break;
+            }
+            current.values[filled] = ( *c == '.' ) ? 0 : *c - '0';
+            if ( ++filled == Grid::ARRAY_SIZE )
+            {
+                _records.push_back( current );
+                filled = 0;
+                // anything after a complete Puzzle is a comment
+                break;
+            }
+        }
+        if ( starting && filled > Grid::SECTOR_SIZE )
+        {
+            // more than a row of the 9x9 layout but not a whole line, so
+            // the next line would be merged into this Puzzle
+            AddMalformed( startLine );
+            filled = 0;
+        }
+        line = eol + 1;
+    }
+    if ( filled != 0 )
+    {
+        AddMalformed( startLine );
+    }
+
+    FILE_LOG(logINFO) << "Read " << _records.size() << " puzzles, "
+                      << _malformed.size() << " malformed.";
+    return _records.size();
+}
+
+void MappedGridImporter::AddMalformed( size_t line )
+{
+    _malformedPositions.push_back( _records.size() + _malformed.size() );
+    _malformed.push_back( line );
+}
+
+void MappedGridImporter::CopyTo( std::vector<Grid> &grids ) const
+{
+    grids.resize( _records.size() );
+    for ( size_t i = 0; i < _records.size(); i++ )
+    {
+        _records[i].CopyTo( grids[i] );
+    }
+}
+
+}
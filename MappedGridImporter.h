@@ -0,0 +1,102 @@
+#ifndef SUDOKU_MAPPED_GRID_IMPORTER_H
+#define SUDOKU_MAPPED_GRID_IMPORTER_H
+
+#include <string>
+#include <vector>
+
+#include "Grid.h"
+
+namespace Sudoku
+{
+
+/**
+ * A Puzzle as read from a file: 81 values, 0 for blank (81 bytes)
+ */
+struct GridRecord
+{
+    unsigned char values[Grid::ARRAY_SIZE];
+
+    /**
+     * Fill a Grid with the values as givens, nothing is marked
+     * @param g Grid to overwrite
+     */
+    void CopyTo( Grid &g ) const;
+};
+
+/**
+ * Bulk importer for large files of Puzzles
+ * Reads the same layouts as GridListImporter, but maps the file instead of
+ * streaming it and writes straight into one array of GridRecords, so
+ * nothing is allocated per Puzzle.  The common case of a line of exactly
+ * 81 values is checked and converted without branching on each character,
+ * which the compiler can vectorize.
+ *
+ * A malformed Puzzle (an unexpected character, a line of more than 9 but
+ * fewer than 81 values, or the file ending part way through) does not stop
+ * the import: the line it started on and its place
+ * among all the Puzzles of the file are reported, and reading goes on with
+ * the next line.
+ */
+class MappedGridImporter
+{
+public:
+    MappedGridImporter() {}
+
+    /**
+     * Read every Puzzle from a file
+     * @param filename File to map
+     * @return Number of Puzzles read
+     * @throw std::runtime_error only if the file cannot be opened or mapped
+     * @post GetRecords has the Puzzles in file order, GetMalformedLines
+     *       the lines where skipped Puzzles started and
+     *       GetMalformedPositions where they were in the file
+     */
+    size_t Import( const std::string &filename );
+
+    /**
+     * Read every Puzzle from memory, see Import
+     * @param data Text of the file
+     * @param size Bytes of text
+     * @return Number of Puzzles read
+     */
+    size_t Parse( const char *data, size_t size );
+
+    const std::vector<GridRecord>& GetRecords() const { return _records; }
+
+    /// Line numbers (from 1) of malformed Puzzles, in file order
+    const std::vector<size_t>& GetMalformedLines() const { return _malformed; }
+
+    /**
+     * Positions of malformed Puzzles among every Puzzle of the file, good or
+     * not, in file order (e.g. {1} for good, malformed, good)
+     * Output in input order puts a placeholder at each of these
+     */
+    const std::vector<size_t>& GetMalformedPositions() const
+    {
+        return _malformedPositions;
+    }
+
+    /**
+     * Expand the records into Grids
+     * @param grids Overwritten with one Grid per record
+     */
+    void CopyTo( std::vector<Grid> &grids ) const;
+
+private:
+    MappedGridImporter( const MappedGridImporter & );
+    MappedGridImporter & operator=( const MappedGridImporter & );
+
+    /**
+     * Report a malformed Puzzle after the records read so far
+     * @param line Line number the Puzzle started on
+     */
+    void AddMalformed( size_t line );
+
+    std::vector<GridRecord> _records;
+    std::vector<size_t> _malformed;
+    std::vector<size_t> _malformedPositions;
+};
+
+}
+
+#endif
@@ -0,0 +1,64 @@
+#include "MethodArena.h"
+
+namespace Sudoku
+{
+
+const size_t MethodArena::CHUNK_SIZE;
+const size_t MethodArena::ALIGNMENT;
+
+MethodArena::~MethodArena()
+{
+    for ( std::vector<Chunk>::iterator it = _chunks.begin();
+          it != _chunks.end();
+          ++it )
+    {
+        ::operator delete( it->memory );
+    }
+}
+
+void * MethodArena::Allocate( size_t bytes )
+{
+    bytes = ( bytes + ALIGNMENT - 1 ) & ~( ALIGNMENT - 1 );
+    // chunks too small for this are skipped until the next Reset
+    for ( ; _chunk < _chunks.size(); ++_chunk, _used = 0 )
+    {
+        if ( _chunks[_chunk].size - _used >= bytes )
+        {
+            void *memory = _chunks[_chunk].memory + _used;
+            _used += bytes;
+            return memory;
+        }
+    }
+    _chunks.reserve( _chunks.size() + 1 );
+    Chunk c;
+    c.size = bytes > CHUNK_SIZE ? bytes : CHUNK_SIZE;
+    c.memory = static_cast<char *>( ::operator new( c.size ) );
+    _chunks.push_back( c );
+    _chunk = _chunks.size() - 1;
+    _used = bytes;
+    return c.memory;
+}
+
+size_t MethodArena::Used() const
+{
+    size_t used = _used;
+    for ( size_t k = 0; k < _chunk && k < _chunks.size(); k++ )
+    {
+        used += _chunks[k].size;
+    }
+    return used;
+}
+
+size_t MethodArena::Capacity() const
+{
+    size_t capacity = 0;
+    for ( std::vector<Chunk>::const_iterator it = _chunks.begin();
+          it != _chunks.end();
+          ++it )
+    {
+        capacity += it->size;
+    }
+    return capacity;
+}
+
+}
@@ -0,0 +1,186 @@
+#ifndef SUDOKU_METHOD_ARENA_H
+#define SUDOKU_METHOD_ARENA_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace Sudoku
+{
+
+/**
+ * Bump allocator for the SolutionMethods of one solve
+ * Memory is handed out from large chunks and never freed one object at a
+ * time; Reset gives all of it back at once by rewinding to the first chunk.
+ * Chunks are kept, so after the first solve a solver using the same arena
+ * does not call malloc for its methods at all.
+ *
+ * SolutionMethodFactory places each method, and the shared_ptr control
+ * block that owns it, in the arena.  Releasing the last shared_ptr only runs
+ * the destructor (dropping its Cell references); Live counts the methods not
+ * yet released, which must be 0 before Reset.
+ */
+class MethodArena
+{
+public:
+    /// Bytes in each chunk, larger requests get a chunk of their own
+    static const size_t CHUNK_SIZE = 64 * 1024;
+    /// Every allocation is aligned to this
+    static const size_t ALIGNMENT = 16;
+
+    MethodArena() : _chunk( 0 ), _used( 0 ), _live( 0 ) {}
+
+    ~MethodArena();
+
+    /**
+     * Get uninitialized memory
+     * @param bytes Size wanted
+     * @return Memory aligned to ALIGNMENT, valid until Reset
+     * @throw std::bad_alloc if a new chunk cannot be allocated
+     */
+    void * Allocate( size_t bytes );
+
+    /**
+     * Release everything allocated, O(1)
+     * @pre Live() == 0, nothing allocated is used again
+     */
+    void Reset() { _chunk = 0; _used = 0; }
+
+    /// Methods created but not yet destroyed
+    size_t Live() const { return _live; }
+
+    /// Bytes handed out since the last Reset, including alignment
+    size_t Used() const;
+
+    /// Bytes held in chunks
+    size_t Capacity() const;
+
+    /**
+     * Construct a T in the arena
+     * @post Live() is one more until the object is passed to a Destroyer
+     */
+    template <class T, class A>
+    T * Create( const A &a )
+    {
+        T *t = new ( Allocate( sizeof( T ) ) ) T( a );
+        ++_live;
+        return t;
+    }
+
+    template <class T, class A, class B>
+    T * Create( const A &a, const B &b )
+    {
+        T *t = new ( Allocate( sizeof( T ) ) ) T( a, b );
+        ++_live;
+        return t;
+    }
+
+    template <class T, class A, class B, class C>
+    T * Create( const A &a, const B &b, const C &c )
+    {
+        T *t = new ( Allocate( sizeof( T ) ) ) T( a, b, c );
+        ++_live;
+        return t;
+    }
+
+    template <class T, class A, class B, class C, class D>
+    T * Create( const A &a, const B &b, const C &c, const D &d )
+    {
+        T *t = new ( Allocate( sizeof( T ) ) ) T( a, b, c, d );
+        ++_live;
+        return t;
+    }
+
+    /**
+     * shared_ptr deleter for objects made by Create, runs the destructor only
+     */
+    template <class T>
+    class Destroyer
+    {
+    public:
+        explicit Destroyer( MethodArena &arena ) : _arena( &arena ) {}
+        void operator()( T *t ) const
+        {
+            t->~T();
+            --_arena->_live;
+        }
+    private:
+        MethodArena *_arena;
+    };
+
+    /**
+     * STL allocator drawing from an arena, deallocate does nothing
+     * Given to shared_ptr so its control block goes in the arena too.
+     */
+    template <class T>
+    class Allocator
+    {
+    public:
+        typedef T value_type;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template <class U>
+        struct rebind
+        {
+            typedef Allocator<U> other;
+        };
+
+        explicit Allocator( MethodArena &arena ) : _arena( &arena ) {}
+
+        template <class U>
+        Allocator( const Allocator<U> &other ) : _arena( other.GetArena() ) {}
+
+        pointer allocate( size_type n, const void * = 0 )
+        {
+            return static_cast<pointer>( _arena->Allocate( n * sizeof( T ) ) );
+        }
+
+        void deallocate( pointer, size_type ) {}
+
+        void construct( pointer p, const T &value ) { new ( p ) T( value ); }
+
+        void destroy( pointer p ) { p->~T(); }
+
+        size_type max_size() const { return size_type( -1 ) / sizeof( T ); }
+
+        MethodArena * GetArena() const { return _arena; }
+
+        template <class U>
+        bool operator==( const Allocator<U> &other ) const
+        { return _arena == other.GetArena(); }
+
+        template <class U>
+        bool operator!=( const Allocator<U> &other ) const
+        { return _arena != other.GetArena(); }
+
+    private:
+        MethodArena *_arena;
+    };
+
+private:
+    MethodArena( const MethodArena & );
+    MethodArena & operator=( const MethodArena & );
+
+    struct Chunk
+    {
+        char *memory;
+        size_t size;
+    };
+
+    /// Every chunk, in the order they are used
+    std::vector<Chunk> _chunks;
+    /// Chunk being handed out from
+    size_t _chunk;
+    /// Bytes used in the current chunk
+    size_t _used;
+    size_t _live;
+};
+
+}
+
+#endif
@@ -1,55 +1,201 @@
 
 #include "MethodSolver.h"
+#include "LinkGraph.h"
+#include "PropagationQueue.h"
 #include "Puzzle.h"
 #include "SolverHelper.h"
 #include "IPuzzleMarker.h"
 #include "IValidator.h"
 #include "SolutionMethod.h"
+#include "SolutionMethodFactory.h"
 
-#define FILELOG_MAX_LEVEL logDEBUG4
 #include "Log.h"
 
+#include <time.h>
+
 namespace Sudoku
 {
 
 namespace
 {
 
-bool ExecuteAllMethods( SolverHelper::MethodContainer methods )
+/**
+ * Nanoseconds of a monotonic clock
+ */
+uint64_t Now()
+{
+    timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return uint64_t( ts.tv_sec ) * 1000000000u + ts.tv_nsec;
+}
+
+/**
+ * Marks of the Cells without a value
+ */
+size_t CountMarks( Puzzle &p )
+{
+    size_t marks = 0;
+    Puzzle::View all = p.GetAllView();
+    for ( Puzzle::View::iterator it = all.begin(); it != all.end(); ++it )
+    {
+        if ( (*it)->CanGuess() && (*it)->DisplayedValue() == 0 )
+        {
+            marks += (*it)->GetMarkContainer().count();
+        }
+    }
+    return marks;
+}
+
+/**
+ * Count the Methods found and the time and marks their execution takes
+ * Does nothing for NULL stats, so the clock and the marks are only read
+ * when stats are collected.
+ */
+class ExecuteScope
+{
+public:
+    ExecuteScope( Puzzle &p, SolveStats::Method *stats, size_t found )
+        : _puzzle( p ), _stats( stats ), _marks( 0 ), _start( 0 )
+    {
+        if ( _stats )
+        {
+            _stats->found += found;
+            _marks = CountMarks( _puzzle );
+            _start = Now();
+        }
+    }
+
+    ~ExecuteScope()
+    {
+        if ( _stats )
+        {
+            _stats->executeNanos += Now() - _start;
+            // Methods only ever remove marks
+            size_t marks = CountMarks( _puzzle );
+            _stats->eliminated += _marks > marks ? _marks - marks : 0;
+        }
+    }
+
+private:
+    ExecuteScope( const ExecuteScope & );
+    ExecuteScope & operator=( const ExecuteScope & );
+
+    Puzzle &_puzzle;
+    SolveStats::Method *_stats;
+    size_t _marks;
+    uint64_t _start;
+};
+
+bool ExecuteAllMethods( Puzzle &p,
+                        const SolverHelper::MethodContainer &methods,
+                        SolveStats::Method *stats )
 {
+    ExecuteScope scope( p, stats, methods.size() );
     bool anyExecuted = false;
-    for ( SolverHelper::MethodContainer::iterator it = methods.begin();
+    for ( SolverHelper::MethodContainer::const_iterator it = methods.begin();
           it != methods.end();
           ++it )
     {
-        FILE_LOG(logINFO) << "Attempting Method.";
+        FILE_LOG(logDEBUG) << "Attempting Method.";
+        if ( stats )
+        {
+            ++stats->verified;
+        }
         if ( (*it)->VerifyForwardConditions() )
         {
             (*it)->ExecuteForward();
-            FILE_LOG(logINFO) << "Executed Method.";
+            FILE_LOG(logDEBUG) << "Executed Method.";
             anyExecuted = true;
+            if ( stats )
+            {
+                ++stats->executed;
+            }
         }
     }
     return anyExecuted;
 }
 
-bool ExecuteRandomMethod( SolverHelper::MethodContainer methods )
+bool ExecuteRandomMethod( Puzzle &p, SolverHelper::MethodContainer &methods,
+                          SolveStats::Method *stats )
 {
+    ExecuteScope scope( p, stats, methods.size() );
     if ( !methods.empty() )
     {
         // scramble methods and get first one
         std::random_shuffle( methods.begin(), methods.end() );
-        FILE_LOG(logINFO) << "Attempting Method.";
+        FILE_LOG(logDEBUG) << "Attempting Method.";
+        if ( stats )
+        {
+            ++stats->verified;
+        }
         if ( methods.front()->VerifyForwardConditions() )
         {
             methods.front()->ExecuteForward();
-            FILE_LOG(logINFO) << "Executed Method.";
+            FILE_LOG(logDEBUG) << "Executed Method.";
+            if ( stats )
+            {
+                ++stats->executed;
+            }
             return true;
         }
     }
     return false;
 }
 
+/**
+ * Marks of each Cell without a value, bit value - 1
+ */
+void Candidates( Puzzle &p, unsigned short candidates[Units::CELL_COUNT] )
+{
+    Puzzle::View all = p.GetAllView();
+    size_t i = 0;
+    for ( Puzzle::View::iterator it = all.begin(); it != all.end(); ++it, ++i )
+    {
+        candidates[i] = ( (*it)->CanGuess() && (*it)->DisplayedValue() == 0 ) ?
+            ( ( (*it)->GetMarkContainer().to_ulong() >> 1 ) & 0x1FF ) : 0;
+    }
+}
+
+/**
+ * Create Methods in an arena for one solve, then empty it
+ * A Method still held by someone else when the solve ends keeps the arena
+ * from being emptied until a later solve.
+ */
+class ArenaScope
+{
+public:
+    ArenaScope( std::shared_ptr<SolutionMethodFactory> factory,
+                MethodArena &arena )
+        : _factory( factory ), _arena( arena ), _previous( 0 )
+    {
+        if ( _factory )
+        {
+            _previous = _factory->GetArena();
+            _factory->SetArena( &_arena );
+        }
+    }
+
+    ~ArenaScope()
+    {
+        if ( _factory )
+        {
+            _factory->SetArena( _previous );
+        }
+        if ( _arena.Live() == 0 )
+        {
+            _arena.Reset();
+        }
+    }
+
+private:
+    ArenaScope( const ArenaScope & );
+    ArenaScope & operator=( const ArenaScope & );
+
+    std::shared_ptr<SolutionMethodFactory> _factory;
+    MethodArena &_arena;
+    MethodArena *_previous;
+};
+
 }
 
 void MethodSolver::Solve( std::shared_ptr<Puzzle> p )
@@ -60,10 +206,22 @@ void MethodSolver::Solve( std::shared_ptr<Puzzle> p )
             "Need PuzzleMarker, SolverHelper, and Validator" );
     }
     
+    // observers hear about each changed Cell once, when solving is done
+    Puzzle::ChangeTransaction changes( p );
+    // every Method found below is released with the arena, before changes
+    ArenaScope arena( _helper->GetFactory(), _arena );
+
+    // counters for this solve, NULL when not collected
+    SolveStats *solveStats = _statsEnabled ? &_stats : NULL;
+    if ( solveStats )
+    {
+        solveStats->Reset();
+    }
+
     // ensure we have minimum solved Cells
     unsigned solvedCount = 0;
     Puzzle::Container all = p->GetAllCells();
-    FILE_LOG(logINFO) << "Checking if we have minimum cells to solve.";
+    FILE_LOG(logDEBUG) << "Checking if we have minimum cells to solve.";
     for ( Puzzle::Container::iterator it = all.begin();
           it != all.end() && solvedCount < MIN_CORRECT_VALUES;
           ++it )
@@ -85,111 +243,206 @@ void MethodSolver::Solve( std::shared_ptr<Puzzle> p )
     FILE_LOG(logINFO) << "Added appropriate marks";
 
 
-    // use the helper to get the increasingly difficult Methods
-    // grab one and execute
-    // repeat for all at each difficulty
-    // repeat entire process until puzzle solved or no more Methods
-    bool gotAnyMethods = false;
-    bool valid = false;
-    do
+    // run the cheapest rule with something to look at, and start over from
+    // the cheapest whenever a Method was executed
+    // each rule only looks where a Cell changed since it last ran
+    // until no rule has anything left to look at
+    PropagationQueue queue;
+    queue.Start( *p );
+    // links for the chains, only rebuilt for the digits which changed
+    LinkGraph graph;
+    PropagationQueue::Work work;
+    size_t rule = PropagationQueue::SINGLE_CANDIDATE;
+    while ( rule < PropagationQueue::RULE_COUNT )
     {
-        gotAnyMethods = false;
-
-        // Single Candidate, we can safely execute all
-        FILE_LOG(logINFO) << "Single Candidate Methods";
-        SolverHelper::MethodContainer methods =
-            _helper->GetAllSingleCandidate( p );
-        if ( !methods.empty() )
+        PropagationQueue::Rule r = static_cast<PropagationQueue::Rule>( rule );
+        if ( !queue.IsPending( r ) )
         {
-            bool success = ExecuteAllMethods( methods );
-            gotAnyMethods = gotAnyMethods || success;
+            ++rule;
+            continue;
         }
-        
-        // Exclusion Method
-        FILE_LOG(logINFO) << "Exclusion Methods";
-        methods.clear();
-        methods = _helper->GetAllExclusion( p );
-        if ( !methods.empty() )
+        queue.Take( r, work );
+
+        SolveStats::Method *stats = NULL;
+        uint64_t start = 0;
+        uint64_t executing = 0;
+        if ( solveStats )
         {
-            bool success = ExecuteAllMethods( methods );
-            gotAnyMethods = gotAnyMethods || success;
+            ++solveStats->passes;
+            stats = &solveStats->methods[r];
+            ++stats->runs;
+            executing = stats->executeNanos;
+            start = Now();
         }
 
-        // Block Intersection
-        methods.clear();
-        // go over all Cells with marks
-        for ( Puzzle::Container::iterator itC = all.begin();
-              itC != all.end();
-              ++itC )
+        bool executed = false;
+        SolverHelper::MethodContainer methods;
+        switch ( r )
         {
-            if ( (*itC)->CanGuess() && (*itC)->GetMarkContainer().any() )
+        case PropagationQueue::SINGLE_CANDIDATE:
+            // Single Candidate, we can safely execute all
+            FILE_LOG(logINFO) << "Single Candidate Methods";
+            methods = _helper->GetAllSingleCandidate( p, work.cells );
+            executed = ExecuteAllMethods( *p, methods, stats );
+            break;
+        case PropagationQueue::EXCLUSION:
+            FILE_LOG(logINFO) << "Exclusion Methods";
+            methods = _helper->GetAllExclusion( p, work.cells );
+            executed = ExecuteAllMethods( *p, methods, stats );
+            break;
+        case PropagationQueue::HIDDEN_SINGLE:
+            // units where a digit may have lost all but one place
+            FILE_LOG(logINFO) << "Hidden Single Methods";
+            for ( size_t u = 0; u < Units::UNIT_COUNT; u++ )
             {
-                FILE_LOG(logINFO) << "Checking for Block Intersection Methods"
-                                  << " on Cell: " << *itC;
-                methods = _helper->GetAllBlockIntersection( p, *itC );
-                
-                if ( !methods.empty() )
+                if ( work.digits[u] )
                 {
-                    bool success = ExecuteAllMethods( methods );
-                    gotAnyMethods = gotAnyMethods || success;
+                    methods = _helper->GetAllHiddenSingle( p, u );
+                    bool success = ExecuteAllMethods( *p, methods, stats );
+                    executed = executed || success;
                 }
             }
-        }
-
-        // Covering Set
-        methods.clear();
-        // go over all sectors
-        for ( size_t row = 1; row <= 9; row++ )
-        {
-            FILE_LOG(logINFO) << "Checking row " << row
-                              << " for Covering Set Methods.";
-            Puzzle::Container row_ = p->GetRow( row );
-            methods = _helper->GetAllCoveringSet( p, row_ );
-            if ( !methods.empty() )
+            break;
+        case PropagationQueue::BLOCK_INTERSECTION:
+            if ( _maxDifficulty >= DIFFICULTY_MEDIUM )
             {
-                    bool success = ExecuteRandomMethod( methods );
-                    gotAnyMethods = gotAnyMethods || success;
+                // Cells with a mark which changed in one of their units
+                Bitboard cells = Bitboard::None();
+                for ( size_t u = 0; u < Units::UNIT_COUNT; u++ )
+                {
+                    for ( size_t k = 0; work.digits[u] && k < Units::UNIT_SIZE;
+                          k++ )
+                    {
+                        size_t i = Units::UNIT_CELLS[u][k];
+                        std::shared_ptr<Cell> c =
+                            p->GetCell( i % 9 + 1, i / 9 + 1 );
+                        if ( c->CanGuess() &&
+                             ( ( c->GetMarkContainer().to_ulong() >> 1 ) &
+                               work.digits[u] ) )
+                        {
+                            cells.Set( i );
+                        }
+                    }
+                }
+                while ( cells.Any() )
+                {
+                    size_t i = cells.PopFirst();
+                    std::shared_ptr<Cell> c =
+                        p->GetCell( i % 9 + 1, i / 9 + 1 );
+                    FILE_LOG(logDEBUG) << "Checking for Block Intersection "
+                                      << "Methods on Cell: " << c;
+                    methods = _helper->GetAllBlockIntersection( p, c );
+                    bool success = ExecuteAllMethods( *p, methods, stats );
+                    executed = executed || success;
+                }
             }
-        }
-        for ( size_t col = 1; col <= 9; col++ )
-        {
-            FILE_LOG(logINFO) << "Checking col " << col
-                              << " for Covering Set Methods.";
-            Puzzle::Container col_ = p->GetCol( col );
-            methods = _helper->GetAllCoveringSet( p, col_ );
-            if ( !methods.empty() )
+            break;
+        case PropagationQueue::COVERING_SET:
+            // Covering Set is the hardest
+            for ( size_t u = 0;
+                  u < Units::UNIT_COUNT && _maxDifficulty >= DIFFICULTY_HARD;
+                  u++ )
+            {
+                if ( work.digits[u] )
+                {
+                    FILE_LOG(logDEBUG) << "Checking unit " << u
+                                      << " for Covering Set Methods.";
+                    methods = _helper->GetAllCoveringSet( p, u );
+                    bool success = ExecuteRandomMethod( *p, methods, stats );
+                    executed = executed || success;
+                }
+            }
+            break;
+        case PropagationQueue::FISH:
+            if ( _maxDifficulty >= DIFFICULTY_HARD )
             {
-                    bool success = ExecuteRandomMethod( methods );
-                    gotAnyMethods = gotAnyMethods || success;
+                // digits whose marks changed anywhere
+                unsigned short digits = 0;
+                for ( size_t u = 0; u < Units::UNIT_COUNT; u++ )
+                {
+                    digits |= work.digits[u];
+                }
+                FILE_LOG(logINFO) << "Fish Methods";
+                methods = _helper->GetAllFish( p, digits );
+                executed = ExecuteAllMethods( *p, methods, stats );
             }
-        }
-        for ( size_t x = 1; x <= 3; x++ )
-        {
-            for ( size_t y = 1; y <= 3; y++ )
+            break;
+        case PropagationQueue::CHAIN:
+            if ( _maxDifficulty >= DIFFICULTY_EXPERT )
             {
-                FILE_LOG(logINFO) << "Checking block " << x << ", " << y
-                                  << " for Covering Set Methods.";
-                Puzzle::Container block_ = p->GetBlock( x, y );
-                methods = _helper->GetAllCoveringSet( p, block_ );
-                if ( !methods.empty() )
+                unsigned short digits = 0;
+                for ( size_t u = 0; u < Units::UNIT_COUNT; u++ )
                 {
-                    bool success = ExecuteRandomMethod( methods );
-                    gotAnyMethods = gotAnyMethods || success;
+                    digits |= work.digits[u];
+                }
+                FILE_LOG(logINFO) << "Chain Methods";
+                // every kind looks, a chain found before an earlier kind
+                // changed the marks is checked again before it runs
+                for ( size_t k = 0; k < Chains::KIND_COUNT; k++ )
+                {
+                    unsigned short candidates[Units::CELL_COUNT];
+                    Candidates( *p, candidates );
+                    graph.Update( candidates );
+                    methods = _helper->GetAllChains(
+                        p, graph, static_cast<Chains::Kind>( k ), digits );
+                    bool success = ExecuteAllMethods( *p, methods, stats );
+                    executed = executed || success;
                 }
             }
+            break;
+        default:
+            break;
+        }
+
+        if ( stats )
+        {
+            // whatever was not executing was finding
+            stats->findNanos += Now() - start -
+                ( stats->executeNanos - executing );
         }
 
-    } while ( !(valid = _validator->IsValid( p )) && gotAnyMethods );
+        // changes made by this rule are pending for every rule again
+        queue.Update( *p );
+        rule = executed
+            ? static_cast<size_t>( PropagationQueue::SINGLE_CANDIDATE )
+            : rule + 1;
+    }
+
+    bool valid = _validator->IsValid( p );
+    if ( solveStats )
+    {
+        ++solveStats->validations;
+    }
+    if ( !valid && _fallback )
+    {
+        FILE_LOG(logINFO) << "Methods are stuck, using fallback Solver.";
+        _fallback->Solve( p );
+        valid = _validator->IsValid( p );
+        if ( solveStats )
+        {
+            ++solveStats->validations;
+        }
+    }
 
     if ( !valid )
     {
-        FILE_LOG(logERROR) << "Could not solve Puzzle.";
+        // without a fallback, stopping short is how a limited solve (e.g.
+        // the PuzzleGenerator checking a difficulty) reports too hard
+        if ( _fallback )
+        {
+            FILE_LOG(logERROR) << "Could not solve Puzzle.";
+        }
+        else
+        {
+            FILE_LOG(logINFO) << "Methods are stuck, Puzzle not solved.";
+        }
         throw std::runtime_error( "Could not solve Puzzle" );
     }
 }
 
 void MethodSolver::CommitGuesses( std::shared_ptr<Puzzle> p )
 {
+    Puzzle::ChangeTransaction changes( p );
     Puzzle::Container all = p->GetAllCells();
     FILE_LOG(logINFO) << "Committing Guesses to correct answers.";
     for ( Puzzle::Container::iterator it = all.begin();
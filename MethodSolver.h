@@ -1,7 +1,10 @@
 #ifndef SUDOKU_METHOD_SOLVER_H
 #define SUDOKU_METHOD_SOLVER_H
 
+#include "Difficulty.h"
 #include "ISolver.h"
+#include "MethodArena.h"
+#include "SolveStats.h"
 #include <string>
 
 namespace Sudoku
@@ -21,13 +24,15 @@ public:
     MethodSolver( std::shared_ptr<SolverHelper> helper,
                   std::shared_ptr<IPuzzleMarker> marker,
                   std::shared_ptr<IValidator> validator )
-        : _helper( helper ), _marker( marker ), _validator( validator ) {}
+        : _helper( helper ), _marker( marker ), _validator( validator ),
+          _maxDifficulty( DIFFICULTY_EXPERT ), _statsEnabled( false ) {}
 
     /**
      * Solve a Puzzle
      * @pre Puzzle has minimal Correct values set (is solvable)
      * @post Puzzle has all CorrectValue's set
-     * @throw May throw if the Puzzle is unsolvable (Solver gets stuck)
+     * @throw May throw if the Puzzle is unsolvable (Solver gets stuck and
+     *        there is no fallback Solver)
      * @param p Puzzle to solve
      */
     virtual void Solve( std::shared_ptr<Puzzle> p );
@@ -40,6 +45,35 @@ public:
      */
     virtual void CommitGuesses( std::shared_ptr<Puzzle> p );
 
+    /**
+     * Set a Solver to finish the Puzzle when the Methods get stuck
+     * @param fallback Solver to use (e.g., BacktrackingSolver), or NULL to
+     *        throw instead
+     */
+    void SetFallback( std::shared_ptr<ISolver> fallback )
+    { _fallback = fallback; }
+
+    /**
+     * Limit the Methods used to those up to a difficulty
+     * e.g. DIFFICULTY_EASY only uses single candidates, exclusion and
+     * hidden singles, so Solve throws on any Puzzle that needs more than that
+     * @param d Hardest Methods to use, DIFFICULTY_EXPERT (default) for all
+     */
+    void SetMaxDifficulty( Difficulty d ) { _maxDifficulty = d; }
+
+    /**
+     * Collect a SolveStats during each Solve
+     * Off by default, which costs a check per rule and per Method
+     * @param enabled true to collect
+     */
+    void SetStatsEnabled( bool enabled ) { _statsEnabled = enabled; }
+
+    /**
+     * What the last Solve with stats enabled did, up to where it threw if
+     * it did
+     */
+    const SolveStats& GetStats() const { return _stats; }
+
     /**
      * Solving is non-graphical, we will create a Log
      * Accessor
@@ -61,6 +95,16 @@ private:
     std::shared_ptr<IPuzzleMarker> _marker;
     /// Checks if Solver got it right
     std::shared_ptr<IValidator> _validator;
+    /// Finishes the Puzzle if the Methods get stuck, may be NULL
+    std::shared_ptr<ISolver> _fallback;
+    /// Hardest Methods to use
+    Difficulty _maxDifficulty;
+    /// Whether Solve collects _stats
+    bool _statsEnabled;
+    /// Counters of the last Solve with stats enabled
+    SolveStats _stats;
+    /// Methods of the current solve, kept for the next one once emptied
+    MethodArena _arena;
 };
 
 }
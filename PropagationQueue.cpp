@@ -0,0 +1,102 @@
+#include "PropagationQueue.h"
+#include "Puzzle.h"
+
+#include <cstring>
+
+namespace Sudoku
+{
+
+namespace
+{
+
+const unsigned short ALL_DIGITS = 0x1FF;
+
+unsigned short Marks( const Cell &c )
+{
+    return static_cast<unsigned short>(
+        ( c.GetMarkContainer().to_ulong() >> 1 ) & ALL_DIGITS );
+}
+
+unsigned short Digit( int value )
+{
+    return value ? 1 << ( value - 1 ) : 0;
+}
+
+}
+
+PropagationQueue::PropagationQueue()
+{
+    for ( size_t r = 0; r < RULE_COUNT; r++ )
+    {
+        _work[r].cells = Bitboard::None();
+        std::memset( _work[r].digits, 0, sizeof( _work[r].digits ) );
+    }
+    std::memset( _marks, 0, sizeof( _marks ) );
+    std::memset( _values, 0, sizeof( _values ) );
+}
+
+void PropagationQueue::Start( const Puzzle &p )
+{
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        std::shared_ptr<const Cell> c = p.GetCell( i % 9 + 1, i / 9 + 1 );
+        _marks[i] = Marks( *c );
+        _values[i] = c->DisplayedValue();
+    }
+    for ( size_t r = 0; r < RULE_COUNT; r++ )
+    {
+        _work[r].cells = Bitboard::All();
+        for ( size_t u = 0; u < Units::UNIT_COUNT; u++ )
+        {
+            _work[r].digits[u] = ALL_DIGITS;
+        }
+    }
+}
+
+size_t PropagationQueue::Update( Puzzle &p )
+{
+    Bitboard changed = p.TakeChanges();
+    size_t count = 0;
+    while ( changed.Any() )
+    {
+        size_t i = changed.PopFirst();
+        std::shared_ptr<Cell> c = p.GetCell( i % 9 + 1, i / 9 + 1 );
+        unsigned short marks = Marks( *c );
+        int value = c->DisplayedValue();
+        unsigned short digits = marks ^ _marks[i];
+        if ( value != _values[i] )
+        {
+            digits |= Digit( value ) | Digit( _values[i] );
+        }
+        _marks[i] = marks;
+        _values[i] = value;
+        if ( digits )
+        {
+            Touch( i, digits );
+            ++count;
+        }
+    }
+    return count;
+}
+
+void PropagationQueue::Touch( size_t i, unsigned short digits )
+{
+    const unsigned char *units = Units::CELL_UNITS[i];
+    for ( size_t r = 0; r < RULE_COUNT; r++ )
+    {
+        _work[r].cells.Set( i );
+        for ( size_t k = 0; k < Units::UNITS_PER_CELL; k++ )
+        {
+            _work[r].digits[units[k]] |= digits;
+        }
+    }
+}
+
+void PropagationQueue::Take( Rule r, Work &w )
+{
+    w = _work[r];
+    _work[r].cells = Bitboard::None();
+    std::memset( _work[r].digits, 0, sizeof( _work[r].digits ) );
+}
+
+}
@@ -0,0 +1,101 @@
+#ifndef SUDOKU_PROPAGATION_QUEUE_H
+#define SUDOKU_PROPAGATION_QUEUE_H
+
+#include <cstddef>
+
+#include "Bitboard.h"
+#include "Units.h"
+
+namespace Sudoku
+{
+
+class Puzzle;
+
+/**
+ * Tracks what changed in a Puzzle so a solver only looks again where a rule
+ * could now find something
+ * The Puzzle must be in a change transaction; Update takes the Cells changed
+ * since the last call (see Puzzle::TakeChanges) and compares them with the
+ * marks and values seen before, to find the digits which changed.  Each
+ * rule has its own pending work: the changed Cells, and for each unit the
+ * digits changed in it.  A rule takes its work when it runs, changes made
+ * meanwhile are kept for the next time.
+ *
+ * Digits use bit value - 1.
+ */
+class PropagationQueue
+{
+public:
+    /// Rules, cheapest first
+    enum Rule
+    {
+        SINGLE_CANDIDATE,
+        EXCLUSION,
+        HIDDEN_SINGLE,
+        BLOCK_INTERSECTION,
+        COVERING_SET,
+        FISH,
+        CHAIN,
+        RULE_COUNT
+    };
+
+    /// What a rule needs to look at
+    struct Work
+    {
+        /// Cells whose marks or value changed
+        Bitboard cells;
+        /// Digits changed in each unit, 0 if none
+        unsigned short digits[Units::UNIT_COUNT];
+
+        bool Empty() const { return cells.Empty(); }
+    };
+
+    PropagationQueue();
+
+    /**
+     * Start following a Puzzle, everything is pending for every rule
+     * @param p Puzzle to remember the marks and values of
+     */
+    void Start( const Puzzle &p );
+
+    /**
+     * Record what changed since Start or the last Update
+     * @param p The same Puzzle, in a change transaction
+     * @throw std::logic_error if p is not in a change transaction
+     * @return Number of Cells which changed
+     */
+    size_t Update( Puzzle &p );
+
+    /**
+     * Record a change to a Cell
+     * @param i Cell index (see Units)
+     * @param digits Digits whose mark or value changed on it
+     */
+    void Touch( size_t i, unsigned short digits );
+
+    /**
+     * Check if a rule has anything to look at
+     */
+    bool IsPending( Rule r ) const { return !_work[r].Empty(); }
+
+    /**
+     * Get the work of a rule and clear it
+     * @param r Rule which is about to run
+     * @param w Set to the changes since r last took its work
+     */
+    void Take( Rule r, Work &w );
+
+private:
+    PropagationQueue( const PropagationQueue & );
+    PropagationQueue & operator=( const PropagationQueue & );
+
+    Work _work[RULE_COUNT];
+    /// Marks of each Cell when last seen, bit value - 1
+    unsigned short _marks[Units::CELL_COUNT];
+    /// Displayed value of each Cell when last seen
+    unsigned char _values[Units::CELL_COUNT];
+};
+
+}
+
+#endif
@@ -1,193 +1,167 @@
 
 #include "Puzzle.h"
+#include "Grid.h"
+#include "GridRandomizer.h"
 #include <stdexcept>
 #include <algorithm>
 #include <iostream>
-#include "StdMapIteratorAdaptor.h"
+#include <random>
+
+#include "Log.h"
 
 namespace Sudoku
 {
 
-// utilities to compare for stl algorithm stuff
+// utilities to build containers from the static tables
 namespace
 {
 
-class CellInRow : public std::unary_function<const std::shared_ptr<Cell>,
-                                             bool>
+/**
+ * Copy the Cells listed in a table into a sorted container
+ * The tables are already sorted so every insert goes at the end
+ */
+template <class C>
+C MakeContainer( const std::shared_ptr<Cell> *grid,
+                 const unsigned char *index,
+                 size_t size )
 {
-public:
-    CellInRow( size_t row ) : _row( row ) {}
-
-    // note use of const ref to shared_ptr's
-    bool operator() ( const std::shared_ptr<Cell> &a ) const
+    C c;
+    for ( size_t i = 0; i < size; i++ )
     {
-        return ( a->GetY() == _row );
+        c.insert( c.end(), grid[index[i]] );
     }
-private:
-    size_t _row;
-};
-
-class CellInCol : public std::unary_function<const std::shared_ptr<Cell>,
-                                             bool>
-{
-public:
-    CellInCol( size_t col ) : _col( col ) {}
+    return c;
+}
 
-    // note use of const ref to shared_ptr's
-    bool operator() ( const std::shared_ptr<Cell> &a ) const
-    {
-        return ( a->GetX() == _col );
-    }
-private:
-    size_t _col;
-};
+}
 
-class CellInBlock : public std::unary_function<const std::shared_ptr<Cell>,
-                                               bool>
+Puzzle::Puzzle()
+    : _history( new CellHistory ),
+      _changeDepth( 0 ),
+      _changed( Bitboard::None() ),
+      _taken( Bitboard::None() )
 {
-public:
-    CellInBlock( size_t x, size_t y ) : _x( x ), _y( y )  {}
-
-    // note use of const ref to shared_ptr's
-    bool operator() ( const std::shared_ptr<Cell> &a ) const
+    // set up positions
+    for ( size_t i = 0; i < ARRAY_SIZE; i++ )
     {
-        return ( ( a->GetX() - 1 ) / 3 + 1 == _x &&
-                 ( a->GetY() - 1 ) / 3 + 1 == _y );
+        _grid[i].reset( new Cell );
+        _grid[i]->SetPos( i % SECTOR_SIZE + 1,
+                          i / SECTOR_SIZE + 1 );
+        _grid[i]->SetHistory( _history.get() );
     }
-private:
-    size_t _x, _y;
-};
+}
 
-class CellIsNeighbor : public CellInRow, CellInCol, CellInBlock
+Puzzle::Puzzle( const Puzzle &p )
+    : _history( new CellHistory ),
+      _changeDepth( 0 ),
+      _changed( Bitboard::None() ),
+      _taken( Bitboard::None() )
 {
-public:
-    CellIsNeighbor( size_t x, size_t y )
-        : CellInRow( y ),
-          CellInCol( x ),
-          CellInBlock( ( x - 1 ) / 3 + 1, ( y - 1 ) / 3 + 1 ) {}
-
-    bool operator() ( const std::shared_ptr<Cell> &a ) const
+    for ( size_t i = 0; i < ARRAY_SIZE; i++ )
     {
-        return ( CellInRow::operator()( a ) ||
-                 CellInCol::operator()( a ) ||
-                 CellInBlock::operator()( a ) );
+        _grid[i].reset( new Cell( *p._grid[i] ) );
+        _grid[i]->SetHistory( _history.get() );
     }
-};
+}
 
-class CompareCell : public std::binary_function<const std::shared_ptr<Cell>,
-                                               const std::shared_ptr<Cell>,
-                                               bool>
+Puzzle& Puzzle::operator=( const Puzzle &p )
 {
-public:
-    bool operator() ( const std::shared_ptr<Cell> &a,
-                      const std::shared_ptr<Cell> &b ) const
+    if ( this != &p )
     {
-        return ( *a == *b );
+        BeginChanges();
+        for ( size_t i = 0; i < ARRAY_SIZE; i++ )
+        {
+            if ( !( *_grid[i] == *p._grid[i] ) )
+            {
+                _history->Save( *_grid[i] );
+                *_grid[i] = *p._grid[i];
+                _grid[i]->NotifyObservers();
+            }
+        }
+        EndChanges();
     }
-};
-
+    return *this;
 }
 
-Puzzle::Puzzle()
+Puzzle::~Puzzle()
 {
-    // set up positions
     for ( size_t i = 0; i < ARRAY_SIZE; i++ )
     {
-        std::shared_ptr<Cell> temp( new Cell );
-        temp->SetPos( i % SECTOR_SIZE + 1,
-                      i / SECTOR_SIZE + 1 );
-        _grid.insert( std::make_pair(temp->GetPos(), temp ) );
+        _grid[i]->SetHistory( NULL );
+        _grid[i]->DeferNotifications( NULL );
     }
 }
 
-Puzzle::Puzzle( const Puzzle &p )
+void Puzzle::Randomize()
 {
-    *this = p;
+    std::random_device device;
+    Randomize( device() );
 }
 
-Puzzle& Puzzle::operator=( const Puzzle &p )
+void Puzzle::Randomize( unsigned seed )
 {
-    if ( this != &p )
+    GridRandomizer randomizer( seed );
+    Grid solution;
+    randomizer.Fill( solution );
+    for ( size_t i = 0; i < ARRAY_SIZE; i++ )
     {
-        _grid.clear();
-        std::copy( p._grid.begin(),
-                   p._grid.end(),
-                   std::inserter( _grid, _grid.begin() ) );
+        Cell &c = *_grid[i];
+        c.Display( false );
+        c.SetCorrect( solution[i].value );
+        c.SetGuess( 0 );
+        c.ClearMarks();
     }
-    return *this;
-}
-
-void Puzzle::Randomize()
-{
-    throw std::runtime_error( "NOT IMPLEMENTED" );
 }
 
 Puzzle::Container Puzzle::GetRow( size_t r )
 {
     Cell::Validate( r, 1, 9 );
-    Container row;
-    std::copy_if( make_map_iterator_adaptor( _grid.begin() ), 
-                  make_map_iterator_adaptor( _grid.end() ),
-                  std::inserter( row, row.begin() ),
-                  CellInRow( r ) );
-    return row;
+    return MakeContainer<Container>( _grid,
+                                     Units::UNIT_CELLS[Units::Row( r )],
+                                     Units::UNIT_SIZE );
 }
 
 Puzzle::ConstContainer Puzzle::GetRow( size_t r ) const
 {
     Cell::Validate( r, 1, 9 );
-    ConstContainer row;
-    std::copy_if( make_map_iterator_adaptor( _grid.begin() ), 
-                  make_map_iterator_adaptor( _grid.end() ),
-                  std::inserter( row, row.begin() ),
-                  CellInRow( r ) );
-    return row;
+    return MakeContainer<ConstContainer>( _grid,
+                                          Units::UNIT_CELLS[Units::Row( r )],
+                                          Units::UNIT_SIZE );
 }
 
 Puzzle::Container Puzzle::GetCol( size_t c )
 {
     Cell::Validate( c, 1, 9 );
-    Container col;
-    std::copy_if( make_map_iterator_adaptor( _grid.begin() ), 
-                  make_map_iterator_adaptor( _grid.end() ),
-                  std::inserter( col, col.begin() ),
-                  CellInCol( c ) );
-    return col;
+    return MakeContainer<Container>( _grid,
+                                     Units::UNIT_CELLS[Units::Col( c )],
+                                     Units::UNIT_SIZE );
 }
 
 Puzzle::ConstContainer Puzzle::GetCol( size_t c ) const
 {
     Cell::Validate( c, 1, 9 );
-    ConstContainer col;
-    std::copy_if( make_map_iterator_adaptor( _grid.begin() ), 
-                  make_map_iterator_adaptor( _grid.end() ),
-                  std::inserter( col, col.begin() ),
-                  CellInCol( c ) );
-    return col;
+    return MakeContainer<ConstContainer>( _grid,
+                                          Units::UNIT_CELLS[Units::Col( c )],
+                                          Units::UNIT_SIZE );
 }
 
 Puzzle::Container Puzzle::GetBlock( size_t x, size_t y )
 {
     Cell::Validate( x, 1, 3 );
     Cell::Validate( y, 1, 3 );
-    Container block;
-    std::copy_if( make_map_iterator_adaptor( _grid.begin() ), 
-                  make_map_iterator_adaptor( _grid.end() ),
-                  std::inserter( block, block.begin() ),
-                  CellInBlock( x, y ) );
-    return block;
+    return MakeContainer<Container>( _grid,
+                                     Units::UNIT_CELLS[Units::Block( x, y )],
+                                     Units::UNIT_SIZE );
 }
 
 Puzzle::ConstContainer Puzzle::GetBlock( size_t x, size_t y ) const
 {
     Cell::Validate( x, 1, 3 );
     Cell::Validate( y, 1, 3 );
-    ConstContainer block;
-    std::copy_if( make_map_iterator_adaptor( _grid.begin() ), 
-                  make_map_iterator_adaptor( _grid.end() ),
-                  std::inserter( block, block.begin() ),
-                  CellInBlock( x, y ) );
-    return block;
+    return MakeContainer<ConstContainer>(
+        _grid,
+        Units::UNIT_CELLS[Units::Block( x, y )],
+        Units::UNIT_SIZE );
 }
 
 Puzzle::Container Puzzle::GetBlock( std::shared_ptr<Cell> c )
@@ -206,36 +180,23 @@ std::shared_ptr<Cell> Puzzle::GetCell( size_t x, size_t y )
 {
     Cell::Validate( x, 1, 9 );
     Cell::Validate( y, 1, 9 );
-    Position p( x, y );
-    CellMap::iterator found = _grid.find( p );
-    if ( found == _grid.end() )
-    {
-        throw std::logic_error( "Could not find given cell in Puzzle" );
-    }
-    return ( found->second );
+    return _grid[Units::Index( x, y )];
 }
 
 std::shared_ptr<const Cell> Puzzle::GetCell( size_t x, size_t y ) const
 {
     Cell::Validate( x, 1, 9 );
     Cell::Validate( y, 1, 9 );
-    Position p( x, y );
-    CellMap::const_iterator found = _grid.find( p );
-    if ( found == _grid.end() )
-    {
-        throw std::logic_error( "Could not find given cell in Puzzle" );
-    }
-    return ( found->second );
+    return _grid[Units::Index( x, y )];
 }
 
 std::shared_ptr<Cell> Puzzle::GetCell( std::shared_ptr<const Cell> c )
 {
-    CellMap::iterator found = _grid.find( c->GetPos() );
-    if ( found == _grid.end() )
+    if ( c->GetX() < 1 || c->GetX() > 9 || c->GetY() < 1 || c->GetY() > 9 )
     {
         throw std::logic_error( "Could not find given cell in Puzzle" );
     }
-    return ( found->second );
+    return _grid[Units::Index( c->GetX(), c->GetY() )];
 }
 
 Puzzle::Container Puzzle::GetNeighbors( std::shared_ptr<Cell> c )
@@ -249,13 +210,12 @@ Puzzle::Container Puzzle::GetNeighbors( size_t x, size_t y )
 {
     Cell::Validate( x, 1, 9 );
     Cell::Validate( y, 1, 9 );
-    // this should be large enough to hold all neighbors after removing overlap
-    Container N;
-    std::copy_if( make_map_iterator_adaptor( _grid.begin() ), 
-                  make_map_iterator_adaptor( _grid.end() ),
-                  std::inserter( N, N.begin() ),
-                  CellIsNeighbor( x, y ) );
-    // N.erase( c );
+    size_t i = Units::Index( x, y );
+    // the peers plus the Cell itself
+    Container N = MakeContainer<Container>( _grid,
+                                            Units::PEERS[i],
+                                            Units::PEER_COUNT );
+    N.insert( _grid[i] );
     return N;
 }
 
@@ -271,41 +231,231 @@ Puzzle::ConstContainer Puzzle::GetNeighbors( size_t x, size_t y ) const
 {
     Cell::Validate( x, 1, 9 );
     Cell::Validate( y, 1, 9 );
-    // this should be large enough to hold all neighbors after removing overlap
-    ConstContainer N;
-    std::copy_if( make_map_iterator_adaptor( _grid.begin() ), 
-                  make_map_iterator_adaptor( _grid.end() ),
-                  std::inserter( N, N.begin() ),
-                  CellIsNeighbor( x, y ) );
-    // N.erase( c );
+    size_t i = Units::Index( x, y );
+    // the peers plus the Cell itself
+    ConstContainer N = MakeContainer<ConstContainer>( _grid,
+                                                      Units::PEERS[i],
+                                                      Units::PEER_COUNT );
+    N.insert( _grid[i] );
     return N;
 }
 
 Puzzle::ConstContainer Puzzle::GetAllCells() const
 {
-    ConstContainer c;
-    std::copy( make_map_iterator_adaptor( _grid.begin() ), 
-               make_map_iterator_adaptor( _grid.end() ),
-               std::inserter( c, c.begin() ) );
-    return c;
+    return MakeContainer<ConstContainer>( _grid,
+                                          Units::ALL_CELLS,
+                                          Units::CELL_COUNT );
 }
 
 Puzzle::Container Puzzle::GetAllCells()
 {
-    Container c;
-    std::copy( make_map_iterator_adaptor( _grid.begin() ),
-               make_map_iterator_adaptor( _grid.end() ),
-               std::inserter( c, c.begin() ) );
-    return c;
+    return MakeContainer<Container>( _grid,
+                                     Units::ALL_CELLS,
+                                     Units::CELL_COUNT );
+}
+
+Puzzle::View Puzzle::GetUnitView( size_t u )
+{
+    Cell::Validate( u, 0, Units::UNIT_COUNT - 1 );
+    return View( _grid, Units::UNIT_CELLS[u], Units::UNIT_SIZE );
+}
+
+Puzzle::ConstView Puzzle::GetUnitView( size_t u ) const
+{
+    Cell::Validate( u, 0, Units::UNIT_COUNT - 1 );
+    return ConstView( _grid, Units::UNIT_CELLS[u], Units::UNIT_SIZE );
+}
+
+Puzzle::View Puzzle::GetRowView( size_t r )
+{
+    Cell::Validate( r, 1, 9 );
+    return GetUnitView( Units::Row( r ) );
+}
+
+Puzzle::ConstView Puzzle::GetRowView( size_t r ) const
+{
+    Cell::Validate( r, 1, 9 );
+    return GetUnitView( Units::Row( r ) );
+}
+
+Puzzle::View Puzzle::GetColView( size_t c )
+{
+    Cell::Validate( c, 1, 9 );
+    return GetUnitView( Units::Col( c ) );
+}
+
+Puzzle::ConstView Puzzle::GetColView( size_t c ) const
+{
+    Cell::Validate( c, 1, 9 );
+    return GetUnitView( Units::Col( c ) );
+}
+
+Puzzle::View Puzzle::GetBlockView( size_t x, size_t y )
+{
+    Cell::Validate( x, 1, 3 );
+    Cell::Validate( y, 1, 3 );
+    return GetUnitView( Units::Block( x, y ) );
+}
+
+Puzzle::ConstView Puzzle::GetBlockView( size_t x, size_t y ) const
+{
+    Cell::Validate( x, 1, 3 );
+    Cell::Validate( y, 1, 3 );
+    return GetUnitView( Units::Block( x, y ) );
+}
+
+Puzzle::View Puzzle::GetPeerView( size_t x, size_t y )
+{
+    Cell::Validate( x, 1, 9 );
+    Cell::Validate( y, 1, 9 );
+    return View( _grid, Units::PEERS[Units::Index( x, y )], Units::PEER_COUNT );
+}
+
+Puzzle::ConstView Puzzle::GetPeerView( size_t x, size_t y ) const
+{
+    Cell::Validate( x, 1, 9 );
+    Cell::Validate( y, 1, 9 );
+    return ConstView( _grid,
+                      Units::PEERS[Units::Index( x, y )],
+                      Units::PEER_COUNT );
+}
+
+Puzzle::View Puzzle::GetAllView()
+{
+    return View( _grid, Units::ALL_CELLS, Units::CELL_COUNT );
+}
+
+Puzzle::ConstView Puzzle::GetAllView() const
+{
+    return ConstView( _grid, Units::ALL_CELLS, Units::CELL_COUNT );
 }
 
 bool Puzzle::operator==( const Puzzle &p ) const
 {
-    return ( p._grid.size() == _grid.size() &&
-             std::equal( make_map_iterator_adaptor( _grid.begin() ),
-                         make_map_iterator_adaptor( _grid.end() ),
-                         make_map_iterator_adaptor( p._grid.begin() ),
-                         CompareCell() ) );
+    for ( size_t i = 0; i < ARRAY_SIZE; i++ )
+    {
+        if ( !( *_grid[i] == *p._grid[i] ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Puzzle::BeginChanges()
+{
+    if ( _changeDepth++ == 0 )
+    {
+        _changed = Bitboard::None();
+        _taken = Bitboard::None();
+        for ( size_t i = 0; i < ARRAY_SIZE; i++ )
+        {
+            _grid[i]->DeferNotifications( &_changed );
+        }
+    }
+}
+
+Bitboard Puzzle::TakeChanges()
+{
+    if ( _changeDepth == 0 )
+    {
+        throw std::logic_error( "No change transaction to take changes of." );
+    }
+    Bitboard recent = _changed;
+    _taken |= recent;
+    _changed = Bitboard::None();
+    return recent;
+}
+
+Bitboard Puzzle::EndChanges()
+{
+    if ( _changeDepth == 0 )
+    {
+        throw std::logic_error( "No change transaction to end." );
+    }
+    if ( --_changeDepth != 0 )
+    {
+        return Bitboard::None();
+    }
+    for ( size_t i = 0; i < ARRAY_SIZE; i++ )
+    {
+        _grid[i]->DeferNotifications( NULL );
+    }
+    Bitboard changed = _changed | _taken;
+    for ( Bitboard left = changed; left.Any(); )
+    {
+        _grid[left.PopFirst()]->NotifyObservers();
+    }
+    return changed;
+}
+
+std::shared_ptr<const PuzzleSnapshot> Puzzle::TakeSnapshot()
+{
+    return std::shared_ptr<const PuzzleSnapshot>(
+        new PuzzleSnapshot( _history, _history->Take() ) );
+}
+
+void Puzzle::Restore( std::shared_ptr<const PuzzleSnapshot> s )
+{
+    checkSnapshot( s );
+    BeginChanges();
+    Bitboard restored = _history->Restore( s->_id, _grid );
+    while ( restored.Any() )
+    {
+        _grid[restored.PopFirst()]->NotifyObservers();
+    }
+    EndChanges();
+}
+
+Bitboard Puzzle::ChangedSince( std::shared_ptr<const PuzzleSnapshot> s ) const
+{
+    checkSnapshot( s );
+    return _history->ChangedSince( s->_id );
+}
+
+void Puzzle::checkSnapshot( std::shared_ptr<const PuzzleSnapshot> s ) const
+{
+    if ( !s || s->_history != _history )
+    {
+        throw std::logic_error( "Snapshot is not from this Puzzle." );
+    }
+    if ( !s->IsValid() )
+    {
+        throw std::logic_error( "Snapshot was dropped by an older Restore." );
+    }
+}
+
+Puzzle::ChangeTransaction::ChangeTransaction( std::shared_ptr<Puzzle> p )
+    : _puzzle( p )
+{
+    if ( !_puzzle )
+    {
+        throw std::runtime_error( "Cannot change NULL Puzzle." );
+    }
+    _puzzle->BeginChanges();
+}
+
+Bitboard Puzzle::ChangeTransaction::End()
+{
+    if ( !_puzzle )
+    {
+        return Bitboard::None();
+    }
+    std::shared_ptr<Puzzle> p;
+    p.swap( _puzzle );
+    return p->EndChanges();
+}
+
+Puzzle::ChangeTransaction::~ChangeTransaction()
+{
+    try
+    {
+        End();
+    }
+    catch ( std::exception &e )
+    {
+        FILE_LOG(logERROR) << "Cell observer failed: " << e.what();
+    }
 }
 
 std::ostream& operator<<( std::ostream &os, const Puzzle &p )
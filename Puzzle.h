@@ -1,10 +1,12 @@
 #ifndef SUDOKU_PUZZLE_H
 #define SUDOKU_PUZZLE_H
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
-#include <valarray>
-#include <map>
 #include "Cell.h"
+#include "CellHistory.h"
+#include "Units.h"
 
 namespace Sudoku
 {
@@ -33,6 +35,85 @@ public:
     }
 };
 
+/**
+ * Non-allocating view over a list of Cells in a Puzzle
+ * This walks one of the static Units tables (a unit, the peers of a Cell, or
+ * the whole board) and dereferences into the Puzzle's own Cell pointers, so
+ * nothing is copied into a new container.
+ * Cells come out in the same order as CellSorter.
+ * @note A view is only valid while the Puzzle it came from is alive
+ * @param Reference What dereferencing gives, a shared_ptr (const ref for the
+ *        non-const Puzzle, shared_ptr to const Cell for the const Puzzle)
+ */
+template <class Reference>
+class CellView
+{
+public:
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::shared_ptr<Cell> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::shared_ptr<Cell>* pointer;
+        typedef Reference reference;
+
+        const_iterator( const std::shared_ptr<Cell> *cells,
+                        const unsigned char *index )
+            : _cells( cells ), _index( index ) {}
+
+        Reference operator*() const { return _cells[*_index]; }
+
+        const_iterator& operator++() { ++_index; return *this; }
+
+        const_iterator operator++( int )
+        {
+            const_iterator temp( *this );
+            ++_index;
+            return temp;
+        }
+
+        bool operator==( const const_iterator &it ) const
+        {
+            return _index == it._index;
+        }
+
+        bool operator!=( const const_iterator &it ) const
+        {
+            return _index != it._index;
+        }
+
+    private:
+        const std::shared_ptr<Cell> *_cells;
+        const unsigned char *_index;
+    };
+    typedef const_iterator iterator;
+
+    /**
+     * Create a view
+     * @param cells The 81 Cell pointers of a Puzzle
+     * @param index Table of Cell indices (from Units)
+     * @param size Number of entries in the table
+     */
+    CellView( const std::shared_ptr<Cell> *cells,
+              const unsigned char *index,
+              size_t size )
+        : _cells( cells ), _index( index ), _size( size ) {}
+
+    const_iterator begin() const { return const_iterator( _cells, _index ); }
+    const_iterator end() const
+    {
+        return const_iterator( _cells, _index + _size );
+    }
+    size_t size() const { return _size; }
+    Reference operator[]( size_t i ) const { return _cells[_index[i]]; }
+
+private:
+    const std::shared_ptr<Cell> *_cells;
+    const unsigned char *_index;
+    size_t _size;
+};
+
 class Puzzle
 {
 public:
@@ -40,7 +121,9 @@ public:
     /// This is the container type we use for holding Cells internally
     typedef std::set<std::shared_ptr<Cell>, CellSorter> Container;
     typedef std::set<std::shared_ptr<const Cell>, CellSorter> ConstContainer;
-    typedef std::map<Position, std::shared_ptr<Cell> > CellMap;
+    /// Views which iterate Cells without allocating a Container
+    typedef CellView<const std::shared_ptr<Cell>&> View;
+    typedef CellView<std::shared_ptr<const Cell> > ConstView;
 
     /**
      * Create a blank board with all positions of Cells set
@@ -52,24 +135,41 @@ public:
      * Copy constructor
      * This Puzzle will have copies of the Cells from the other
      * @param p Puzzle to copy
-     * @post This Puzzle is an exact copy of p
+     * @post This Puzzle is an exact copy of p, sharing no Cells (and no
+     *       observers) with it
      */
     Puzzle( const Puzzle &p );
 
     /**
      * Copy another Puzzle, replacing the existing
+     * The Cells of this Puzzle keep their observers, which are notified
+     * of the Cells which change
      * @param p Puzzle to copy
      * @return this for method chaining
      */
     Puzzle& operator=( const Puzzle &p );
 
+    /**
+     * Cells outliving the Puzzle stop recording changes
+     */
+    ~Puzzle();
+
     /**
      * Randomize the solution of all Cells
      * Keep Guesses blank and Display false
      * This is a blank board which we can use to generate a game
+     * @post Every Cell has a correct value, the values form a valid solution
      */
     void Randomize();
 
+    /**
+     * Randomize the solution of all Cells, reproducibly
+     * @param seed The same seed always gives the same solution
+     * @see GridRandomizer to make many solutions without a Puzzle
+     * @overload void Randomize()
+     */
+    void Randomize( unsigned seed );
+
     /**
      * Get a row by index
      * @param r Row number
@@ -205,6 +305,91 @@ public:
      */
     ConstContainer GetAllCells() const;
 
+    /**
+     * Get a row, column, or block without allocating
+     * @param u Unit number (see Units), rows 0-8, columns 9-17, blocks 18-26
+     * @pre u is in range [0,26]
+     * @return view of the Cells in the unit
+     */
+    View GetUnitView( size_t u );
+
+    /**
+     * Get a unit without allocating, const version
+     * @overload View GetUnitView( size_t u )
+     */
+    ConstView GetUnitView( size_t u ) const;
+
+    /**
+     * Get a row without allocating
+     * @param r Row number
+     * @pre r is in range [1,9]
+     * @return view of the Cells in the given row
+     */
+    View GetRowView( size_t r );
+
+    /**
+     * Get a row without allocating, const version
+     * @overload View GetRowView( size_t r )
+     */
+    ConstView GetRowView( size_t r ) const;
+
+    /**
+     * Get a column without allocating
+     * @param c Column number
+     * @pre c is in range [1,9]
+     * @return view of the Cells in the given column
+     */
+    View GetColView( size_t c );
+
+    /**
+     * Get a column without allocating, const version
+     * @overload View GetColView( size_t c )
+     */
+    ConstView GetColView( size_t c ) const;
+
+    /**
+     * Get a 3 by 3 block without allocating
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @pre x, y are each in range [1,3]
+     * @return view of the Cells in the given block
+     */
+    View GetBlockView( size_t x, size_t y );
+
+    /**
+     * Get a 3 by 3 block without allocating, const version
+     * @overload View GetBlockView( size_t x, size_t y )
+     */
+    ConstView GetBlockView( size_t x, size_t y ) const;
+
+    /**
+     * Get the peers of a Cell without allocating
+     * Unlike GetNeighbors, the Cell itself is not included (20 Cells)
+     * @param x X coordinate of Cell
+     * @param y Y coordinate of Cell
+     * @pre x and y are both in range [1,9]
+     * @return view of the Cells sharing a row, column, or block with (x,y)
+     */
+    View GetPeerView( size_t x, size_t y );
+
+    /**
+     * Get the peers of a Cell without allocating, const version
+     * @overload View GetPeerView( size_t x, size_t y )
+     */
+    ConstView GetPeerView( size_t x, size_t y ) const;
+
+    /**
+     * Get all of the Cells in the grid without allocating
+     * @return view of all 81 Cells
+     */
+    View GetAllView();
+
+    /**
+     * Get all of the Cells in the grid without allocating, const version
+     * @overload View GetAllView()
+     */
+    ConstView GetAllView() const;
+
     /**
      * Check if two puzzles contain the exact same grid
      * @param p Other puzzle to compare
@@ -212,6 +397,107 @@ public:
      */
     bool operator==( const Puzzle &p ) const;
 
+    /**
+     * Start a change transaction
+     * Until the matching EndChanges, Cells do not notify their observers and
+     * are only recorded as changed.  Transactions nest, only the outermost
+     * one notifies.
+     * @post Cell notifications are deferred
+     */
+    void BeginChanges();
+
+    /**
+     * End a change transaction
+     * When the outermost transaction ends, every Cell which changed notifies
+     * its observers once, no matter how many times it changed
+     * @pre BeginChanges was called
+     * @throw std::logic_error if there is no transaction to end
+     * @return Cells which changed (by index, see Units), always empty when
+     *         an inner transaction ends
+     */
+    Bitboard EndChanges();
+
+    /**
+     * Take the Cells changed since the transaction began or the last call
+     * A solver can follow what each step changed this way; the outermost
+     * EndChanges still notifies (and returns) every Cell changed in the
+     * transaction.
+     * @pre BeginChanges was called
+     * @throw std::logic_error if there is no open transaction
+     * @return Cells which changed (by index, see Units) since the last call,
+     *         changing a Cell back still counts
+     */
+    Bitboard TakeChanges();
+
+    /**
+     * Check for an open change transaction
+     * @return true between BeginChanges and the matching EndChanges
+     */
+    bool IsChanging() const { return _changeDepth != 0; }
+
+    /**
+     * Remember the current state of the Puzzle
+     * This is copy-on-write: nothing is copied now, each Cell saves its old
+     * state the first time it changes afterwards
+     * @return handle to go back to this state with Restore
+     */
+    std::shared_ptr<const PuzzleSnapshot> TakeSnapshot();
+
+    /**
+     * Go back to a snapshot
+     * Only the Cells changed since the snapshot are touched (and notify
+     * their observers).  Snapshots taken after this one can no longer be
+     * restored, this one can be restored again.
+     * @param s Snapshot of this Puzzle
+     * @throw std::logic_error if s is NULL, from another Puzzle, or was
+     *        dropped by restoring an older snapshot
+     */
+    void Restore( std::shared_ptr<const PuzzleSnapshot> s );
+
+    /**
+     * Find the Cells changed since a snapshot
+     * @param s Snapshot of this Puzzle
+     * @throw std::logic_error if s cannot be restored
+     * @return Cells by index (see Units), changing a Cell back still counts
+     */
+    Bitboard ChangedSince( std::shared_ptr<const PuzzleSnapshot> s ) const;
+
+    /**
+     * Change transaction for a scope
+     * Begins on creation and ends when it goes out of scope (also when an
+     * exception is thrown), so bulk operations like solving notify each
+     * changed Cell once at the end instead of on every change.
+     */
+    class ChangeTransaction
+    {
+    public:
+        /**
+         * Begin a change transaction
+         * @param p Puzzle to change
+         * @throw std::runtime_error if p is NULL
+         */
+        explicit ChangeTransaction( std::shared_ptr<Puzzle> p );
+
+        /**
+         * End the transaction early
+         * @return Cells which changed, see Puzzle::EndChanges
+         */
+        Bitboard End();
+
+        /**
+         * End the transaction if End was not called
+         * @note Errors from observers are logged, not thrown
+         */
+        ~ChangeTransaction();
+
+    private:
+        ChangeTransaction( const ChangeTransaction & );
+        ChangeTransaction & operator=( const ChangeTransaction & );
+
+        /// NULL once ended
+        std::shared_ptr<Puzzle> _puzzle;
+    };
+
 private:
 
     /**
@@ -219,12 +505,25 @@ private:
      */
     friend std::ostream& operator<<( std::ostream &os, const Puzzle &p );
 
-//    Cell _grid[9][9];
     static const size_t ARRAY_SIZE = 81;
     static const size_t SECTOR_SIZE = 9;
-    CellMap _grid;
-    //Container _grid;
+    /// Cells indexed as in Units, (y - 1) * 9 + (x - 1)
+    std::shared_ptr<Cell> _grid[ARRAY_SIZE];
+
+    /**
+     * Check that a snapshot can be restored on this Puzzle
+     * @throw std::logic_error if not
+     */
+    void checkSnapshot( std::shared_ptr<const PuzzleSnapshot> s ) const;
 
+    /// Old states of changed Cells, shared with the snapshots
+    std::shared_ptr<CellHistory> _history;
+    /// Open change transactions
+    unsigned _changeDepth;
+    /// Cells changed in the current transaction, since the last TakeChanges
+    Bitboard _changed;
+    /// Cells changed in the current transaction and already taken
+    Bitboard _taken;
 };
 
 }
@@ -0,0 +1,265 @@
+#include "PuzzleBatch.h"
+#include "Grid.h"
+
+#include <cstring>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace Sudoku
+{
+
+namespace
+{
+
+const uint16_t ALL_CANDIDATES = 0x1FF;
+
+#ifdef __AVX2__
+
+inline __m256i Load( const uint16_t *lanes )
+{
+    return _mm256_loadu_si256( reinterpret_cast<const __m256i *>( lanes ) );
+}
+
+inline void Store( uint16_t *lanes, __m256i v )
+{
+    _mm256_storeu_si256( reinterpret_cast<__m256i *>( lanes ), v );
+}
+
+/**
+ * Candidates of each open Cell are every value not placed in a peer
+ */
+void MarkBlock( uint16_t placed[][PuzzleBatch::LANES],
+                uint16_t candidates[][PuzzleBatch::LANES] )
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i all = _mm256_set1_epi16( ALL_CANDIDATES );
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        __m256i open = _mm256_cmpeq_epi16( Load( placed[i] ), zero );
+        Store( candidates[i], _mm256_and_si256( open, all ) );
+    }
+}
+
+void ExcludeBlock( uint16_t placed[][PuzzleBatch::LANES],
+                   uint16_t candidates[][PuzzleBatch::LANES] )
+{
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        const unsigned char *peers = Units::PEERS[i];
+        __m256i seen = Load( placed[peers[0]] );
+        for ( size_t k = 1; k < Units::PEER_COUNT; k++ )
+        {
+            seen = _mm256_or_si256( seen, Load( placed[peers[k]] ) );
+        }
+        Store( candidates[i],
+               _mm256_andnot_si256( seen, Load( candidates[i] ) ) );
+    }
+}
+
+size_t SinglesBlock( uint16_t placed[][PuzzleBatch::LANES],
+                     uint16_t candidates[][PuzzleBatch::LANES] )
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi16( 1 );
+    size_t count = 0;
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        __m256i c = Load( candidates[i] );
+        __m256i p = Load( placed[i] );
+        // one bit set: c & ( c - 1 ) == 0 and c != 0, on an open Cell
+        __m256i single = _mm256_and_si256(
+            _mm256_cmpeq_epi16(
+                _mm256_and_si256( c, _mm256_sub_epi16( c, one ) ), zero ),
+            _mm256_cmpeq_epi16( p, zero ) );
+        single = _mm256_andnot_si256( _mm256_cmpeq_epi16( c, zero ), single );
+        Store( placed[i], _mm256_or_si256( p, _mm256_and_si256( single, c ) ) );
+        Store( candidates[i], _mm256_andnot_si256( single, c ) );
+        // two mask bytes per lane
+        count += __builtin_popcount( _mm256_movemask_epi8( single ) ) / 2;
+    }
+    return count;
+}
+
+#else
+
+void MarkBlock( uint16_t placed[][PuzzleBatch::LANES],
+                uint16_t candidates[][PuzzleBatch::LANES] )
+{
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        for ( size_t l = 0; l < PuzzleBatch::LANES; l++ )
+        {
+            candidates[i][l] = placed[i][l] ? 0 : ALL_CANDIDATES;
+        }
+    }
+}
+
+void ExcludeBlock( uint16_t placed[][PuzzleBatch::LANES],
+                   uint16_t candidates[][PuzzleBatch::LANES] )
+{
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        const unsigned char *peers = Units::PEERS[i];
+        uint16_t seen[PuzzleBatch::LANES];
+        std::memcpy( seen, placed[peers[0]], sizeof( seen ) );
+        for ( size_t k = 1; k < Units::PEER_COUNT; k++ )
+        {
+            const uint16_t *peer = placed[peers[k]];
+            for ( size_t l = 0; l < PuzzleBatch::LANES; l++ )
+            {
+                seen[l] |= peer[l];
+            }
+        }
+        for ( size_t l = 0; l < PuzzleBatch::LANES; l++ )
+        {
+            candidates[i][l] &= ~seen[l];
+        }
+    }
+}
+
+size_t SinglesBlock( uint16_t placed[][PuzzleBatch::LANES],
+                     uint16_t candidates[][PuzzleBatch::LANES] )
+{
+    size_t count = 0;
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        for ( size_t l = 0; l < PuzzleBatch::LANES; l++ )
+        {
+            uint16_t c = candidates[i][l];
+            uint16_t single = ( c != 0 && ( c & ( c - 1 ) ) == 0 &&
+                                placed[i][l] == 0 ) ? 0xFFFF : 0;
+            placed[i][l] |= c & single;
+            candidates[i][l] = c & ~single;
+            count += single & 1;
+        }
+    }
+    return count;
+}
+
+#endif
+
+}
+
+const size_t PuzzleBatch::LANES;
+
+void PuzzleBatch::Add( const Grid &g )
+{
+    size_t lane = _size % LANES;
+    if ( lane == 0 )
+    {
+        // value initialized, so every lane starts empty
+        _blocks.push_back( Block() );
+    }
+    Block &b = _blocks.back();
+    Bitboard givens = Bitboard::None();
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        b.placed[i][lane] = g[i].value ? 1 << ( g[i].value - 1 ) : 0;
+        b.candidates[i][lane] = 0;
+        if ( g[i].given )
+        {
+            givens.Set( i );
+        }
+    }
+    _givens.push_back( givens );
+    ++_size;
+}
+
+void PuzzleBatch::CopyTo( size_t n, Grid &g ) const
+{
+    const Block &b = _blocks[n / LANES];
+    size_t lane = n % LANES;
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        g[i].value = GetValue( n, i );
+        g[i].given = _givens[n].Test( i );
+        g[i].marks = b.candidates[i][lane];
+    }
+}
+
+int PuzzleBatch::GetValue( size_t n, size_t i ) const
+{
+    uint16_t p = _blocks[n / LANES].placed[i][n % LANES];
+    return p ? __builtin_ctz( p ) + 1 : 0;
+}
+
+bool PuzzleBatch::IsSolved( size_t n ) const
+{
+    const Block &b = _blocks[n / LANES];
+    size_t lane = n % LANES;
+    for ( size_t i = 0; i < Units::CELL_COUNT; i++ )
+    {
+        if ( b.placed[i][lane] == 0 )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PuzzleBatch::UpdateMarks()
+{
+    for ( std::vector<Block>::iterator b = _blocks.begin();
+          b != _blocks.end();
+          ++b )
+    {
+        MarkBlock( b->placed, b->candidates );
+        ExcludeBlock( b->placed, b->candidates );
+    }
+}
+
+void PuzzleBatch::Exclude()
+{
+    for ( std::vector<Block>::iterator b = _blocks.begin();
+          b != _blocks.end();
+          ++b )
+    {
+        ExcludeBlock( b->placed, b->candidates );
+    }
+}
+
+size_t PuzzleBatch::PlaceSingles()
+{
+    size_t count = 0;
+    for ( std::vector<Block>::iterator b = _blocks.begin();
+          b != _blocks.end();
+          ++b )
+    {
+        count += SinglesBlock( b->placed, b->candidates );
+    }
+    return count;
+}
+
+size_t PuzzleBatch::Solve()
+{
+    for ( std::vector<Block>::iterator b = _blocks.begin();
+          b != _blocks.end();
+          ++b )
+    {
+        MarkBlock( b->placed, b->candidates );
+        ExcludeBlock( b->placed, b->candidates );
+        while ( SinglesBlock( b->placed, b->candidates ) != 0 )
+        {
+            ExcludeBlock( b->placed, b->candidates );
+        }
+    }
+    size_t solved = 0;
+    for ( size_t n = 0; n < _size; n++ )
+    {
+        solved += IsSolved( n );
+    }
+    return solved;
+}
+
+bool PuzzleBatch::UsesAvx2()
+{
+#ifdef __AVX2__
+    return true;
+#else
+    return false;
+#endif
+}
+
+}
@@ -0,0 +1,118 @@
+#ifndef SUDOKU_PUZZLE_BATCH_H
+#define SUDOKU_PUZZLE_BATCH_H
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+#include "Bitboard.h"
+#include "Units.h"
+
+namespace Sudoku
+{
+
+class Grid;
+
+/**
+ * Many Puzzles stored structure-of-arrays, to propagate them all at once
+ * Puzzles go in blocks of LANES.  In a block, the placed value and the
+ * candidate mask of one Cell are stored for every Puzzle side by side, so
+ * one 256-bit register holds a Cell of 16 Puzzles and marking, exclusion
+ * and single candidates each handle a whole block per instruction.  With
+ * AVX2 (build with -mavx2, see "make avx2") the kernels use intrinsics,
+ * otherwise plain loops over the lanes which the compiler may vectorize.
+ *
+ * Masks use bit value - 1 like Grid and CandidateGrid; a placed value is
+ * stored as its bit, 0 if the Cell is open.  Placed Cells have no
+ * candidates.
+ */
+class PuzzleBatch
+{
+public:
+    /// Puzzles per block (16 x 16 bits = 256 bits)
+    static const size_t LANES = 16;
+
+    PuzzleBatch() : _size( 0 ) {}
+
+    /**
+     * Add a Puzzle
+     * @param g Grid with givens (and any values) set, marks are ignored
+     * @post it is Puzzle Size() - 1, with no candidates until UpdateMarks
+     */
+    void Add( const Grid &g );
+
+    size_t Size() const { return _size; }
+
+    /**
+     * Copy a Puzzle out
+     * @param n Puzzle number
+     * @param g Set to the values and candidates, givens as they were added
+     */
+    void CopyTo( size_t n, Grid &g ) const;
+
+    /**
+     * Value of a Cell
+     * @return 1-9, or 0 if open
+     */
+    int GetValue( size_t n, size_t i ) const;
+
+    unsigned short GetCandidates( size_t n, size_t i ) const
+    {
+        return _blocks[n / LANES].candidates[i][n % LANES];
+    }
+
+    /**
+     * Check if every Cell of a Puzzle has a value
+     */
+    bool IsSolved( size_t n ) const;
+
+    /**
+     * Batch PuzzleMarker::UpdateMarks
+     * @post open Cells have every value no peer has as candidates
+     */
+    void UpdateMarks();
+
+    /**
+     * Batch ExclusionMethod, for every placed Cell at once
+     * @post no open Cell has a value of one of its peers as a candidate
+     */
+    void Exclude();
+
+    /**
+     * Batch SingleCandidateMethod, for every open Cell at once
+     * Two peers with the same single candidate both get it, which is only
+     * possible for a Puzzle without a solution
+     * @return Number of Cells placed, over all Puzzles
+     */
+    size_t PlaceSingles();
+
+    /**
+     * Mark, then exclude and place singles until nothing changes
+     * Each block is run to the end before the next one, while it is cached
+     * @return Number of Puzzles solved
+     */
+    size_t Solve();
+
+    /**
+     * Check which kernels were compiled in
+     * @return true if the AVX2 kernels are used
+     */
+    static bool UsesAvx2();
+
+private:
+    /// LANES Puzzles, Cell by Cell
+    struct Block
+    {
+        uint16_t placed[Units::CELL_COUNT][LANES];
+        uint16_t candidates[Units::CELL_COUNT][LANES];
+    };
+
+    std::vector<Block> _blocks;
+    /// Given Cells of each Puzzle
+    std::vector<Bitboard> _givens;
+    size_t _size;
+};
+
+}
+
+#endif
@@ -2,6 +2,7 @@
 #include "PuzzleController.h"
 #include "ICommandExecutor.h"
 #include "IPuzzleAccess.h"
+#include "ISolutionCounter.h"
 #include "AddHintMarksCommand.h"
 #include "SolveCommand.h"
 
@@ -11,11 +12,13 @@ namespace Sudoku
 PuzzleController::PuzzleController( std::shared_ptr<ICommandExecutor> exec,
                                     std::shared_ptr<IPuzzleAccess> access,
                                     std::shared_ptr<IPuzzleMarker> marker,
-                                    std::shared_ptr<ISolver> solver )
+                                    std::shared_ptr<ISolver> solver,
+                                    std::shared_ptr<ISolutionCounter> counter )
     : _executor( exec ),
       _puzzleAccess( access ),
       _puzzleMarker( marker ),
-      _solver( solver )
+      _solver( solver ),
+      _counter( counter )
 {
     if ( !_executor )
     {
@@ -37,6 +40,11 @@ PuzzleController::PuzzleController( std::shared_ptr<ICommandExecutor> exec,
         throw std::runtime_error(
             "Cannot create PuzzleController with NULL Solver.");
     }
+    if ( !_counter )
+    {
+        throw std::runtime_error(
+            "Cannot create PuzzleController with NULL SolutionCounter." );
+    }
 }
 
 void PuzzleController::MarkHints()
@@ -55,4 +63,14 @@ void PuzzleController::Solve()
     _executor->Execute( command );
 }
 
+size_t PuzzleController::CountSolutions( size_t limit )
+{
+    return _counter->CountSolutions( _puzzleAccess->GetPuzzle(), limit );
+}
+
+bool PuzzleController::HasUniqueSolution()
+{
+    return ( CountSolutions( 2 ) == 1 );
+}
+
 }
@@ -1,6 +1,7 @@
 #ifndef SUDOKU_PUZZLE_CONTROLLER_H
 #define SUDOKU_PUZZLE_CONTROLLER_H
 
+#include <cstddef>
 #include <memory>
 
 namespace Sudoku
@@ -9,6 +10,7 @@ namespace Sudoku
 class ICommandExecutor;
 class IPuzzleAccess;
 class IPuzzleMarker;
+class ISolutionCounter;
 class ISolver;
 
 class PuzzleController
@@ -18,11 +20,15 @@ public:
      * Constructor, pass a few essential interfaces
      * @param exec Class that can execute commands
      * @param access Class that can return a pointer to a const Puzzle
+     * @param marker Marks hints
+     * @param solver Solves the Puzzle
+     * @param counter Counts solutions of the Puzzle
      */
     PuzzleController( std::shared_ptr<ICommandExecutor> exec,
                       std::shared_ptr<IPuzzleAccess> access,
                       std::shared_ptr<IPuzzleMarker> marker,
-                      std::shared_ptr<ISolver> solver );
+                      std::shared_ptr<ISolver> solver,
+                      std::shared_ptr<ISolutionCounter> counter );
 
     /**
      * Mark all Cells with their possible values to give hints to user
@@ -38,6 +44,19 @@ public:
      */
     void Solve();
 
+    /**
+     * Count the solutions of the current Puzzle (from its givens)
+     * @param limit Stop counting once this many solutions are found
+     * @return number of solutions, at most limit
+     */
+    size_t CountSolutions( size_t limit = 2 );
+
+    /**
+     * Check that the current Puzzle is a proper Sudoku
+     * @return true if the givens have exactly one solution
+     */
+    bool HasUniqueSolution();
+
     ~PuzzleController() {}
 
 private:
@@ -52,6 +71,8 @@ private:
     std::shared_ptr<IPuzzleMarker> _puzzleMarker;
     /// solver
     std::shared_ptr<ISolver> _solver;
+    /// solution counter
+    std::shared_ptr<ISolutionCounter> _counter;
 };
 
 }
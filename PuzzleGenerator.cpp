@@ -0,0 +1,187 @@
+#include "PuzzleGenerator.h"
+#include "MethodSolver.h"
+#include "Puzzle.h"
+#include "PuzzleMarker.h"
+#include "SimpleValidator.h"
+#include "SolutionMethod.h"
+#include "SolutionMethodFactory.h"
+#include "SolverHelper.h"
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "Log.h"
+
+namespace Sudoku
+{
+
+namespace
+{
+
+/**
+ * Seed of one Puzzle in a batch, spread out so neighbours are unrelated
+ */
+uint32_t BatchSeed( uint32_t seed, size_t n )
+{
+    uint32_t x = seed + static_cast<uint32_t>( n ) * 0x9E3779B9u;
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    return x;
+}
+
+/**
+ * Generates one Puzzle of the batch with the generator of the worker
+ */
+class GenerateTask : public WorkStealingPool::Task
+{
+public:
+    GenerateTask( uint32_t seed,
+                  std::vector<Grid> &results,
+                  std::vector<std::shared_ptr<PuzzleGenerator> > &generators )
+        : _seed( seed ), _results( results ), _generators( generators ) {}
+
+    virtual void Execute( size_t worker, size_t item )
+    {
+        PuzzleGenerator &g = *_generators[worker];
+        g.Seed( BatchSeed( _seed, item ) );
+        g.Generate( _results[item], NULL );
+    }
+
+private:
+    uint32_t _seed;
+    std::vector<Grid> &_results;
+    std::vector<std::shared_ptr<PuzzleGenerator> > &_generators;
+};
+
+}
+
+PuzzleGenerator::PuzzleGenerator( uint32_t seed, Difficulty target )
+    : _random( seed ),
+      _target( target ),
+      _factory( new SolutionMethodFactory )
+{
+    std::shared_ptr<SolverHelper> helper( new SolverHelper( _factory ) );
+    std::shared_ptr<IPuzzleMarker> marker( new PuzzleMarker );
+    _solver.reset( new MethodSolver( helper, marker,
+                                     SimpleValidator::CreateGuessValidator() ) );
+    _solver->SetMaxDifficulty( _target );
+}
+
+std::shared_ptr<Puzzle> PuzzleGenerator::Generate()
+{
+    Grid givens;
+    Grid solution;
+    Generate( givens, &solution );
+
+    std::shared_ptr<Puzzle> p( new Puzzle );
+    for ( size_t i = 0; i < Grid::ARRAY_SIZE; i++ )
+    {
+        std::shared_ptr<Cell> c = p->GetCell( i % Grid::SECTOR_SIZE + 1,
+                                              i / Grid::SECTOR_SIZE + 1 );
+        c->SetCorrect( solution[i].value );
+        c->Display( givens[i].given != 0 );
+    }
+    return p;
+}
+
+void PuzzleGenerator::Generate( Grid &givens, Grid *solution )
+{
+    Grid solved;
+    _random.Fill( solved );
+    givens = solved;
+
+    // the solved state the Methods work on: every Cell is a guess
+    std::shared_ptr<Puzzle> work( new Puzzle );
+    for ( size_t i = 0; i < Grid::ARRAY_SIZE; i++ )
+    {
+        work->GetCell( i % Grid::SECTOR_SIZE + 1, i / Grid::SECTOR_SIZE + 1 )
+            ->SetGuess( solved[i].value );
+    }
+
+    unsigned char order[Grid::ARRAY_SIZE];
+    std::copy( Units::ALL_CELLS, Units::ALL_CELLS + Grid::ARRAY_SIZE, order );
+    for ( size_t k = Grid::ARRAY_SIZE; k > 1; k-- )
+    {
+        std::swap( order[k - 1], order[_random.Below( k )] );
+    }
+
+    size_t remaining = Grid::ARRAY_SIZE;
+    for ( size_t k = 0; k < Grid::ARRAY_SIZE; k++ )
+    {
+        size_t i = order[k];
+        std::shared_ptr<SolutionMethod> method =
+            _factory->CreateSingleCandidateMethod(
+                work->GetCell( i % Grid::SECTOR_SIZE + 1,
+                               i / Grid::SECTOR_SIZE + 1 ) );
+        if ( remaining <= MethodSolver::MIN_CORRECT_VALUES ||
+             !method->VerifyReverseConditions() )
+        {
+            continue;
+        }
+        method->ExecuteReverse();
+        givens[i].value = 0;
+        givens[i].given = 0;
+        if ( IsAcceptable( givens ) )
+        {
+            --remaining;
+        }
+        else
+        {
+            // put the value back
+            method->ExecuteForward();
+            givens[i] = solved[i];
+        }
+    }
+    FILE_LOG(logINFO) << "Generated Puzzle with " << remaining << " givens.";
+
+    if ( solution )
+    {
+        *solution = solved;
+    }
+}
+
+bool PuzzleGenerator::IsAcceptable( const Grid &givens )
+{
+    // uniqueness is cheap and rules out most removals
+    if ( _counter.CountSolutions( givens, 2 ) != 1 )
+    {
+        return false;
+    }
+    if ( _target == DIFFICULTY_EXPERT )
+    {
+        return true;
+    }
+    std::shared_ptr<Puzzle> p( new Puzzle );
+    givens.CopyTo( *p );
+    try
+    {
+        _solver->Solve( p );
+    }
+    catch ( std::runtime_error & )
+    {
+        return false;
+    }
+    return true;
+}
+
+std::vector<Grid> PuzzleGenerator::GenerateBatch( size_t count,
+                                                  uint32_t seed,
+                                                  Difficulty target,
+                                                  size_t threads )
+{
+    WorkStealingPool pool( threads );
+    std::vector<std::shared_ptr<PuzzleGenerator> > generators;
+    for ( size_t w = 0; w < pool.GetThreadCount(); w++ )
+    {
+        generators.push_back( std::shared_ptr<PuzzleGenerator>(
+                                  new PuzzleGenerator( seed, target ) ) );
+    }
+    std::vector<Grid> results( count );
+    GenerateTask task( seed, results, generators );
+    pool.Run( count, task );
+    return results;
+}
+
+}
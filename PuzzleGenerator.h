@@ -0,0 +1,104 @@
+#ifndef SUDOKU_PUZZLE_GENERATOR_H
+#define SUDOKU_PUZZLE_GENERATOR_H
+
+#include <memory>
+#include <vector>
+#include <stdint.h>
+
+#include "Difficulty.h"
+#include "Grid.h"
+#include "GridRandomizer.h"
+#include "SolutionCounter.h"
+
+namespace Sudoku
+{
+
+class MethodSolver;
+class Puzzle;
+class SolutionMethodFactory;
+
+/**
+ * Makes new Puzzles by running the Solver backwards
+ * Starts from a random solved grid where every Cell holds a guess and visits
+ * the Cells in random order.  Each Cell is unsolved with the reverse of a
+ * SingleCandidateMethod (VerifyReverseConditions / ExecuteReverse) and the
+ * step is kept only if the givens left still have a unique solution and
+ * MethodSolver can still solve them without going over the target
+ * difficulty; otherwise ExecuteForward puts the value back.
+ *
+ * The result is minimal for its difficulty: no remaining given can be
+ * removed without breaking one of those checks.
+ */
+class PuzzleGenerator
+{
+public:
+    /**
+     * Create a generator
+     * @param seed Seed of the random sequence, the same seed and target
+     *        always give the same Puzzles
+     * @param target Hardest Methods a player may need
+     */
+    PuzzleGenerator( uint32_t seed, Difficulty target = DIFFICULTY_EXPERT );
+
+    /**
+     * Restart the random sequence
+     * @param seed Seed of the random sequence
+     */
+    void Seed( uint32_t seed ) { _random.Seed( seed ); }
+
+    /**
+     * Accessor
+     * @return hardest Methods a player may need
+     */
+    Difficulty GetTarget() const { return _target; }
+
+    /**
+     * Make the next Puzzle
+     * @return Puzzle with givens displayed and the solution as the hidden
+     *         correct value of every other Cell
+     */
+    std::shared_ptr<Puzzle> Generate();
+
+    /**
+     * Make the next Puzzle as a Grid
+     * @param givens Set to the givens, every other record is blank
+     * @param solution If not NULL, set to the solution
+     */
+    void Generate( Grid &givens, Grid *solution );
+
+    /**
+     * Make many Puzzles in parallel
+     * Puzzle n is made from its own seed (derived from seed and n), so the
+     * result does not depend on the number of threads
+     * @param count Number of Puzzles
+     * @param seed Seed for the whole batch
+     * @param target Hardest Methods a player may need
+     * @param threads Number of worker threads, 0 for one per hardware thread
+     * @return givens of each Puzzle
+     */
+    static std::vector<Grid> GenerateBatch( size_t count, uint32_t seed,
+                                            Difficulty target,
+                                            size_t threads = 0 );
+
+private:
+    PuzzleGenerator( const PuzzleGenerator & );
+    PuzzleGenerator & operator=( const PuzzleGenerator & );
+
+    /**
+     * Check the givens still make a proper Puzzle at the target difficulty
+     * @param givens Givens to check
+     * @return true if unique and solvable by the allowed Methods
+     */
+    bool IsAcceptable( const Grid &givens );
+
+    GridRandomizer _random;
+    Difficulty _target;
+    std::shared_ptr<SolutionMethodFactory> _factory;
+    /// Solver limited to the target difficulty, without fallback
+    std::shared_ptr<MethodSolver> _solver;
+    SolutionCounter _counter;
+};
+
+}
+
+#endif
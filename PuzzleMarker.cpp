@@ -7,8 +7,8 @@ namespace Sudoku
 
 void PuzzleMarker::ClearPuzzle( std::shared_ptr<Puzzle> puzzle )
 {
-    Puzzle::Container all = puzzle->GetAllCells();
-    for ( Puzzle::Container::iterator it = all.begin();
+    Puzzle::View all = puzzle->GetAllView();
+    for ( Puzzle::View::iterator it = all.begin();
           it != all.end();
           ++it )
     {
@@ -18,18 +18,19 @@ void PuzzleMarker::ClearPuzzle( std::shared_ptr<Puzzle> puzzle )
 
 void PuzzleMarker::UpdateMarks( std::shared_ptr<Puzzle> puzzle )
 {
-    Puzzle::Container all = puzzle->GetAllCells();
-    for ( Puzzle::Container::iterator it = all.begin();
+    Puzzle::View all = puzzle->GetAllView();
+    for ( Puzzle::View::iterator it = all.begin();
           it != all.end();
           ++it )
     {
-        // get neighbors
-        Puzzle::Container N = puzzle->GetNeighbors( *it );
-        // all values are possible
+        // get peers (walks a static table, no allocation)
+        Puzzle::View N = puzzle->GetPeerView( (*it)->GetX(), (*it)->GetY() );
+        // all values are possible, except what is already here
         Cell::MarkContainer possible;
         possible.set();
+        possible.reset( (*it)->DisplayedValue() );
         // iterator over neighbors and find what is possible
-        for ( Puzzle::Container::iterator neighbors = N.begin();
+        for ( Puzzle::View::iterator neighbors = N.begin();
               neighbors != N.end();
               ++neighbors )
         {
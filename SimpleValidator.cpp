@@ -1,6 +1,7 @@
 #include "SimpleValidator.h"
 #include "Puzzle.h"
 #include "Cell.h"
+#include "Units.h"
 
 namespace Sudoku
 {
@@ -31,73 +32,72 @@ std::shared_ptr<SimpleValidator> SimpleValidator::CreateGuessValidator()
 
 bool SimpleValidator::IsValid( std::shared_ptr<Puzzle> p )
 {
-    // check all Sectors for 9 unique values
-    
-    // start with the rows
-    for ( size_t r = 1; r <= 9; r++ )
+    unsigned char values[Units::CELL_COUNT];
+    unsigned char *v = values;
+    // rows in order give the Cells in index order
+    for ( size_t r = 0; r < Units::UNIT_SIZE; r++ )
     {
-        std::set<int> values;
-        Puzzle::Container row = p->GetCol( r );
-        for ( Puzzle::Container::iterator it = row.begin();
+        Puzzle::View row = p->GetUnitView( Units::FIRST_ROW + r );
+        for ( Puzzle::View::iterator it = row.begin();
               it != row.end();
               ++it )
         {
-            if ( (*_checker)(*it) != 0 )
-            {
-                values.insert( (*_checker)(*it) );
-            }
-        }
-        if ( values.size() != row.size() )
-        {
-            return false;
+            *v++ = static_cast<unsigned char>( (*_checker)(*it) );
         }
     }
+    return IsValid( values );
+}
 
-    // then columns
-    for ( size_t c = 1; c <= 9; c++ )
+bool SimpleValidator::IsValid( const unsigned char *values )
+{
+    // bits 1-9 set, bit 0 (blank) clear
+    const unsigned ALL = 0x3FE;
+    unsigned cols[Units::UNIT_SIZE] = { 0 };
+    unsigned blocks[3] = { 0 };
+    unsigned bad = 0;
+    for ( size_t r = 0; r < Units::UNIT_SIZE; r++ )
     {
-        std::set<int> values;
-        Puzzle::Container col = p->GetCol( c );
-        for ( Puzzle::Container::iterator it = col.begin();
-              it != col.end();
-              ++it )
+        unsigned row = 0;
+        for ( size_t c = 0; c < Units::UNIT_SIZE; c++ )
         {
-            if ( (*_checker)(*it) != 0 )
-            {
-                values.insert( (*_checker)(*it) );
-            }
+            unsigned v = values[r * Units::UNIT_SIZE + c];
+            // values over 15 would alias, anything over 9 never fills ALL
+            bad |= v >> 4;
+            unsigned bit = 1u << ( v & 0xF );
+            row |= bit;
+            cols[c] |= bit;
+            blocks[c / 3] |= bit;
         }
-        if ( values.size() != col.size() )
+        bad |= row ^ ALL;
+        if ( r % 3 == 2 )
         {
-            return false;
+            // a band of three blocks is done
+            bad |= ( blocks[0] ^ ALL ) | ( blocks[1] ^ ALL ) |
+                ( blocks[2] ^ ALL );
+            blocks[0] = blocks[1] = blocks[2] = 0;
         }
     }
+    for ( size_t c = 0; c < Units::UNIT_SIZE; c++ )
+    {
+        bad |= cols[c] ^ ALL;
+    }
+    return bad == 0;
+}
 
-    // then blocks
-    for ( size_t x = 1; x <= 3; x++ )
+size_t SimpleValidator::IsValid( const unsigned char *values, size_t count,
+                                 unsigned char *results )
+{
+    size_t valid = 0;
+    for ( size_t g = 0; g < count; g++, values += Units::CELL_COUNT )
     {
-        for ( size_t y = 1; y <= 3; y++ )
+        bool ok = IsValid( values );
+        valid += ok;
+        if ( results )
         {
-            std::set<int> values;
-            Puzzle::Container block = p->GetBlock( x, y );
-            for ( Puzzle::Container::iterator it = block.begin();
-                  it != block.end();
-                  ++it )
-            {
-                if ( (*_checker)(*it) != 0 )
-                {
-                    values.insert( (*_checker)(*it) );
-                }
-            }
-            if ( values.size() != block.size() )
-            {
-                return false;
-            }
+            results[g] = ok;
         }
-
     }
-
-    return true;
+    return valid;
 }
 
 }
@@ -2,6 +2,7 @@
 #define SUDOKU_CORRECT_VALIDATOR_H
 
 #include "IValidator.h"
+#include <cstddef>
 #include <memory>
 
 namespace Sudoku
@@ -38,7 +39,11 @@ public:
 };
 
 /**
- * Validates Puzzles by looping over all 27 sectors
+ * Validates Puzzles by checking all 27 sectors with bitmasks
+ * Each value becomes one bit, a sector is valid when the OR of its 9 bits
+ * is exactly values 1-9 (so no blanks and no repeats), with no branches.
+ * The kernel works on 81 packed values, so whole files of solutions can be
+ * checked without building Puzzles.
  */
 class SimpleValidator : public IValidator
 {
@@ -61,6 +66,24 @@ public:
      */
     virtual bool IsValid( std::shared_ptr<Puzzle> p );
 
+    /**
+     * Check 81 packed values (0 for blank), indexed as in Units
+     * @param values 81 values
+     * @return True if every sector has each of 1-9 once
+     */
+    static bool IsValid( const unsigned char *values );
+
+    /**
+     * Check many grids of 81 packed values in one call
+     * An array of GridRecords can be passed as is
+     * @param values count grids of 81 values each, back to back
+     * @param count Number of grids
+     * @param results If not NULL, set to 1 or 0 for each grid
+     * @return Number of valid grids
+     */
+    static size_t IsValid( const unsigned char *values, size_t count,
+                           unsigned char *results );
+
 private:
     SimpleValidator( const SimpleValidator & );
     SimpleValidator & operator=( const SimpleValidator & );
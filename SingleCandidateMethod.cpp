@@ -22,7 +22,7 @@ void SingleCandidateMethod::ExecuteForward()
 bool SingleCandidateMethod::VerifyForwardConditions()
 {
     // check that there is one mark, no correct value displayed, and no guess
-    return ( _cell->GetMarkedValues().size() == 1 &&
+    return ( _cell->CountMarks() == 1 &&
              _cell->CanGuess() && _cell->DisplayedValue() == 0 );
 }
 
@@ -37,7 +37,7 @@ void SingleCandidateMethod::ExecuteReverse()
 bool SingleCandidateMethod::VerifyReverseConditions()
 {
     // check that there are no marks and a guess is set
-    return ( _cell->GetMarkedValues().empty() &&
+    return ( _cell->CountMarks() == 0 &&
              _cell->CanGuess() && _cell->DisplayedValue() != 0 );
 }
 
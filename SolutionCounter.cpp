@@ -0,0 +1,58 @@
+#include "SolutionCounter.h"
+#include "BacktrackingSolver.h"
+#include "CandidateGrid.h"
+#include "Grid.h"
+#include "Puzzle.h"
+
+#include <stdexcept>
+
+#include "Log.h"
+
+namespace Sudoku
+{
+
+size_t SolutionCounter::CountSolutions( std::shared_ptr<const Puzzle> p,
+                                        size_t limit )
+{
+    if ( !p )
+    {
+        throw std::runtime_error( "Cannot count solutions of NULL Puzzle." );
+    }
+    CandidateGrid g;
+    Puzzle::ConstView all = p->GetAllView();
+    size_t i = 0;
+    for ( Puzzle::ConstView::iterator it = all.begin();
+          it != all.end() && g.IsConsistent();
+          ++it, ++i )
+    {
+        if ( !(*it)->CanGuess() && (*it)->DisplayedValue() != 0 )
+        {
+            g.Place( i, (*it)->DisplayedValue() );
+        }
+    }
+    if ( !g.IsConsistent() )
+    {
+        FILE_LOG(logINFO) << "Givens conflict, Puzzle has no solution.";
+        return 0;
+    }
+    return BacktrackingSolver::Search( g, limit, NULL );
+}
+
+size_t SolutionCounter::CountSolutions( const Grid &g, size_t limit )
+{
+    CandidateGrid c;
+    for ( size_t i = 0; i < Grid::ARRAY_SIZE && c.IsConsistent(); i++ )
+    {
+        if ( g[i].given && g[i].value != 0 )
+        {
+            c.Place( i, g[i].value );
+        }
+    }
+    if ( !c.IsConsistent() )
+    {
+        return 0;
+    }
+    return BacktrackingSolver::Search( c, limit, NULL );
+}
+
+}
@@ -0,0 +1,47 @@
+#ifndef SUDOKU_SOLUTION_COUNTER_H
+#define SUDOKU_SOLUTION_COUNTER_H
+
+#include "ISolutionCounter.h"
+
+namespace Sudoku
+{
+
+/**
+ * Counts solutions with the BacktrackingSolver search
+ * The givens are loaded straight into a CandidateGrid on the stack, so a
+ * check does not allocate and costs about as much as solving the Puzzle
+ * (twice for a uniqueness check, which has to rule out a second solution).
+ */
+class SolutionCounter : public ISolutionCounter
+{
+public:
+    SolutionCounter() {}
+
+    /**
+     * Count the solutions of a Puzzle
+     * @param p Puzzle to check, it is only read (never copied or changed)
+     * @param limit Stop counting once this many solutions are found
+     * @return number of solutions, at most limit (0 if the givens conflict)
+     * @throw std::runtime_error if p is NULL
+     */
+    virtual size_t CountSolutions( std::shared_ptr<const Puzzle> p,
+                                   size_t limit );
+
+    /**
+     * Count the solutions of a Grid
+     * @param g Grid to check, only values marked as given count
+     * @param limit Stop counting once this many solutions are found
+     * @return number of solutions, at most limit (0 if the givens conflict)
+     */
+    virtual size_t CountSolutions( const Grid &g, size_t limit );
+
+    virtual ~SolutionCounter() {}
+
+private:
+    SolutionCounter( const SolutionCounter & );
+    SolutionCounter & operator=( const SolutionCounter & );
+};
+
+}
+
+#endif
@@ -6,7 +6,11 @@
 #include "SingleCandidateMethod.h"
 #include "ExclusionMethod.h"
 #include "BlockIntersectionMethod.h"
+#include "ChainMethod.h"
 #include "CoveringSetMethod.h"
+#include "FishMethod.h"
+#include "HiddenSingleMethod.h"
+#include "MethodArena.h"
 
 namespace Sudoku
 {
@@ -14,13 +18,33 @@ namespace Sudoku
 /**
  * This creates the actual Solution Method objects
  * It is mostly useful to make the PuzzleHelper testable
+ * With an arena set, methods and their shared_ptr bookkeeping are placed in
+ * it instead of the heap (see MethodArena), so a solve can find and run
+ * methods without calling malloc.
  */
 class SolutionMethodFactory
 {
 public:
+    SolutionMethodFactory() : _arena( 0 ) {}
+
+    virtual ~SolutionMethodFactory() {}
+
+    /**
+     * Choose where new methods go
+     * @param arena Arena to create methods in, NULL for the heap
+     * @pre arena outlives every method created in it
+     */
+    void SetArena( MethodArena *arena ) { _arena = arena; }
+
+    MethodArena * GetArena() const { return _arena; }
+
     virtual std::shared_ptr<SolutionMethod> CreateSingleCandidateMethod(
         std::shared_ptr<Cell> c )
     {
+        if ( _arena )
+        {
+            return own( _arena->Create<SingleCandidateMethod>( c ) );
+        }
         std::shared_ptr<SolutionMethod> s(
             new SingleCandidateMethod( c ) );
         return s;
@@ -30,6 +54,10 @@ public:
         std::shared_ptr<Puzzle> p,
         std::shared_ptr<Cell> c )
     {
+        if ( _arena )
+        {
+            return own( _arena->Create<ExclusionMethod>( p, c ) );
+        }
         std::shared_ptr<SolutionMethod> s(
             new ExclusionMethod( p, c ) );
         return s;
@@ -38,22 +66,90 @@ public:
     virtual std::shared_ptr<SolutionMethod> CreateBlockIntersectionMethod(
         std::shared_ptr<Cell> c,
         unsigned mark,
-        Puzzle::Container primary,
-        Puzzle::Container secondary )
+        const Puzzle::Container &primary,
+        const Puzzle::Container &secondary )
     {
+        if ( _arena )
+        {
+            return own( _arena->Create<BlockIntersectionMethod>(
+                            c, mark, primary, secondary ) );
+        }
         std::shared_ptr<SolutionMethod> s(
             new BlockIntersectionMethod( c, mark, primary, secondary ) );
         return s;
     }
 
     virtual std::shared_ptr<SolutionMethod> CreateCoveringSetMethod(
-        Puzzle::Container sector,
-        Puzzle::Container subset )
+        const Puzzle::Container &sector,
+        const Puzzle::Container &subset )
     {
+        if ( _arena )
+        {
+            return own( _arena->Create<CoveringSetMethod>( sector, subset ) );
+        }
         std::shared_ptr<SolutionMethod> s(
             new CoveringSetMethod( sector, subset ) );
         return s;
     }
+
+    virtual std::shared_ptr<SolutionMethod> CreateHiddenSingleMethod(
+        std::shared_ptr<Cell> c,
+        unsigned mark,
+        const Puzzle::View &sector )
+    {
+        if ( _arena )
+        {
+            return own( _arena->Create<HiddenSingleMethod>( c, mark, sector ) );
+        }
+        std::shared_ptr<SolutionMethod> s(
+            new HiddenSingleMethod( c, mark, sector ) );
+        return s;
+    }
+
+    virtual std::shared_ptr<SolutionMethod> CreateFishMethod(
+        std::shared_ptr<Puzzle> p,
+        unsigned mark,
+        const Bitboard &base,
+        const Bitboard &cover )
+    {
+        if ( _arena )
+        {
+            return own( _arena->Create<FishMethod>( p, mark, base, cover ) );
+        }
+        std::shared_ptr<SolutionMethod> s(
+            new FishMethod( p, mark, base, cover ) );
+        return s;
+    }
+
+    virtual std::shared_ptr<SolutionMethod> CreateChainMethod(
+        std::shared_ptr<Puzzle> p,
+        const Chains::Chain &chain )
+    {
+        if ( _arena )
+        {
+            return own( _arena->Create<ChainMethod>( p, chain ) );
+        }
+        std::shared_ptr<SolutionMethod> s( new ChainMethod( p, chain ) );
+        return s;
+    }
+
+private:
+    SolutionMethodFactory( const SolutionMethodFactory & );
+    SolutionMethodFactory & operator=( const SolutionMethodFactory & );
+
+    /**
+     * Share a method made in the arena, the control block goes there too
+     */
+    template <class T>
+    std::shared_ptr<SolutionMethod> own( T *method )
+    {
+        return std::shared_ptr<SolutionMethod>(
+            method,
+            MethodArena::Destroyer<T>( *_arena ),
+            MethodArena::Allocator<T>( *_arena ) );
+    }
+
+    MethodArena *_arena;
 };
 
 }
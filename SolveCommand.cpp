@@ -27,33 +27,36 @@ bool SolveCommand::execute( std::shared_ptr<Puzzle> p )
         throw std::runtime_error(
             "Cannot execute hint command without solver." );
     }
-    if ( _copyPuzzle )
+    if ( _snapshot )
     {
         throw std::runtime_error(
             "The old puzzle state was not cleared properly on last execute." );
     }
     // store old state
-    _copyPuzzle.reset( new Puzzle( *p ) );
-    _solver->Solve( p );
+    _snapshot = p->TakeSnapshot();
+    try
+    {
+        _solver->Solve( p );
+    }
+    catch ( ... )
+    {
+        // do not leave a half solved Puzzle behind
+        p->Restore( _snapshot );
+        _snapshot.reset();
+        throw;
+    }
     return true;
 }
 
 bool SolveCommand::unexecute( std::shared_ptr<Puzzle> p )
 {
-    if ( !_copyPuzzle )
+    if ( !_snapshot )
     {
         throw std::runtime_error(
             "The old puzzle was not stored properly on last execute." );
     }
-    Puzzle::Container all = p->GetAllCells();
-    Puzzle::Container copy = _copyPuzzle->GetAllCells();
-    for ( Puzzle::Container::iterator it = all.begin(), it2 = copy.begin();
-          it != all.end();
-          ++it, ++it2 )
-    {
-        *(*it) = *(*it2);
-    }
-    _copyPuzzle.reset();
+    p->Restore( _snapshot );
+    _snapshot.reset();
     return true;
 }
 
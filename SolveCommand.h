@@ -10,6 +10,7 @@ namespace Sudoku
 {
 
 class Puzzle;
+class PuzzleSnapshot;
 class ISolver;
 
 /**
@@ -41,6 +42,7 @@ protected:
      * @pre we can execute
      * @param non-const Puzzle to execute on
      * @return Success or Failure
+     * @throw whatever the solver throws, the Puzzle is put back first
      * @post we can unexecute
      */
     virtual bool execute( std::shared_ptr<Puzzle> p );
@@ -60,8 +62,8 @@ private:
 
     /// Marker can add hints
     std::shared_ptr<ISolver> _solver;
-    /// Need to store old values (Memento)
-    std::shared_ptr<Puzzle> _copyPuzzle;
+    /// Need to store old values (Memento), only changed Cells are kept
+    std::shared_ptr<const PuzzleSnapshot> _snapshot;
 };
 
 }
@@ -0,0 +1,73 @@
+#include "SolveStats.h"
+
+#include <stdexcept>
+
+namespace Sudoku
+{
+
+namespace
+{
+
+const char *NAMES[PropagationQueue::RULE_COUNT] = {
+    "single_candidate",
+    "exclusion",
+    "hidden_single",
+    "block_intersection",
+    "covering_set",
+    "fish",
+    "chain"
+};
+
+}
+
+SolveStats::SolveStats()
+{
+    Reset();
+}
+
+void SolveStats::Reset()
+{
+    for ( size_t k = 0; k < PropagationQueue::RULE_COUNT; k++ )
+    {
+        Method &m = methods[k];
+        m.runs = 0;
+        m.found = 0;
+        m.verified = 0;
+        m.executed = 0;
+        m.eliminated = 0;
+        m.findNanos = 0;
+        m.executeNanos = 0;
+    }
+    passes = 0;
+    validations = 0;
+}
+
+SolveStats& SolveStats::operator+=( const SolveStats &other )
+{
+    for ( size_t k = 0; k < PropagationQueue::RULE_COUNT; k++ )
+    {
+        Method &m = methods[k];
+        const Method &o = other.methods[k];
+        m.runs += o.runs;
+        m.found += o.found;
+        m.verified += o.verified;
+        m.executed += o.executed;
+        m.eliminated += o.eliminated;
+        m.findNanos += o.findNanos;
+        m.executeNanos += o.executeNanos;
+    }
+    passes += other.passes;
+    validations += other.validations;
+    return *this;
+}
+
+const char* SolveStats::GetName( size_t rule )
+{
+    if ( rule >= PropagationQueue::RULE_COUNT )
+    {
+        throw std::invalid_argument( "No such Method." );
+    }
+    return NAMES[rule];
+}
+
+}
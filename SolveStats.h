@@ -0,0 +1,73 @@
+#ifndef SUDOKU_SOLVE_STATS_H
+#define SUDOKU_SOLVE_STATS_H
+
+#include <cstddef>
+#include <stdint.h>
+
+#include "PropagationQueue.h"
+
+namespace Sudoku
+{
+
+/**
+ * What a MethodSolver did, per kind of Method
+ * Methods are counted by the rule which found them (see PropagationQueue),
+ * which is one kind of Method each.  Finding covers the SolverHelper and
+ * the bookkeeping around it, executing covers verifying and executing the
+ * Methods found; both are wall clock time from a monotonic clock.
+ *
+ * Collecting them reads the clock around every rule and counts the marks
+ * of the Puzzle around every execution, so it is off unless asked for (see
+ * MethodSolver::SetStatsEnabled).
+ */
+struct SolveStats
+{
+    /// Counters of one kind of Method
+    struct Method
+    {
+        /// Times the rule ran
+        size_t runs;
+        /// Methods returned by the SolverHelper
+        size_t found;
+        /// Methods whose forward conditions were verified
+        size_t verified;
+        /// Methods executed, i.e. whose conditions held
+        size_t executed;
+        /// Marks removed from Cells without a value, including the marks of
+        /// a Cell a value was placed in
+        size_t eliminated;
+        /// Time spent finding Methods, in nanoseconds
+        uint64_t findNanos;
+        /// Time spent verifying and executing Methods, in nanoseconds
+        uint64_t executeNanos;
+    };
+
+    SolveStats();
+
+    /**
+     * Set every counter to 0
+     */
+    void Reset();
+
+    /**
+     * Add the counters of another solve, to follow many Puzzles
+     */
+    SolveStats& operator+=( const SolveStats &other );
+
+    /**
+     * Name of a kind of Method, e.g. "hidden_single"
+     * @param rule Rule which finds it, in range [0,RULE_COUNT)
+     */
+    static const char* GetName( size_t rule );
+
+    /// Per kind of Method, indexed by PropagationQueue::Rule
+    Method methods[PropagationQueue::RULE_COUNT];
+    /// Rules run, over all kinds
+    size_t passes;
+    /// Calls to IValidator::IsValid
+    size_t validations;
+};
+
+}
+
+#endif
@@ -1,10 +1,16 @@
 #include "SolverHelper.h"
 
 #include "Puzzle.h"
+#include "CoveringSets.h"
+
+#include <stdexcept>
 
 #include "BlockIntersectionMethod.h"
+#include "ChainMethod.h"
 #include "CoveringSetMethod.h"
 #include "ExclusionMethod.h"
+#include "FishMethod.h"
+#include "HiddenSingleMethod.h"
 #include "SingleCandidateMethod.h"
 
 #include "SolutionMethodFactory.h"
@@ -16,16 +22,6 @@ namespace Sudoku
 namespace
 {
 
-Cell::MarkContainer ContainerMarks( const Puzzle::Container &c )
-{
-    Cell::MarkContainer allMarks;
-    for ( Puzzle::Container::iterator it = c.begin(); it != c.end(); ++it )
-    {
-        allMarks |= (*it)->GetMarkContainer();
-    }
-    return allMarks;
-}
-
 // functor to remove cells we don't need from CoveringSetMethod
 class CellHasMarks : public std::unary_function<const std::shared_ptr<Cell>,
                                                 bool>
@@ -40,36 +36,107 @@ public:
     }
 };
 
-// functor to find if a given Cell has one of the given marks
-class CellHasGivenMarks
-    : public std::unary_function<const std::shared_ptr<Cell>, bool>
+// candidates of a Cell as a 9-bit mask, bit value - 1
+unsigned short MarkMask( const std::shared_ptr<Cell> &c )
+{
+    return static_cast<unsigned short>(
+        ( c->GetMarkContainer().to_ulong() >> 1 ) & 0x1FF );
+}
+
+// check a mask is not inside any of a list
+bool NotInside( unsigned short cells, const std::vector<unsigned short> &sets )
+{
+    for ( std::vector<unsigned short>::const_iterator it = sets.begin();
+          it != sets.end();
+          ++it )
+    {
+        if ( ( cells & ~*it ) == 0 )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Cells of one unit outside another, marks are found without allocating and
+// the Container is built the first time it is asked for
+class UnitDifference
 {
 public:
-    CellHasGivenMarks( const Cell::MarkContainer &m ) : _marks( m ) {}
-    bool operator() ( const std::shared_ptr<Cell> &c ) const
+    UnitDifference( Puzzle &p, size_t u, size_t v )
+        : _view( p.GetUnitView( u ) ), _u( u ), _v( v ), _built( false )
     {
-        // check if it has any marks in common
-        return (c->GetMarkContainer() & _marks).any();
+        size_t k = 0;
+        for ( Puzzle::View::iterator it = _view.begin();
+              it != _view.end();
+              ++it, ++k )
+        {
+            if ( !inside( k ) && (*it)->CanGuess() &&
+                 (*it)->DisplayedValue() == 0 )
+            {
+                _marks |= (*it)->GetMarkContainer();
+            }
+        }
     }
+
+    const Cell::MarkContainer & Marks() const { return _marks; }
+
+    const Puzzle::Container & Cells()
+    {
+        if ( !_built )
+        {
+            size_t k = 0;
+            for ( Puzzle::View::iterator it = _view.begin();
+                  it != _view.end();
+                  ++it, ++k )
+            {
+                if ( !inside( k ) )
+                {
+                    _cells.insert( _cells.end(), *it );
+                }
+            }
+            _built = true;
+        }
+        return _cells;
+    }
+
 private:
+    bool inside( size_t k ) const
+    {
+        return Units::UNIT_BOARDS[_v].Test( Units::UNIT_CELLS[_u][k] );
+    }
+
+    Puzzle::View _view;
+    size_t _u;
+    size_t _v;
     Cell::MarkContainer _marks;
+    bool _built;
+    Puzzle::Container _cells;
 };
 
 }
 
 SolverHelper::MethodContainer SolverHelper::GetAllSingleCandidate(
     std::shared_ptr<Puzzle> p )
+{
+    return GetAllSingleCandidate( p, Bitboard::All() );
+}
+
+SolverHelper::MethodContainer SolverHelper::GetAllSingleCandidate(
+    std::shared_ptr<Puzzle> p,
+    Bitboard cells )
 {
     MethodContainer m;
     // iterate over cells
-    Puzzle::Container all = p->GetAllCells();
-    for ( Puzzle::Container::iterator it = all.begin(); it != all.end(); ++it )
+    while ( cells.Any() )
     {
-        if ( (*it)->CanGuess() && (*it)->DisplayedValue() == 0 &&
-             (*it)->GetMarkedValues().size() == 1 )
+        size_t i = cells.PopFirst();
+        std::shared_ptr<Cell> c = p->GetCell( i % 9 + 1, i / 9 + 1 );
+        if ( c->CanGuess() && c->DisplayedValue() == 0 &&
+             c->CountMarks() == 1 )
         {
             std::shared_ptr<SolutionMethod> candidate(
-                _factory->CreateSingleCandidateMethod( *it ) );
+                _factory->CreateSingleCandidateMethod( c ) );
             m.push_back( candidate );
         }
     }
@@ -79,24 +146,32 @@ SolverHelper::MethodContainer SolverHelper::GetAllSingleCandidate(
 
 SolverHelper::MethodContainer SolverHelper::GetAllExclusion(
     std::shared_ptr<Puzzle> p )
+{
+    return GetAllExclusion( p, Bitboard::All() );
+}
+
+SolverHelper::MethodContainer SolverHelper::GetAllExclusion(
+    std::shared_ptr<Puzzle> p,
+    Bitboard cells )
 {
     MethodContainer m;
-    Puzzle::Container all = p->GetAllCells();
-    for ( Puzzle::Container::iterator it = all.begin(); it != all.end(); ++it )
+    while ( cells.Any() )
     {
-        if ( (*it)->CanGuess() && (*it)->DisplayedValue() != 0 )
+        size_t i = cells.PopFirst();
+        std::shared_ptr<Cell> c = p->GetCell( i % 9 + 1, i / 9 + 1 );
+        if ( c->CanGuess() && c->DisplayedValue() != 0 )
         {
-            // need to check neighbors
-            Puzzle::Container N = p->GetNeighbors( *it );
-            int guess = (*it)->DisplayedValue();
-            for ( Puzzle::Container::iterator it2 = N.begin();
+            // need to check peers
+            Puzzle::View N = p->GetPeerView( c->GetX(), c->GetY() );
+            int guess = c->DisplayedValue();
+            for ( Puzzle::View::iterator it2 = N.begin();
                   it2 != N.end();
                   ++it2 )
             {
                 if ( (*it2)->CanGuess() && (*it2)->GetMarkContainer()[guess] )
                 {
                     std::shared_ptr<SolutionMethod> exclusion(
-                        _factory->CreateExclusionMethod( p, *it ) );
+                        _factory->CreateExclusionMethod( p, c ) );
                     m.push_back( exclusion );
                     break;
                 }
@@ -107,75 +182,77 @@ SolverHelper::MethodContainer SolverHelper::GetAllExclusion(
     return m;
 }
 
+SolverHelper::MethodContainer SolverHelper::GetAllHiddenSingle(
+    std::shared_ptr<Puzzle> p )
+{
+    MethodContainer m;
+    Bitboard found = Bitboard::None();
+    for ( size_t u = 0; u < Units::UNIT_COUNT; u++ )
+    {
+        findHiddenSingles( p, u, found, m );
+    }
+    return m;
+}
+
+SolverHelper::MethodContainer SolverHelper::GetAllHiddenSingle(
+    std::shared_ptr<Puzzle> p,
+    size_t unit )
+{
+    MethodContainer m;
+    Bitboard found = Bitboard::None();
+    findHiddenSingles( p, unit, found, m );
+    return m;
+}
+
 SolverHelper::MethodContainer SolverHelper::GetAllBlockIntersection(
     std::shared_ptr<Puzzle> p,
     std::shared_ptr<Cell> c )
 {
     MethodContainer m;
     // look at every mark on c
-    Cell::MarkedValues marks = c->GetMarkedValues();
-
-    // get all groupings of row\block, block\row, col\block, block\col
-    Puzzle::Container row = p->GetRow( c->GetY() );
-    Puzzle::Container col = p->GetCol( c->GetX() );
-    Puzzle::Container block = p->GetBlock( c );
-
-    Puzzle::Container rowMinusBlock;
-    std::set_difference( row.begin(), row.end(),
-                         block.begin(), block.end(),
-                         std::inserter( rowMinusBlock, rowMinusBlock.begin() ),
-                         row.value_comp() );
-    Cell::MarkContainer rowMinusBlockMarks = ContainerMarks( rowMinusBlock );
-
-    Puzzle::Container colMinusBlock;
-    std::set_difference( col.begin(), col.end(),
-                         block.begin(), block.end(),
-                         std::inserter( colMinusBlock, colMinusBlock.begin() ),
-                         col.value_comp() );
-    Cell::MarkContainer colMinusBlockMarks = ContainerMarks( colMinusBlock );
-
-    Puzzle::Container blockMinusRow;
-    std::set_difference( block.begin(), block.end(),
-                         row.begin(), row.end(),
-                         std::inserter( blockMinusRow, blockMinusRow.begin() ),
-                         block.value_comp() );
-    Cell::MarkContainer blockMinusRowMarks = ContainerMarks( blockMinusRow );
-
-    Puzzle::Container blockMinusCol;
-    std::set_difference( block.begin(), block.end(),
-                         col.begin(), col.end(),
-                         std::inserter( blockMinusCol, blockMinusCol.begin() ),
-                         block.value_comp() );
-    Cell::MarkContainer blockMinusColMarks = ContainerMarks( blockMinusCol );
-
-    for ( Cell::MarkedValues::iterator it = marks.begin();
-          it != marks.end();
-          ++it )
+    Cell::MarkContainer marks = c->GetMarkContainer();
+
+    // all groupings of row\block, block\row, col\block, block\col, the
+    // Containers are only built for a Method which uses them
+    size_t i = Units::Index( c->GetX(), c->GetY() );
+    size_t row = Units::CELL_UNITS[i][0];
+    size_t col = Units::CELL_UNITS[i][1];
+    size_t block = Units::CELL_UNITS[i][2];
+    UnitDifference rowMinusBlock( *p, row, block );
+    UnitDifference colMinusBlock( *p, col, block );
+    UnitDifference blockMinusRow( *p, block, row );
+    UnitDifference blockMinusCol( *p, block, col );
+
+    for ( size_t mark = 1; mark < marks.size(); mark++ )
     {
+        if ( !marks[mark] )
+        {
+            continue;
+        }
         std::shared_ptr<SolutionMethod> method;
-        if ( rowMinusBlockMarks[*it] && !blockMinusRowMarks[*it] )
+        if ( rowMinusBlock.Marks()[mark] && !blockMinusRow.Marks()[mark] )
         {
             method =  _factory->CreateBlockIntersectionMethod(
-                c, *it, rowMinusBlock, blockMinusRow );
+                c, mark, rowMinusBlock.Cells(), blockMinusRow.Cells() );
             m.push_back( method );
         }
-        else if ( !rowMinusBlockMarks[*it] && blockMinusRowMarks[*it] )
+        else if ( !rowMinusBlock.Marks()[mark] && blockMinusRow.Marks()[mark] )
         {
             method = _factory->CreateBlockIntersectionMethod(
-                c, *it, blockMinusRow, rowMinusBlock );
+                c, mark, blockMinusRow.Cells(), rowMinusBlock.Cells() );
             m.push_back( method );
         }
 
-        if ( colMinusBlockMarks[*it] && !blockMinusColMarks[*it] )
+        if ( colMinusBlock.Marks()[mark] && !blockMinusCol.Marks()[mark] )
         {
             method = _factory->CreateBlockIntersectionMethod(
-                c, *it, colMinusBlock, blockMinusCol );
+                c, mark, colMinusBlock.Cells(), blockMinusCol.Cells() );
             m.push_back( method );
         }
-        else if ( !colMinusBlockMarks[*it] && blockMinusColMarks[*it] )
+        else if ( !colMinusBlock.Marks()[mark] && blockMinusCol.Marks()[mark] )
         {
             method = _factory->CreateBlockIntersectionMethod(
-                c, *it, blockMinusCol, colMinusBlock );
+                c, mark, blockMinusCol.Cells(), colMinusBlock.Cells() );
             m.push_back( method );
         }
     }
@@ -187,205 +264,242 @@ SolverHelper::MethodContainer SolverHelper::GetAllCoveringSet(
     std::shared_ptr<Puzzle> p,
     const Puzzle::Container &sector )
 {
-    MethodContainer m;
-    // cut sector down to cells with no guess and some marks
-    std::vector<std::shared_ptr<Cell> > prunedSector;
-    std::copy_if( sector.begin(), sector.end(),
-                  std::back_inserter( prunedSector ),
-                  CellHasMarks() );
+    if ( sector.size() > Units::UNIT_SIZE )
+    {
+        throw std::invalid_argument( "Covering sets are found in a unit." );
+    }
+    return findCoveringSets( SectorCells( sector.begin(), sector.end() ),
+                             &sector );
+}
 
-    // keep a list of possible subsets and then reduce the list
-    std::vector<Puzzle::Container> subsets;
+SolverHelper::MethodContainer SolverHelper::GetAllCoveringSet(
+    std::shared_ptr<Puzzle> p,
+    size_t unit )
+{
+    Puzzle::View view = p->GetUnitView( unit );
+    return findCoveringSets( SectorCells( view.begin(), view.end() ), 0 );
+}
+
+SolverHelper::MethodContainer SolverHelper::GetAllFish(
+    std::shared_ptr<Puzzle> p )
+{
+    return GetAllFish( p, 0x1FF );
+}
 
-    // look at n-tuples (n=2,3,4)
-    if ( prunedSector.size() >= 2 )
+SolverHelper::MethodContainer SolverHelper::GetAllFish(
+    std::shared_ptr<Puzzle> p,
+    unsigned short digits )
+{
+    // columns of each mark in each row, and the rows and columns where a
+    // digit is placed
+    unsigned short rows[Units::UNIT_SIZE][Units::UNIT_SIZE] = { { 0 } };
+    unsigned short placedRows[Units::UNIT_SIZE] = { 0 };
+    unsigned short placedCols[Units::UNIT_SIZE] = { 0 };
+    Puzzle::View all = p->GetAllView();
+    size_t i = 0;
+    for ( Puzzle::View::iterator it = all.begin(); it != all.end(); ++it, ++i )
     {
-        std::vector<std::shared_ptr<Cell> >::iterator first;
-        std::vector<std::shared_ptr<Cell> >::iterator second;
-        std::vector<std::shared_ptr<Cell> >::iterator third;
-        std::vector<std::shared_ptr<Cell> >::iterator fourth;
-        for ( first = prunedSector.begin();
-              first != prunedSector.end();
-              ++first )
+        size_t row = i / Units::UNIT_SIZE;
+        size_t col = i % Units::UNIT_SIZE;
+        int value = (*it)->DisplayedValue();
+        if ( value != 0 )
         {
-            //std::cout << **first << std::endl;
-            Puzzle::Container temp;
-            // need to look at the remaining Cells to find the guess
-            Puzzle::Container other;
-            temp.insert( *first );
-
-            for ( second = first + 1;
-                  second != prunedSector.end();
-                  ++second )
+            placedRows[value - 1] |= 1 << row;
+            placedCols[value - 1] |= 1 << col;
+        }
+        else if ( (*it)->CanGuess() )
+        {
+            unsigned long marks = (*it)->GetMarkContainer().to_ulong() >> 1;
+            for ( marks &= digits; marks; marks &= marks - 1 )
             {
-                //std::cout << "\t" << **second << std::endl;
-                bool triple = false;
-                temp.insert( *second );
-                // now check all 3-tuples
-                for ( third = second + 1;
-                      third != prunedSector.end();
-                      ++third )
-                {
-                    //std::cout << "\t\t" << **third<< std::endl;
-                    bool fourTuple = false;
-                    temp.insert( *third );
-                    // now check all 4-tuples
-                    for ( fourth = third + 1;
-                          fourth != prunedSector.end();
-                          ++fourth )
-                    {
-                        //std::cout << "\t\t\t" << **fourth << std::endl;
-                        temp.insert( *fourth );
-                        Cell::MarkContainer tempMarks = ContainerMarks( temp );
-                        if ( tempMarks.count() == 4 )
-                        {
-                            // check that we can remove a mark from the others
-                            other.clear();
-                            std::set_difference( prunedSector.begin(),
-                                                 prunedSector.end(),
-                                                 temp.begin(),
-                                                 temp.end(),
-                                                 std::inserter( other,
-                                                                other.begin() ),
-                                                 temp.value_comp() );
-                            if ( !other.empty() )
-                            {
-                                if ( std::find_if( other.begin(),
-                                                   other.end(),
-                                                   CellHasGivenMarks(
-                                                       tempMarks ) )
-                                     != other.end() )
-                                {
-                                    // ok these four work
-                                    subsets.push_back( temp );
-                                    fourTuple = true;
-                                }
-                            }
-                        }
-                        // remove before going to next fourth
-                        temp.erase( *fourth );
-                    }
-                    // ignore triple if it is a part of the larger group
-                    if ( !fourTuple )
-                    {
-                        // check triples after checking deeper
-                        Cell::MarkContainer tempMarks = ContainerMarks( temp );
-                        if ( tempMarks.count() == 3 )
-                        {
-                            // make sure we haven't already seen this
-                            bool unique = true;
-                            for ( std::vector<Puzzle::Container>::iterator it =
-                                      subsets.begin();
-                                  it != subsets.end();
-                                  ++it )
-                            {
-                                if ( std::includes( (*it).begin(), (*it).end(),
-                                                    temp.begin(), temp.end(),
-                                                    temp.value_comp() ) )
-                                {
-                                    unique = false;
-                                    break;
-                                }
-                            }
-                            if ( unique )
-                            {
-                                // check that we can remove a mark
-                                other.clear();
-                                std::set_difference(
-                                    prunedSector.begin(),
-                                    prunedSector.end(),
-                                    temp.begin(),
-                                    temp.end(),
-                                    std::inserter( other,
-                                                   other.begin() ),
-                                    temp.value_comp() );
-                                if ( !other.empty() )
-                                {
-                                    if ( std::find_if( other.begin(),
-                                                       other.end(),
-                                                       CellHasGivenMarks(
-                                                           tempMarks ) )
-                                         != other.end() )
-                                    {
-                                        // ok these three work
-                                        subsets.push_back( temp );
-                                        triple = true;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    else
-                    {
-                        triple = true;
-                    }
-                    // remove before going to next third
-                    temp.erase( *third );
-                }
-                // ignore pairs that are subsets
-                if ( !triple )
-                {
-                    // check pairs after checking deeper
-                    Cell::MarkContainer tempMarks = ContainerMarks( temp );
-                    if ( tempMarks.count() == 2 )
-                    {
-                        // make sure we haven't already seen this
-                        bool unique = true;
-                        for ( std::vector<Puzzle::Container>::iterator it =
-                                  subsets.begin();
-                              it != subsets.end();
-                              ++it )
-                        {
-                            if ( std::includes( (*it).begin(), (*it).end(),
-                                                temp.begin(), temp.end(),
-                                                temp.value_comp() ) )
-                            {
-                                unique = false;
-                                break;
-                            }
-                        }
-                        if ( unique )
-                        {
-                            // check that we can remove a mark from the others
-                            other.clear();
-                            std::set_difference( prunedSector.begin(),
-                                                 prunedSector.end(),
-                                                 temp.begin(),
-                                                 temp.end(),
-                                                 std::inserter( other,
-                                                                other.begin() ),
-                                                 temp.value_comp() );
-                            if ( !other.empty() )
-                            {
-                                if ( std::find_if( other.begin(),
-                                                   other.end(),
-                                                   CellHasGivenMarks(
-                                                       tempMarks ) )
-                                     != other.end() )
-                                {
-                                    // ok these two work
-                                    subsets.push_back( temp );
-                                }
-                            }
-                        }
-                    }
-                }
-                // remove before going to next second
-                temp.erase( *second );
+                rows[__builtin_ctzl( marks )][row] |= 1 << col;
+            }
+        }
+    }
+
+    MethodContainer m;
+    CoveringSets::FishContainer found;
+    for ( size_t size = FishMethod::MIN_SIZE; size <= FishMethod::MAX_SIZE;
+          size++ )
+    {
+        for ( size_t d = 0; d < Units::UNIT_SIZE; d++ )
+        {
+            if ( !( digits & ( 1 << d ) ) )
+            {
+                continue;
+            }
+            unsigned short open[Units::UNIT_SIZE];
+            for ( size_t r = 0; r < Units::UNIT_SIZE; r++ )
+            {
+                open[r] = ( placedRows[d] & ( 1 << r ) ) ?
+                    0 : rows[d][r] & ~placedCols[d];
+            }
+            found.clear();
+            CoveringSets::FindFish( open, size, found );
+            for ( CoveringSets::FishContainer::const_iterator it =
+                      found.begin();
+                  it != found.end();
+                  ++it )
+            {
+                std::shared_ptr<SolutionMethod> method(
+                    _factory->CreateFishMethod( p, d + 1, it->base,
+                                                it->cover ) );
+                m.push_back( method );
             }
         }
     }
+    return m;
+}
 
-    for ( std::vector<Puzzle::Container>::iterator it = subsets.begin();
-          it != subsets.end();
+SolverHelper::MethodContainer SolverHelper::GetAllChains(
+    std::shared_ptr<Puzzle> p,
+    const LinkGraph &graph,
+    Chains::Kind kind,
+    unsigned short digits )
+{
+    MethodContainer m;
+    Chains::ChainContainer found;
+    Chains::Find( graph, kind, digits, found );
+    for ( Chains::ChainContainer::const_iterator it = found.begin();
+          it != found.end();
           ++it )
     {
         std::shared_ptr<SolutionMethod> method(
-            _factory->CreateCoveringSetMethod(
-                sector, *it ) );
+            _factory->CreateChainMethod( p, *it ) );
+        m.push_back( method );
+    }
+    return m;
+}
+
+void SolverHelper::findHiddenSingles( std::shared_ptr<Puzzle> p,
+                                      size_t unit,
+                                      Bitboard &found,
+                                      MethodContainer &m )
+{
+    Puzzle::View sector = p->GetUnitView( unit );
+    // marks of each open Cell, bit value - 1
+    unsigned short marks[Units::UNIT_SIZE];
+    unsigned short once = 0;
+    unsigned short twice = 0;
+    unsigned short placed = 0;
+    size_t k = 0;
+    for ( Puzzle::View::iterator it = sector.begin();
+          it != sector.end();
+          ++it, ++k )
+    {
+        int value = (*it)->DisplayedValue();
+        marks[k] = 0;
+        if ( value != 0 )
+        {
+            placed |= 1 << ( value - 1 );
+        }
+        else if ( (*it)->CanGuess() )
+        {
+            marks[k] = static_cast<unsigned short>(
+                ( (*it)->GetMarkContainer().to_ulong() >> 1 ) & 0x1FF );
+            twice |= once & marks[k];
+            once |= marks[k];
+        }
+    }
+
+    unsigned short hidden = once & ~twice & ~placed;
+    while ( hidden )
+    {
+        unsigned short digit = hidden & -hidden;
+        hidden &= hidden - 1;
+        k = 0;
+        while ( !( marks[k] & digit ) )
+        {
+            ++k;
+        }
+        size_t i = Units::UNIT_CELLS[unit][k];
+        if ( found.Test( i ) )
+        {
+            continue;
+        }
+        found.Set( i );
+        std::shared_ptr<SolutionMethod> method(
+            _factory->CreateHiddenSingleMethod(
+                p->GetCell( i % 9 + 1, i / 9 + 1 ),
+                __builtin_ctz( digit ) + 1, sector ) );
         m.push_back( method );
     }
+}
+
+SolverHelper::MethodContainer SolverHelper::findCoveringSets(
+    const SectorCells &cells,
+    const Puzzle::Container *sector )
+{
+    MethodContainer m;
+    // masks of the Cells with no guess and some marks, by position
+    unsigned short candidates[Units::UNIT_SIZE] = { 0 };
+    unsigned short open = 0;
+    for ( size_t k = 0; k < cells.size(); k++ )
+    {
+        if ( CellHasMarks()( cells[k] ) )
+        {
+            candidates[k] = MarkMask( cells[k] );
+            open |= 1 << k;
+        }
+    }
+
+    CoveringSets::SetContainer found;
+    for ( size_t size = CoveringSets::MAX_SIZE;
+          size >= CoveringSets::MIN_SIZE;
+          --size )
+    {
+        CoveringSets::Find( candidates, size, found );
+    }
+
+    // larger naked sets come first, one inside them is left for later
+    std::vector<unsigned short> subsets;
+    for ( CoveringSets::SetContainer::iterator it = found.begin();
+          it != found.end();
+          ++it )
+    {
+        if ( !it->hidden && NotInside( it->cells, subsets ) )
+        {
+            subsets.push_back( it->cells );
+        }
+    }
+    // a hidden set is the same as the naked set of the other open Cells,
+    // which is how CoveringSetMethod removes its marks
+    for ( CoveringSets::SetContainer::iterator it = found.begin();
+          it != found.end();
+          ++it )
+    {
+        unsigned short rest = open & ~it->cells;
+        unsigned short marks = 0;
+        for ( unsigned short b = rest; b; b &= b - 1 )
+        {
+            marks |= candidates[__builtin_ctz( b )];
+        }
+        if ( it->hidden && rest &&
+             __builtin_popcount( marks ) == __builtin_popcount( rest ) &&
+             NotInside( rest, subsets ) )
+        {
+            subsets.push_back( rest );
+        }
+    }
 
+    // the sector is only needed as a Container for a Method
+    Puzzle::Container built;
+    for ( size_t s = 0; s < subsets.size(); s++ )
+    {
+        if ( !sector )
+        {
+            built.insert( cells.begin(), cells.end() );
+            sector = &built;
+        }
+        Puzzle::Container subset;
+        for ( unsigned short b = subsets[s]; b; b &= b - 1 )
+        {
+            subset.insert( cells[__builtin_ctz( b )] );
+        }
+        std::shared_ptr<SolutionMethod> method(
+            _factory->CreateCoveringSetMethod( *sector, subset ) );
+        m.push_back( method );
+    }
 
     return m;
 }
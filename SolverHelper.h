@@ -4,7 +4,11 @@
 #include <memory>
 #include <vector>
 
+#include "Bitboard.h"
+#include "CellArray.h"
+#include "Chains.h"
 #include "Puzzle.h"
+#include "Units.h"
 
 namespace Sudoku
 {
@@ -12,10 +16,14 @@ namespace Sudoku
 // Various solving methods we will find
 class SolutionMethod;
 class BlockIntersectionMethod;
+class ChainMethod;
 class CoveringSetMethod;
 class ExclusionMethod;
+class FishMethod;
+class HiddenSingleMethod;
 class SingleCandidateMethod;
 
+class LinkGraph;
 class SolutionMethodFactory;
 
 /**
@@ -49,6 +57,15 @@ public:
      */
     MethodContainer GetAllSingleCandidate( std::shared_ptr<Puzzle> p );
 
+    /**
+     * Gets the Cells with only one Mark among some Cells
+     * @param p Puzzle to look at
+     * @param cells Cells to look at (see Units for the index)
+     * @return Collection of SingleCandidateMethod ojbects which can be executed
+     */
+    MethodContainer GetAllSingleCandidate( std::shared_ptr<Puzzle> p,
+                                           Bitboard cells );
+
     // For ExclusionMethod, we do that for when adding a guess?
     /**
      * Get all the Cells with a guess with neighbors we can unmark
@@ -57,6 +74,32 @@ public:
      */
     MethodContainer GetAllExclusion( std::shared_ptr<Puzzle> p );
 
+    /**
+     * Get the Cells with a guess with neighbors we can unmark among some Cells
+     * @param p Puzzle to look at
+     * @param cells Cells to look at (see Units for the index)
+     * @return those Cells with guesses where neighbors have that mark
+     */
+    MethodContainer GetAllExclusion( std::shared_ptr<Puzzle> p,
+                                     Bitboard cells );
+
+    /**
+     * Get all the Cells which are the only place left for a mark in a unit
+     * Each Cell is given once, for the first unit it is hidden in
+     * @param p Puzzle to look at
+     * @return Collection of HiddenSingleMethod objects which can be executed
+     */
+    MethodContainer GetAllHiddenSingle( std::shared_ptr<Puzzle> p );
+
+    /**
+     * Get the hidden singles of one unit
+     * @param p Puzzle to look at
+     * @param unit Unit number (see Units)
+     * @pre unit is in range [0,26]
+     */
+    MethodContainer GetAllHiddenSingle( std::shared_ptr<Puzzle> p,
+                                        size_t unit );
+
     /**
      * Get all the ways to do a block intersection for a given Cell
      * This will attempt all combinations of Row/Column/Block
@@ -72,16 +115,83 @@ public:
     /**
      * Get all the covering sets for a given sector of a puzzle
      * This will look at a sector and find all groups of 2 to 4 cells
-     * Which have that same number of marks in common
+     * Which have that same number of marks in common (naked sets), and all
+     * groups of 2 to 4 marks found in only that many cells (hidden sets,
+     * given as the naked set of the other cells)
+     * A naked set inside a larger one is not returned
      * @param p Puzzle to look at
-     * @param sector Sector to look in
+     * @param sector Sector to look in, a unit of at most 9 Cells
      * @return Collection of CoveringSetMethod objects which can be executed
      *         in that sector
+     * @throw std::invalid_argument if the sector has more than 9 Cells
      */
     MethodContainer GetAllCoveringSet( std::shared_ptr<Puzzle> p,
                                        const Puzzle::Container &sector );
 
+    /**
+     * Get all the covering sets for a unit of a puzzle
+     * Same as for a sector, but the unit's Cells are only copied into a
+     * Container when a covering set is found
+     * @param p Puzzle to look at
+     * @param unit Unit number (see Units)
+     * @pre unit is in range [0,26]
+     */
+    MethodContainer GetAllCoveringSet( std::shared_ptr<Puzzle> p,
+                                       size_t unit );
+
+    /**
+     * Get all the X-Wings, Swordfish and Jellyfish of a puzzle
+     * The marks of each digit are turned into one mask of columns per row,
+     * which is searched like the Cells of a unit for covering sets
+     * @param p Puzzle to look at
+     * @return Collection of FishMethod objects which can be executed, the
+     *         smaller ones first
+     */
+    MethodContainer GetAllFish( std::shared_ptr<Puzzle> p );
+
+    /**
+     * Get the fish on some digits
+     * @param p Puzzle to look at
+     * @param digits Digits to look for, bit value - 1
+     */
+    MethodContainer GetAllFish( std::shared_ptr<Puzzle> p,
+                                unsigned short digits );
+
+    /**
+     * Get the chains of a kind which remove a mark
+     * @param p Puzzle to look at
+     * @param graph Links of p, up to date with its marks
+     * @param kind Kind of chain to look for
+     * @param digits Digits whose links changed, bit value - 1 (see Chains)
+     * @return Collection of ChainMethod objects which can be executed
+     */
+    MethodContainer GetAllChains( std::shared_ptr<Puzzle> p,
+                                  const LinkGraph &graph,
+                                  Chains::Kind kind,
+                                  unsigned short digits );
+
 private:
+    /// Cells of a sector in order
+    typedef CellArray<Units::UNIT_SIZE> SectorCells;
+
+    /**
+     * Find covering sets in a sector
+     * @param cells Cells of the sector
+     * @param sector The same Cells as a Container, NULL to build it if needed
+     */
+    MethodContainer findCoveringSets( const SectorCells &cells,
+                                      const Puzzle::Container *sector );
+
+    /**
+     * Find hidden singles in a unit
+     * Marks are counted per digit across the unit with two bit masks (seen
+     * once, seen twice), so a unit takes one pass over its 9 Cells
+     * @param found Cells already given, updated with the new ones
+     * @param m Methods are added here
+     */
+    void findHiddenSingles( std::shared_ptr<Puzzle> p, size_t unit,
+                            Bitboard &found, MethodContainer &m );
+
     SolverHelper( const SolverHelper & );
     SolverHelper & operator=( const SolverHelper & );
 
@@ -0,0 +1,314 @@
+#include "UndoHistory.h"
+
+#include <stdexcept>
+
+namespace Sudoku
+{
+
+const size_t UndoHistory::DEFAULT_MAX_BYTES;
+const size_t UndoHistory::MIN_MAX_BYTES;
+
+UndoHistory::UndoHistory( size_t maxBytes )
+    : _maxBytes( 0 ),
+      _head( 0 ),
+      _used( 0 ),
+      _undoable( 0 ),
+      _spilling( false ),
+      _spillEnd( 0 ),
+      _spilled( 0 )
+{
+    SetMaxBytes( maxBytes );
+}
+
+void UndoHistory::SetMaxBytes( size_t maxBytes )
+{
+    if ( maxBytes < MIN_MAX_BYTES )
+    {
+        throw std::invalid_argument( "Undo history memory cap is too small." );
+    }
+    Clear();
+    _maxBytes = maxBytes;
+    // release the old ring, the new one is sized on first use
+    DeltaContainer().swap( _ring );
+}
+
+void UndoHistory::SetSpillFile( const std::string &filename )
+{
+    Clear();
+    if ( _spill.is_open() )
+    {
+        _spill.close();
+    }
+    _spill.clear();
+    _spilling = false;
+    if ( filename.empty() )
+    {
+        return;
+    }
+    _spill.open( filename.c_str(), std::ios::in | std::ios::out |
+                 std::ios::trunc | std::ios::binary );
+    if ( !_spill )
+    {
+        throw std::runtime_error( "Cannot open undo spill file " + filename );
+    }
+    _spilling = true;
+}
+
+void UndoHistory::Record( const DeltaContainer &deltas )
+{
+    while ( CanRedo() )
+    {
+        dropNewest();
+    }
+    makeRoom( deltas.size() );
+    append( deltas.empty() ? NULL : &deltas[0], deltas.size() );
+}
+
+bool UndoHistory::Undo( DeltaContainer &deltas )
+{
+    if ( !CanUndo() )
+    {
+        return false;
+    }
+    if ( _undoable == 0 )
+    {
+        unspill();
+    }
+    --_undoable;
+    copyOut( _steps[_undoable], deltas );
+    return true;
+}
+
+bool UndoHistory::Redo( DeltaContainer &deltas )
+{
+    if ( !CanRedo() )
+    {
+        return false;
+    }
+    copyOut( _steps[_undoable], deltas );
+    ++_undoable;
+    return true;
+}
+
+void UndoHistory::Export( DeltaContainer &deltas,
+                          std::vector<uint32_t> &counts, size_t &undoable )
+{
+    deltas.clear();
+    counts.clear();
+    // the spill file is a stack, walk it from the newest step
+    std::vector<DeltaContainer> spilled;
+    std::streamoff end = _spillEnd;
+    for ( size_t i = 0; i < _spilled; i++ )
+    {
+        uint32_t count = 0;
+        _spill.seekg( end - static_cast<std::streamoff>( sizeof( count ) ) );
+        _spill.read( reinterpret_cast<char *>( &count ), sizeof( count ) );
+        end -= sizeof( count ) + count * sizeof( Delta );
+        spilled.push_back( DeltaContainer( count ) );
+        _spill.seekg( end );
+        if ( count > 0 )
+        {
+            _spill.read( reinterpret_cast<char *>( &spilled.back()[0] ),
+                         count * sizeof( Delta ) );
+        }
+        if ( !_spill )
+        {
+            throw std::runtime_error( "Cannot read undo spill file." );
+        }
+    }
+    for ( std::vector<DeltaContainer>::reverse_iterator it = spilled.rbegin();
+          it != spilled.rend();
+          ++it )
+    {
+        deltas.insert( deltas.end(), it->begin(), it->end() );
+        counts.push_back( static_cast<uint32_t>( it->size() ) );
+    }
+    DeltaContainer step;
+    for ( StepContainer::const_iterator it = _steps.begin();
+          it != _steps.end();
+          ++it )
+    {
+        copyOut( *it, step );
+        deltas.insert( deltas.end(), step.begin(), step.end() );
+        counts.push_back( static_cast<uint32_t>( step.size() ) );
+    }
+    undoable = _spilled + _undoable;
+}
+
+void UndoHistory::Import( const Delta *deltas, const uint32_t *counts,
+                          size_t steps, size_t undoable )
+{
+    Clear();
+    makeRoom( 0 );
+    size_t s = 0;
+    for ( ; s < undoable && s < steps; s++ )
+    {
+        makeRoom( counts[s] );
+        append( deltas, counts[s] );
+        deltas += counts[s];
+    }
+    // only steps to undo may be evicted for the ones to redo
+    size_t redo = 0;
+    for ( ; s < steps; s++, redo++ )
+    {
+        while ( !fits( counts[s] ) && _steps.size() > redo )
+        {
+            evictOldest();
+        }
+        if ( !fits( counts[s] ) )
+        {
+            break;
+        }
+        append( deltas, counts[s] );
+        deltas += counts[s];
+    }
+    _undoable = _steps.size() - redo;
+}
+
+void UndoHistory::Clear()
+{
+    _steps.clear();
+    _head = 0;
+    _used = 0;
+    _undoable = 0;
+    _spillEnd = 0;
+    _spilled = 0;
+}
+
+bool UndoHistory::fits( size_t count ) const
+{
+    return _used + count <= _ring.size() &&
+        ( _used + count ) * sizeof( Delta ) +
+        ( _steps.size() + 1 ) * sizeof( Step ) <= _maxBytes;
+}
+
+void UndoHistory::makeRoom( size_t count )
+{
+    if ( _ring.empty() )
+    {
+        _ring.resize( _maxBytes / sizeof( Delta ) );
+    }
+    while ( !fits( count ) )
+    {
+        if ( _steps.empty() )
+        {
+            throw std::invalid_argument( "Undo step is larger than the cap." );
+        }
+        evictOldest();
+    }
+}
+
+void UndoHistory::append( const Delta *deltas, size_t count )
+{
+    Step s;
+    s.start = ( _head + _used ) % _ring.size();
+    s.count = count;
+    size_t at = s.start;
+    for ( size_t i = 0; i < count; i++ )
+    {
+        _ring[at] = deltas[i];
+        if ( ++at == _ring.size() )
+        {
+            at = 0;
+        }
+    }
+    _used += count;
+    _steps.push_back( s );
+    ++_undoable;
+}
+
+void UndoHistory::evictOldest()
+{
+    const Step &s = _steps.front();
+    if ( _spilling )
+    {
+        DeltaContainer deltas;
+        copyOut( s, deltas );
+        uint32_t count = static_cast<uint32_t>( deltas.size() );
+        _spill.seekp( _spillEnd );
+        if ( count > 0 )
+        {
+            _spill.write( reinterpret_cast<const char *>( &deltas[0] ),
+                          count * sizeof( Delta ) );
+        }
+        _spill.write( reinterpret_cast<const char *>( &count ),
+                      sizeof( count ) );
+        if ( !_spill )
+        {
+            throw std::runtime_error( "Cannot write undo spill file." );
+        }
+        _spillEnd += count * sizeof( Delta ) + sizeof( count );
+        ++_spilled;
+    }
+    _head = ( _head + s.count ) % _ring.size();
+    _used -= s.count;
+    _steps.pop_front();
+    --_undoable;
+}
+
+void UndoHistory::dropNewest()
+{
+    _used -= _steps.back().count;
+    _steps.pop_back();
+}
+
+void UndoHistory::unspill()
+{
+    uint32_t count = 0;
+    _spill.seekg( _spillEnd - static_cast<std::streamoff>( sizeof( count ) ) );
+    _spill.read( reinterpret_cast<char *>( &count ), sizeof( count ) );
+    std::streamoff start = _spillEnd - sizeof( count ) - count * sizeof( Delta );
+    DeltaContainer deltas( count );
+    _spill.seekg( start );
+    if ( count > 0 )
+    {
+        _spill.read( reinterpret_cast<char *>( &deltas[0] ),
+                     count * sizeof( Delta ) );
+    }
+    if ( !_spill )
+    {
+        throw std::runtime_error( "Cannot read undo spill file." );
+    }
+    _spillEnd = start;
+    --_spilled;
+
+    // everything in memory can only be redone, give up the furthest steps
+    while ( !fits( count ) )
+    {
+        dropNewest();
+    }
+    Step s;
+    s.start = ( _head + _ring.size() - count ) % _ring.size();
+    s.count = count;
+    _head = s.start;
+    size_t at = s.start;
+    for ( DeltaContainer::const_iterator it = deltas.begin();
+          it != deltas.end();
+          ++it )
+    {
+        _ring[at] = *it;
+        if ( ++at == _ring.size() )
+        {
+            at = 0;
+        }
+    }
+    _used += count;
+    _steps.push_front( s );
+    ++_undoable;
+}
+
+void UndoHistory::copyOut( const Step &s, DeltaContainer &deltas ) const
+{
+    deltas.clear();
+    size_t at = s.start;
+    for ( size_t i = 0; i < s.count; ++i )
+    {
+        deltas.push_back( _ring[at] );
+        if ( ++at == _ring.size() )
+        {
+            at = 0;
+        }
+    }
+}
+
+}
@@ -0,0 +1,236 @@
+#ifndef SUDOKU_UNDO_HISTORY_H
+#define SUDOKU_UNDO_HISTORY_H
+
+#include <deque>
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "Cell.h"
+
+namespace Sudoku
+{
+
+/**
+ * Undo and redo history stored as the Cells each step changed
+ * A step is a run of deltas (Cell index, state before, state after, packed
+ * in 8 bytes) in a ring buffer which is allocated once, so a step costs
+ * only the Cells it changed instead of a copy of what its Command saw.
+ *
+ * Memory is capped: recording a step which does not fit evicts the oldest
+ * steps.  Evicted steps are lost, unless a spill file is set, then they are
+ * appended to it and read back once Undo gets to them.
+ */
+class UndoHistory
+{
+public:
+    /// One changed Cell: index (0-80, see Units), state before and after
+    typedef uint64_t Delta;
+    typedef std::vector<Delta> DeltaContainer;
+
+    /// Memory cap used unless SetMaxBytes is called
+    static const size_t DEFAULT_MAX_BYTES = 1 << 20;
+    /// Smallest cap, a step changing every Cell must fit
+    static const size_t MIN_MAX_BYTES = 81 * sizeof( Delta ) + 64;
+
+    /**
+     * Create an empty history
+     * @param maxBytes Memory cap, see SetMaxBytes
+     */
+    explicit UndoHistory( size_t maxBytes = DEFAULT_MAX_BYTES );
+
+    /**
+     * Pack a changed Cell
+     * @param index Cell index (0-80)
+     * @param before Cell::GetState before the change
+     * @param after Cell::GetState after the change
+     */
+    static Delta MakeDelta( size_t index, Cell::State before,
+                            Cell::State after )
+    {
+        return static_cast<Delta>( index ) |
+            ( static_cast<Delta>( before ) << 7 ) |
+            ( static_cast<Delta>( after ) << 32 );
+    }
+
+    static size_t GetIndex( Delta d ) { return d & 0x7F; }
+
+    static Cell::State GetBefore( Delta d )
+    {
+        return static_cast<Cell::State>( ( d >> 7 ) & 0x7FFFF );
+    }
+
+    static Cell::State GetAfter( Delta d )
+    {
+        return static_cast<Cell::State>( d >> 32 );
+    }
+
+    /**
+     * Change the memory cap
+     * The deltas and the step bookkeeping together stay under it
+     * @param maxBytes Cap in bytes
+     * @throw std::invalid_argument if below MIN_MAX_BYTES
+     * @post the history is cleared
+     */
+    void SetMaxBytes( size_t maxBytes );
+
+    size_t GetMaxBytes() const { return _maxBytes; }
+
+    /**
+     * Keep evicted steps in a file instead of dropping them
+     * @param filename File to write, truncated; empty to stop spilling
+     * @throw std::runtime_error if the file cannot be opened
+     * @post the history is cleared
+     */
+    void SetSpillFile( const std::string &filename );
+
+    /**
+     * Add a step, dropping anything that could be redone
+     * @param deltas Cells changed by the step (may be empty)
+     * @post CanUndo, memory use is at most the cap
+     */
+    void Record( const DeltaContainer &deltas );
+
+    /**
+     * Take the last step back
+     * @param deltas Filled with the Cells of the step, to set to GetBefore
+     * @return false if there is nothing to undo
+     * @post the step can be redone
+     */
+    bool Undo( DeltaContainer &deltas );
+
+    /**
+     * Take the last undone step again
+     * @param deltas Filled with the Cells of the step, to set to GetAfter
+     * @return false if there is nothing to redo
+     * @post the step can be undone
+     */
+    bool Redo( DeltaContainer &deltas );
+
+    bool CanUndo() const { return _undoable > 0 || _spilled > 0; }
+
+    bool CanRedo() const { return _undoable < _steps.size(); }
+
+    /**
+     * Copy out every step, spilled ones included, to be saved
+     * @param deltas Filled with the deltas of all steps, oldest first
+     * @param counts Filled with the number of deltas of each step
+     * @param undoable Set to how many of the steps (the first ones) can
+     *        be undone, the rest can be redone
+     * @throw std::runtime_error if the spill file cannot be read
+     */
+    void Export( DeltaContainer &deltas, std::vector<uint32_t> &counts,
+                 size_t &undoable );
+
+    /**
+     * Replace the history with saved steps, see Export
+     * Steps are read straight from the arrays (which may be a mapped file)
+     * @param deltas Deltas of all steps, oldest first
+     * @param counts Number of deltas of each step
+     * @param steps Number of steps
+     * @param undoable How many of the steps can be undone
+     * @post Steps over the cap are evicted as if they were just recorded;
+     *       if even the steps to redo do not fit, the last ones are dropped
+     */
+    void Import( const Delta *deltas, const uint32_t *counts, size_t steps,
+                 size_t undoable );
+
+    /**
+     * Forget everything, the spill file is kept but emptied
+     */
+    void Clear();
+
+    /**
+     * Memory held by the steps which are in memory
+     * @return bytes, at most GetMaxBytes
+     */
+    size_t GetMemoryUsage() const
+    {
+        return _used * sizeof( Delta ) + _steps.size() * sizeof( Step );
+    }
+
+    /// Steps which can be undone, including spilled ones
+    size_t CountUndo() const { return _undoable + _spilled; }
+
+    /// Steps which can be redone
+    size_t CountRedo() const { return _steps.size() - _undoable; }
+
+    /// Steps which were written to the spill file
+    size_t CountSpilled() const { return _spilled; }
+
+private:
+    UndoHistory( const UndoHistory & );
+    UndoHistory & operator=( const UndoHistory & );
+
+    /// Deltas of a step, they may wrap around the end of the ring
+    struct Step
+    {
+        size_t start;
+        size_t count;
+    };
+    typedef std::deque<Step> StepContainer;
+
+    /**
+     * Check if a step of count more deltas fits under the cap
+     */
+    bool fits( size_t count ) const;
+
+    /**
+     * Evict steps until one of count deltas fits
+     * @pre nothing can be redone
+     * @throw std::invalid_argument if it can never fit
+     */
+    void makeRoom( size_t count );
+
+    /**
+     * Add a step after the newest one, as one to undo
+     * @pre it fits
+     */
+    void append( const Delta *deltas, size_t count );
+
+    /**
+     * Remove the oldest step, to the spill file if there is one
+     * @pre it can not be redone
+     */
+    void evictOldest();
+
+    /**
+     * Drop the newest step, which can be redone
+     */
+    void dropNewest();
+
+    /**
+     * Bring back the newest spilled step as the oldest one in memory
+     * @pre _spilled > 0 and nothing in memory can be undone
+     */
+    void unspill();
+
+    /**
+     * Copy the deltas of a step out of the ring
+     */
+    void copyOut( const Step &s, DeltaContainer &deltas ) const;
+
+    size_t _maxBytes;
+    /// Ring buffer, sized on first use
+    DeltaContainer _ring;
+    /// Ring position of the oldest delta in memory
+    size_t _head;
+    /// Deltas in memory
+    size_t _used;
+    /// Oldest step first
+    StepContainer _steps;
+    /// The first _undoable steps can be undone, the rest redone
+    size_t _undoable;
+
+    /// Spilled steps, as deltas followed by their count (a stack)
+    std::fstream _spill;
+    bool _spilling;
+    /// Logical end of the spill file
+    std::streamoff _spillEnd;
+    size_t _spilled;
+};
+
+}
+
+#endif
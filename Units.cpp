@@ -0,0 +1,431 @@
+#include "Units.h"
+
+namespace Sudoku
+{
+
+const size_t Units::CELL_COUNT;
+const size_t Units::UNIT_COUNT;
+const size_t Units::UNIT_SIZE;
+const size_t Units::UNITS_PER_CELL;
+const size_t Units::PEER_COUNT;
+const size_t Units::FIRST_ROW;
+const size_t Units::FIRST_COL;
+const size_t Units::FIRST_BLOCK;
+
+// these tables were generated once and are checked by UnitsTest
+
+const unsigned char Units::UNIT_CELLS[UNIT_COUNT][UNIT_SIZE] =
+{
+    // rows
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8 },
+    {  9, 10, 11, 12, 13, 14, 15, 16, 17 },
+    { 18, 19, 20, 21, 22, 23, 24, 25, 26 },
+    { 27, 28, 29, 30, 31, 32, 33, 34, 35 },
+    { 36, 37, 38, 39, 40, 41, 42, 43, 44 },
+    { 45, 46, 47, 48, 49, 50, 51, 52, 53 },
+    { 54, 55, 56, 57, 58, 59, 60, 61, 62 },
+    { 63, 64, 65, 66, 67, 68, 69, 70, 71 },
+    { 72, 73, 74, 75, 76, 77, 78, 79, 80 },
+    // columns
+    {  0,  9, 18, 27, 36, 45, 54, 63, 72 },
+    {  1, 10, 19, 28, 37, 46, 55, 64, 73 },
+    {  2, 11, 20, 29, 38, 47, 56, 65, 74 },
+    {  3, 12, 21, 30, 39, 48, 57, 66, 75 },
+    {  4, 13, 22, 31, 40, 49, 58, 67, 76 },
+    {  5, 14, 23, 32, 41, 50, 59, 68, 77 },
+    {  6, 15, 24, 33, 42, 51, 60, 69, 78 },
+    {  7, 16, 25, 34, 43, 52, 61, 70, 79 },
+    {  8, 17, 26, 35, 44, 53, 62, 71, 80 },
+    // blocks
+    {  0,  1,  2,  9, 10, 11, 18, 19, 20 },
+    {  3,  4,  5, 12, 13, 14, 21, 22, 23 },
+    {  6,  7,  8, 15, 16, 17, 24, 25, 26 },
+    { 27, 28, 29, 36, 37, 38, 45, 46, 47 },
+    { 30, 31, 32, 39, 40, 41, 48, 49, 50 },
+    { 33, 34, 35, 42, 43, 44, 51, 52, 53 },
+    { 54, 55, 56, 63, 64, 65, 72, 73, 74 },
+    { 57, 58, 59, 66, 67, 68, 75, 76, 77 },
+    { 60, 61, 62, 69, 70, 71, 78, 79, 80 }
+};
+
+const unsigned char Units::CELL_UNITS[CELL_COUNT][UNITS_PER_CELL] =
+{
+    {  0,  9, 18 },
+    {  0, 10, 18 },
+    {  0, 11, 18 },
+    {  0, 12, 19 },
+    {  0, 13, 19 },
+    {  0, 14, 19 },
+    {  0, 15, 20 },
+    {  0, 16, 20 },
+    {  0, 17, 20 },
+    {  1,  9, 18 },
+    {  1, 10, 18 },
+    {  1, 11, 18 },
+    {  1, 12, 19 },
+    {  1, 13, 19 },
+    {  1, 14, 19 },
+    {  1, 15, 20 },
+    {  1, 16, 20 },
+    {  1, 17, 20 },
+    {  2,  9, 18 },
+    {  2, 10, 18 },
+    {  2, 11, 18 },
+    {  2, 12, 19 },
+    {  2, 13, 19 },
+    {  2, 14, 19 },
+    {  2, 15, 20 },
+    {  2, 16, 20 },
+    {  2, 17, 20 },
+    {  3,  9, 21 },
+    {  3, 10, 21 },
+    {  3, 11, 21 },
+    {  3, 12, 22 },
+    {  3, 13, 22 },
+    {  3, 14, 22 },
+    {  3, 15, 23 },
+    {  3, 16, 23 },
+    {  3, 17, 23 },
+    {  4,  9, 21 },
+    {  4, 10, 21 },
+    {  4, 11, 21 },
+    {  4, 12, 22 },
+    {  4, 13, 22 },
+    {  4, 14, 22 },
+    {  4, 15, 23 },
+    {  4, 16, 23 },
+    {  4, 17, 23 },
+    {  5,  9, 21 },
+    {  5, 10, 21 },
+    {  5, 11, 21 },
+    {  5, 12, 22 },
+    {  5, 13, 22 },
+    {  5, 14, 22 },
+    {  5, 15, 23 },
+    {  5, 16, 23 },
+    {  5, 17, 23 },
+    {  6,  9, 24 },
+    {  6, 10, 24 },
+    {  6, 11, 24 },
+    {  6, 12, 25 },
+    {  6, 13, 25 },
+    {  6, 14, 25 },
+    {  6, 15, 26 },
+    {  6, 16, 26 },
+    {  6, 17, 26 },
+    {  7,  9, 24 },
+    {  7, 10, 24 },
+    {  7, 11, 24 },
+    {  7, 12, 25 },
+    {  7, 13, 25 },
+    {  7, 14, 25 },
+    {  7, 15, 26 },
+    {  7, 16, 26 },
+    {  7, 17, 26 },
+    {  8,  9, 24 },
+    {  8, 10, 24 },
+    {  8, 11, 24 },
+    {  8, 12, 25 },
+    {  8, 13, 25 },
+    {  8, 14, 25 },
+    {  8, 15, 26 },
+    {  8, 16, 26 },
+    {  8, 17, 26 }
+};
+
+const unsigned char Units::PEERS[CELL_COUNT][PEER_COUNT] =
+{
+    {  1,  2,  3,  4,  5,  6,  7,  8,  9, 10,
+      11, 18, 19, 20, 27, 36, 45, 54, 63, 72 },
+    {  0,  2,  3,  4,  5,  6,  7,  8,  9, 10,
+      11, 18, 19, 20, 28, 37, 46, 55, 64, 73 },
+    {  0,  1,  3,  4,  5,  6,  7,  8,  9, 10,
+      11, 18, 19, 20, 29, 38, 47, 56, 65, 74 },
+    {  0,  1,  2,  4,  5,  6,  7,  8, 12, 13,
+      14, 21, 22, 23, 30, 39, 48, 57, 66, 75 },
+    {  0,  1,  2,  3,  5,  6,  7,  8, 12, 13,
+      14, 21, 22, 23, 31, 40, 49, 58, 67, 76 },
+    {  0,  1,  2,  3,  4,  6,  7,  8, 12, 13,
+      14, 21, 22, 23, 32, 41, 50, 59, 68, 77 },
+    {  0,  1,  2,  3,  4,  5,  7,  8, 15, 16,
+      17, 24, 25, 26, 33, 42, 51, 60, 69, 78 },
+    {  0,  1,  2,  3,  4,  5,  6,  8, 15, 16,
+      17, 24, 25, 26, 34, 43, 52, 61, 70, 79 },
+    {  0,  1,  2,  3,  4,  5,  6,  7, 15, 16,
+      17, 24, 25, 26, 35, 44, 53, 62, 71, 80 },
+    {  0,  1,  2, 10, 11, 12, 13, 14, 15, 16,
+      17, 18, 19, 20, 27, 36, 45, 54, 63, 72 },
+    {  0,  1,  2,  9, 11, 12, 13, 14, 15, 16,
+      17, 18, 19, 20, 28, 37, 46, 55, 64, 73 },
+    {  0,  1,  2,  9, 10, 12, 13, 14, 15, 16,
+      17, 18, 19, 20, 29, 38, 47, 56, 65, 74 },
+    {  3,  4,  5,  9, 10, 11, 13, 14, 15, 16,
+      17, 21, 22, 23, 30, 39, 48, 57, 66, 75 },
+    {  3,  4,  5,  9, 10, 11, 12, 14, 15, 16,
+      17, 21, 22, 23, 31, 40, 49, 58, 67, 76 },
+    {  3,  4,  5,  9, 10, 11, 12, 13, 15, 16,
+      17, 21, 22, 23, 32, 41, 50, 59, 68, 77 },
+    {  6,  7,  8,  9, 10, 11, 12, 13, 14, 16,
+      17, 24, 25, 26, 33, 42, 51, 60, 69, 78 },
+    {  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+      17, 24, 25, 26, 34, 43, 52, 61, 70, 79 },
+    {  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+      16, 24, 25, 26, 35, 44, 53, 62, 71, 80 },
+    {  0,  1,  2,  9, 10, 11, 19, 20, 21, 22,
+      23, 24, 25, 26, 27, 36, 45, 54, 63, 72 },
+    {  0,  1,  2,  9, 10, 11, 18, 20, 21, 22,
+      23, 24, 25, 26, 28, 37, 46, 55, 64, 73 },
+    {  0,  1,  2,  9, 10, 11, 18, 19, 21, 22,
+      23, 24, 25, 26, 29, 38, 47, 56, 65, 74 },
+    {  3,  4,  5, 12, 13, 14, 18, 19, 20, 22,
+      23, 24, 25, 26, 30, 39, 48, 57, 66, 75 },
+    {  3,  4,  5, 12, 13, 14, 18, 19, 20, 21,
+      23, 24, 25, 26, 31, 40, 49, 58, 67, 76 },
+    {  3,  4,  5, 12, 13, 14, 18, 19, 20, 21,
+      22, 24, 25, 26, 32, 41, 50, 59, 68, 77 },
+    {  6,  7,  8, 15, 16, 17, 18, 19, 20, 21,
+      22, 23, 25, 26, 33, 42, 51, 60, 69, 78 },
+    {  6,  7,  8, 15, 16, 17, 18, 19, 20, 21,
+      22, 23, 24, 26, 34, 43, 52, 61, 70, 79 },
+    {  6,  7,  8, 15, 16, 17, 18, 19, 20, 21,
+      22, 23, 24, 25, 35, 44, 53, 62, 71, 80 },
+    {  0,  9, 18, 28, 29, 30, 31, 32, 33, 34,
+      35, 36, 37, 38, 45, 46, 47, 54, 63, 72 },
+    {  1, 10, 19, 27, 29, 30, 31, 32, 33, 34,
+      35, 36, 37, 38, 45, 46, 47, 55, 64, 73 },
+    {  2, 11, 20, 27, 28, 30, 31, 32, 33, 34,
+      35, 36, 37, 38, 45, 46, 47, 56, 65, 74 },
+    {  3, 12, 21, 27, 28, 29, 31, 32, 33, 34,
+      35, 39, 40, 41, 48, 49, 50, 57, 66, 75 },
+    {  4, 13, 22, 27, 28, 29, 30, 32, 33, 34,
+      35, 39, 40, 41, 48, 49, 50, 58, 67, 76 },
+    {  5, 14, 23, 27, 28, 29, 30, 31, 33, 34,
+      35, 39, 40, 41, 48, 49, 50, 59, 68, 77 },
+    {  6, 15, 24, 27, 28, 29, 30, 31, 32, 34,
+      35, 42, 43, 44, 51, 52, 53, 60, 69, 78 },
+    {  7, 16, 25, 27, 28, 29, 30, 31, 32, 33,
+      35, 42, 43, 44, 51, 52, 53, 61, 70, 79 },
+    {  8, 17, 26, 27, 28, 29, 30, 31, 32, 33,
+      34, 42, 43, 44, 51, 52, 53, 62, 71, 80 },
+    {  0,  9, 18, 27, 28, 29, 37, 38, 39, 40,
+      41, 42, 43, 44, 45, 46, 47, 54, 63, 72 },
+    {  1, 10, 19, 27, 28, 29, 36, 38, 39, 40,
+      41, 42, 43, 44, 45, 46, 47, 55, 64, 73 },
+    {  2, 11, 20, 27, 28, 29, 36, 37, 39, 40,
+      41, 42, 43, 44, 45, 46, 47, 56, 65, 74 },
+    {  3, 12, 21, 30, 31, 32, 36, 37, 38, 40,
+      41, 42, 43, 44, 48, 49, 50, 57, 66, 75 },
+    {  4, 13, 22, 30, 31, 32, 36, 37, 38, 39,
+      41, 42, 43, 44, 48, 49, 50, 58, 67, 76 },
+    {  5, 14, 23, 30, 31, 32, 36, 37, 38, 39,
+      40, 42, 43, 44, 48, 49, 50, 59, 68, 77 },
+    {  6, 15, 24, 33, 34, 35, 36, 37, 38, 39,
+      40, 41, 43, 44, 51, 52, 53, 60, 69, 78 },
+    {  7, 16, 25, 33, 34, 35, 36, 37, 38, 39,
+      40, 41, 42, 44, 51, 52, 53, 61, 70, 79 },
+    {  8, 17, 26, 33, 34, 35, 36, 37, 38, 39,
+      40, 41, 42, 43, 51, 52, 53, 62, 71, 80 },
+    {  0,  9, 18, 27, 28, 29, 36, 37, 38, 46,
+      47, 48, 49, 50, 51, 52, 53, 54, 63, 72 },
+    {  1, 10, 19, 27, 28, 29, 36, 37, 38, 45,
+      47, 48, 49, 50, 51, 52, 53, 55, 64, 73 },
+    {  2, 11, 20, 27, 28, 29, 36, 37, 38, 45,
+      46, 48, 49, 50, 51, 52, 53, 56, 65, 74 },
+    {  3, 12, 21, 30, 31, 32, 39, 40, 41, 45,
+      46, 47, 49, 50, 51, 52, 53, 57, 66, 75 },
+    {  4, 13, 22, 30, 31, 32, 39, 40, 41, 45,
+      46, 47, 48, 50, 51, 52, 53, 58, 67, 76 },
+    {  5, 14, 23, 30, 31, 32, 39, 40, 41, 45,
+      46, 47, 48, 49, 51, 52, 53, 59, 68, 77 },
+    {  6, 15, 24, 33, 34, 35, 42, 43, 44, 45,
+      46, 47, 48, 49, 50, 52, 53, 60, 69, 78 },
+    {  7, 16, 25, 33, 34, 35, 42, 43, 44, 45,
+      46, 47, 48, 49, 50, 51, 53, 61, 70, 79 },
+    {  8, 17, 26, 33, 34, 35, 42, 43, 44, 45,
+      46, 47, 48, 49, 50, 51, 52, 62, 71, 80 },
+    {  0,  9, 18, 27, 36, 45, 55, 56, 57, 58,
+      59, 60, 61, 62, 63, 64, 65, 72, 73, 74 },
+    {  1, 10, 19, 28, 37, 46, 54, 56, 57, 58,
+      59, 60, 61, 62, 63, 64, 65, 72, 73, 74 },
+    {  2, 11, 20, 29, 38, 47, 54, 55, 57, 58,
+      59, 60, 61, 62, 63, 64, 65, 72, 73, 74 },
+    {  3, 12, 21, 30, 39, 48, 54, 55, 56, 58,
+      59, 60, 61, 62, 66, 67, 68, 75, 76, 77 },
+    {  4, 13, 22, 31, 40, 49, 54, 55, 56, 57,
+      59, 60, 61, 62, 66, 67, 68, 75, 76, 77 },
+    {  5, 14, 23, 32, 41, 50, 54, 55, 56, 57,
+      58, 60, 61, 62, 66, 67, 68, 75, 76, 77 },
+    {  6, 15, 24, 33, 42, 51, 54, 55, 56, 57,
+      58, 59, 61, 62, 69, 70, 71, 78, 79, 80 },
+    {  7, 16, 25, 34, 43, 52, 54, 55, 56, 57,
+      58, 59, 60, 62, 69, 70, 71, 78, 79, 80 },
+    {  8, 17, 26, 35, 44, 53, 54, 55, 56, 57,
+      58, 59, 60, 61, 69, 70, 71, 78, 79, 80 },
+    {  0,  9, 18, 27, 36, 45, 54, 55, 56, 64,
+      65, 66, 67, 68, 69, 70, 71, 72, 73, 74 },
+    {  1, 10, 19, 28, 37, 46, 54, 55, 56, 63,
+      65, 66, 67, 68, 69, 70, 71, 72, 73, 74 },
+    {  2, 11, 20, 29, 38, 47, 54, 55, 56, 63,
+      64, 66, 67, 68, 69, 70, 71, 72, 73, 74 },
+    {  3, 12, 21, 30, 39, 48, 57, 58, 59, 63,
+      64, 65, 67, 68, 69, 70, 71, 75, 76, 77 },
+    {  4, 13, 22, 31, 40, 49, 57, 58, 59, 63,
+      64, 65, 66, 68, 69, 70, 71, 75, 76, 77 },
+    {  5, 14, 23, 32, 41, 50, 57, 58, 59, 63,
+      64, 65, 66, 67, 69, 70, 71, 75, 76, 77 },
+    {  6, 15, 24, 33, 42, 51, 60, 61, 62, 63,
+      64, 65, 66, 67, 68, 70, 71, 78, 79, 80 },
+    {  7, 16, 25, 34, 43, 52, 60, 61, 62, 63,
+      64, 65, 66, 67, 68, 69, 71, 78, 79, 80 },
+    {  8, 17, 26, 35, 44, 53, 60, 61, 62, 63,
+      64, 65, 66, 67, 68, 69, 70, 78, 79, 80 },
+    {  0,  9, 18, 27, 36, 45, 54, 55, 56, 63,
+      64, 65, 73, 74, 75, 76, 77, 78, 79, 80 },
+    {  1, 10, 19, 28, 37, 46, 54, 55, 56, 63,
+      64, 65, 72, 74, 75, 76, 77, 78, 79, 80 },
+    {  2, 11, 20, 29, 38, 47, 54, 55, 56, 63,
+      64, 65, 72, 73, 75, 76, 77, 78, 79, 80 },
+    {  3, 12, 21, 30, 39, 48, 57, 58, 59, 66,
+      67, 68, 72, 73, 74, 76, 77, 78, 79, 80 },
+    {  4, 13, 22, 31, 40, 49, 57, 58, 59, 66,
+      67, 68, 72, 73, 74, 75, 77, 78, 79, 80 },
+    {  5, 14, 23, 32, 41, 50, 57, 58, 59, 66,
+      67, 68, 72, 73, 74, 75, 76, 78, 79, 80 },
+    {  6, 15, 24, 33, 42, 51, 60, 61, 62, 69,
+      70, 71, 72, 73, 74, 75, 76, 77, 79, 80 },
+    {  7, 16, 25, 34, 43, 52, 60, 61, 62, 69,
+      70, 71, 72, 73, 74, 75, 76, 77, 78, 80 },
+    {  8, 17, 26, 35, 44, 53, 60, 61, 62, 69,
+      70, 71, 72, 73, 74, 75, 76, 77, 78, 79 }
+};
+
+const unsigned char Units::ALL_CELLS[CELL_COUNT] =
+{
+     0,  1,  2,  3,  4,  5,  6,  7,  8,
+     9, 10, 11, 12, 13, 14, 15, 16, 17,
+    18, 19, 20, 21, 22, 23, 24, 25, 26,
+    27, 28, 29, 30, 31, 32, 33, 34, 35,
+    36, 37, 38, 39, 40, 41, 42, 43, 44,
+    45, 46, 47, 48, 49, 50, 51, 52, 53,
+    54, 55, 56, 57, 58, 59, 60, 61, 62,
+    63, 64, 65, 66, 67, 68, 69, 70, 71,
+    72, 73, 74, 75, 76, 77, 78, 79, 80
+};
+
+const Bitboard Units::UNIT_BOARDS[UNIT_COUNT] =
+{
+    { 0x00000000000001ffULL, 0x00000ULL },
+    { 0x000000000003fe00ULL, 0x00000ULL },
+    { 0x0000000007fc0000ULL, 0x00000ULL },
+    { 0x0000000ff8000000ULL, 0x00000ULL },
+    { 0x00001ff000000000ULL, 0x00000ULL },
+    { 0x003fe00000000000ULL, 0x00000ULL },
+    { 0x7fc0000000000000ULL, 0x00000ULL },
+    { 0x8000000000000000ULL, 0x000ffULL },
+    { 0x0000000000000000ULL, 0x1ff00ULL },
+    { 0x8040201008040201ULL, 0x00100ULL },
+    { 0x0080402010080402ULL, 0x00201ULL },
+    { 0x0100804020100804ULL, 0x00402ULL },
+    { 0x0201008040201008ULL, 0x00804ULL },
+    { 0x0402010080402010ULL, 0x01008ULL },
+    { 0x0804020100804020ULL, 0x02010ULL },
+    { 0x1008040201008040ULL, 0x04020ULL },
+    { 0x2010080402010080ULL, 0x08040ULL },
+    { 0x4020100804020100ULL, 0x10080ULL },
+    { 0x00000000001c0e07ULL, 0x00000ULL },
+    { 0x0000000000e07038ULL, 0x00000ULL },
+    { 0x00000000070381c0ULL, 0x00000ULL },
+    { 0x0000e07038000000ULL, 0x00000ULL },
+    { 0x00070381c0000000ULL, 0x00000ULL },
+    { 0x00381c0e00000000ULL, 0x00000ULL },
+    { 0x81c0000000000000ULL, 0x00703ULL },
+    { 0x0e00000000000000ULL, 0x0381cULL },
+    { 0x7000000000000000ULL, 0x1c0e0ULL }
+};
+
+const Bitboard Units::PEER_BOARDS[CELL_COUNT] =
+{
+    { 0x80402010081c0ffeULL, 0x00100ULL },
+    { 0x00804020101c0ffdULL, 0x00201ULL },
+    { 0x01008040201c0ffbULL, 0x00402ULL },
+    { 0x0201008040e071f7ULL, 0x00804ULL },
+    { 0x0402010080e071efULL, 0x01008ULL },
+    { 0x0804020100e071dfULL, 0x02010ULL },
+    { 0x10080402070381bfULL, 0x04020ULL },
+    { 0x201008040703817fULL, 0x08040ULL },
+    { 0x40201008070380ffULL, 0x10080ULL },
+    { 0x80402010081ffc07ULL, 0x00100ULL },
+    { 0x00804020101ffa07ULL, 0x00201ULL },
+    { 0x01008040201ff607ULL, 0x00402ULL },
+    { 0x0201008040e3ee38ULL, 0x00804ULL },
+    { 0x0402010080e3de38ULL, 0x01008ULL },
+    { 0x0804020100e3be38ULL, 0x02010ULL },
+    { 0x1008040207037fc0ULL, 0x04020ULL },
+    { 0x201008040702ffc0ULL, 0x08040ULL },
+    { 0x402010080701ffc0ULL, 0x10080ULL },
+    { 0x804020100ff80e07ULL, 0x00100ULL },
+    { 0x0080402017f40e07ULL, 0x00201ULL },
+    { 0x0100804027ec0e07ULL, 0x00402ULL },
+    { 0x0201008047dc7038ULL, 0x00804ULL },
+    { 0x0402010087bc7038ULL, 0x01008ULL },
+    { 0x08040201077c7038ULL, 0x02010ULL },
+    { 0x1008040206ff81c0ULL, 0x04020ULL },
+    { 0x2010080405ff81c0ULL, 0x08040ULL },
+    { 0x4020100803ff81c0ULL, 0x10080ULL },
+    { 0x8040e07ff0040201ULL, 0x00100ULL },
+    { 0x0080e07fe8080402ULL, 0x00201ULL },
+    { 0x0100e07fd8100804ULL, 0x00402ULL },
+    { 0x0207038fb8201008ULL, 0x00804ULL },
+    { 0x0407038f78402010ULL, 0x01008ULL },
+    { 0x0807038ef8804020ULL, 0x02010ULL },
+    { 0x10381c0df9008040ULL, 0x04020ULL },
+    { 0x20381c0bfa010080ULL, 0x08040ULL },
+    { 0x40381c07fc020100ULL, 0x10080ULL },
+    { 0x8040ffe038040201ULL, 0x00100ULL },
+    { 0x0080ffd038080402ULL, 0x00201ULL },
+    { 0x0100ffb038100804ULL, 0x00402ULL },
+    { 0x02071f71c0201008ULL, 0x00804ULL },
+    { 0x04071ef1c0402010ULL, 0x01008ULL },
+    { 0x08071df1c0804020ULL, 0x02010ULL },
+    { 0x10381bfe01008040ULL, 0x04020ULL },
+    { 0x203817fe02010080ULL, 0x08040ULL },
+    { 0x40380ffe04020100ULL, 0x10080ULL },
+    { 0x807fc07038040201ULL, 0x00100ULL },
+    { 0x00bfa07038080402ULL, 0x00201ULL },
+    { 0x013f607038100804ULL, 0x00402ULL },
+    { 0x023ee381c0201008ULL, 0x00804ULL },
+    { 0x043de381c0402010ULL, 0x01008ULL },
+    { 0x083be381c0804020ULL, 0x02010ULL },
+    { 0x1037fc0e01008040ULL, 0x04020ULL },
+    { 0x202ffc0e02010080ULL, 0x08040ULL },
+    { 0x401ffc0e04020100ULL, 0x10080ULL },
+    { 0xff80201008040201ULL, 0x00703ULL },
+    { 0xff40402010080402ULL, 0x00703ULL },
+    { 0xfec0804020100804ULL, 0x00703ULL },
+    { 0x7dc1008040201008ULL, 0x0381cULL },
+    { 0x7bc2010080402010ULL, 0x0381cULL },
+    { 0x77c4020100804020ULL, 0x0381cULL },
+    { 0x6fc8040201008040ULL, 0x1c0e0ULL },
+    { 0x5fd0080402010080ULL, 0x1c0e0ULL },
+    { 0x3fe0100804020100ULL, 0x1c0e0ULL },
+    { 0x01c0201008040201ULL, 0x007ffULL },
+    { 0x81c0402010080402ULL, 0x007feULL },
+    { 0x81c0804020100804ULL, 0x007fdULL },
+    { 0x8e01008040201008ULL, 0x038fbULL },
+    { 0x8e02010080402010ULL, 0x038f7ULL },
+    { 0x8e04020100804020ULL, 0x038efULL },
+    { 0xf008040201008040ULL, 0x1c0dfULL },
+    { 0xf010080402010080ULL, 0x1c0bfULL },
+    { 0xf020100804020100ULL, 0x1c07fULL },
+    { 0x81c0201008040201ULL, 0x1fe03ULL },
+    { 0x81c0402010080402ULL, 0x1fd03ULL },
+    { 0x81c0804020100804ULL, 0x1fb03ULL },
+    { 0x0e01008040201008ULL, 0x1f71cULL },
+    { 0x0e02010080402010ULL, 0x1ef1cULL },
+    { 0x0e04020100804020ULL, 0x1df1cULL },
+    { 0x7008040201008040ULL, 0x1bfe0ULL },
+    { 0x7010080402010080ULL, 0x17fe0ULL },
+    { 0x7020100804020100ULL, 0x0ffe0ULL }
+};
+
+}
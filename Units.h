@@ -0,0 +1,110 @@
+#ifndef SUDOKU_UNITS_H
+#define SUDOKU_UNITS_H
+
+#include <cstddef>
+#include "Bitboard.h"
+
+namespace Sudoku
+{
+
+/**
+ * Static lookup tables describing the geometry of the board
+ * The tables are constant data initialized at compile time (no code runs
+ * to build them) so any module can walk a unit or the peers of a Cell
+ * without scanning the board or allocating.
+ *
+ * Cells are indexed (y - 1) * 9 + (x - 1), x being the column and y the row.
+ * Units are numbered 0-8 for rows, 9-17 for columns and 18-26 for blocks
+ * (blocks in left-right, top-bottom order).
+ * Every list is sorted by index, which is the same order as CellSorter.
+ */
+class Units
+{
+public:
+    /// Cells on the board
+    static const size_t CELL_COUNT = 81;
+    /// Rows, columns and blocks
+    static const size_t UNIT_COUNT = 27;
+    /// Cells in each unit
+    static const size_t UNIT_SIZE = 9;
+    /// Units each Cell belongs to (row, column, block)
+    static const size_t UNITS_PER_CELL = 3;
+    /// Cells sharing a unit with a given Cell, not counting itself
+    static const size_t PEER_COUNT = 20;
+
+    /// First unit number of each kind
+    static const size_t FIRST_ROW = 0;
+    static const size_t FIRST_COL = 9;
+    static const size_t FIRST_BLOCK = 18;
+
+    /// Cell indices of each unit
+    static const unsigned char UNIT_CELLS[UNIT_COUNT][UNIT_SIZE];
+    /// Row, column and block unit of each Cell
+    static const unsigned char CELL_UNITS[CELL_COUNT][UNITS_PER_CELL];
+    /// Peers of each Cell
+    static const unsigned char PEERS[CELL_COUNT][PEER_COUNT];
+    /// Every Cell index in order
+    static const unsigned char ALL_CELLS[CELL_COUNT];
+    /// Cells of each unit as a Bitboard
+    static const Bitboard UNIT_BOARDS[UNIT_COUNT];
+    /// Peers of each Cell as a Bitboard
+    static const Bitboard PEER_BOARDS[CELL_COUNT];
+
+    /**
+     * Index of a Cell by position
+     * @param x X coordinate of Cell (starting from 1)
+     * @param y Y coordinate of Cell (starting from 1)
+     * @pre x and y are both in range [1,9]
+     */
+    static size_t Index( size_t x, size_t y )
+    {
+        return ( y - 1 ) * UNIT_SIZE + ( x - 1 );
+    }
+
+    /**
+     * Unit number of a row
+     * @param r Row number in range [1,9]
+     */
+    static size_t Row( size_t r ) { return FIRST_ROW + r - 1; }
+
+    /**
+     * Unit number of a column
+     * @param c Column number in range [1,9]
+     */
+    static size_t Col( size_t c ) { return FIRST_COL + c - 1; }
+
+    /**
+     * Unit number of a block
+     * @param x X coordinate of the block in range [1,3]
+     * @param y Y coordinate of the block in range [1,3]
+     */
+    static size_t Block( size_t x, size_t y )
+    {
+        return FIRST_BLOCK + ( y - 1 ) * 3 + ( x - 1 );
+    }
+
+    /**
+     * Position of a Cell inside one of its units
+     * @param i Cell index
+     * @param k Which unit of the Cell, 0 row, 1 column, 2 block
+     * @return index into UNIT_CELLS for that unit, in range [0,8]
+     */
+    static size_t PositionInUnit( size_t i, size_t k )
+    {
+        size_t r = i / UNIT_SIZE;
+        size_t c = i % UNIT_SIZE;
+        switch ( k )
+        {
+        case 0: return c;
+        case 1: return r;
+        default: return ( r % 3 ) * 3 + c % 3;
+        }
+    }
+
+private:
+    Units();
+};
+
+}
+
+#endif
@@ -0,0 +1,156 @@
+#include "WorkStealingPool.h"
+
+#include <thread>
+
+#include "Log.h"
+
+namespace Sudoku
+{
+
+WorkStealingPool::WorkStealingPool( size_t threads )
+    : _threadCount( threads )
+{
+    if ( _threadCount == 0 )
+    {
+        _threadCount = std::thread::hardware_concurrency();
+    }
+    if ( _threadCount == 0 )
+    {
+        _threadCount = 1;
+    }
+    for ( size_t w = 0; w < _threadCount; w++ )
+    {
+        _ranges.push_back( std::shared_ptr<Range>( new Range ) );
+    }
+}
+
+void WorkStealingPool::Run( size_t count, Task &task )
+{
+    // contiguous ranges keep neighbouring items on the same worker
+    for ( size_t w = 0; w < _threadCount; w++ )
+    {
+        _ranges[w]->begin = count * w / _threadCount;
+        _ranges[w]->end = count * ( w + 1 ) / _threadCount;
+    }
+    _error = std::exception_ptr();
+
+    FILE_LOG(logINFO) << "Running " << count << " items on "
+                      << _threadCount << " threads.";
+
+    // the calling thread is worker 0
+    std::vector<std::thread> threads;
+    for ( size_t w = 1; w < _threadCount; w++ )
+    {
+        threads.push_back( std::thread( &WorkStealingPool::Work,
+                                        this, w, &task ) );
+    }
+    Work( 0, &task );
+    for ( std::vector<std::thread>::iterator it = threads.begin();
+          it != threads.end();
+          ++it )
+    {
+        it->join();
+    }
+
+    if ( _error )
+    {
+        std::rethrow_exception( _error );
+    }
+}
+
+void WorkStealingPool::Work( size_t worker, Task *task )
+{
+    try
+    {
+        size_t item;
+        while ( PopOwn( worker, item ) || ( Steal( worker ) &&
+                                            PopOwn( worker, item ) ) )
+        {
+            task->Execute( worker, item );
+        }
+    }
+    catch ( ... )
+    {
+        {
+            std::lock_guard<std::mutex> guard( _errorLock );
+            if ( !_error )
+            {
+                _error = std::current_exception();
+            }
+        }
+        Cancel();
+    }
+}
+
+bool WorkStealingPool::PopOwn( size_t worker, size_t &item )
+{
+    Range &r = *_ranges[worker];
+    std::lock_guard<std::mutex> guard( r.lock );
+    if ( r.begin == r.end )
+    {
+        return false;
+    }
+    item = r.begin++;
+    return true;
+}
+
+bool WorkStealingPool::Steal( size_t worker )
+{
+    while ( true )
+    {
+        // pick the victim with the most work left
+        size_t victim = worker;
+        size_t most = 0;
+        for ( size_t w = 0; w < _threadCount; w++ )
+        {
+            if ( w == worker )
+            {
+                continue;
+            }
+            std::lock_guard<std::mutex> guard( _ranges[w]->lock );
+            size_t left = _ranges[w]->end - _ranges[w]->begin;
+            if ( left > most )
+            {
+                most = left;
+                victim = w;
+            }
+        }
+        if ( most == 0 )
+        {
+            return false;
+        }
+
+        size_t begin, end;
+        {
+            Range &v = *_ranges[victim];
+            std::lock_guard<std::mutex> guard( v.lock );
+            size_t left = v.end - v.begin;
+            if ( left == 0 )
+            {
+                // someone else got there first, look again
+                continue;
+            }
+            // take the back half, or the last item
+            end = v.end;
+            begin = v.begin + left / 2;
+            v.end = begin;
+        }
+
+        Range &own = *_ranges[worker];
+        std::lock_guard<std::mutex> guard( own.lock );
+        own.begin = begin;
+        own.end = end;
+        return true;
+    }
+}
+
+void WorkStealingPool::Cancel()
+{
+    for ( size_t w = 0; w < _threadCount; w++ )
+    {
+        std::lock_guard<std::mutex> guard( _ranges[w]->lock );
+        _ranges[w]->begin = _ranges[w]->end;
+    }
+}
+
+}
@@ -0,0 +1,109 @@
+#ifndef SUDOKU_WORK_STEALING_POOL_H
+#define SUDOKU_WORK_STEALING_POOL_H
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Sudoku
+{
+
+/**
+ * Runs a fixed number of independent work items on a set of threads
+ * The items [0, count) are split into one contiguous range per worker.
+ * A worker takes items from the front of its own range, and when it runs
+ * out it steals the back half of the largest range left, so a few slow
+ * items do not leave the other threads idle.
+ *
+ * Each item is handed to the Task with the number of the worker running it,
+ * which lets callers keep per-worker state without any locking.
+ */
+class WorkStealingPool
+{
+public:
+    /**
+     * Work to run for each item
+     */
+    class Task
+    {
+    public:
+        /**
+         * Run one item
+         * @param worker Number of the worker thread in range [0,threads)
+         * @param item Item to run
+         */
+        virtual void Execute( size_t worker, size_t item ) = 0;
+
+        virtual ~Task() {}
+    };
+
+    /**
+     * Create a pool
+     * @param threads Number of worker threads, 0 for one per hardware thread
+     */
+    explicit WorkStealingPool( size_t threads = 0 );
+
+    /**
+     * Accessor
+     * @return number of worker threads
+     */
+    size_t GetThreadCount() const { return _threadCount; }
+
+    /**
+     * Run every item and wait for all of them to finish
+     * @param count Number of items
+     * @param task Work to run for each item
+     * @post task.Execute was called exactly once for every item
+     * @throw rethrows the first exception thrown by the Task, once every
+     *        worker has stopped
+     */
+    void Run( size_t count, Task &task );
+
+private:
+    WorkStealingPool( const WorkStealingPool & );
+    WorkStealingPool & operator=( const WorkStealingPool & );
+
+    /**
+     * Items a worker still has to run, [begin, end)
+     */
+    struct Range
+    {
+        std::mutex lock;
+        size_t begin;
+        size_t end;
+    };
+
+    /**
+     * Body of each worker thread
+     */
+    void Work( size_t worker, Task *task );
+
+    /**
+     * Take the next item from a worker's own range
+     * @return false if the range is empty
+     */
+    bool PopOwn( size_t worker, size_t &item );
+
+    /**
+     * Move half of the biggest other range into a worker's own range
+     * @return false if there is nothing left anywhere
+     */
+    bool Steal( size_t worker );
+
+    /**
+     * Empty every range so the workers stop early
+     */
+    void Cancel();
+
+    size_t _threadCount;
+    std::vector<std::shared_ptr<Range> > _ranges;
+    /// Protects _error
+    std::mutex _errorLock;
+    std::exception_ptr _error;
+};
+
+}
+
+#endif
@@ -0,0 +1,172 @@
+/**
+ * Compare the map-backed Puzzle with the flat Grid storage engine
+ * Usage: grid_bench [puzzle file] [iterations]
+ */
+
+#include "../CandidateGrid.h"
+#include "../Grid.h"
+#include "../Puzzle.h"
+#include "../PuzzleMarker.h"
+#include "../SimplePuzzleImporter.h"
+#include "../Log.h"
+
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include <time.h>
+
+namespace
+{
+
+double NowNs()
+{
+    timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+void Report( const char *name, double puzzleNs, double gridNs, size_t n )
+{
+    std::cout << name << "\tPuzzle " << puzzleNs / n << " ns/op"
+              << "\tGrid " << gridNs / n << " ns/op"
+              << "\tspeedup " << puzzleNs / gridNs << "x" << std::endl;
+}
+
+// keeps the optimizer from dropping the loops
+volatile unsigned sink;
+
+}
+
+int main( int argc, char** argv )
+{
+    FILELog::ReportingLevel() = logERROR;
+
+    const char *file = ( argc > 1 ) ? argv[1] : "qt/sample";
+    size_t n = ( argc > 2 ) ? std::atoi( argv[2] ) : 20000;
+
+    std::ifstream in( file );
+    if ( !in )
+    {
+        std::cerr << "Cannot open " << file << std::endl;
+        return 1;
+    }
+    Sudoku::SimplePuzzleImporter importer;
+    std::shared_ptr<Sudoku::Puzzle> puzzle = importer.Import( in );
+    Sudoku::PuzzleMarker marker;
+    Sudoku::Grid grid( *puzzle );
+
+    std::cout << "sizeof(Grid) = " << sizeof( Sudoku::Grid ) << " bytes"
+              << std::endl;
+
+    // mark computation
+    double start = NowNs();
+    for ( size_t i = 0; i < n; i++ )
+    {
+        marker.UpdateMarks( puzzle );
+    }
+    double puzzleNs = NowNs() - start;
+    start = NowNs();
+    for ( size_t i = 0; i < n; i++ )
+    {
+        grid.UpdateMarks();
+        sink = grid[i % Sudoku::Grid::ARRAY_SIZE].marks;
+    }
+    Report( "UpdateMarks", puzzleNs, NowNs() - start, n );
+
+    // walk all 27 sectors
+    unsigned total = 0;
+    start = NowNs();
+    for ( size_t i = 0; i < n; i++ )
+    {
+        for ( size_t s = 1; s <= 9; s++ )
+        {
+            Sudoku::Puzzle::Container row = puzzle->GetRow( s );
+            Sudoku::Puzzle::Container col = puzzle->GetCol( s );
+            Sudoku::Puzzle::Container block =
+                puzzle->GetBlock( ( s - 1 ) % 3 + 1, ( s - 1 ) / 3 + 1 );
+            for ( Sudoku::Puzzle::Container::iterator it = row.begin();
+                  it != row.end(); ++it ) { total += (*it)->DisplayedValue(); }
+            for ( Sudoku::Puzzle::Container::iterator it = col.begin();
+                  it != col.end(); ++it ) { total += (*it)->DisplayedValue(); }
+            for ( Sudoku::Puzzle::Container::iterator it = block.begin();
+                  it != block.end(); ++it ) { total += (*it)->DisplayedValue(); }
+        }
+    }
+    puzzleNs = NowNs() - start;
+    start = NowNs();
+    for ( size_t i = 0; i < n; i++ )
+    {
+        for ( size_t s = 1; s <= 9; s++ )
+        {
+            Sudoku::Grid::Sector row = grid.GetRow( s );
+            Sudoku::Grid::Sector col = grid.GetCol( s );
+            Sudoku::Grid::Sector block =
+                grid.GetBlock( ( s - 1 ) % 3 + 1, ( s - 1 ) / 3 + 1 );
+            for ( size_t c = 0; c < row.size(); c++ )
+            {
+                total += row[c].value + col[c].value + block[c].value;
+            }
+        }
+    }
+    Report( "SectorWalk", puzzleNs, NowNs() - start, n );
+    sink = total;
+
+    // random access by position
+    start = NowNs();
+    for ( size_t i = 0; i < n * 81; i++ )
+    {
+        total += puzzle->GetCell( i % 9 + 1, ( i / 9 ) % 9 + 1 )->DisplayedValue();
+    }
+    puzzleNs = NowNs() - start;
+    start = NowNs();
+    for ( size_t i = 0; i < n * 81; i++ )
+    {
+        total += grid.GetCell( i % 9 + 1, ( i / 9 ) % 9 + 1 ).value;
+    }
+    Report( "GetCell", puzzleNs, NowNs() - start, n * 81 );
+    sink = total;
+
+    // copying the whole board
+    start = NowNs();
+    for ( size_t i = 0; i < n; i++ )
+    {
+        Sudoku::Puzzle copy( *puzzle );
+        sink = copy.GetCell( 1, 1 )->DisplayedValue();
+    }
+    puzzleNs = NowNs() - start;
+    start = NowNs();
+    for ( size_t i = 0; i < n; i++ )
+    {
+        Sudoku::Grid copy( grid );
+        sink = copy[i % Sudoku::Grid::ARRAY_SIZE].value;
+    }
+    Report( "Copy", puzzleNs, NowNs() - start, n );
+
+    // single candidate detection on a marked board
+    marker.UpdateMarks( puzzle );
+    Sudoku::CandidateGrid candidates( grid );
+    start = NowNs();
+    for ( size_t i = 0; i < n; i++ )
+    {
+        Sudoku::Puzzle::View all = puzzle->GetAllView();
+        for ( Sudoku::Puzzle::View::iterator it = all.begin();
+              it != all.end(); ++it )
+        {
+            if ( (*it)->DisplayedValue() == 0 &&
+                 (*it)->GetMarkedValues().size() == 1 )
+            {
+                total++;
+            }
+        }
+    }
+    puzzleNs = NowNs() - start;
+    start = NowNs();
+    for ( size_t i = 0; i < n; i++ )
+    {
+        total += candidates.GetNakedSingles().Count();
+    }
+    Report( "Singles", puzzleNs, NowNs() - start, n );
+    sink = total;
+
+    return 0;
+}
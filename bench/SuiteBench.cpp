@@ -0,0 +1,526 @@
+/**
+ * Run corpora of Puzzles through each stage of solving and report the cost
+ * of every stage as JSON: ns/op, allocations/op and ops/s
+ * Stages: import, marks, each SolverHelper query, MethodSolver::Solve
+ * (with its SolveStats), validation and undo/redo.  Each stage runs over
+ * the whole corpus as many rounds as it takes to reach the op count, so
+ * one Puzzle files are measured as well as large ones.
+ * SolveStats are the totals over every round.
+ * Usage: suite_bench [-n ops] corpus...
+ */
+
+#include "../BacktrackingSolver.h"
+#include "../Cell.h"
+#include "../Grid.h"
+#include "../GridListImporter.h"
+#include "../LinkGraph.h"
+#include "../MethodSolver.h"
+#include "../Puzzle.h"
+#include "../PuzzleMarker.h"
+#include "../SimpleValidator.h"
+#include "../SolutionMethodFactory.h"
+#include "../SolverHelper.h"
+#include "../UndoHistory.h"
+#include "../Log.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <sstream>
+#include <vector>
+#include <time.h>
+
+namespace
+{
+
+// every allocation of the process, the suite runs on one thread
+size_t allocations = 0;
+
+}
+
+// new and delete stay out of line: inlined into the same caller, GCC takes
+// the free() of what came from operator new for a mismatched deallocation
+__attribute__(( noinline ))
+void* operator new( size_t n )
+{
+    ++allocations;
+    void *p = std::malloc( n ? n : 1 );
+    if ( !p )
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+__attribute__(( noinline ))
+void* operator new[]( size_t n )
+{
+    return operator new( n );
+}
+
+__attribute__(( noinline ))
+void* operator new( size_t n, const std::nothrow_t& ) throw()
+{
+    ++allocations;
+    return std::malloc( n ? n : 1 );
+}
+
+__attribute__(( noinline ))
+void* operator new[]( size_t n, const std::nothrow_t &tag ) throw()
+{
+    return operator new( n, tag );
+}
+
+// every other form of delete goes to free() as well, or the library ones
+// would release memory they did not allocate
+
+__attribute__(( noinline ))
+void operator delete( void *p ) throw()
+{
+    std::free( p );
+}
+
+__attribute__(( noinline ))
+void operator delete[]( void *p ) throw()
+{
+    std::free( p );
+}
+
+__attribute__(( noinline ))
+void operator delete( void *p, size_t ) throw()
+{
+    std::free( p );
+}
+
+__attribute__(( noinline ))
+void operator delete[]( void *p, size_t ) throw()
+{
+    std::free( p );
+}
+
+__attribute__(( noinline ))
+void operator delete( void *p, const std::nothrow_t& ) throw()
+{
+    std::free( p );
+}
+
+__attribute__(( noinline ))
+void operator delete[]( void *p, const std::nothrow_t& ) throw()
+{
+    std::free( p );
+}
+
+namespace
+{
+
+typedef std::vector<std::shared_ptr<Sudoku::Puzzle> > PuzzleContainer;
+
+double NowNs()
+{
+    timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * Time and allocations of one stage, over many ops
+ */
+class Stage
+{
+public:
+    explicit Stage( const char *name )
+        : _name( name ), _ns( 0 ), _allocations( 0 ), _ops( 0 ),
+          _start( 0 ), _startAllocations( 0 ) {}
+
+    void Start()
+    {
+        _startAllocations = allocations;
+        _start = NowNs();
+    }
+
+    void Stop( size_t ops )
+    {
+        _ns += NowNs() - _start;
+        _allocations += allocations - _startAllocations;
+        _ops += ops;
+    }
+
+    void Write( std::ostream &out ) const
+    {
+        size_t ops = _ops ? _ops : 1;
+        out << "{\"name\": \"" << _name << "\", \"ops\": " << _ops
+            << ", \"ns_per_op\": " << _ns / ops
+            << ", \"allocs_per_op\": "
+            << static_cast<double>( _allocations ) / ops
+            << ", \"ops_per_sec\": " << ( _ns > 0 ? _ops * 1e9 / _ns : 0 )
+            << "}";
+    }
+
+private:
+    const char *_name;
+    double _ns;
+    size_t _allocations;
+    size_t _ops;
+    double _start;
+    size_t _startAllocations;
+};
+
+/**
+ * Fresh, unmarked Puzzles of a corpus
+ */
+void MakePuzzles( const std::vector<Sudoku::Grid> &grids,
+                  PuzzleContainer &puzzles )
+{
+    puzzles.clear();
+    for ( size_t k = 0; k < grids.size(); k++ )
+    {
+        std::shared_ptr<Sudoku::Puzzle> p( new Sudoku::Puzzle );
+        grids[k].CopyTo( *p );
+        puzzles.push_back( p );
+    }
+}
+
+/**
+ * Marks of each Cell without a value, bit value - 1, as MethodSolver
+ * feeds its LinkGraph
+ */
+void Candidates( Sudoku::Puzzle &p,
+                 unsigned short candidates[Sudoku::Units::CELL_COUNT] )
+{
+    for ( size_t i = 0; i < Sudoku::Units::CELL_COUNT; i++ )
+    {
+        std::shared_ptr<Sudoku::Cell> c = p.GetCell( i % 9 + 1, i / 9 + 1 );
+        candidates[i] = ( c->CanGuess() && c->DisplayedValue() == 0 ) ?
+            ( ( c->GetMarkContainer().to_ulong() >> 1 ) & 0x1FF ) : 0;
+    }
+}
+
+void WriteStats( std::ostream &out, const Sudoku::SolveStats &stats )
+{
+    out << "{\"passes\": " << stats.passes
+        << ", \"validations\": " << stats.validations
+        << ", \"methods\": {";
+    for ( size_t k = 0; k < Sudoku::PropagationQueue::RULE_COUNT; k++ )
+    {
+        const Sudoku::SolveStats::Method &m = stats.methods[k];
+        out << ( k ? ", " : "" ) << "\n        \""
+            << Sudoku::SolveStats::GetName( k ) << "\": {"
+            << "\"runs\": " << m.runs
+            << ", \"found\": " << m.found
+            << ", \"verified\": " << m.verified
+            << ", \"executed\": " << m.executed
+            << ", \"eliminated\": " << m.eliminated
+            << ", \"find_ns\": " << m.findNanos
+            << ", \"execute_ns\": " << m.executeNanos << "}";
+    }
+    out << "}}";
+}
+
+/**
+ * Run every stage over a corpus and write its JSON object
+ * @return false if the corpus cannot be read
+ */
+bool RunCorpus( const char *file, size_t minOps, std::ostream &out )
+{
+    std::ifstream in( file );
+    if ( !in )
+    {
+        std::cerr << "Cannot open " << file << std::endl;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+
+    Sudoku::GridListImporter importer;
+    std::vector<Sudoku::Grid> grids;
+    {
+        std::istringstream first( text );
+        grids = importer.Import( first );
+    }
+    if ( grids.empty() )
+    {
+        std::cerr << "No puzzles in " << file << std::endl;
+        return false;
+    }
+    const size_t n = grids.size();
+    const size_t rounds = ( minOps + n - 1 ) / n;
+    // the covering sets are picked at random
+    std::srand( 1 );
+
+    std::shared_ptr<Sudoku::IPuzzleMarker> marker( new Sudoku::PuzzleMarker );
+    std::shared_ptr<Sudoku::SolutionMethodFactory> factory(
+        new Sudoku::SolutionMethodFactory );
+    std::shared_ptr<Sudoku::SolverHelper> helper(
+        new Sudoku::SolverHelper( factory ) );
+    std::shared_ptr<Sudoku::IValidator> validator =
+        Sudoku::SimpleValidator::CreateGuessValidator();
+    Sudoku::MethodSolver solver( helper, marker, validator );
+    solver.SetFallback( std::shared_ptr<Sudoku::ISolver>(
+        new Sudoku::BacktrackingSolver( marker ) ) );
+    solver.SetStatsEnabled( true );
+
+    std::vector<Stage> stages;
+    PuzzleContainer puzzles;
+
+    // parsing the file and building the Puzzles
+    Stage import( "import" );
+    for ( size_t r = 0; r < rounds; r++ )
+    {
+        import.Start();
+        std::istringstream stream( text );
+        std::vector<Sudoku::Grid> parsed = importer.Import( stream );
+        MakePuzzles( parsed, puzzles );
+        import.Stop( n );
+    }
+    stages.push_back( import );
+
+    Stage marks( "marks" );
+    for ( size_t r = 0; r < rounds; r++ )
+    {
+        MakePuzzles( grids, puzzles );
+        marks.Start();
+        for ( size_t k = 0; k < n; k++ )
+        {
+            marker->UpdateMarks( puzzles[k] );
+        }
+        marks.Stop( n );
+    }
+    stages.push_back( marks );
+
+    // queries only find Methods, so the marked Puzzles are kept
+    Stage singleCandidate( "single_candidate" );
+    Stage exclusion( "exclusion" );
+    Stage hiddenSingle( "hidden_single" );
+    Stage blockIntersection( "block_intersection" );
+    Stage coveringSet( "covering_set" );
+    Stage fish( "fish" );
+    Stage chain( "chain" );
+    for ( size_t r = 0; r < rounds; r++ )
+    {
+        for ( size_t k = 0; k < n; k++ )
+        {
+            std::shared_ptr<Sudoku::Puzzle> p = puzzles[k];
+            singleCandidate.Start();
+            helper->GetAllSingleCandidate( p );
+            singleCandidate.Stop( 1 );
+
+            exclusion.Start();
+            helper->GetAllExclusion( p );
+            exclusion.Stop( 1 );
+
+            hiddenSingle.Start();
+            helper->GetAllHiddenSingle( p );
+            hiddenSingle.Stop( 1 );
+
+            blockIntersection.Start();
+            for ( size_t i = 0; i < Sudoku::Units::CELL_COUNT; i++ )
+            {
+                std::shared_ptr<Sudoku::Cell> c =
+                    p->GetCell( i % 9 + 1, i / 9 + 1 );
+                if ( c->CanGuess() )
+                {
+                    helper->GetAllBlockIntersection( p, c );
+                }
+            }
+            blockIntersection.Stop( 1 );
+
+            coveringSet.Start();
+            for ( size_t u = 0; u < Sudoku::Units::UNIT_COUNT; u++ )
+            {
+                helper->GetAllCoveringSet( p, u );
+            }
+            coveringSet.Stop( 1 );
+
+            fish.Start();
+            helper->GetAllFish( p );
+            fish.Stop( 1 );
+
+            chain.Start();
+            unsigned short candidates[Sudoku::Units::CELL_COUNT];
+            Candidates( *p, candidates );
+            Sudoku::LinkGraph graph;
+            graph.Update( candidates );
+            for ( size_t kind = 0; kind < Sudoku::Chains::KIND_COUNT; kind++ )
+            {
+                helper->GetAllChains( p, graph,
+                                      static_cast<Sudoku::Chains::Kind>( kind ),
+                                      0x1FF );
+            }
+            chain.Stop( 1 );
+        }
+    }
+    stages.push_back( singleCandidate );
+    stages.push_back( exclusion );
+    stages.push_back( hiddenSingle );
+    stages.push_back( blockIntersection );
+    stages.push_back( coveringSet );
+    stages.push_back( fish );
+    stages.push_back( chain );
+
+    Stage solve( "solve" );
+    Sudoku::SolveStats solveStats;
+    PuzzleContainer solved;
+    for ( size_t r = 0; r < rounds; r++ )
+    {
+        MakePuzzles( grids, puzzles );
+        solve.Start();
+        for ( size_t k = 0; k < n; k++ )
+        {
+            try
+            {
+                solver.Solve( puzzles[k] );
+            }
+            catch ( const std::exception &e )
+            {
+                // counted anyway, validation reports it
+                std::cerr << "Puzzle " << k << " of " << file << ": "
+                          << e.what() << std::endl;
+            }
+            solveStats += solver.GetStats();
+        }
+        solve.Stop( n );
+    }
+    solved = puzzles;
+    stages.push_back( solve );
+
+    Stage validate( "validate" );
+    for ( size_t r = 0; r < rounds; r++ )
+    {
+        validate.Start();
+        for ( size_t k = 0; k < n; k++ )
+        {
+            if ( !validator->IsValid( solved[k] ) )
+            {
+                std::cerr << "Puzzle " << k << " of " << file
+                          << " is not solved" << std::endl;
+            }
+        }
+        validate.Stop( n );
+    }
+    stages.push_back( validate );
+
+    // a player entering the solution one Cell at a time, then taking every
+    // step back and doing it again, as GameManager applies them
+    std::vector<Sudoku::UndoHistory::DeltaContainer> steps( n );
+    MakePuzzles( grids, puzzles );
+    for ( size_t k = 0; k < n; k++ )
+    {
+        for ( size_t i = 0; i < Sudoku::Units::CELL_COUNT; i++ )
+        {
+            Sudoku::Cell::State before = puzzles[k]->GetCell(
+                i % 9 + 1, i / 9 + 1 )->GetState();
+            Sudoku::Cell::State after = solved[k]->GetCell(
+                i % 9 + 1, i / 9 + 1 )->GetState();
+            if ( before != after )
+            {
+                steps[k].push_back(
+                    Sudoku::UndoHistory::MakeDelta( i, before, after ) );
+            }
+        }
+    }
+    Stage undoRedo( "undo_redo" );
+    Sudoku::UndoHistory history;
+    Sudoku::UndoHistory::DeltaContainer deltas;
+    for ( size_t r = 0; r < rounds; r++ )
+    {
+        for ( size_t k = 0; k < n; k++ )
+        {
+            history.Clear();
+            for ( size_t s = 0; s < steps[k].size(); s++ )
+            {
+                deltas.assign( 1, steps[k][s] );
+                history.Record( deltas );
+            }
+            std::shared_ptr<Sudoku::Puzzle> p = solved[k];
+            undoRedo.Start();
+            size_t ops = 0;
+            for ( int redo = 0; redo < 2; redo++ )
+            {
+                while ( redo ? history.Redo( deltas ) : history.Undo( deltas ) )
+                {
+                    Sudoku::Puzzle::ChangeTransaction changes( p );
+                    for ( size_t d = 0; d < deltas.size(); d++ )
+                    {
+                        Sudoku::UndoHistory::Delta delta = deltas[d];
+                        size_t i = Sudoku::UndoHistory::GetIndex( delta );
+                        p->GetCell( i % 9 + 1, i / 9 + 1 )->SetState(
+                            redo ? Sudoku::UndoHistory::GetAfter( delta )
+                                 : Sudoku::UndoHistory::GetBefore( delta ) );
+                    }
+                    ++ops;
+                }
+            }
+            undoRedo.Stop( ops );
+        }
+    }
+    stages.push_back( undoRedo );
+
+    out << "    {\"corpus\": \"" << file << "\", \"puzzles\": " << n
+        << ", \"rounds\": " << rounds << ",\n     \"stages\": [";
+    for ( size_t s = 0; s < stages.size(); s++ )
+    {
+        out << ( s ? "," : "" ) << "\n      ";
+        stages[s].Write( out );
+    }
+    out << "],\n     \"solve_stats\": ";
+    WriteStats( out, solveStats );
+    out << "}";
+    return true;
+}
+
+void Usage()
+{
+    std::cerr << "Usage: suite_bench [-n ops] corpus..." << std::endl;
+}
+
+}
+
+int main( int argc, char** argv )
+{
+    FILELog::ReportingLevel() = logERROR;
+
+    size_t minOps = 2000;
+    std::vector<const char*> corpora;
+    for ( int a = 1; a < argc; a++ )
+    {
+        if ( std::strcmp( argv[a], "-n" ) == 0 && a + 1 < argc )
+        {
+            minOps = std::atol( argv[++a] );
+        }
+        else if ( argv[a][0] != '-' )
+        {
+            corpora.push_back( argv[a] );
+        }
+        else
+        {
+            Usage();
+            return 1;
+        }
+    }
+    if ( corpora.empty() || minOps == 0 )
+    {
+        Usage();
+        return 1;
+    }
+
+    // a corpus which cannot be read is left out, the JSON stays valid
+    std::cout << "{\"corpora\": [\n";
+    bool ok = true;
+    size_t written = 0;
+    for ( size_t c = 0; c < corpora.size(); c++ )
+    {
+        std::ostringstream corpus;
+        if ( !RunCorpus( corpora[c], minOps, corpus ) )
+        {
+            ok = false;
+            continue;
+        }
+        std::cout << ( written++ ? ",\n" : "" ) << corpus.str();
+    }
+    std::cout << "\n]}" << std::endl;
+    return ok ? 0 : 1;
+}
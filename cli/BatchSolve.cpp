@@ -0,0 +1,167 @@
+/**
+ * Headless solver for files of Puzzles
+ * Usage: batch_solve [-j threads] [input file] [output file]
+ *
+ * Input is one Puzzle per line (81 values) or the 9x9 layout of
+ * SimplePuzzleImporter, "-" or no file for stdin/stdout.  An input file is
+ * mapped, stdin is read whole; either way malformed Puzzles are reported on
+ * stderr and not solved.
+ * Writes one line of 81 values per Puzzle in input order (only the givens
+ * with 0 elsewhere if the solver got stuck, all 0 for a malformed Puzzle)
+ * and reports throughput on stderr.
+ * Exit status is 0 if every Puzzle was solved, 2 if some were not (malformed
+ * ones included), 1 on error.
+ */
+
+#include "../BatchSolver.h"
+#include "../GridListImporter.h"
+#include "../Log.h"
+#include "../MappedGridImporter.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <time.h>
+
+namespace
+{
+
+double NowSeconds()
+{
+    timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void Usage()
+{
+    std::cerr << "Usage: batch_solve [-j threads] [input file] [output file]"
+              << std::endl;
+}
+
+}
+
+int main( int argc, char** argv )
+{
+    FILELog::ReportingLevel() = logERROR;
+    // e.g. SUDOKU_LOG=MethodSolver=DEBUG
+    LogModule::Configure( std::getenv( "SUDOKU_LOG" ) );
+
+    size_t threads = 0;
+    const char *inName = "-";
+    const char *outName = "-";
+    int files = 0;
+    for ( int a = 1; a < argc; a++ )
+    {
+        if ( std::strcmp( argv[a], "-j" ) == 0 && a + 1 < argc )
+        {
+            threads = std::atoi( argv[++a] );
+        }
+        else if ( std::strcmp( argv[a], "-h" ) == 0 || files == 2 )
+        {
+            Usage();
+            return 1;
+        }
+        else if ( files++ == 0 )
+        {
+            inName = argv[a];
+        }
+        else
+        {
+            outName = argv[a];
+        }
+    }
+
+    // malformed Puzzles are reported here and written as all 0 below
+    Sudoku::MappedGridImporter importer;
+    std::vector<Sudoku::Grid> puzzles;
+    try
+    {
+        if ( std::strcmp( inName, "-" ) == 0 )
+        {
+            std::string text( ( std::istreambuf_iterator<char>( std::cin ) ),
+                              std::istreambuf_iterator<char>() );
+            importer.Parse( text.data(), text.size() );
+        }
+        else
+        {
+            importer.Import( inName );
+        }
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << inName << ": " << e.what() << std::endl;
+        return 1;
+    }
+    const std::vector<size_t> &bad = importer.GetMalformedLines();
+    for ( size_t i = 0; i < bad.size(); i++ )
+    {
+        std::cerr << inName << ":" << bad[i] << ": malformed puzzle"
+                  << std::endl;
+    }
+    importer.CopyTo( puzzles );
+
+    Sudoku::BatchSolver solver( threads );
+    double start = NowSeconds();
+    std::vector<Sudoku::BatchSolver::Result> results = solver.Solve( puzzles );
+    double elapsed = NowSeconds() - start;
+
+    std::ofstream file;
+    if ( std::strcmp( outName, "-" ) != 0 )
+    {
+        file.open( outName );
+        if ( !file )
+        {
+            std::cerr << "Cannot open " << outName << std::endl;
+            return 1;
+        }
+    }
+    std::ostream &out = file.is_open() ? file : std::cout;
+    const std::vector<size_t> &malformed = importer.GetMalformedPositions();
+    const size_t total = results.size() + malformed.size();
+    const Sudoku::Grid blank;
+    size_t solved = 0;
+    size_t next = 0;
+    size_t r = 0;
+    for ( size_t i = 0; i < total; i++ )
+    {
+        if ( next < malformed.size() && malformed[next] == i )
+        {
+            Sudoku::GridListImporter::Export( out, blank );
+            ++next;
+            continue;
+        }
+        if ( results[r].solved )
+        {
+            Sudoku::GridListImporter::Export( out, results[r].grid );
+            ++solved;
+        }
+        else
+        {
+            // what the solver left may hold wrong guesses, keep the givens
+            Sudoku::Grid givens = results[r].grid;
+            for ( size_t c = 0; c < Sudoku::Grid::ARRAY_SIZE; c++ )
+            {
+                if ( !givens[c].given )
+                {
+                    givens[c].value = 0;
+                }
+            }
+            Sudoku::GridListImporter::Export( out, givens );
+        }
+        ++r;
+    }
+    out.flush();
+
+    std::cerr << "Solved " << solved << " of " << total
+              << " puzzles in " << elapsed << " s on "
+              << solver.GetThreadCount() << " threads ("
+              << ( elapsed > 0 ? results.size() / elapsed : 0 )
+              << " puzzles/sec)" << std::endl;
+
+    return ( solved == total ) ? 0 : 2;
+}
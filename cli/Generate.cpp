@@ -0,0 +1,108 @@
+/**
+ * Headless Puzzle generator
+ * Usage: generate [-j threads] [-s seed] [-d easy|medium|hard|expert] count
+ *
+ * Writes count Puzzles to stdout, one line of 81 values each (0 for blank),
+ * and reports throughput on stderr.  The output only depends on the seed and
+ * difficulty, not on the number of threads.
+ */
+
+#include "../GridListImporter.h"
+#include "../PuzzleGenerator.h"
+#include "../Log.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <time.h>
+
+namespace
+{
+
+double NowSeconds()
+{
+    timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void Usage()
+{
+    std::cerr << "Usage: generate [-j threads] [-s seed] "
+              << "[-d easy|medium|hard|expert] count" << std::endl;
+}
+
+bool ParseDifficulty( const std::string &s, Sudoku::Difficulty &d )
+{
+    if ( s == "easy" ) { d = Sudoku::DIFFICULTY_EASY; }
+    else if ( s == "medium" ) { d = Sudoku::DIFFICULTY_MEDIUM; }
+    else if ( s == "hard" ) { d = Sudoku::DIFFICULTY_HARD; }
+    else if ( s == "expert" ) { d = Sudoku::DIFFICULTY_EXPERT; }
+    else { return false; }
+    return true;
+}
+
+}
+
+int main( int argc, char** argv )
+{
+    FILELog::ReportingLevel() = logERROR;
+    // e.g. SUDOKU_LOG=MethodSolver=DEBUG
+    LogModule::Configure( std::getenv( "SUDOKU_LOG" ) );
+
+    size_t threads = 0;
+    uint32_t seed = static_cast<uint32_t>( time( 0 ) );
+    Sudoku::Difficulty target = Sudoku::DIFFICULTY_EXPERT;
+    long count = -1;
+    for ( int a = 1; a < argc; a++ )
+    {
+        if ( std::strcmp( argv[a], "-j" ) == 0 && a + 1 < argc )
+        {
+            threads = std::atoi( argv[++a] );
+        }
+        else if ( std::strcmp( argv[a], "-s" ) == 0 && a + 1 < argc )
+        {
+            seed = std::strtoul( argv[++a], NULL, 10 );
+        }
+        else if ( std::strcmp( argv[a], "-d" ) == 0 && a + 1 < argc )
+        {
+            if ( !ParseDifficulty( argv[++a], target ) )
+            {
+                Usage();
+                return 1;
+            }
+        }
+        else if ( count < 0 && argv[a][0] != '-' )
+        {
+            count = std::atol( argv[a] );
+        }
+        else
+        {
+            Usage();
+            return 1;
+        }
+    }
+    if ( count < 0 )
+    {
+        Usage();
+        return 1;
+    }
+
+    double start = NowSeconds();
+    std::vector<Sudoku::Grid> puzzles =
+        Sudoku::PuzzleGenerator::GenerateBatch( count, seed, target, threads );
+    double elapsed = NowSeconds() - start;
+
+    for ( size_t i = 0; i < puzzles.size(); i++ )
+    {
+        Sudoku::GridListImporter::Export( std::cout, puzzles[i] );
+    }
+    std::cout.flush();
+
+    std::cerr << "Generated " << puzzles.size() << " puzzles (seed " << seed
+              << ") in " << elapsed << " s ("
+              << ( elapsed > 0 ? puzzles.size() / elapsed : 0 )
+              << " puzzles/sec)" << std::endl;
+    return 0;
+}
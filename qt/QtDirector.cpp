@@ -54,6 +54,10 @@ QtDirector::QtDirector( int &argc, char **argv,
 
     connect( _window->GetLoadAction(), SIGNAL( triggered() ),
              _model.get(), SLOT( LoadPuzzle() ) );
+    connect( _window->GetSaveGameAction(), SIGNAL( triggered() ),
+             _model.get(), SLOT( SaveGame() ) );
+    connect( _window->GetResumeGameAction(), SIGNAL( triggered() ),
+             _model.get(), SLOT( LoadGame() ) );
     connect( _window->GetNewAction(), SIGNAL( triggered() ),
              _model.get(), SLOT( NewPuzzle() ) );
     connect( _window->GetUndoAction(), SIGNAL( triggered() ),
@@ -69,6 +73,8 @@ QtDirector::QtDirector( int &argc, char **argv,
              _window->GetMarkHintsAction(), SLOT( setEnabled( bool ) ) );
     connect( _model.get(), SIGNAL( hasPuzzle(bool) ),
              _window->GetSolveAction(), SLOT( setEnabled( bool ) ) );
+    connect( _model.get(), SIGNAL( hasPuzzle(bool) ),
+             _window->GetSaveGameAction(), SLOT( setEnabled( bool ) ) );
 
     connect( this, SIGNAL( canUndo( bool ) ),
              _window->GetUndoAction(), SLOT( setEnabled( bool ) ) );
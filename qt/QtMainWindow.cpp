@@ -33,6 +33,16 @@ QAction* QtMainWindow::GetLoadAction()
     return _loadAction;
 }
 
+QAction* QtMainWindow::GetSaveGameAction()
+{
+    return _saveGameAction;
+}
+
+QAction* QtMainWindow::GetResumeGameAction()
+{
+    return _resumeGameAction;
+}
+
 QAction* QtMainWindow::GetExitAction()
 {
     return _exitAction;
@@ -93,6 +103,14 @@ void QtMainWindow::createActions()
     _loadAction->setShortcuts( QKeySequence::Open );
     _loadAction->setStatusTip( tr("Load a puzzle from a file") );
 
+    _saveGameAction = new QAction( tr("&Save Game..."), this );
+    _saveGameAction->setShortcuts( QKeySequence::Save );
+    _saveGameAction->setStatusTip( tr("Save the game, with undo history") );
+    _saveGameAction->setEnabled( false );
+
+    _resumeGameAction = new QAction( tr("&Resume Game..."), this );
+    _resumeGameAction->setStatusTip( tr("Resume a saved game") );
+
     _exitAction = new QAction( tr("E&xit"), this );
     _exitAction->setShortcuts( QKeySequence::Quit );
     _exitAction->setStatusTip( tr("Quit the game") );
@@ -133,6 +151,9 @@ void QtMainWindow::createMenus()
     _fileMenu->addAction( _newAction );
     _fileMenu->addAction( _loadAction );
     _fileMenu->addSeparator();
+    _fileMenu->addAction( _saveGameAction );
+    _fileMenu->addAction( _resumeGameAction );
+    _fileMenu->addSeparator();
     _fileMenu->addAction( _exitAction);
 
     _editMenu = menuBar()->addMenu( tr("&Edit")) ;
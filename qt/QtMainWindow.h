@@ -19,6 +19,8 @@ public:
     // Allow other things to connect to the action SIGNALs
     QAction* GetNewAction();
     QAction* GetLoadAction();
+    QAction* GetSaveGameAction();
+    QAction* GetResumeGameAction();
     QAction* GetExitAction();
     QAction* GetUndoAction();
     QAction* GetRedoAction();
@@ -51,6 +53,8 @@ private:
     QMenu *_helpMenu;
     QAction *_newAction;
     QAction *_loadAction;
+    QAction *_saveGameAction;
+    QAction *_resumeGameAction;
     QAction *_exitAction;
     QAction *_undoAction;
     QAction *_redoAction;
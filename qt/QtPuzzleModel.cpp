@@ -280,4 +280,42 @@ void QtPuzzleModel::Update( const Sudoku::Cell &c )
                       createIndex( c.GetY() - 1, c.GetX() - 1 ) );
 }
 
+bool QtPuzzleModel::SaveGame()
+{
+    QString fileName =
+        QFileDialog::getSaveFileName( QApplication::focusWidget() );
+    if ( !fileName.isEmpty() )
+    {
+        if ( !_gameController->SaveGame( fileName.toStdString() ) )
+        {
+            QErrorMessage message( QApplication::focusWidget() );
+            message.showMessage( "Failed to save game" );
+            message.exec();
+            return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool QtPuzzleModel::LoadGame()
+{
+    QString fileName =
+        QFileDialog::getOpenFileName( QApplication::focusWidget() );
+    if ( !fileName.isEmpty() )
+    {
+        bool ret = _gameController->LoadGame( fileName.toStdString() );
+        if ( !ret )
+        {
+            QErrorMessage message( QApplication::focusWidget() );
+            message.showMessage( "Failed to resume game" );
+            message.exec();
+        }
+        emit hasPuzzle( _access->GetPuzzle() );
+        return ret;
+    }
+    emit hasPuzzle( _access->GetPuzzle() );
+    return false;
+}
+
 }
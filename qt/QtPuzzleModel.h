@@ -48,6 +48,8 @@ public:
 public slots:
     void NewPuzzle();
     bool LoadPuzzle();
+    bool SaveGame();
+    bool LoadGame();
     void MarkPuzzleHints();
     void Solve();
     void Undo();
@@ -4,11 +4,15 @@
 #include "QtFactory.h"
 #include <Log.h>
 
+#include <cstdlib>
+
 using namespace QtSudoku;
 
 int main( int argc, char** argv )
 {
     FILELog::ReportingLevel() = logERROR;
+    // e.g. SUDOKU_LOG=MethodSolver=DEBUG
+    LogModule::Configure( std::getenv( "SUDOKU_LOG" ) );
     QtFactory factory;
     std::shared_ptr<QtDirector> director = factory.CreateDirector( argc, argv );
     return director->Exec();
@@ -100,10 +100,13 @@ TEST_F( AddHintMarksCommandTest, SetsMarksOnExecute )
     _puzzle->GetCell( 1, 7 )->SetGuess( 3 );
     std::shared_ptr<Sudoku::Puzzle> copyPuzzle(
         new Sudoku::Puzzle( *_puzzle ) );
+    _marker->UpdateMarks( copyPuzzle );
     _command = Sudoku::AddHintMarksCommand::CreateAddHintMarksCommand(
         _puzzle, _marker );
     EXPECT_TRUE( _command->Execute( _puzzle ) );
-    EXPECT_EQ( *copyPuzzle, *_puzzle );    
+    EXPECT_EQ( *copyPuzzle, *_puzzle );
+    EXPECT_FALSE( _puzzle->GetCell( 3, 4 )->GetMarkContainer()[4] );
+    EXPECT_TRUE( _puzzle->GetCell( 3, 4 )->GetMarkContainer()[5] );
 }
 
 // can execute, unexecute, execute
@@ -0,0 +1,130 @@
+#include "../BacktrackingSolver.h"
+#include "../CandidateGrid.h"
+#include "../Grid.h"
+#include "../Puzzle.h"
+#include "../PuzzleMarker.h"
+#include "../SimpleValidator.h"
+#include "../SolveCommand.h"
+#include "TestGrids.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+namespace {
+
+using Sudoku::TestGrids::HARD;
+using Sudoku::TestGrids::HARD_SOLUTION;
+using Sudoku::TestGrids::MakeGrid;
+
+class BacktrackingSolverTest : public ::testing::Test
+{
+protected:
+    BacktrackingSolverTest()
+    {
+        _puzzle.reset( new Sudoku::Puzzle );
+        _marker.reset( new Sudoku::PuzzleMarker );
+        _validator = Sudoku::SimpleValidator::CreateGuessValidator();
+        _solver.reset( new Sudoku::BacktrackingSolver( _marker ) );
+    }
+
+    virtual ~BacktrackingSolverTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    void MakePuzzle( const std::string &s )
+    {
+        MakeGrid( s ).CopyTo( *_puzzle );
+    }
+
+    std::string Displayed()
+    {
+        std::string s;
+        for ( size_t y = 1; y <= 9; y++ )
+        {
+            for ( size_t x = 1; x <= 9; x++ )
+            {
+                s += '0' + _puzzle->GetCell( x, y )->DisplayedValue();
+            }
+        }
+        return s;
+    }
+
+    std::shared_ptr<Sudoku::Puzzle> _puzzle;
+    std::shared_ptr<Sudoku::IPuzzleMarker> _marker;
+    std::shared_ptr<Sudoku::IValidator> _validator;
+    std::shared_ptr<Sudoku::BacktrackingSolver> _solver;
+};
+
+// A puzzle the logical methods cannot finish
+TEST_F( BacktrackingSolverTest, SolvesHardPuzzle )
+{
+    MakePuzzle( HARD );
+    EXPECT_NO_THROW( _solver->Solve( _puzzle ) );
+    EXPECT_TRUE( _validator->IsValid( _puzzle ) );
+    EXPECT_EQ( HARD_SOLUTION, Displayed() );
+    // givens stay givens, the rest are guesses without marks
+    EXPECT_FALSE( _puzzle->GetCell( 1, 1 )->CanGuess() );
+    EXPECT_TRUE( _puzzle->GetCell( 2, 1 )->CanGuess() );
+    EXPECT_EQ( 1, _puzzle->GetCell( 2, 1 )->DisplayedValue() );
+    EXPECT_EQ( 0u, _puzzle->GetCell( 2, 1 )->CountMarks() );
+}
+
+// Guesses already on the board are kept
+TEST_F( BacktrackingSolverTest, KeepsGuesses )
+{
+    MakePuzzle( HARD );
+    _puzzle->GetCell( 2, 1 )->SetGuess( 1 );
+    _solver->Solve( _puzzle );
+    EXPECT_EQ( HARD_SOLUTION, Displayed() );
+}
+
+// Conflicting values cannot be solved
+TEST_F( BacktrackingSolverTest, ThrowsWithoutSolution )
+{
+    MakePuzzle( HARD );
+    _puzzle->GetCell( 2, 1 )->SetGuess( 8 );
+    EXPECT_THROW( _solver->Solve( _puzzle ), std::runtime_error );
+
+    // consistent so far, but no solution
+    MakePuzzle( HARD );
+    _puzzle->GetCell( 2, 1 )->SetGuess( 2 );
+    EXPECT_THROW( _solver->Solve( _puzzle ), std::runtime_error );
+}
+
+// Search stops at the limit and finds the solution
+TEST_F( BacktrackingSolverTest, SearchCountsToLimit )
+{
+    Sudoku::CandidateGrid solution;
+    Sudoku::CandidateGrid hard( MakeGrid( HARD ) );
+    EXPECT_EQ( 1u, Sudoku::BacktrackingSolver::Search( hard, 2, &solution ) );
+    EXPECT_EQ( 8, solution.GetValue( 0 ) );
+    EXPECT_EQ( 1, solution.GetValue( 1 ) );
+    EXPECT_TRUE( solution.IsSolved() );
+
+    Sudoku::CandidateGrid blank;
+    EXPECT_EQ( 2u, Sudoku::BacktrackingSolver::Search( blank, 2, NULL ) );
+    EXPECT_EQ( 5u, Sudoku::BacktrackingSolver::Search( blank, 5, NULL ) );
+    EXPECT_EQ( 0u, Sudoku::BacktrackingSolver::Search( blank, 0, NULL ) );
+}
+
+// Works as the solver of a SolveCommand
+TEST_F( BacktrackingSolverTest, SolveCommand )
+{
+    MakePuzzle( HARD );
+    std::shared_ptr<Sudoku::Command<Sudoku::Puzzle> > c =
+        Sudoku::SolveCommand::Create( _puzzle, _solver );
+    EXPECT_TRUE( c->Execute( _puzzle ) );
+    EXPECT_EQ( HARD_SOLUTION, Displayed() );
+    EXPECT_TRUE( c->Unexecute( _puzzle ) );
+    EXPECT_EQ( HARD, Displayed() );
+}
+
+}  // namespace
@@ -0,0 +1,97 @@
+#include "../BatchSolver.h"
+#include "../GridListImporter.h"
+#include "TestGrids.h"
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+namespace {
+
+using Sudoku::TestGrids::EASY;
+using Sudoku::TestGrids::EASY_SOLUTION;
+
+class BatchSolverTest : public ::testing::Test
+{
+protected:
+    BatchSolverTest()
+    {
+    }
+
+    virtual ~BatchSolverTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    std::vector<Sudoku::Grid> Import( const std::string &s )
+    {
+        std::istringstream in( s );
+        Sudoku::GridListImporter importer;
+        return importer.Import( in );
+    }
+
+    /**
+     * Export one Grid, without the line break
+     */
+    std::string Export( const Sudoku::Grid &g )
+    {
+        std::ostringstream out;
+        Sudoku::GridListImporter::Export( out, g );
+        std::string line = out.str();
+        return line.substr( 0, line.size() - 1 );
+    }
+};
+
+const char *TOO_FEW =
+    "100000000000000000000000000000000000000000000"
+    "000000000000000000000000000000000000";
+
+// Results come back in input order, failures are flagged
+TEST_F( BatchSolverTest, SolvesInOrder )
+{
+    std::string input;
+    for ( size_t i = 0; i < 20; i++ )
+    {
+        input += ( i % 5 == 3 ) ? TOO_FEW : EASY;
+        input += '\n';
+    }
+    std::vector<Sudoku::Grid> puzzles = Import( input );
+    Sudoku::BatchSolver solver( 4 );
+    EXPECT_EQ( 4u, solver.GetThreadCount() );
+    std::vector<Sudoku::BatchSolver::Result> results =
+        solver.Solve( puzzles );
+    ASSERT_EQ( 20u, results.size() );
+    for ( size_t i = 0; i < results.size(); i++ )
+    {
+        if ( i % 5 == 3 )
+        {
+            EXPECT_FALSE( results[i].solved );
+            EXPECT_EQ( TOO_FEW, Export( results[i].grid ) );
+        }
+        else
+        {
+            EXPECT_TRUE( results[i].solved );
+            EXPECT_EQ( EASY_SOLUTION, Export( results[i].grid ) );
+        }
+    }
+}
+
+// Same output with one thread
+TEST_F( BatchSolverTest, SingleThread )
+{
+    Sudoku::BatchSolver solver( 1 );
+    std::vector<Sudoku::BatchSolver::Result> results =
+        solver.Solve( Import( EASY ) );
+    ASSERT_EQ( 1u, results.size() );
+    EXPECT_TRUE( results[0].solved );
+    EXPECT_EQ( EASY_SOLUTION, Export( results[0].grid ) );
+    EXPECT_TRUE( solver.Solve( std::vector<Sudoku::Grid>() ).empty() );
+}
+
+}  // namespace
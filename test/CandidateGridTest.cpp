@@ -0,0 +1,209 @@
+#include "../CandidateGrid.h"
+#include "../Grid.h"
+#include "TestGrids.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using Sudoku::TestGrids::EASY;
+using Sudoku::TestGrids::EASY_SOLUTION;
+using Sudoku::TestGrids::MakeGrid;
+
+class CandidateGridTest : public ::testing::Test
+{
+protected:
+    CandidateGridTest()
+    {
+    }
+
+    virtual ~CandidateGridTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    /**
+     * Compare the incremental candidates with a full recompute
+     */
+    void ExpectMatchesRecompute( const Sudoku::CandidateGrid &cg )
+    {
+        Sudoku::Grid g;
+        cg.CopyTo( g );
+        Sudoku::Grid fresh = g;
+        fresh.UpdateMarks();
+        for ( size_t i = 0; i < Sudoku::Grid::ARRAY_SIZE; i++ )
+        {
+            unsigned short expected = g[i].value ? 0 : fresh[i].marks;
+            EXPECT_EQ( expected, cg.GetCandidates( i ) ) << "cell " << i;
+            for ( int d = 1; d <= 9; d++ )
+            {
+                EXPECT_EQ( ( expected >> ( d - 1 ) ) & 1,
+                           cg.GetValueCells( d ).Test( i ) );
+            }
+        }
+    }
+};
+
+// Bitboard set operations stay within the 81 cells
+TEST_F( CandidateGridTest, BitboardBasics )
+{
+    Sudoku::Bitboard b = Sudoku::Bitboard::None();
+    EXPECT_TRUE( b.Empty() );
+    b.Set( 0 );
+    b.Set( 63 );
+    b.Set( 64 );
+    b.Set( 80 );
+    EXPECT_EQ( 4u, b.Count() );
+    EXPECT_TRUE( b.Test( 64 ) );
+    EXPECT_FALSE( b.Test( 1 ) );
+    EXPECT_EQ( 77u, ( ~b ).Count() );
+    EXPECT_EQ( 81u, Sudoku::Bitboard::All().Count() );
+    EXPECT_EQ( 0u, b.PopFirst() );
+    EXPECT_EQ( 63u, b.PopFirst() );
+    EXPECT_EQ( 64u, b.PopFirst() );
+    EXPECT_EQ( 80u, b.First() );
+    b.Reset( 80 );
+    EXPECT_TRUE( b.Empty() );
+}
+
+// Unit and peer boards agree with the index tables
+TEST_F( CandidateGridTest, UnitBoardsMatchTables )
+{
+    for ( size_t u = 0; u < Sudoku::Units::UNIT_COUNT; u++ )
+    {
+        Sudoku::Bitboard b = Sudoku::Bitboard::None();
+        for ( size_t k = 0; k < Sudoku::Units::UNIT_SIZE; k++ )
+        {
+            b.Set( Sudoku::Units::UNIT_CELLS[u][k] );
+        }
+        EXPECT_TRUE( b == Sudoku::Units::UNIT_BOARDS[u] );
+    }
+    for ( size_t i = 0; i < Sudoku::Units::CELL_COUNT; i++ )
+    {
+        Sudoku::Bitboard b = Sudoku::Bitboard::None();
+        for ( size_t p = 0; p < Sudoku::Units::PEER_COUNT; p++ )
+        {
+            b.Set( Sudoku::Units::PEERS[i][p] );
+        }
+        EXPECT_TRUE( b == Sudoku::Units::PEER_BOARDS[i] );
+        for ( size_t k = 0; k < Sudoku::Units::UNITS_PER_CELL; k++ )
+        {
+            size_t u = Sudoku::Units::CELL_UNITS[i][k];
+            EXPECT_EQ( i, Sudoku::Units::UNIT_CELLS[u][
+                           Sudoku::Units::PositionInUnit( i, k )] );
+        }
+    }
+}
+
+// Blank board has every candidate everywhere
+TEST_F( CandidateGridTest, BlankHasAllCandidates )
+{
+    Sudoku::CandidateGrid cg;
+    EXPECT_TRUE( cg.IsConsistent() );
+    EXPECT_FALSE( cg.IsSolved() );
+    EXPECT_EQ( 81u, cg.GetUnsolved().Count() );
+    for ( size_t i = 0; i < Sudoku::Units::CELL_COUNT; i++ )
+    {
+        EXPECT_EQ( 0x1FF, cg.GetCandidates( i ) );
+    }
+    EXPECT_EQ( 0x1FF, cg.GetUnitPositions( 5, 3 ) );
+    EXPECT_TRUE( cg.GetNakedSingles().Empty() );
+}
+
+// Placing a value removes it from the peers only
+TEST_F( CandidateGridTest, PlaceEliminatesFromPeers )
+{
+    Sudoku::CandidateGrid cg;
+    EXPECT_TRUE( cg.Place( 10, 4 ) );
+    EXPECT_EQ( 4, cg.GetValue( 10 ) );
+    EXPECT_EQ( 0, cg.GetCandidates( 10 ) );
+    EXPECT_EQ( 60u, cg.GetValueCells( 4 ).Count() );
+    EXPECT_EQ( 0x1F7, cg.GetCandidates( 11 ) );
+    EXPECT_EQ( 0x1F7, cg.GetCandidates( 73 ) );
+    EXPECT_EQ( 0x1FF, cg.GetCandidates( 80 ) );
+    EXPECT_EQ( 1 << 3, cg.GetUnitValues( 1 ) );
+    EXPECT_EQ( 0, cg.GetUnitPositions( 1, 4 ) );
+    ExpectMatchesRecompute( cg );
+}
+
+// Incremental updates give the same marks as recomputing from scratch
+TEST_F( CandidateGridTest, LoadMatchesUpdateMarks )
+{
+    Sudoku::CandidateGrid cg( MakeGrid( EASY ) );
+    EXPECT_TRUE( cg.IsConsistent() );
+    ExpectMatchesRecompute( cg );
+}
+
+// Naked singles are cells with a single candidate
+TEST_F( CandidateGridTest, NakedSingles )
+{
+    Sudoku::CandidateGrid cg;
+    for ( int d = 1; d <= 8; d++ )
+    {
+        cg.Place( d, d );
+    }
+    Sudoku::Bitboard singles = cg.GetNakedSingles();
+    EXPECT_EQ( 1u, singles.Count() );
+    EXPECT_EQ( 0u, singles.First() );
+    EXPECT_EQ( 1 << 8, cg.GetCandidates( 0 ) );
+}
+
+// Hidden singles are the only place for a value in some unit
+TEST_F( CandidateGridTest, HiddenSingles )
+{
+    Sudoku::CandidateGrid cg;
+    // 1 in rows 2 and 3 and columns 2 and 3 leaves cell 0 for block 0
+    cg.Place( 9 + 4, 1 );
+    cg.Place( 18 + 7, 1 );
+    cg.Place( 4 * 9 + 1, 1 );
+    cg.Place( 7 * 9 + 2, 1 );
+    unsigned char values[Sudoku::Units::CELL_COUNT];
+    Sudoku::Bitboard hidden = cg.GetHiddenSingles( values );
+    ASSERT_TRUE( hidden.Test( 0 ) );
+    EXPECT_EQ( 1, values[0] );
+    EXPECT_TRUE( cg.GetNakedSingles().Empty() );
+}
+
+// Singles alone finish an easy puzzle
+TEST_F( CandidateGridTest, PlaceSinglesSolvesEasy )
+{
+    Sudoku::CandidateGrid cg( MakeGrid( EASY ) );
+    EXPECT_TRUE( cg.PlaceSingles() );
+    ASSERT_TRUE( cg.IsSolved() );
+    for ( size_t i = 0; i < Sudoku::Units::CELL_COUNT; i++ )
+    {
+        EXPECT_EQ( EASY_SOLUTION[i] - '0', cg.GetValue( i ) );
+    }
+    Sudoku::Grid g = MakeGrid( EASY );
+    cg.CopyTo( g );
+    EXPECT_EQ( 1, g[0].given == 0 );
+    EXPECT_EQ( 3, g[2].value );
+    EXPECT_EQ( 4, g[0].value );
+}
+
+// Conflicts are reported
+TEST_F( CandidateGridTest, Contradiction )
+{
+    Sudoku::CandidateGrid cg;
+    EXPECT_TRUE( cg.Place( 0, 5 ) );
+    EXPECT_FALSE( cg.Place( 8, 5 ) );
+    EXPECT_FALSE( cg.IsConsistent() );
+
+    Sudoku::CandidateGrid other;
+    for ( int d = 1; d <= 8; d++ )
+    {
+        EXPECT_TRUE( other.Eliminate( 40, d ) );
+    }
+    EXPECT_FALSE( other.Eliminate( 40, 1 ) );
+    EXPECT_TRUE( other.IsConsistent() );
+    other.Eliminate( 40, 9 );
+    EXPECT_FALSE( other.IsConsistent() );
+}
+
+}  // namespace
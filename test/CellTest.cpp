@@ -641,5 +641,42 @@ TEST_F( CellTest, NoObserverUpdateOnCopy )
     copy.SetGuess( 4 );
 }
 
+// Make sure a packed state gives back the same Cell
+TEST_F( CellTest, StateRoundTrip )
+{
+    Sudoku::Cell c;
+    c.SetPos( 4, 7 );
+    c.SetCorrect( 9 );
+    c.SetGuess( 3 );
+    c.Mark( 2 );
+    c.Mark( 8 );
+
+    Sudoku::Cell other;
+    other.SetPos( 4, 7 );
+    other.SetState( c.GetState() );
+    EXPECT_EQ( c, other );
+
+    c.Display( true );
+    other.SetState( c.GetState() );
+    EXPECT_EQ( c, other );
+    EXPECT_EQ( 9, other.DisplayedValue() );
+
+    EXPECT_THROW( other.SetState( 15 << 10 ), std::range_error );
+}
+
+// Setting the same state is not a change
+TEST_F( CellTest, NoObserverUpdateOnSameState )
+{
+    Sudoku::Cell c;
+    observer.reset( new Sudoku::MockCellObserver );
+    c.AddObserver( observer );
+    c.SetGuess( 5 );
+
+    EXPECT_CALL( *observer, Update( Ref( c ) ) )
+        .Times( 1 );
+
+    c.SetState( c.GetState() );
+    c.SetState( 0 );
+}
 
 }  // namespace
@@ -0,0 +1,159 @@
+#include "../ChainMethod.h"
+#include "../Cell.h"
+#include "../Puzzle.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// The fixture for testing class ChainMethod.
+class ChainMethodTest : public ::testing::Test
+{
+protected:
+
+    ChainMethodTest()
+    {
+    }
+
+    virtual ~ChainMethodTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+        // an XY-Wing: pivot 12 at (1,1), wings 13 at (4,1) and 23 at (1,3),
+        // so (5,3) cannot have 3
+        _puzzle.reset( new Sudoku::Puzzle );
+        Mark( 1, 1, 1, 2 );
+        Mark( 4, 1, 1, 3 );
+        Mark( 1, 3, 2, 3 );
+        Mark( 5, 3, 3, 4 );
+        _puzzle->GetCell( 5, 3 )->Mark( 5 );
+
+        _chain.kind = Sudoku::Chains::XY_WING;
+        _chain.digit = 3;
+        _chain.length = 0;
+        AddNode( 4, 1, 3 );
+        AddNode( 4, 1, 1 );
+        AddNode( 1, 1, 1 );
+        AddNode( 1, 1, 2 );
+        AddNode( 1, 3, 2 );
+        AddNode( 1, 3, 3 );
+        _chain.targets = Sudoku::Bitboard::Single( 22 );
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    void Mark( size_t x, size_t y, unsigned a, unsigned b )
+    {
+        _puzzle->GetCell( x, y )->Mark( a );
+        _puzzle->GetCell( x, y )->Mark( b );
+    }
+
+    void AddNode( size_t x, size_t y, int digit )
+    {
+        _chain.nodes[_chain.length].cell = ( y - 1 ) * 9 + ( x - 1 );
+        _chain.nodes[_chain.length].digit = digit;
+        ++_chain.length;
+    }
+
+    std::shared_ptr<Sudoku::Puzzle> _puzzle;
+    Sudoku::Chains::Chain _chain;
+};
+
+// Nodes have to alternate links and end on the mark
+TEST_F( ChainMethodTest, ThrowsForBadChain )
+{
+    Sudoku::Chains::Chain c = _chain;
+    c.length = 5;
+    EXPECT_THROW( Sudoku::ChainMethod( _puzzle, c ), std::logic_error );
+    c = _chain;
+    c.digit = 0;
+    EXPECT_THROW( Sudoku::ChainMethod( _puzzle, c ), std::logic_error );
+    c = _chain;
+    c.digit = 1;
+    EXPECT_THROW( Sudoku::ChainMethod( _puzzle, c ), std::logic_error );
+    c = _chain;
+    c.nodes[4].cell = 80;
+    EXPECT_THROW( Sudoku::ChainMethod( _puzzle, c ), std::logic_error );
+    Sudoku::ChainMethod cm( _puzzle, _chain );
+    EXPECT_EQ( Sudoku::Chains::XY_WING, cm.GetKind() );
+}
+
+// Operation is valid when the links hold and the target has the mark
+TEST_F( ChainMethodTest, ForwardValidWorks )
+{
+    Sudoku::ChainMethod cm( _puzzle, _chain );
+    EXPECT_TRUE( cm.VerifyForwardConditions() );
+}
+
+// Operation is invalid once a strong link is gone
+TEST_F( ChainMethodTest, ForwardInvalidIfNotBivalue )
+{
+    _puzzle->GetCell( 1, 1 )->Mark( 7 );
+    Sudoku::ChainMethod cm( _puzzle, _chain );
+    EXPECT_FALSE( cm.VerifyForwardConditions() );
+}
+
+// Operation is invalid when a node has a value
+TEST_F( ChainMethodTest, ForwardInvalidIfNodeSet )
+{
+    _puzzle->GetCell( 4, 1 )->SetGuess( 1 );
+    Sudoku::ChainMethod cm( _puzzle, _chain );
+    EXPECT_FALSE( cm.VerifyForwardConditions() );
+}
+
+// Forward operation removes the mark from the target
+TEST_F( ChainMethodTest, ForwardExecuteWorks )
+{
+    Sudoku::ChainMethod cm( _puzzle, _chain );
+    cm.ExecuteForward();
+    EXPECT_FALSE( _puzzle->GetCell( 5, 3 )->GetMarkContainer()[3] );
+    EXPECT_TRUE( _puzzle->GetCell( 5, 3 )->GetMarkContainer()[4] );
+    EXPECT_FALSE( cm.VerifyForwardConditions() );
+    EXPECT_TRUE( cm.VerifyReverseConditions() );
+}
+
+// Reverse operation is invalid while the target has the mark
+TEST_F( ChainMethodTest, ReverseInvalidIfTargetMarked )
+{
+    Sudoku::ChainMethod cm( _puzzle, _chain );
+    EXPECT_FALSE( cm.VerifyReverseConditions() );
+}
+
+// Reverse operation marks the target again
+TEST_F( ChainMethodTest, ForwardThenReverseIsOriginal )
+{
+    Sudoku::ChainMethod cm( _puzzle, _chain );
+    cm.ExecuteForward();
+    cm.ExecuteReverse();
+    EXPECT_TRUE( _puzzle->GetCell( 5, 3 )->GetMarkContainer()[3] );
+    EXPECT_TRUE( cm.VerifyForwardConditions() );
+}
+
+// A conjugate pair is only strong while the unit has two places
+TEST_F( ChainMethodTest, ConjugateNeedsTwoPlaces )
+{
+    // 1 at (1,1)=(5,1)=(5,5)=(6,6) with (1,6) seeing both ends
+    _puzzle.reset( new Sudoku::Puzzle );
+    _puzzle->GetCell( 1, 1 )->Mark( 1 );
+    _puzzle->GetCell( 5, 1 )->Mark( 1 );
+    _puzzle->GetCell( 5, 5 )->Mark( 1 );
+    _puzzle->GetCell( 6, 6 )->Mark( 1 );
+    _puzzle->GetCell( 1, 6 )->Mark( 1 );
+    _chain.kind = Sudoku::Chains::SIMPLE_COLORING;
+    _chain.digit = 1;
+    _chain.length = 0;
+    AddNode( 1, 1, 1 );
+    AddNode( 5, 1, 1 );
+    AddNode( 5, 5, 1 );
+    AddNode( 6, 6, 1 );
+    _chain.targets = Sudoku::Bitboard::Single( 45 );
+    Sudoku::ChainMethod cm( _puzzle, _chain );
+    EXPECT_TRUE( cm.VerifyForwardConditions() );
+    _puzzle->GetCell( 9, 1 )->Mark( 1 );
+    EXPECT_FALSE( cm.VerifyForwardConditions() );
+}
+
+}  // namespace
@@ -0,0 +1,163 @@
+#include "../Chains.h"
+#include "../LinkGraph.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+class ChainsTest : public ::testing::Test
+{
+protected:
+    ChainsTest()
+    {
+    }
+
+    virtual ~ChainsTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+        for ( size_t i = 0; i < Sudoku::Units::CELL_COUNT; i++ )
+        {
+            _candidates[i] = 0;
+        }
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    // mask of values, bit value - 1
+    static unsigned short Values( int a, int b = 0, int c = 0 )
+    {
+        unsigned short m = 0;
+        int v[] = { a, b, c };
+        for ( size_t i = 0; i < 3; i++ )
+        {
+            if ( v[i] )
+            {
+                m |= 1 << ( v[i] - 1 );
+            }
+        }
+        return m;
+    }
+
+    // cell index of (x,y)
+    static size_t At( size_t x, size_t y )
+    {
+        return ( y - 1 ) * 9 + ( x - 1 );
+    }
+
+    size_t Find( Sudoku::Chains::Kind kind, unsigned short digits = 0x1FF )
+    {
+        _graph.Update( _candidates );
+        _found.clear();
+        return Sudoku::Chains::Find( _graph, kind, digits, _found );
+    }
+
+    // 1 at (1,1)=(5,1)=(5,5)=(6,6) linked by conjugate pairs, and at (1,6)
+    // which sees both ends
+    void SetUpColoring()
+    {
+        _candidates[At( 1, 1 )] = Values( 1 );
+        _candidates[At( 5, 1 )] = Values( 1 );
+        _candidates[At( 5, 5 )] = Values( 1 );
+        _candidates[At( 6, 6 )] = Values( 1 );
+        _candidates[At( 1, 6 )] = Values( 1 );
+        // keep row 6 and column 1 from being conjugate pairs
+        _candidates[At( 9, 6 )] = Values( 1 );
+        _candidates[At( 1, 9 )] = Values( 1 );
+    }
+
+    unsigned short _candidates[Sudoku::Units::CELL_COUNT];
+    Sudoku::LinkGraph _graph;
+    Sudoku::Chains::ChainContainer _found;
+};
+
+// Nothing to find without candidates
+TEST_F( ChainsTest, FindsNothingDefault )
+{
+    for ( size_t k = 0; k < Sudoku::Chains::KIND_COUNT; k++ )
+    {
+        EXPECT_EQ( 0u, Find( static_cast<Sudoku::Chains::Kind>( k ) ) );
+    }
+}
+
+// A Cell seeing both colors of a cluster cannot have the digit
+TEST_F( ChainsTest, FindsColorTrap )
+{
+    SetUpColoring();
+    ASSERT_EQ( 1u, Find( Sudoku::Chains::SIMPLE_COLORING ) );
+    const Sudoku::Chains::Chain &c = _found.front();
+    EXPECT_EQ( 1, c.digit );
+    EXPECT_EQ( 4u, c.length );
+    EXPECT_EQ( Sudoku::Bitboard::Single( At( 1, 6 ) ), c.targets );
+    // only the digits asked for are looked at
+    EXPECT_EQ( 0u, Find( Sudoku::Chains::SIMPLE_COLORING, Values( 2 ) ) );
+}
+
+// An X-Chain finds the same trap from its lower end
+TEST_F( ChainsTest, FindsXChain )
+{
+    SetUpColoring();
+    ASSERT_EQ( 1u, Find( Sudoku::Chains::X_CHAIN ) );
+    const Sudoku::Chains::Chain &c = _found.front();
+    EXPECT_EQ( 4u, c.length );
+    EXPECT_EQ( At( 1, 1 ), c.nodes[0].cell );
+    EXPECT_EQ( At( 6, 6 ), c.nodes[3].cell );
+    EXPECT_EQ( Sudoku::Bitboard::Single( At( 1, 6 ) ), c.targets );
+}
+
+// Pivot 12 with wings 13 and 23 removes 3 where both wings are seen
+TEST_F( ChainsTest, FindsXYWing )
+{
+    _candidates[At( 1, 1 )] = Values( 1, 2 );
+    _candidates[At( 4, 1 )] = Values( 1, 3 );
+    _candidates[At( 1, 3 )] = Values( 2, 3 );
+    _candidates[At( 5, 3 )] = Values( 3, 4, 5 );
+    ASSERT_EQ( 1u, Find( Sudoku::Chains::XY_WING ) );
+    const Sudoku::Chains::Chain &c = _found.front();
+    EXPECT_EQ( 3, c.digit );
+    EXPECT_EQ( 6u, c.length );
+    EXPECT_EQ( Sudoku::Bitboard::Single( At( 5, 3 ) ), c.targets );
+    EXPECT_EQ( 0u, Find( Sudoku::Chains::XY_WING, 0 ) );
+}
+
+// Pivot 123 with wings 13 and 23 removes 3 where all three are seen
+TEST_F( ChainsTest, FindsXYZWing )
+{
+    _candidates[At( 1, 1 )] = Values( 1, 2, 3 );
+    _candidates[At( 5, 1 )] = Values( 1, 3 );
+    _candidates[At( 2, 2 )] = Values( 2, 3 );
+    _candidates[At( 2, 1 )] = Values( 3, 5, 6 );
+    // sees the pivot and one wing only
+    _candidates[At( 5, 2 )] = Values( 3, 5, 6 );
+    EXPECT_EQ( 0u, Find( Sudoku::Chains::XY_WING ) );
+    ASSERT_EQ( 1u, Find( Sudoku::Chains::XYZ_WING ) );
+    const Sudoku::Chains::Chain &c = _found.front();
+    EXPECT_EQ( 3, c.digit );
+    EXPECT_EQ( 3u, c.length );
+    EXPECT_EQ( Sudoku::Bitboard::Single( At( 2, 1 ) ), c.targets );
+}
+
+// Pairs of 47 three links apart remove both digits from the Cells seeing
+// the ends
+TEST_F( ChainsTest, FindsRemotePair )
+{
+    _candidates[At( 1, 1 )] = Values( 4, 7 );
+    _candidates[At( 5, 1 )] = Values( 4, 7 );
+    _candidates[At( 5, 5 )] = Values( 4, 7 );
+    _candidates[At( 9, 5 )] = Values( 4, 7 );
+    _candidates[At( 1, 5 )] = Values( 4, 5, 6 );
+    ASSERT_EQ( 1u, Find( Sudoku::Chains::REMOTE_PAIR ) );
+    const Sudoku::Chains::Chain &c = _found.front();
+    EXPECT_EQ( 4, c.digit );
+    EXPECT_EQ( 8u, c.length );
+    EXPECT_EQ( Sudoku::Bitboard::Single( At( 1, 5 ) ), c.targets );
+
+    // two links apart the ends are the same
+    _candidates[At( 9, 5 )] = 0;
+    EXPECT_EQ( 0u, Find( Sudoku::Chains::REMOTE_PAIR ) );
+}
+
+}  // namespace
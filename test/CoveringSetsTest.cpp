@@ -0,0 +1,201 @@
+#include "../CoveringSets.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+class CoveringSetsTest : public ::testing::Test
+{
+protected:
+    CoveringSetsTest()
+    {
+    }
+
+    virtual ~CoveringSetsTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+        for ( size_t k = 0; k < 9; k++ )
+        {
+            _candidates[k] = 0;
+        }
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    // mask of values, bit value - 1
+    static unsigned short Values( int a, int b = 0, int c = 0, int d = 0 )
+    {
+        unsigned short m = 0;
+        int v[] = { a, b, c, d };
+        for ( size_t i = 0; i < 4; i++ )
+        {
+            if ( v[i] )
+            {
+                m |= 1 << ( v[i] - 1 );
+            }
+        }
+        return m;
+    }
+
+    unsigned short _candidates[9];
+    Sudoku::CoveringSets::SetContainer _found;
+};
+
+// Each table has every 9-bit mask of its size exactly once, in order
+TEST_F( CoveringSetsTest, CombinationTablesMatchBitCounts )
+{
+    for ( size_t size = 2; size <= 4; size++ )
+    {
+        const unsigned short *table = Sudoku::CoveringSets::Combinations( size );
+        size_t n = 0;
+        for ( unsigned m = 0; m < 512; m++ )
+        {
+            if ( static_cast<size_t>( __builtin_popcount( m ) ) == size )
+            {
+                ASSERT_LT( n, Sudoku::CoveringSets::CHOOSE[9][size] );
+                EXPECT_EQ( m, table[n] );
+                ++n;
+            }
+        }
+        EXPECT_EQ( Sudoku::CoveringSets::CHOOSE[9][size], n );
+    }
+}
+
+// The first CHOOSE[n][k] masks only use the low n bits
+TEST_F( CoveringSetsTest, ChooseIsPrefixOfTable )
+{
+    for ( size_t size = 2; size <= 4; size++ )
+    {
+        const unsigned short *table = Sudoku::CoveringSets::Combinations( size );
+        for ( size_t n = 0; n <= 9; n++ )
+        {
+            size_t count = Sudoku::CoveringSets::CHOOSE[n][size];
+            for ( size_t i = 0; i < count; i++ )
+            {
+                EXPECT_EQ( 0, table[i] >> n );
+            }
+            if ( count < Sudoku::CoveringSets::CHOOSE[9][size] )
+            {
+                EXPECT_NE( 0, table[count] >> n );
+            }
+        }
+    }
+}
+
+TEST_F( CoveringSetsTest, SizeOutOfRangeThrows )
+{
+    EXPECT_THROW( Sudoku::CoveringSets::Find( _candidates, 1, _found ),
+                  std::invalid_argument );
+    EXPECT_THROW( Sudoku::CoveringSets::Find( _candidates, 5, _found ),
+                  std::invalid_argument );
+}
+
+TEST_F( CoveringSetsTest, EmptyUnitHasNothing )
+{
+    for ( size_t size = 2; size <= 4; size++ )
+    {
+        EXPECT_EQ( 0u, Sudoku::CoveringSets::Find( _candidates, size, _found ) );
+    }
+    EXPECT_TRUE( _found.empty() );
+}
+
+// the other two Cells hold the other two values, a hidden pair
+TEST_F( CoveringSetsTest, FindsNakedPairThenHiddenPair )
+{
+    _candidates[1] = Values( 4, 6 );
+    _candidates[5] = Values( 4, 6 );
+    _candidates[7] = Values( 4, 6, 8 );
+    _candidates[8] = Values( 8, 9 );
+
+    EXPECT_EQ( 2u, Sudoku::CoveringSets::Find( _candidates, 2, _found ) );
+    ASSERT_EQ( 2u, _found.size() );
+    EXPECT_FALSE( _found[0].hidden );
+    EXPECT_EQ( ( 1 << 1 ) | ( 1 << 5 ), _found[0].cells );
+    EXPECT_EQ( Values( 4, 6 ), _found[0].values );
+    EXPECT_TRUE( _found[1].hidden );
+    EXPECT_EQ( ( 1 << 7 ) | ( 1 << 8 ), _found[1].cells );
+    EXPECT_EQ( Values( 8, 9 ), _found[1].values );
+}
+
+TEST_F( CoveringSetsTest, IgnoresNakedPairWithNothingToRemove )
+{
+    _candidates[1] = Values( 4, 6 );
+    _candidates[5] = Values( 4, 6 );
+    _candidates[7] = Values( 8, 9 );
+
+    EXPECT_EQ( 0u, Sudoku::CoveringSets::Find( _candidates, 2, _found ) );
+}
+
+TEST_F( CoveringSetsTest, FindsHiddenTriple )
+{
+    // 1, 2 and 3 only appear in positions 0, 4 and 8
+    _candidates[0] = Values( 1, 2, 5 );
+    _candidates[4] = Values( 2, 3, 6 );
+    _candidates[8] = Values( 1, 3, 5 );
+    _candidates[2] = Values( 5, 6 );
+    _candidates[3] = Values( 5, 6 );
+
+    EXPECT_EQ( 1u, Sudoku::CoveringSets::Find( _candidates, 3, _found ) );
+    ASSERT_EQ( 1u, _found.size() );
+    EXPECT_TRUE( _found[0].hidden );
+    EXPECT_EQ( ( 1 << 0 ) | ( 1 << 4 ) | ( 1 << 8 ), _found[0].cells );
+    EXPECT_EQ( Values( 1, 2, 3 ), _found[0].values );
+}
+
+TEST_F( CoveringSetsTest, FindsNakedQuad )
+{
+    _candidates[0] = Values( 1, 2 );
+    _candidates[2] = Values( 2, 3 );
+    _candidates[3] = Values( 3, 4 );
+    _candidates[6] = Values( 1, 4 );
+    _candidates[7] = Values( 1, 5 );
+
+    EXPECT_EQ( 1u, Sudoku::CoveringSets::Find( _candidates, 4, _found ) );
+    ASSERT_EQ( 1u, _found.size() );
+    EXPECT_FALSE( _found[0].hidden );
+    EXPECT_EQ( 0x4D, _found[0].cells );
+    EXPECT_EQ( Values( 1, 2, 3, 4 ), _found[0].values );
+}
+
+// Rows of a digit with its columns, an X-Wing is a naked pair of rows
+TEST_F( CoveringSetsTest, FindsFishAsNakedRows )
+{
+    _candidates[0] = Values( 1, 5 );
+    _candidates[1] = Values( 1, 8 );
+    _candidates[5] = Values( 1, 8 );
+    _candidates[8] = Values( 5, 8 );
+
+    Sudoku::CoveringSets::FishContainer fish;
+    EXPECT_EQ( 1u, Sudoku::CoveringSets::FindFish( _candidates, 2, fish ) );
+    ASSERT_EQ( 1u, fish.size() );
+    EXPECT_EQ( Sudoku::Units::UNIT_BOARDS[Sudoku::Units::Row( 2 )] |
+               Sudoku::Units::UNIT_BOARDS[Sudoku::Units::Row( 6 )],
+               fish[0].base );
+    EXPECT_EQ( Sudoku::Units::UNIT_BOARDS[Sudoku::Units::Col( 1 )] |
+               Sudoku::Units::UNIT_BOARDS[Sudoku::Units::Col( 8 )],
+               fish[0].cover );
+}
+
+// Columns found in only as many rows are a fish on the columns
+TEST_F( CoveringSetsTest, FindsFishAsHiddenColumns )
+{
+    _candidates[2] = Values( 4, 6, 9 );
+    _candidates[7] = Values( 4, 6 );
+    _candidates[4] = Values( 9 );
+
+    Sudoku::CoveringSets::FishContainer fish;
+    EXPECT_EQ( 1u, Sudoku::CoveringSets::FindFish( _candidates, 2, fish ) );
+    ASSERT_EQ( 1u, fish.size() );
+    EXPECT_EQ( Sudoku::Units::UNIT_BOARDS[Sudoku::Units::Col( 4 )] |
+               Sudoku::Units::UNIT_BOARDS[Sudoku::Units::Col( 6 )],
+               fish[0].base );
+    EXPECT_EQ( Sudoku::Units::UNIT_BOARDS[Sudoku::Units::Row( 3 )] |
+               Sudoku::Units::UNIT_BOARDS[Sudoku::Units::Row( 8 )],
+               fish[0].cover );
+}
+
+}  // namespace
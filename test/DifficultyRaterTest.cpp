@@ -0,0 +1,210 @@
+#include "../DifficultyRater.h"
+#include "../Grid.h"
+#include "../MethodSolver.h"
+#include "../Puzzle.h"
+#include "../PuzzleGenerator.h"
+#include "../PuzzleMarker.h"
+#include "../SimpleValidator.h"
+#include "../SolutionMethodFactory.h"
+#include "../SolverHelper.h"
+#include "TestGrids.h"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+using Sudoku::TestGrids::HARD;
+using Sudoku::TestGrids::MakeGrid;
+
+class DifficultyRaterTest : public ::testing::Test
+{
+protected:
+    DifficultyRaterTest()
+    {
+    }
+
+    virtual ~DifficultyRaterTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    /**
+     * Check if a MethodSolver limited to a difficulty solves a Grid
+     */
+    bool MethodSolverSolves( const Sudoku::Grid &g, Sudoku::Difficulty d )
+    {
+        std::shared_ptr<Sudoku::Puzzle> p( new Sudoku::Puzzle );
+        g.CopyTo( *p );
+        std::shared_ptr<Sudoku::SolutionMethodFactory> factory(
+            new Sudoku::SolutionMethodFactory );
+        Sudoku::MethodSolver solver(
+            std::shared_ptr<Sudoku::SolverHelper>(
+                new Sudoku::SolverHelper( factory ) ),
+            std::shared_ptr<Sudoku::IPuzzleMarker>( new Sudoku::PuzzleMarker ),
+            Sudoku::SimpleValidator::CreateGuessValidator() );
+        solver.SetMaxDifficulty( d );
+        try
+        {
+            solver.Solve( p );
+        }
+        catch ( std::runtime_error & )
+        {
+            return false;
+        }
+        return true;
+    }
+
+    Sudoku::DifficultyRater _rater;
+};
+
+// A Puzzle the Methods cannot finish is expert
+TEST_F( DifficultyRaterTest, StuckIsExpert )
+{
+    Sudoku::DifficultyRater::Rating r = _rater.Rate( MakeGrid( HARD ) );
+    EXPECT_FALSE( r.solved );
+    EXPECT_GT( r.unsolved, 0u );
+    EXPECT_EQ( Sudoku::DIFFICULTY_EXPERT, r.tier );
+    EXPECT_GE( r.score, Sudoku::DifficultyRater::STUCK_SCORE );
+}
+
+// Givens which conflict cannot be solved
+TEST_F( DifficultyRaterTest, ConflictIsExpert )
+{
+    std::string s( HARD );
+    s[1] = '8';
+    Sudoku::DifficultyRater::Rating r = _rater.Rate( MakeGrid( s ) );
+    EXPECT_FALSE( r.solved );
+    EXPECT_EQ( Sudoku::DIFFICULTY_EXPERT, r.tier );
+}
+
+// Single candidates and hidden singles alone are easy, every blank Cell is
+// one of them
+TEST_F( DifficultyRaterTest, EasyPuzzle )
+{
+    Sudoku::PuzzleGenerator generator( 3, Sudoku::DIFFICULTY_EASY );
+    Sudoku::Grid g;
+    generator.Generate( g, NULL );
+    size_t blank = 0;
+    for ( size_t i = 0; i < Sudoku::Grid::ARRAY_SIZE; i++ )
+    {
+        blank += ( g[i].value == 0 );
+    }
+
+    Sudoku::DifficultyRater::Rating r = _rater.Rate( g );
+    EXPECT_TRUE( r.solved );
+    EXPECT_EQ( Sudoku::DIFFICULTY_EASY, r.tier );
+    EXPECT_EQ( blank, r.singleCandidates + r.hiddenSingles );
+    EXPECT_LE( r.exclusions, blank );
+    EXPECT_EQ( 0u, r.blockIntersections );
+    EXPECT_EQ( 0u, r.largestCoveringSet );
+    EXPECT_EQ( r.singleCandidates *
+               Sudoku::DifficultyRater::SINGLE_CANDIDATE_SCORE +
+               r.hiddenSingles * Sudoku::DifficultyRater::HIDDEN_SINGLE_SCORE,
+               r.score );
+}
+
+// The tier is exactly the MethodSolver limit needed to solve the Puzzle
+TEST_F( DifficultyRaterTest, TierMatchesMethodSolver )
+{
+    Sudoku::PuzzleGenerator generator( 21, Sudoku::DIFFICULTY_HARD );
+    for ( size_t n = 0; n < 5; n++ )
+    {
+        Sudoku::Grid g;
+        generator.Generate( g, NULL );
+        Sudoku::DifficultyRater::Rating r = _rater.Rate( g );
+        EXPECT_TRUE( r.solved );
+        EXPECT_LE( r.tier, Sudoku::DIFFICULTY_HARD );
+        EXPECT_TRUE( MethodSolverSolves( g, r.tier ) );
+        if ( r.tier > Sudoku::DIFFICULTY_EASY )
+        {
+            EXPECT_FALSE( MethodSolverSolves(
+                g, static_cast<Sudoku::Difficulty>( r.tier - 1 ) ) );
+        }
+    }
+}
+
+// Puzzle and Grid give the same rating, only givens count
+TEST_F( DifficultyRaterTest, RatesPuzzleGivens )
+{
+    Sudoku::PuzzleGenerator generator( 8, Sudoku::DIFFICULTY_HARD );
+    Sudoku::Grid g;
+    generator.Generate( g, NULL );
+    std::shared_ptr<Sudoku::Puzzle> p( new Sudoku::Puzzle );
+    g.CopyTo( *p );
+    // a guess does not change anything
+    for ( size_t x = 1; x <= 9; x++ )
+    {
+        std::shared_ptr<Sudoku::Cell> c = p->GetCell( x, 1 );
+        if ( c->CanGuess() )
+        {
+            c->SetGuess( 1 );
+            break;
+        }
+    }
+
+    Sudoku::DifficultyRater::Rating a = _rater.Rate( g );
+    Sudoku::DifficultyRater::Rating b = _rater.Rate( p );
+    EXPECT_EQ( a.score, b.score );
+    EXPECT_EQ( a.tier, b.tier );
+    EXPECT_EQ( a.singleCandidates, b.singleCandidates );
+    EXPECT_EQ( a.blockIntersections, b.blockIntersections );
+
+    EXPECT_THROW( _rater.Rate( std::shared_ptr<const Sudoku::Puzzle>() ),
+                  std::runtime_error );
+}
+
+// Harder steps score more
+TEST_F( DifficultyRaterTest, ScoreWeighsSteps )
+{
+    Sudoku::DifficultyRater::Rating r;
+    r.solved = true;
+    r.singleCandidates = 10;
+    Sudoku::DifficultyRater::Score( r );
+    EXPECT_EQ( 10u, r.score );
+    EXPECT_EQ( Sudoku::DIFFICULTY_EASY, r.tier );
+
+    r.singleCandidates = 8;
+    r.hiddenSingles = 1;
+    Sudoku::DifficultyRater::Score( r );
+    EXPECT_EQ( 10u, r.score );
+    EXPECT_EQ( Sudoku::DIFFICULTY_EASY, r.tier );
+
+    r.blockIntersections = 1;
+    Sudoku::DifficultyRater::Score( r );
+    EXPECT_EQ( 15u, r.score );
+    EXPECT_EQ( Sudoku::DIFFICULTY_MEDIUM, r.tier );
+
+    r.coveringSets[3] = 1;
+    r.largestCoveringSet = 3;
+    Sudoku::DifficultyRater::Score( r );
+    EXPECT_EQ( 45u, r.score );
+    EXPECT_EQ( Sudoku::DIFFICULTY_HARD, r.tier );
+
+    r.fish[2] = 1;
+    r.largestFish = 2;
+    Sudoku::DifficultyRater::Score( r );
+    EXPECT_EQ( 75u, r.score );
+    EXPECT_EQ( Sudoku::DIFFICULTY_HARD, r.tier );
+
+    r.chains[Sudoku::Chains::XY_WING] = 1;
+    Sudoku::DifficultyRater::Score( r );
+    EXPECT_EQ( 100u, r.score );
+    EXPECT_EQ( Sudoku::DIFFICULTY_EXPERT, r.tier );
+
+    r.solved = false;
+    r.unsolved = 2;
+    Sudoku::DifficultyRater::Score( r );
+    EXPECT_EQ( 210u, r.score );
+    EXPECT_EQ( Sudoku::DIFFICULTY_EXPERT, r.tier );
+}
+
+}  // namespace
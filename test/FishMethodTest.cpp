@@ -0,0 +1,128 @@
+#include "../FishMethod.h"
+#include "../Cell.h"
+#include "../Puzzle.h"
+#include "../Units.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// The fixture for testing class FishMethod.
+class FishMethodTest : public ::testing::Test
+{
+protected:
+
+    FishMethodTest()
+    {
+    }
+
+    virtual ~FishMethodTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+        // an X-Wing on 3: rows 2 and 6 only have it in columns 1 and 8,
+        // which have it all the way down
+        _puzzle.reset( new Sudoku::Puzzle );
+        for ( size_t y = 1; y <= 9; y++ )
+        {
+            _puzzle->GetCell( 1, y )->Mark( 3 );
+            _puzzle->GetCell( 8, y )->Mark( 3 );
+        }
+        _rows = Sudoku::Units::UNIT_BOARDS[Sudoku::Units::Row( 2 )] |
+            Sudoku::Units::UNIT_BOARDS[Sudoku::Units::Row( 6 )];
+        _cols = Sudoku::Units::UNIT_BOARDS[Sudoku::Units::Col( 1 )] |
+            Sudoku::Units::UNIT_BOARDS[Sudoku::Units::Col( 8 )];
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    size_t CountMarked( unsigned mark )
+    {
+        size_t count = 0;
+        for ( size_t i = 0; i < Sudoku::Units::CELL_COUNT; i++ )
+        {
+            count += _puzzle->GetCell( i % 9 + 1, i / 9 + 1 )
+                ->GetMarkContainer()[mark];
+        }
+        return count;
+    }
+
+    std::shared_ptr<Sudoku::Puzzle> _puzzle;
+    Sudoku::Bitboard _rows;
+    Sudoku::Bitboard _cols;
+};
+
+// Lines have to be 2 to 4 rows crossing as many columns
+TEST_F( FishMethodTest, ThrowsForBadLines )
+{
+    Sudoku::Bitboard row = Sudoku::Units::UNIT_BOARDS[Sudoku::Units::Row( 1 )];
+    EXPECT_THROW( Sudoku::FishMethod( _puzzle, 3, row, row ),
+                  std::logic_error );
+    EXPECT_THROW( Sudoku::FishMethod( _puzzle, 3, _rows, _rows ),
+                  std::logic_error );
+    EXPECT_THROW( Sudoku::FishMethod( _puzzle, 3, _rows, _cols | row ),
+                  std::logic_error );
+    EXPECT_THROW( Sudoku::FishMethod( _puzzle, 0, _rows, _cols ),
+                  std::logic_error );
+    Sudoku::FishMethod fm( _puzzle, 3, _rows, _cols );
+    EXPECT_EQ( 2u, fm.GetSize() );
+}
+
+// Operation is valid when the base lines are covered
+TEST_F( FishMethodTest, ForwardValidWorks )
+{
+    Sudoku::FishMethod fm( _puzzle, 3, _rows, _cols );
+    EXPECT_TRUE( fm.VerifyForwardConditions() );
+    // the same lines the other way round remove nothing
+    Sudoku::FishMethod swapped( _puzzle, 3, _cols, _rows );
+    EXPECT_FALSE( swapped.VerifyForwardConditions() );
+}
+
+// Operation is invalid when a base line has the mark outside the cover
+TEST_F( FishMethodTest, ForwardInvalidIfBaseUncovered )
+{
+    _puzzle->GetCell( 5, 6 )->Mark( 3 );
+    Sudoku::FishMethod fm( _puzzle, 3, _rows, _cols );
+    EXPECT_FALSE( fm.VerifyForwardConditions() );
+}
+
+// Operation is invalid when a base line has the value
+TEST_F( FishMethodTest, ForwardInvalidIfValueInBase )
+{
+    _puzzle->GetCell( 1, 2 )->SetGuess( 3 );
+    Sudoku::FishMethod fm( _puzzle, 3, _rows, _cols );
+    EXPECT_FALSE( fm.VerifyForwardConditions() );
+}
+
+// Forward operation leaves the mark only where the lines cross
+TEST_F( FishMethodTest, ForwardExecuteWorks )
+{
+    Sudoku::FishMethod fm( _puzzle, 3, _rows, _cols );
+    fm.ExecuteForward();
+    EXPECT_EQ( 4u, CountMarked( 3 ) );
+    EXPECT_TRUE( _puzzle->GetCell( 8, 6 )->GetMarkContainer()[3] );
+    EXPECT_FALSE( fm.VerifyForwardConditions() );
+    EXPECT_TRUE( fm.VerifyReverseConditions() );
+}
+
+// Reverse operation is invalid while the cover lines still have the mark
+TEST_F( FishMethodTest, ReverseInvalidIfCoverMarked )
+{
+    Sudoku::FishMethod fm( _puzzle, 3, _rows, _cols );
+    EXPECT_FALSE( fm.VerifyReverseConditions() );
+}
+
+// Reverse operation marks the cover lines again
+TEST_F( FishMethodTest, ForwardThenReverseIsOriginal )
+{
+    Sudoku::FishMethod fm( _puzzle, 3, _rows, _cols );
+    fm.ExecuteForward();
+    fm.ExecuteReverse();
+    EXPECT_EQ( 18u, CountMarked( 3 ) );
+    EXPECT_TRUE( fm.VerifyForwardConditions() );
+}
+
+}  // namespace
@@ -0,0 +1,173 @@
+#include "../Cell.h"
+#include "../GameFile.h"
+#include "../GameManager.h"
+#include "../GuessCommand.h"
+#include "../MarkCommand.h"
+#include "../Puzzle.h"
+#include "../UndoHistory.h"
+#include "TestGrids.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+class GameFileTest : public ::testing::Test
+{
+protected:
+    GameFileTest() : filename( "game_file_test.sav" )
+    {
+    }
+
+    virtual ~GameFileTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+        std::remove( filename );
+    }
+
+    const char *filename;
+};
+
+// Make sure every Cell and the whole history come back
+TEST_F( GameFileTest, RoundTrip )
+{
+    Sudoku::Puzzle p;
+    p.GetCell( 1, 1 )->SetCorrect( 5 );
+    p.GetCell( 1, 1 )->Display( true );
+    p.GetCell( 2, 1 )->SetCorrect( 3 );
+    p.GetCell( 2, 1 )->SetGuess( 7 );
+    p.GetCell( 9, 9 )->Mark( 1 );
+    p.GetCell( 9, 9 )->Mark( 9 );
+
+    Sudoku::UndoHistory history;
+    Sudoku::UndoHistory::DeltaContainer step;
+    step.push_back( Sudoku::UndoHistory::MakeDelta( 1, 0, 7 << 14 ) );
+    history.Record( step );
+    history.Record( Sudoku::UndoHistory::DeltaContainer() );
+    step.push_back( Sudoku::UndoHistory::MakeDelta( 80, 0, 1 << 9 ) );
+    history.Record( step );
+    Sudoku::UndoHistory::DeltaContainer out;
+    history.Undo( out );
+
+    Sudoku::GameFile::Save( filename, p, history );
+
+    Sudoku::UndoHistory loadedHistory;
+    std::shared_ptr<Sudoku::Puzzle> loaded =
+        Sudoku::GameFile::Load( filename, loadedHistory );
+    ASSERT_TRUE( loaded );
+    for ( size_t y = 1; y <= 9; y++ )
+    {
+        for ( size_t x = 1; x <= 9; x++ )
+        {
+            EXPECT_EQ( *p.GetCell( x, y ), *loaded->GetCell( x, y ) );
+        }
+    }
+
+    Sudoku::UndoHistory::DeltaContainer deltas, loadedDeltas;
+    std::vector<uint32_t> counts, loadedCounts;
+    size_t undoable = 0, loadedUndoable = 0;
+    history.Export( deltas, counts, undoable );
+    loadedHistory.Export( loadedDeltas, loadedCounts, loadedUndoable );
+    EXPECT_EQ( deltas, loadedDeltas );
+    EXPECT_EQ( counts, loadedCounts );
+    EXPECT_EQ( 2u, loadedUndoable );
+    EXPECT_TRUE( loadedHistory.CanRedo() );
+}
+
+// Make sure files which are not saves are refused and change nothing
+TEST_F( GameFileTest, RejectsBadFiles )
+{
+    Sudoku::UndoHistory history;
+    history.Record( Sudoku::UndoHistory::DeltaContainer() );
+
+    EXPECT_THROW( Sudoku::GameFile::Load( "no_such_file.sav", history ),
+                  std::runtime_error );
+    {
+        std::ofstream out( filename );
+        out << "53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28"
+            << "....419..5....8..79\n";
+    }
+    EXPECT_THROW( Sudoku::GameFile::Load( filename, history ),
+                  std::runtime_error );
+
+    // cut a good save short
+    Sudoku::Puzzle p;
+    Sudoku::GameFile::Save( filename, p, history );
+    std::vector<char> bytes;
+    {
+        std::ifstream in( filename, std::ios::binary );
+        bytes.assign( std::istreambuf_iterator<char>( in ),
+                      std::istreambuf_iterator<char>() );
+    }
+    {
+        std::ofstream out( filename, std::ios::binary | std::ios::trunc );
+        out.write( &bytes[0], bytes.size() - 4 );
+    }
+    EXPECT_THROW( Sudoku::GameFile::Load( filename, history ),
+                  std::runtime_error );
+    EXPECT_EQ( 1u, history.CountUndo() );
+}
+
+// Make sure a resumed game can undo what was done before it was saved
+TEST_F( GameFileTest, GameManagerResumes )
+{
+    std::shared_ptr<Sudoku::GameManager> gm = Sudoku::GameManager::Create();
+    EXPECT_FALSE( gm->SaveGame( filename ) );
+    gm->NewPuzzle();
+    std::shared_ptr<const Sudoku::Cell> c = gm->GetPuzzle()->GetCell( 4, 5 );
+    gm->Execute( Sudoku::GuessCommand::CreateGuessCommand( c, 6 ) );
+    gm->Execute( Sudoku::MarkCommand::CreateMarkCommand( c, 2 ) );
+    ASSERT_TRUE( gm->SaveGame( filename ) );
+
+    std::shared_ptr<Sudoku::GameManager> resumed =
+        Sudoku::GameManager::Create();
+    ASSERT_TRUE( resumed->LoadGame( filename ) );
+    c = resumed->GetPuzzle()->GetCell( 4, 5 );
+    EXPECT_EQ( 6, c->DisplayedValue() );
+    EXPECT_TRUE( c->GetMarkContainer()[2] );
+
+    ASSERT_TRUE( resumed->Undo() );
+    EXPECT_FALSE( c->GetMarkContainer()[2] );
+    ASSERT_TRUE( resumed->Undo() );
+    EXPECT_EQ( 0, c->DisplayedValue() );
+    EXPECT_FALSE( resumed->CanUndo() );
+    ASSERT_TRUE( resumed->Redo() );
+    EXPECT_EQ( 6, c->DisplayedValue() );
+
+    EXPECT_FALSE( resumed->LoadGame( "no_such_file.sav" ) );
+    EXPECT_EQ( 6, resumed->GetPuzzle()->GetCell( 4, 5 )->DisplayedValue() );
+}
+
+// Loading checks the loaded Puzzle like an import does
+TEST_F( GameFileTest, LoadRechecksPuzzle )
+{
+    std::shared_ptr<Sudoku::GameManager> gm = Sudoku::GameManager::Create();
+    gm->NewPuzzle();
+    ASSERT_TRUE( gm->SaveGame( filename ) );
+
+    const char *imported = "game_file_test.txt";
+    {
+        std::ofstream out( imported );
+        out << Sudoku::TestGrids::EASY << "\n";
+    }
+    ASSERT_TRUE( gm->ImportFromFile( imported ) );
+    std::remove( imported );
+    EXPECT_EQ( 1u, gm->GetImportedSolutionCount() );
+    EXPECT_TRUE( gm->GetImportedRating().solved );
+
+    ASSERT_TRUE( gm->LoadGame( filename ) );
+    EXPECT_EQ( 2u, gm->GetImportedSolutionCount() );
+    EXPECT_FALSE( gm->GetImportedRating().solved );
+}
+
+}  // namespace
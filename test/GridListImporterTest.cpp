@@ -0,0 +1,96 @@
+#include "../GridListImporter.h"
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+class GridListImporterTest : public ::testing::Test
+{
+protected:
+    GridListImporterTest()
+    {
+    }
+
+    virtual ~GridListImporterTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    std::vector<Sudoku::Grid> Import( const std::string &s )
+    {
+        std::istringstream in( s );
+        return _importer.Import( in );
+    }
+
+    Sudoku::GridListImporter _importer;
+};
+
+const char *LINE1 =
+    "003020600900305001001806400008102900700000008"
+    "006708200002609500800203009005010300";
+const char *LINE2 =
+    "4.....8.5.3..........7......2.....6.....8.4......1......."
+    "6.3.7.5..2.....1.4......";
+
+// One Puzzle per line, with dots or zeros for blanks
+TEST_F( GridListImporterTest, ReadsLines )
+{
+    std::vector<Sudoku::Grid> grids =
+        Import( std::string( LINE1 ) + "\n" + LINE2 + "  comment\n" );
+    ASSERT_EQ( 2u, grids.size() );
+    EXPECT_EQ( 0, grids[0][0].value );
+    EXPECT_EQ( 3, grids[0][2].value );
+    EXPECT_EQ( 1, grids[0][2].given );
+    EXPECT_EQ( 0, grids[0][0].given );
+    EXPECT_EQ( 4, grids[1][0].value );
+    EXPECT_EQ( 0, grids[1][1].value );
+    EXPECT_EQ( 0, grids[1][80].value );
+    EXPECT_EQ( 0, grids[1][0].marks );
+}
+
+// The 9 by 9 layout of SimplePuzzleImporter, with labels in between
+TEST_F( GridListImporterTest, ReadsBlocks )
+{
+    std::vector<Sudoku::Grid> grids = Import(
+        "# first\n"
+        "1 4 0  0 0 0  0 0 8\n0 0 5  4 8 0  3 0 0\n0 0 9  2 0 0  1 4 0\n\n"
+        "0 2 8  0 0 0  0 0 1\n5 1 0  0 0 0  0 9 2\n3 0 0  0 0 0  5 7 0\n\n"
+        "0 5 7  0 0 2  4 0 0\n0 0 1  0 9 6  7 0 0\n6 0 0  0 0 0  0 8 5\n"
+        "\nmedium\n" + std::string( LINE1 ) + "\n" );
+    ASSERT_EQ( 2u, grids.size() );
+    EXPECT_EQ( 1, grids[0][0].value );
+    EXPECT_EQ( 4, grids[0][1].value );
+    EXPECT_EQ( 5, grids[0][80].value );
+    EXPECT_EQ( 3, grids[1][2].value );
+}
+
+// Bad characters and truncated Puzzles throw
+TEST_F( GridListImporterTest, RejectsBadInput )
+{
+    EXPECT_THROW( Import( "12x" + std::string( LINE1 ) ), std::domain_error );
+    EXPECT_THROW( Import( "123456789\n" ), std::runtime_error );
+    EXPECT_THROW( Import( std::string( LINE1 ).substr( 0, 80 ) + "\n" +
+                          LINE1 + "\n" ),
+                  std::domain_error );
+    EXPECT_TRUE( Import( "" ).empty() );
+}
+
+// Export writes one line which imports to the same Grid
+TEST_F( GridListImporterTest, ExportRoundTrip )
+{
+    std::vector<Sudoku::Grid> grids = Import( LINE1 );
+    std::ostringstream out;
+    Sudoku::GridListImporter::Export( out, grids[0] );
+    EXPECT_EQ( std::string( LINE1 ) + "\n", out.str() );
+}
+
+}  // namespace
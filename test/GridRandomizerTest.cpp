@@ -0,0 +1,119 @@
+#include "../GridRandomizer.h"
+#include "../Grid.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace {
+
+class GridRandomizerTest : public ::testing::Test
+{
+protected:
+    GridRandomizerTest()
+    {
+    }
+
+    virtual ~GridRandomizerTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    /**
+     * Every unit holds each value once
+     */
+    bool IsSolved( const Sudoku::Grid &g )
+    {
+        for ( size_t u = 0; u < Sudoku::Units::UNIT_COUNT; u++ )
+        {
+            unsigned short seen = 0;
+            Sudoku::Grid::ConstSector s = g.GetUnit( u );
+            for ( size_t k = 0; k < s.size(); k++ )
+            {
+                if ( s[k].value < 1 || s[k].value > 9 )
+                {
+                    return false;
+                }
+                seen |= 1 << ( s[k].value - 1 );
+            }
+            if ( seen != Sudoku::Grid::ALL_MARKS )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Every grid is a valid solution made of givens
+TEST_F( GridRandomizerTest, FillsSolvedGrids )
+{
+    Sudoku::GridRandomizer r( 1 );
+    for ( size_t n = 0; n < 50; n++ )
+    {
+        Sudoku::Grid g;
+        g[3].marks = 0x1F;
+        r.Fill( g );
+        EXPECT_TRUE( IsSolved( g ) );
+        EXPECT_EQ( 1, g[0].given );
+        EXPECT_EQ( 0, g[3].marks );
+    }
+}
+
+// Same seed, same grids; different seed, different grids
+TEST_F( GridRandomizerTest, SeedIsReproducible )
+{
+    Sudoku::GridRandomizer a( 42 );
+    Sudoku::GridRandomizer b( 42 );
+    Sudoku::GridRandomizer c( 43 );
+    Sudoku::Grid ga, gb, gc;
+    a.Fill( ga );
+    b.Fill( gb );
+    c.Fill( gc );
+    EXPECT_TRUE( ga == gb );
+    EXPECT_FALSE( ga == gc );
+    a.Fill( ga );
+    EXPECT_FALSE( ga == gb );
+}
+
+// Bulk filling is the same sequence as one at a time
+TEST_F( GridRandomizerTest, BulkFillMatchesSingle )
+{
+    std::vector<Sudoku::Grid> buffer( 20 );
+    Sudoku::GridRandomizer bulk( 7 );
+    bulk.Fill( &buffer[0], buffer.size() );
+    Sudoku::GridRandomizer single( 7 );
+    for ( size_t n = 0; n < buffer.size(); n++ )
+    {
+        Sudoku::Grid g;
+        single.Fill( g );
+        EXPECT_TRUE( g == buffer[n] );
+    }
+    EXPECT_FALSE( buffer[0] == buffer[1] );
+}
+
+// Draws stay in range and hit every value
+TEST_F( GridRandomizerTest, BelowIsInRange )
+{
+    Sudoku::GridRandomizer r( 3 );
+    std::vector<int> hits( 9, 0 );
+    for ( size_t n = 0; n < 900; n++ )
+    {
+        uint32_t v = r.Below( 9 );
+        ASSERT_LT( v, 9u );
+        hits[v]++;
+    }
+    for ( size_t v = 0; v < 9; v++ )
+    {
+        EXPECT_GT( hits[v], 0 );
+    }
+    EXPECT_EQ( 0u, r.Below( 1 ) );
+}
+
+}  // namespace
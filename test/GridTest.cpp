@@ -0,0 +1,181 @@
+#include "../Grid.h"
+#include "../Puzzle.h"
+#include "../PuzzleMarker.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+class GridTest : public ::testing::Test
+{
+protected:
+    GridTest()
+    {
+        _puzzle.reset( new Sudoku::Puzzle );
+    }
+
+    virtual ~GridTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    /**
+     * A few givens and a guess
+     */
+    void MakePartial()
+    {
+        _puzzle->GetCell( 1, 1 )->SetCorrect( 5 );
+        _puzzle->GetCell( 1, 1 )->Display( true );
+        _puzzle->GetCell( 9, 1 )->SetCorrect( 3 );
+        _puzzle->GetCell( 9, 1 )->Display( true );
+        _puzzle->GetCell( 5, 5 )->SetCorrect( 7 );
+        _puzzle->GetCell( 5, 5 )->Display( true );
+        _puzzle->GetCell( 2, 8 )->SetGuess( 4 );
+    }
+
+    std::shared_ptr<Sudoku::Puzzle> _puzzle;
+};
+
+// Blank grid has nothing set
+TEST_F( GridTest, BlankGridIsEmpty )
+{
+    Sudoku::Grid g;
+    for ( size_t i = 0; i < Sudoku::Grid::ARRAY_SIZE; i++ )
+    {
+        EXPECT_EQ( 0, g[i].value );
+        EXPECT_EQ( 0, g[i].given );
+        EXPECT_EQ( 0, g[i].marks );
+    }
+}
+
+// Records are small enough to keep the whole board in a few cache lines
+TEST_F( GridTest, StorageIsCompact )
+{
+    EXPECT_EQ( 4u, sizeof( Sudoku::GridCell ) );
+    EXPECT_EQ( 81u * 4u, sizeof( Sudoku::Grid ) );
+}
+
+// Get Cell throws when out of range
+TEST_F( GridTest, GetCellThrowsOutOfRange )
+{
+    Sudoku::Grid g;
+    EXPECT_ANY_THROW( g.GetCell( 0, 1 ) );
+    EXPECT_ANY_THROW( g.GetCell( 1, 0 ) );
+    EXPECT_ANY_THROW( g.GetCell( 10, 1 ) );
+    EXPECT_ANY_THROW( g.GetCell( 1, 10 ) );
+    EXPECT_NO_THROW( g.GetCell( 9, 9 ) );
+}
+
+// Get Cell and index access agree
+TEST_F( GridTest, GetCellMatchesIndex )
+{
+    Sudoku::Grid g;
+    for ( size_t x = 1; x <= 9; x++ )
+    {
+        for ( size_t y = 1; y <= 9; y++ )
+        {
+            EXPECT_EQ( &g[( y - 1 ) * 9 + x - 1], &g.GetCell( x, y ) );
+        }
+    }
+}
+
+// Rows, columns and blocks hold the right records
+TEST_F( GridTest, SectorsReturnCorrectCells )
+{
+    Sudoku::Grid g;
+    for ( size_t i = 0; i < Sudoku::Grid::ARRAY_SIZE; i++ )
+    {
+        g[i].value = i % 9 + 1;
+        g[i].marks = i;
+    }
+    for ( size_t n = 1; n <= 9; n++ )
+    {
+        Sudoku::Grid::Sector row = g.GetRow( n );
+        Sudoku::Grid::Sector col = g.GetCol( n );
+        for ( size_t i = 0; i < 9; i++ )
+        {
+            EXPECT_EQ( &g.GetCell( i + 1, n ), &row[i] );
+            EXPECT_EQ( &g.GetCell( n, i + 1 ), &col[i] );
+        }
+    }
+    Sudoku::Grid::Sector block = g.GetBlock( 2, 3 );
+    EXPECT_EQ( &g.GetCell( 4, 7 ), &block[0] );
+    EXPECT_EQ( &g.GetCell( 6, 7 ), &block[2] );
+    EXPECT_EQ( &g.GetCell( 5, 8 ), &block[4] );
+    EXPECT_EQ( &g.GetCell( 6, 9 ), &block[8] );
+    EXPECT_ANY_THROW( g.GetBlock( 0, 1 ) );
+    EXPECT_ANY_THROW( g.GetBlock( 1, 4 ) );
+
+    const Sudoku::Grid &cg = g;
+    EXPECT_EQ( &cg.GetCell( 3, 2 ), &cg.GetRow( 2 )[2] );
+    EXPECT_EQ( &cg.GetCell( 3, 2 ), &cg.GetCol( 3 )[1] );
+    EXPECT_EQ( &cg.GetCell( 3, 2 ), &cg.GetBlock( 1, 1 )[5] );
+}
+
+// Loading a Puzzle copies values, givens and marks
+TEST_F( GridTest, LoadFromPuzzle )
+{
+    MakePartial();
+    _puzzle->GetCell( 3, 3 )->Mark( 1 );
+    _puzzle->GetCell( 3, 3 )->Mark( 9 );
+    Sudoku::Grid g( *_puzzle );
+    EXPECT_EQ( 5, g.GetCell( 1, 1 ).value );
+    EXPECT_TRUE( g.GetCell( 1, 1 ).given );
+    EXPECT_EQ( 4, g.GetCell( 2, 8 ).value );
+    EXPECT_FALSE( g.GetCell( 2, 8 ).given );
+    EXPECT_EQ( 0, g.GetCell( 2, 2 ).value );
+    EXPECT_TRUE( g.GetCell( 3, 3 ).HasMark( 1 ) );
+    EXPECT_TRUE( g.GetCell( 3, 3 ).HasMark( 9 ) );
+    EXPECT_EQ( 2u, g.GetCell( 3, 3 ).MarkCount() );
+}
+
+// Load then store is lossless for what the Grid holds
+TEST_F( GridTest, CopyToRoundTrips )
+{
+    MakePartial();
+    Sudoku::PuzzleMarker marker;
+    marker.UpdateMarks( _puzzle );
+    Sudoku::Grid g( *_puzzle );
+    g.GetCell( 4, 4 ).value = 6;
+    g.GetCell( 4, 4 ).marks = 0;
+
+    Sudoku::Puzzle other;
+    g.CopyTo( other );
+    EXPECT_EQ( g, Sudoku::Grid( other ) );
+    EXPECT_EQ( 6, other.GetCell( 4, 4 )->DisplayedValue() );
+    EXPECT_TRUE( other.GetCell( 4, 4 )->CanGuess() );
+    EXPECT_EQ( 5, other.GetCell( 1, 1 )->GetCorrectValue() );
+    EXPECT_FALSE( other.GetCell( 1, 1 )->CanGuess() );
+}
+
+// Grid marks are the same as the PuzzleMarker marks
+TEST_F( GridTest, UpdateMarksSameAsPuzzleMarker )
+{
+    MakePartial();
+    Sudoku::Grid g( *_puzzle );
+    g.UpdateMarks();
+    Sudoku::PuzzleMarker marker;
+    marker.UpdateMarks( _puzzle );
+    EXPECT_EQ( Sudoku::Grid( *_puzzle ), g );
+}
+
+// Mark helpers work on the right bits
+TEST_F( GridTest, MarkHelpers )
+{
+    Sudoku::GridCell c = { 0, 0, 0 };
+    c.Mark( 1 );
+    c.Mark( 9 );
+    EXPECT_EQ( 0x101, c.marks );
+    EXPECT_TRUE( c.HasMark( 9 ) );
+    c.Unmark( 9 );
+    EXPECT_FALSE( c.HasMark( 9 ) );
+    EXPECT_EQ( 1u, c.MarkCount() );
+}
+
+}  // namespace
@@ -0,0 +1,139 @@
+#include "../HiddenSingleMethod.h"
+#include "../Cell.h"
+#include "../Puzzle.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// The fixture for testing class HiddenSingleMethod.
+class HiddenSingleMethodTest : public ::testing::Test
+{
+protected:
+
+    HiddenSingleMethodTest()
+    {
+    }
+
+    virtual ~HiddenSingleMethodTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+        // row 2 is marked with 1 and 2, only ( 6, 2 ) has 4
+        for ( size_t x = 1; x <= 9; x++ )
+        {
+            _puzzle.GetCell( x, 2 )->Mark( 1 );
+            _puzzle.GetCell( x, 2 )->Mark( 2 );
+        }
+        _cell = _puzzle.GetCell( 6, 2 );
+        _cell->Mark( 4 );
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    Sudoku::Puzzle _puzzle;
+    std::shared_ptr<Sudoku::Cell> _cell;
+};
+
+// Only marks from 1 to 9 make sense
+TEST_F( HiddenSingleMethodTest, ThrowsForBadMark )
+{
+    EXPECT_THROW( Sudoku::HiddenSingleMethod( _cell, 0,
+                                              _puzzle.GetRowView( 2 ) ),
+                  std::logic_error );
+    EXPECT_THROW( Sudoku::HiddenSingleMethod( _cell, 10,
+                                              _puzzle.GetRowView( 2 ) ),
+                  std::logic_error );
+}
+
+// Operation is valid when no other Cell has the mark
+TEST_F( HiddenSingleMethodTest, ForwardValidWorks )
+{
+    Sudoku::HiddenSingleMethod hsm( _cell, 4, _puzzle.GetRowView( 2 ) );
+    EXPECT_TRUE( hsm.VerifyForwardConditions() );
+}
+
+// Operation is invalid when the Cell does not have the mark
+TEST_F( HiddenSingleMethodTest, ForwardInvalidWithoutMark )
+{
+    Sudoku::HiddenSingleMethod hsm( _cell, 5, _puzzle.GetRowView( 2 ) );
+    EXPECT_FALSE( hsm.VerifyForwardConditions() );
+}
+
+// Operation is invalid when another Cell has the mark
+TEST_F( HiddenSingleMethodTest, ForwardInvalidIfMarkedElsewhere )
+{
+    Sudoku::HiddenSingleMethod hsm( _cell, 1, _puzzle.GetRowView( 2 ) );
+    EXPECT_FALSE( hsm.VerifyForwardConditions() );
+}
+
+// Operation is invalid when another Cell has the value
+TEST_F( HiddenSingleMethodTest, ForwardInvalidIfValueElsewhere )
+{
+    Sudoku::HiddenSingleMethod hsm( _cell, 4, _puzzle.GetRowView( 2 ) );
+    _puzzle.GetCell( 9, 2 )->SetGuess( 4 );
+    EXPECT_FALSE( hsm.VerifyForwardConditions() );
+}
+
+// Operation is invalid if there is already a guess
+TEST_F( HiddenSingleMethodTest, ForwardInvalidIfGuessSet )
+{
+    Sudoku::HiddenSingleMethod hsm( _cell, 4, _puzzle.GetRowView( 2 ) );
+    _cell->SetGuess( 4 );
+    EXPECT_FALSE( hsm.VerifyForwardConditions() );
+}
+
+// Forward operation sets the guess and removes every mark
+TEST_F( HiddenSingleMethodTest, ForwardExecuteWorks )
+{
+    Sudoku::HiddenSingleMethod hsm( _cell, 4, _puzzle.GetRowView( 2 ) );
+    hsm.ExecuteForward();
+    EXPECT_EQ( 4, _cell->DisplayedValue() );
+    EXPECT_EQ( 0u, _cell->CountMarks() );
+    EXPECT_TRUE( hsm.VerifyReverseConditions() );
+}
+
+// Reverse operation is invalid without the guess
+TEST_F( HiddenSingleMethodTest, ReverseInvalidForNoGuess )
+{
+    Sudoku::HiddenSingleMethod hsm( _cell, 4, _puzzle.GetRowView( 2 ) );
+    EXPECT_FALSE( hsm.VerifyReverseConditions() );
+}
+
+// Reverse operation is invalid when another Cell has the mark
+TEST_F( HiddenSingleMethodTest, ReverseInvalidIfMarkedElsewhere )
+{
+    Sudoku::HiddenSingleMethod hsm( _cell, 4, _puzzle.GetRowView( 2 ) );
+    hsm.ExecuteForward();
+    _puzzle.GetCell( 1, 2 )->Mark( 4 );
+    EXPECT_FALSE( hsm.VerifyReverseConditions() );
+}
+
+// Reverse operation removes the guess and sets the mark
+TEST_F( HiddenSingleMethodTest, ReverseExecuteWorks )
+{
+    Sudoku::HiddenSingleMethod hsm( _cell, 7, _puzzle.GetRowView( 2 ) );
+    _cell->ClearMarks();
+    _cell->SetGuess( 7 );
+    EXPECT_TRUE( hsm.VerifyReverseConditions() );
+    hsm.ExecuteReverse();
+    EXPECT_EQ( 0, _cell->DisplayedValue() );
+    EXPECT_EQ( 1u, _cell->CountMarks() );
+    EXPECT_TRUE( hsm.VerifyForwardConditions() );
+}
+
+// Forward then reverse the operation returns to original
+TEST_F( HiddenSingleMethodTest, ForwardThenReverseIsOriginal )
+{
+    Sudoku::Cell::MarkContainer marks = _cell->GetMarkContainer();
+    Sudoku::HiddenSingleMethod hsm( _cell, 4, _puzzle.GetRowView( 2 ) );
+    hsm.ExecuteForward();
+    hsm.ExecuteReverse();
+    EXPECT_EQ( 0, _cell->DisplayedValue() );
+    EXPECT_EQ( marks, _cell->GetMarkContainer() );
+}
+
+}  // namespace
@@ -0,0 +1,90 @@
+#include "../LinkGraph.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+class LinkGraphTest : public ::testing::Test
+{
+protected:
+    LinkGraphTest()
+    {
+    }
+
+    virtual ~LinkGraphTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+        for ( size_t i = 0; i < Sudoku::Units::CELL_COUNT; i++ )
+        {
+            _candidates[i] = 0;
+        }
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    unsigned short _candidates[Sudoku::Units::CELL_COUNT];
+    Sudoku::LinkGraph _graph;
+};
+
+// Nothing is linked before the first Update
+TEST_F( LinkGraphTest, EmptyByDefault )
+{
+    for ( int d = 1; d <= 9; d++ )
+    {
+        EXPECT_TRUE( _graph.GetCells( d ).Empty() );
+    }
+    EXPECT_TRUE( _graph.GetBivalue().Empty() );
+    EXPECT_EQ( 0u, _graph.Update( _candidates ) );
+}
+
+// The only two places of a digit in a unit are a conjugate pair
+TEST_F( LinkGraphTest, FindsConjugatePairs )
+{
+    // 5 at (1,1) and (5,1) in row 1, (5,1) and (5,5) in column 5, (7,5)
+    // and (9,5) in their block
+    _candidates[0] = 1 << 4;
+    _candidates[4] = 1 << 4;
+    _candidates[40] = 1 << 4;
+    _candidates[44] = 1 << 4;
+    _candidates[42] = 1 << 4;
+    _graph.Update( _candidates );
+
+    EXPECT_EQ( Sudoku::Bitboard::Single( 4 ), _graph.GetConjugates( 5, 0 ) );
+    EXPECT_EQ( Sudoku::Bitboard::Single( 0 ) | Sudoku::Bitboard::Single( 40 ),
+               _graph.GetConjugates( 5, 4 ) );
+    // row 5 has three places
+    EXPECT_EQ( Sudoku::Bitboard::Single( 4 ), _graph.GetConjugates( 5, 40 ) );
+    EXPECT_EQ( Sudoku::Bitboard::Single( 42 ), _graph.GetConjugates( 5, 44 ) );
+    EXPECT_TRUE( _graph.GetConjugates( 4, 0 ).Empty() );
+    // weak links are all the peers
+    EXPECT_EQ( Sudoku::Bitboard::Single( 40 ) | Sudoku::Bitboard::Single( 44 ),
+               _graph.GetWeak( 5, 42 ) );
+}
+
+// Update only reports and rebuilds the digits which changed
+TEST_F( LinkGraphTest, UpdateReturnsChangedDigits )
+{
+    _candidates[0] = ( 1 << 4 ) | ( 1 << 6 );
+    _candidates[4] = 1 << 4;
+    EXPECT_EQ( ( 1 << 4 ) | ( 1 << 6 ), _graph.Update( _candidates ) );
+    EXPECT_EQ( 0u, _graph.Update( _candidates ) );
+    EXPECT_EQ( Sudoku::Bitboard::Single( 0 ), _graph.GetBivalue() );
+
+    _candidates[4] |= 1 << 6;
+    EXPECT_EQ( 1 << 6, _graph.Update( _candidates ) );
+    EXPECT_EQ( Sudoku::Bitboard::Single( 4 ), _graph.GetConjugates( 7, 0 ) );
+    EXPECT_EQ( Sudoku::Bitboard::Single( 0 ) | Sudoku::Bitboard::Single( 4 ),
+               _graph.GetBivalue() );
+
+    _candidates[0] = 0;
+    EXPECT_EQ( ( 1 << 4 ) | ( 1 << 6 ), _graph.Update( _candidates ) );
+    EXPECT_TRUE( _graph.GetConjugates( 5, 4 ).Empty() );
+    EXPECT_EQ( Sudoku::Bitboard::Single( 4 ), _graph.GetCells( 7 ) );
+    EXPECT_EQ( Sudoku::Bitboard::Single( 4 ), _graph.GetBivalue() );
+}
+
+}  // namespace
@@ -0,0 +1,121 @@
+// keep every level even in release builds
+#define FILELOG_MAX_LEVEL logDEBUG4
+#include "../Log.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <string>
+
+namespace {
+
+class LogTest : public ::testing::Test
+{
+protected:
+    LogTest()
+    {
+    }
+
+    virtual ~LogTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+        _file = tmpfile();
+        ASSERT_TRUE( _file != NULL );
+        Output2FILE::Flush();
+        _old = Output2FILE::Stream();
+        Output2FILE::Stream() = _file;
+    }
+
+    virtual void TearDown()
+    {
+        Output2FILE::Flush();
+        Output2FILE::Stream() = _old;
+        Output2FILE::Async() = true;
+        LogModule::ResetLevels();
+        fclose( _file );
+    }
+
+    /**
+     * Everything written to the log so far
+     */
+    std::string Written()
+    {
+        Output2FILE::Flush();
+        std::string text;
+        rewind( _file );
+        char buffer[256];
+        size_t n;
+        while ( ( n = fread( buffer, 1, sizeof( buffer ), _file ) ) > 0 )
+        {
+            text.append( buffer, n );
+        }
+        return text;
+    }
+
+    FILE *_file;
+    FILE *_old;
+};
+
+// The module of a source file is named after the file
+TEST_F( LogTest, ModuleName )
+{
+    EXPECT_EQ( "LogTest", FileLogModule().Name() );
+    EXPECT_EQ( "Solver", LogModule( "a/b/Solver.cpp" ).Name() );
+}
+
+// Modules follow the global level until they get their own
+TEST_F( LogTest, ModuleLevels )
+{
+    EXPECT_EQ( FILELog::ReportingLevel(), FileLogModule().Level() );
+    FILE_LOG(logINFO) << "hidden";
+    EXPECT_EQ( "", Written() );
+
+    LogModule::SetLevel( "LogTest", logINFO );
+    EXPECT_EQ( logINFO, FileLogModule().Level() );
+    FILE_LOG(logINFO) << "shown";
+    FILE_LOG(logDEBUG) << "hidden";
+    std::string text = Written();
+    EXPECT_NE( std::string::npos, text.find( "INFO: [LogTest] shown\n" ) );
+    EXPECT_EQ( std::string::npos, text.find( "hidden" ) );
+
+    // other modules are not changed
+    LogModule other( "Other.cpp" );
+    EXPECT_EQ( FILELog::ReportingLevel(), other.Level() );
+
+    LogModule::ResetLevels();
+    EXPECT_EQ( FILELog::ReportingLevel(), FileLogModule().Level() );
+}
+
+// Levels can be set before a module exists, from a list
+TEST_F( LogTest, Configure )
+{
+    LogModule::Configure( NULL );
+    LogModule::Configure( "Late=DEBUG2,bad,Early=WARNING" );
+    LogModule late( "Late.cpp" );
+    EXPECT_EQ( logDEBUG2, late.Level() );
+    LogModule early( "Early.h" );
+    EXPECT_EQ( logWARNING, early.Level() );
+}
+
+// Queued messages come out in order, and right away without the queue
+TEST_F( LogTest, Output )
+{
+    LogModule::SetLevel( "LogTest", logDEBUG );
+    for ( int i = 0; i < 100; i++ )
+    {
+        FILE_LOG(logDEBUG) << "message " << i;
+    }
+    std::string text = Written();
+    EXPECT_LT( text.find( "message 0\n" ), text.find( "message 1\n" ) );
+    EXPECT_LT( text.find( "message 98\n" ), text.find( "message 99\n" ) );
+
+    Output2FILE::Async() = false;
+    FILE_LOG(logWARNING) << "direct";
+    fflush( _file );
+    rewind( _file );
+    EXPECT_NE( std::string::npos, Written().find( "direct" ) );
+}
+
+}  // namespace
@@ -0,0 +1,134 @@
+#include "../GridListImporter.h"
+#include "../MappedGridImporter.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+class MappedGridImporterTest : public ::testing::Test
+{
+protected:
+    MappedGridImporterTest()
+    {
+    }
+
+    virtual ~MappedGridImporterTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    size_t Parse( const std::string &s )
+    {
+        return _importer.Parse( s.data(), s.size() );
+    }
+
+    Sudoku::MappedGridImporter _importer;
+};
+
+const char *LINE1 =
+    "003020600900305001001806400008102900700000008"
+    "006708200002609500800203009005010300";
+const char *LINE2 =
+    "4.....8.5.3..........7......2.....6.....8.4......1......."
+    "6.3.7.5..2.....1.4......";
+const char *BLOCKS =
+    "1 4 0  0 0 0  0 0 8\n0 0 5  4 8 0  3 0 0\n0 0 9  2 0 0  1 4 0\n\n"
+    "0 2 8  0 0 0  0 0 1\n5 1 0  0 0 0  0 9 2\n3 0 0  0 0 0  5 7 0\n\n"
+    "0 5 7  0 0 2  4 0 0\n0 0 1  0 9 6  7 0 0\n6 0 0  0 0 0  0 8 5\n";
+
+// Reads the same Grids as GridListImporter, in both layouts
+TEST_F( MappedGridImporterTest, MatchesGridListImporter )
+{
+    std::string text = "# comment\n" + std::string( LINE1 ) + "\r\n" +
+        LINE2 + "  trailing comment\n\n" + BLOCKS + "hard\n" + LINE1;
+    ASSERT_EQ( 4u, Parse( text ) );
+    EXPECT_TRUE( _importer.GetMalformedLines().empty() );
+
+    std::istringstream in( text );
+    Sudoku::GridListImporter reference;
+    std::vector<Sudoku::Grid> expected = reference.Import( in );
+    std::vector<Sudoku::Grid> grids;
+    _importer.CopyTo( grids );
+    ASSERT_EQ( expected.size(), grids.size() );
+    for ( size_t g = 0; g < grids.size(); g++ )
+    {
+        for ( size_t i = 0; i < Sudoku::Grid::ARRAY_SIZE; i++ )
+        {
+            EXPECT_EQ( expected[g][i], grids[g][i] ) << g << ", " << i;
+        }
+    }
+}
+
+// Malformed Puzzles are skipped and reported by line, nothing throws
+TEST_F( MappedGridImporterTest, ReportsMalformedLines )
+{
+    std::string text = std::string( LINE1 ) + "\n" +
+        "12x" + LINE1 + "\n" +
+        LINE2 + "\n" +
+        "1 2 3\n4 5 6 ?\n" +
+        LINE2 + "\n" +
+        "123456789\n";
+    EXPECT_EQ( 3u, Parse( text ) );
+    ASSERT_EQ( 3u, _importer.GetMalformedLines().size() );
+    EXPECT_EQ( 2u, _importer.GetMalformedLines()[0] );
+    EXPECT_EQ( 4u, _importer.GetMalformedLines()[1] );
+    EXPECT_EQ( 7u, _importer.GetMalformedLines()[2] );
+    ASSERT_EQ( 3u, _importer.GetMalformedPositions().size() );
+    EXPECT_EQ( 1u, _importer.GetMalformedPositions()[0] );
+    EXPECT_EQ( 3u, _importer.GetMalformedPositions()[1] );
+    EXPECT_EQ( 5u, _importer.GetMalformedPositions()[2] );
+    EXPECT_EQ( 4, _importer.GetRecords()[1].values[0] );
+    EXPECT_EQ( 4, _importer.GetRecords()[2].values[0] );
+
+    EXPECT_EQ( 0u, Parse( "" ) );
+    EXPECT_TRUE( _importer.GetMalformedLines().empty() );
+    EXPECT_TRUE( _importer.GetMalformedPositions().empty() );
+}
+
+// A truncated line is malformed, it is not completed by the next line
+TEST_F( MappedGridImporterTest, ReportsTruncatedLine )
+{
+    std::string text = std::string( LINE1 ) + "\n" +
+        std::string( LINE2 ).substr( 0, 80 ) + "\n" +
+        LINE2 + "\n" +
+        LINE1 + "\n";
+    EXPECT_EQ( 3u, Parse( text ) );
+    ASSERT_EQ( 1u, _importer.GetMalformedLines().size() );
+    EXPECT_EQ( 2u, _importer.GetMalformedLines()[0] );
+    ASSERT_EQ( 1u, _importer.GetMalformedPositions().size() );
+    EXPECT_EQ( 1u, _importer.GetMalformedPositions()[0] );
+    EXPECT_EQ( 4, _importer.GetRecords()[1].values[0] );
+    EXPECT_EQ( 3, _importer.GetRecords()[2].values[2] );
+}
+
+// Maps a file, and only a missing file throws
+TEST_F( MappedGridImporterTest, ImportsFile )
+{
+    const char *filename = "mapped_grid_importer_test.txt";
+    {
+        std::ofstream out( filename );
+        for ( size_t i = 0; i < 1000; i++ )
+        {
+            out << ( i % 2 ? LINE1 : LINE2 ) << "\n";
+        }
+    }
+    EXPECT_EQ( 1000u, _importer.Import( filename ) );
+    EXPECT_EQ( 3, _importer.GetRecords()[999].values[2] );
+    std::remove( filename );
+
+    EXPECT_THROW( _importer.Import( filename ), std::runtime_error );
+}
+
+}  // namespace
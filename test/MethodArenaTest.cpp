@@ -0,0 +1,107 @@
+#include "../MethodArena.h"
+#include "../Puzzle.h"
+#include "../SolutionMethodFactory.h"
+#include "gtest/gtest.h"
+
+#include <stdint.h>
+
+namespace {
+
+class MethodArenaTest : public ::testing::Test
+{
+protected:
+    MethodArenaTest()
+    {
+    }
+
+    virtual ~MethodArenaTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    Sudoku::MethodArena _arena;
+};
+
+TEST_F( MethodArenaTest, AllocationsAreAlignedAndDistinct )
+{
+    char *a = static_cast<char *>( _arena.Allocate( 3 ) );
+    char *b = static_cast<char *>( _arena.Allocate( 40 ) );
+    EXPECT_EQ( 0u, reinterpret_cast<uintptr_t>( a ) %
+               Sudoku::MethodArena::ALIGNMENT );
+    EXPECT_EQ( 0u, reinterpret_cast<uintptr_t>( b ) %
+               Sudoku::MethodArena::ALIGNMENT );
+    EXPECT_GE( b - a, 3 );
+    EXPECT_EQ( 64u, _arena.Used() );
+}
+
+TEST_F( MethodArenaTest, ResetReusesMemory )
+{
+    void *first = _arena.Allocate( 100 );
+    for ( size_t k = 0; k < 10000; k++ )
+    {
+        _arena.Allocate( 100 );
+    }
+    size_t capacity = _arena.Capacity();
+    EXPECT_GT( capacity, Sudoku::MethodArena::CHUNK_SIZE );
+
+    _arena.Reset();
+    EXPECT_EQ( 0u, _arena.Used() );
+    EXPECT_EQ( first, _arena.Allocate( 100 ) );
+    for ( size_t k = 0; k < 10000; k++ )
+    {
+        _arena.Allocate( 100 );
+    }
+    // the same chunks were walked again
+    EXPECT_EQ( capacity, _arena.Capacity() );
+}
+
+TEST_F( MethodArenaTest, LargeAllocationGetsOwnChunk )
+{
+    size_t big = Sudoku::MethodArena::CHUNK_SIZE * 2;
+    char *p = static_cast<char *>( _arena.Allocate( big ) );
+    p[0] = 1;
+    p[big - 1] = 1;
+    EXPECT_GE( _arena.Capacity(), big );
+}
+
+TEST_F( MethodArenaTest, FactoryCreatesMethodsInArena )
+{
+    Sudoku::Puzzle p;
+    Sudoku::SolutionMethodFactory factory;
+    factory.SetArena( &_arena );
+    std::shared_ptr<Sudoku::Cell> c = p.GetCell( 1, 1 );
+    long uses = c.use_count();
+    {
+        std::shared_ptr<Sudoku::SolutionMethod> m =
+            factory.CreateSingleCandidateMethod( c );
+        std::shared_ptr<Sudoku::SolutionMethod> copy = m;
+        EXPECT_EQ( 1u, _arena.Live() );
+        EXPECT_GT( _arena.Used(), 0u );
+        EXPECT_EQ( uses + 1, c.use_count() );
+    }
+    // destructor ran, memory stays until Reset
+    EXPECT_EQ( 0u, _arena.Live() );
+    EXPECT_EQ( uses, c.use_count() );
+    EXPECT_GT( _arena.Used(), 0u );
+    _arena.Reset();
+    EXPECT_EQ( 0u, _arena.Used() );
+}
+
+TEST_F( MethodArenaTest, FactoryWithoutArenaUsesHeap )
+{
+    Sudoku::Puzzle p;
+    Sudoku::SolutionMethodFactory factory;
+    std::shared_ptr<Sudoku::SolutionMethod> m =
+        factory.CreateCoveringSetMethod( p.GetRow( 1 ), p.GetRow( 1 ) );
+    EXPECT_EQ( 0u, _arena.Used() );
+    EXPECT_FALSE( m->VerifyForwardConditions() );
+}
+
+}  // namespace
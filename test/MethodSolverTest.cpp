@@ -1,9 +1,13 @@
 #include "../MethodSolver.h"
+#include "../BacktrackingSolver.h"
+#include "../Grid.h"
 #include "../Puzzle.h"
 #include "../SolverHelper.h"
 #include "../PuzzleMarker.h"
 #include "../SimpleValidator.h"
 #include "../SolutionMethodFactory.h"
+#include "MockCellObserver.h"
+#include "TestGrids.h"
 #include "gtest/gtest.h"
 
 namespace {
@@ -85,6 +89,16 @@ protected:
     }
     
     std::shared_ptr<Sudoku::Puzzle> _puzzle;
+    /**
+     * SOURCE:
+     * Arto Inkala, "world's hardest sudoku" (needs search)
+     */
+    void MakeHardPuzzle()
+    {
+        Sudoku::TestGrids::MakeGrid( Sudoku::TestGrids::HARD ).CopyTo(
+            *_puzzle );
+    }
+
     std::shared_ptr<Sudoku::MethodSolver> _solver;
     std::shared_ptr<Sudoku::SolverHelper> _helper;
     std::shared_ptr<Sudoku::IPuzzleMarker> _marker;
@@ -100,4 +114,95 @@ TEST_F( MethodSolverTest, CanSolveMediumPuzzle )
     EXPECT_TRUE( _validator->IsValid( _puzzle ) );
 }
 
+// Methods alone get stuck on a hard puzzle
+TEST_F( MethodSolverTest, ThrowsWhenStuck )
+{
+    MakeHardPuzzle();
+    EXPECT_THROW( _solver->Solve( _puzzle ), std::runtime_error );
+}
+
+// The fallback finishes what the Methods started
+TEST_F( MethodSolverTest, FallbackSolvesHardPuzzle )
+{
+    MakeHardPuzzle();
+    _solver->SetFallback( std::shared_ptr<Sudoku::ISolver>(
+        new Sudoku::BacktrackingSolver( _marker ) ) );
+    EXPECT_NO_THROW( _solver->Solve( _puzzle ) );
+    EXPECT_TRUE( _validator->IsValid( _puzzle ) );
+    EXPECT_EQ( 1, _puzzle->GetCell( 2, 1 )->DisplayedValue() );
+}
+
+// Observers hear about each Cell at most once per Solve
+TEST_F( MethodSolverTest, SolveNotifiesEachCellOnce )
+{
+    MakeHardPuzzle();
+    _solver->SetFallback( std::shared_ptr<Sudoku::ISolver>(
+        new Sudoku::BacktrackingSolver( _marker ) ) );
+    std::shared_ptr<Sudoku::MockCellObserver> observer(
+        new Sudoku::MockCellObserver );
+    Sudoku::Puzzle::View all = _puzzle->GetAllView();
+    for ( Sudoku::Puzzle::View::iterator it = all.begin();
+          it != all.end();
+          ++it )
+    {
+        (*it)->AddObserver( observer );
+    }
+    EXPECT_CALL( *observer, Update( ::testing::_ ) )
+        .Times( ::testing::Between( 60, 81 ) );
+    _solver->Solve( _puzzle );
+}
+
+// Nothing is counted unless asked for
+TEST_F( MethodSolverTest, StatsOffByDefault )
+{
+    MakeMediumPuzzle();
+    _solver->Solve( _puzzle );
+    EXPECT_EQ( 0u, _solver->GetStats().passes );
+    EXPECT_EQ( 0u, _solver->GetStats().validations );
+}
+
+// Stats account for every mark the Methods removed
+TEST_F( MethodSolverTest, StatsCountWhatSolveDid )
+{
+    MakeMediumPuzzle();
+    _marker->UpdateMarks( _puzzle );
+    size_t marks = 0;
+    Sudoku::Puzzle::View all = _puzzle->GetAllView();
+    for ( Sudoku::Puzzle::View::iterator it = all.begin();
+          it != all.end();
+          ++it )
+    {
+        if ( (*it)->CanGuess() )
+        {
+            marks += (*it)->GetMarkContainer().count();
+        }
+    }
+
+    _solver->SetStatsEnabled( true );
+    _solver->Solve( _puzzle );
+    const Sudoku::SolveStats &stats = _solver->GetStats();
+    EXPECT_EQ( 1u, stats.validations );
+    size_t runs = 0;
+    size_t eliminated = 0;
+    for ( size_t k = 0; k < Sudoku::PropagationQueue::RULE_COUNT; k++ )
+    {
+        const Sudoku::SolveStats::Method &m = stats.methods[k];
+        EXPECT_LE( m.executed, m.verified );
+        EXPECT_LE( m.verified, m.found );
+        runs += m.runs;
+        eliminated += m.eliminated;
+    }
+    EXPECT_EQ( stats.passes, runs );
+    EXPECT_EQ( marks, eliminated );
+    EXPECT_GT(
+        stats.methods[Sudoku::PropagationQueue::SINGLE_CANDIDATE].executed,
+        0u );
+
+    // a second solve starts counting over
+    Sudoku::SolveStats first = stats;
+    _solver->Solve( _puzzle );
+    EXPECT_EQ( 1u, stats.validations );
+    EXPECT_LT( stats.passes, first.passes );
+}
+
 }  // namespace
@@ -0,0 +1,23 @@
+#ifndef SUDOKU_MOCK_SOLUTION_COUNTER_H
+#define SUDOKU_MOCK_SOLUTION_COUNTER_H
+
+#include "gmock/gmock.h"
+
+#include "../ISolutionCounter.h"
+
+namespace Sudoku
+{
+
+class MockSolutionCounter : public ISolutionCounter
+{
+public:
+
+    MOCK_METHOD2( CountSolutions, size_t ( std::shared_ptr<const Puzzle> p,
+                                           size_t limit ) );
+
+    MOCK_METHOD2( CountSolutions, size_t ( const Grid &g, size_t limit ) );
+};
+
+}
+
+#endif
@@ -23,13 +23,31 @@ public:
                   std::shared_ptr<SolutionMethod> (
                       std::shared_ptr<Cell> c,
                       unsigned mark,
-                      Puzzle::Container primary,
-                      Puzzle::Container secondary ) );
+                      const Puzzle::Container &primary,
+                      const Puzzle::Container &secondary ) );
 
     MOCK_METHOD2( CreateCoveringSetMethod,
                   std::shared_ptr<SolutionMethod> (
-                      Puzzle::Container sector,
-                      Puzzle::Container subset ) );
+                      const Puzzle::Container &sector,
+                      const Puzzle::Container &subset ) );
+
+    MOCK_METHOD3( CreateHiddenSingleMethod,
+                  std::shared_ptr<SolutionMethod> (
+                      std::shared_ptr<Cell> c,
+                      unsigned mark,
+                      const Puzzle::View &sector ) );
+
+    MOCK_METHOD4( CreateFishMethod,
+                  std::shared_ptr<SolutionMethod> (
+                      std::shared_ptr<Puzzle> p,
+                      unsigned mark,
+                      const Bitboard &base,
+                      const Bitboard &cover ) );
+
+    MOCK_METHOD2( CreateChainMethod,
+                  std::shared_ptr<SolutionMethod> (
+                      std::shared_ptr<Puzzle> p,
+                      const Chains::Chain &chain ) );
 };
 
 }
@@ -0,0 +1,101 @@
+#include "../PropagationQueue.h"
+#include "../Puzzle.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+class PropagationQueueTest : public ::testing::Test
+{
+protected:
+    PropagationQueueTest()
+    {
+    }
+
+    virtual ~PropagationQueueTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+        queue.Start( puzzle );
+        for ( size_t r = 0; r < Sudoku::PropagationQueue::RULE_COUNT; r++ )
+        {
+            queue.Take( static_cast<Sudoku::PropagationQueue::Rule>( r ),
+                        work );
+        }
+        puzzle.BeginChanges();
+    }
+
+    virtual void TearDown()
+    {
+        puzzle.EndChanges();
+    }
+
+    Sudoku::Puzzle puzzle;
+    Sudoku::PropagationQueue queue;
+    Sudoku::PropagationQueue::Work work;
+};
+
+// Everything is pending after Start
+TEST_F( PropagationQueueTest, StartMakesEverythingPending )
+{
+    EXPECT_FALSE( queue.IsPending( Sudoku::PropagationQueue::EXCLUSION ) );
+    queue.Start( puzzle );
+    queue.Take( Sudoku::PropagationQueue::EXCLUSION, work );
+    EXPECT_EQ( Sudoku::Bitboard::All(), work.cells );
+    for ( size_t u = 0; u < Sudoku::Units::UNIT_COUNT; u++ )
+    {
+        EXPECT_EQ( 0x1FF, work.digits[u] );
+    }
+    EXPECT_FALSE( queue.IsPending( Sudoku::PropagationQueue::EXCLUSION ) );
+    EXPECT_TRUE( queue.IsPending( Sudoku::PropagationQueue::COVERING_SET ) );
+}
+
+// A changed mark touches its Cell and the digit in the Cell's units
+TEST_F( PropagationQueueTest, UpdateTouchesChangedDigit )
+{
+    EXPECT_FALSE(
+        queue.IsPending( Sudoku::PropagationQueue::SINGLE_CANDIDATE ) );
+    puzzle.GetCell( 2, 1 )->Mark( 3 );
+    EXPECT_EQ( 1u, queue.Update( puzzle ) );
+
+    queue.Take( Sudoku::PropagationQueue::SINGLE_CANDIDATE, work );
+    EXPECT_EQ( Sudoku::Bitboard::Single( 1 ), work.cells );
+    for ( size_t u = 0; u < Sudoku::Units::UNIT_COUNT; u++ )
+    {
+        bool touched = u == Sudoku::Units::Row( 1 ) ||
+            u == Sudoku::Units::Col( 2 ) || u == Sudoku::Units::Block( 1, 1 );
+        EXPECT_EQ( touched ? 1 << 2 : 0, work.digits[u] );
+    }
+
+    // other rules keep their work
+    EXPECT_FALSE(
+        queue.IsPending( Sudoku::PropagationQueue::SINGLE_CANDIDATE ) );
+    EXPECT_TRUE(
+        queue.IsPending( Sudoku::PropagationQueue::BLOCK_INTERSECTION ) );
+}
+
+// A new value touches the digit of the value and of the marks removed
+TEST_F( PropagationQueueTest, UpdateTouchesValueAndMarks )
+{
+    puzzle.GetCell( 9, 9 )->Mark( 1 );
+    puzzle.GetCell( 9, 9 )->Mark( 2 );
+    queue.Update( puzzle );
+    queue.Take( Sudoku::PropagationQueue::EXCLUSION, work );
+
+    puzzle.GetCell( 9, 9 )->SetGuess( 5 );
+    puzzle.GetCell( 9, 9 )->ClearMarks();
+    EXPECT_EQ( 1u, queue.Update( puzzle ) );
+    queue.Take( Sudoku::PropagationQueue::EXCLUSION, work );
+    EXPECT_EQ( Sudoku::Bitboard::Single( 80 ), work.cells );
+    EXPECT_EQ( ( 1 << 0 ) | ( 1 << 1 ) | ( 1 << 4 ),
+               work.digits[Sudoku::Units::Row( 9 )] );
+
+    // changes which cancel out touch nothing
+    puzzle.GetCell( 1, 1 )->Mark( 4 );
+    puzzle.GetCell( 1, 1 )->Unmark( 4 );
+    EXPECT_EQ( 0u, queue.Update( puzzle ) );
+    EXPECT_FALSE( queue.IsPending( Sudoku::PropagationQueue::EXCLUSION ) );
+}
+
+}  // namespace
@@ -0,0 +1,141 @@
+#include "../CandidateGrid.h"
+#include "../Grid.h"
+#include "../GridListImporter.h"
+#include "../PuzzleBatch.h"
+#include "TestGrids.h"
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Sudoku::TestGrids::EASY;
+using Sudoku::TestGrids::EASY_SOLUTION;
+
+class PuzzleBatchTest : public ::testing::Test
+{
+protected:
+    PuzzleBatchTest()
+    {
+    }
+
+    virtual ~PuzzleBatchTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    Sudoku::Grid MakeGrid( const std::string &s )
+    {
+        std::istringstream in( s );
+        Sudoku::GridListImporter importer;
+        return importer.Import( in ).at( 0 );
+    }
+
+    /**
+     * Export one Grid, without the line break
+     */
+    std::string Export( const Sudoku::Grid &g )
+    {
+        std::ostringstream out;
+        Sudoku::GridListImporter::Export( out, g );
+        std::string line = out.str();
+        return line.substr( 0, line.size() - 1 );
+    }
+};
+
+const char *HARD =
+    "4.....8.5.3..........7......2.....6.....8.4......1......."
+    "6.3.7.5..2.....1.4......\n";
+
+// Marks match the candidates of a CandidateGrid in every lane
+TEST_F( PuzzleBatchTest, UpdateMarksMatchesCandidateGrid )
+{
+    Sudoku::Grid grids[2] = { MakeGrid( EASY ), MakeGrid( HARD ) };
+    Sudoku::PuzzleBatch batch;
+    for ( size_t n = 0; n < 20; n++ )
+    {
+        batch.Add( grids[n % 2] );
+    }
+    ASSERT_EQ( 20u, batch.Size() );
+    batch.UpdateMarks();
+    for ( size_t n = 0; n < batch.Size(); n++ )
+    {
+        Sudoku::CandidateGrid cg( grids[n % 2] );
+        for ( size_t i = 0; i < Sudoku::Units::CELL_COUNT; i++ )
+        {
+            if ( cg.GetValue( i ) == 0 )
+            {
+                EXPECT_EQ( cg.GetCandidates( i ), batch.GetCandidates( n, i ) )
+                    << n << ", " << i;
+            }
+            else
+            {
+                EXPECT_EQ( cg.GetValue( i ), batch.GetValue( n, i ) );
+                EXPECT_EQ( 0, batch.GetCandidates( n, i ) );
+            }
+        }
+    }
+}
+
+// Singles finish the easy Puzzle and leave the hard one open
+TEST_F( PuzzleBatchTest, Solve )
+{
+    Sudoku::PuzzleBatch batch;
+    for ( size_t n = 0; n < 35; n++ )
+    {
+        batch.Add( MakeGrid( n % 5 ? EASY : HARD ) );
+    }
+    EXPECT_EQ( 28u, batch.Solve() );
+    for ( size_t n = 0; n < batch.Size(); n++ )
+    {
+        Sudoku::Grid g;
+        batch.CopyTo( n, g );
+        if ( n % 5 )
+        {
+            EXPECT_TRUE( batch.IsSolved( n ) );
+            EXPECT_EQ( EASY_SOLUTION, Export( g ) );
+            EXPECT_EQ( 1, g[2].given );
+            EXPECT_EQ( 0, g[0].given );
+        }
+        else
+        {
+            EXPECT_FALSE( batch.IsSolved( n ) );
+            EXPECT_EQ( 4, g[0].value );
+        }
+    }
+}
+
+// One step at a time: exclusion, then a pass of singles
+TEST_F( PuzzleBatchTest, SinglesAndExclusion )
+{
+    Sudoku::Grid g = MakeGrid( EASY_SOLUTION );
+    g[0].value = 0;
+    g[0].given = 0;
+    g[80].value = 0;
+    g[80].given = 0;
+    Sudoku::PuzzleBatch batch;
+    batch.Add( g );
+    batch.UpdateMarks();
+    EXPECT_EQ( 1 << 3, batch.GetCandidates( 0, 0 ) );
+    EXPECT_EQ( 2u, batch.PlaceSingles() );
+    EXPECT_EQ( 0u, batch.PlaceSingles() );
+    EXPECT_TRUE( batch.IsSolved( 0 ) );
+    EXPECT_EQ( 4, batch.GetValue( 0, 0 ) );
+    EXPECT_EQ( 2, batch.GetValue( 0, 80 ) );
+    EXPECT_EQ( 0, batch.GetCandidates( 0, 0 ) );
+
+    // exclusion removes a placed value from its peers
+    batch.Exclude();
+    EXPECT_EQ( 0, batch.GetCandidates( 0, 1 ) );
+}
+
+}  // namespace
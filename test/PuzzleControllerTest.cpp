@@ -3,6 +3,7 @@
 #include "MockCommandExecutor.h"
 #include "MockPuzzleAccess.h"
 #include "MockPuzzleMarker.h"
+#include "MockSolutionCounter.h"
 #include "MockSolver.h"
 #include "gtest/gtest.h"
 
@@ -21,6 +22,7 @@ protected:
         _commandExec.reset( new Sudoku::MockCommandExecutor );
         _marker.reset( new Sudoku::MockPuzzleMarker );
         _solver.reset( new Sudoku::MockSolver );
+        _counter.reset( new Sudoku::MockSolutionCounter );
 
         ON_CALL( *_puzzleAccess, GetPuzzle() )
             .WillByDefault( Return( _puzzle ) );
@@ -42,6 +44,7 @@ protected:
     std::shared_ptr<Sudoku::MockCommandExecutor> _commandExec;
     std::shared_ptr<Sudoku::MockPuzzleMarker> _marker;
     std::shared_ptr<Sudoku::MockSolver> _solver;
+    std::shared_ptr<Sudoku::MockSolutionCounter> _counter;
     std::shared_ptr<Sudoku::Puzzle> _puzzle;
 };
 
@@ -53,7 +56,8 @@ TEST_F( PuzzleControllerTest, ThrowIfNullPuzzleAccess )
         Sudoku::PuzzleController controller( _commandExec,
                                              _puzzleAccess,
                                              _marker,
-                                             _solver ) );
+                                             _solver,
+                                             _counter ) );
 }
 
 // make sure we throw on null pointers
@@ -64,7 +68,8 @@ TEST_F( PuzzleControllerTest, ThrowIfNullCommandExecutor )
         Sudoku::PuzzleController controller( _commandExec,
                                              _puzzleAccess,
                                              _marker,
-                                             _solver ) );
+                                             _solver,
+                                             _counter ) );
 }
 
 // make sure we throw on null pointers
@@ -75,7 +80,8 @@ TEST_F( PuzzleControllerTest, ThrowIfNullMarker )
         Sudoku::PuzzleController controller( _commandExec,
                                              _puzzleAccess,
                                              _marker,
-                                             _solver ) );
+                                             _solver,
+                                             _counter ) );
 }
 
 // make sure we throw on null pointers
@@ -86,7 +92,8 @@ TEST_F( PuzzleControllerTest, ThrowIfNullSolver )
         Sudoku::PuzzleController controller( _commandExec,
                                              _puzzleAccess,
                                              _marker,
-                                             _solver ) );
+                                             _solver,
+                                             _counter ) );
 }
 
 // check that guessing works
@@ -95,7 +102,8 @@ TEST_F( PuzzleControllerTest, MarkHintsExecutesCommand )
     Sudoku::PuzzleController controller( _commandExec,
                                          _puzzleAccess,
                                          _marker,
-                                         _solver );
+                                         _solver,
+                                         _counter );
     
     EXPECT_CALL( *_puzzleAccess, GetPuzzle() )
         .Times( 1 );
@@ -111,7 +119,8 @@ TEST_F( PuzzleControllerTest, SolveExecutesCommand )
     Sudoku::PuzzleController controller( _commandExec,
                                          _puzzleAccess,
                                              _marker,
-                                             _solver );
+                                             _solver,
+                                             _counter );
     
     EXPECT_CALL( *_puzzleAccess, GetPuzzle() )
         .Times( 1 );
@@ -121,4 +130,40 @@ TEST_F( PuzzleControllerTest, SolveExecutesCommand )
     controller.Solve();
 }
 
+// make sure we throw on null pointers
+TEST_F( PuzzleControllerTest, ThrowIfNullSolutionCounter )
+{
+    _counter.reset();
+    EXPECT_ANY_THROW(
+        Sudoku::PuzzleController controller( _commandExec,
+                                             _puzzleAccess,
+                                             _marker,
+                                             _solver,
+                                             _counter ) );
+}
+
+// counting goes to the counter with the current Puzzle, no command
+TEST_F( PuzzleControllerTest, CountSolutionsUsesCounter )
+{
+    Sudoku::PuzzleController controller( _commandExec,
+                                         _puzzleAccess,
+                                         _marker,
+                                         _solver,
+                                         _counter );
+
+    EXPECT_CALL( *_puzzleAccess, GetPuzzle() )
+        .Times( 2 );
+    EXPECT_CALL( *_counter,
+                 CountSolutions( std::shared_ptr<const Sudoku::Puzzle>(
+                                     _puzzle ), 2u ) )
+        .Times( 2 )
+        .WillOnce( Return( 1u ) )
+        .WillOnce( Return( 2u ) );
+    EXPECT_CALL( *_commandExec, Execute(_) )
+        .Times( 0 );
+
+    EXPECT_EQ( 1u, controller.CountSolutions() );
+    EXPECT_FALSE( controller.HasUniqueSolution() );
+}
+
 }  // namespace
@@ -0,0 +1,130 @@
+#include "../PuzzleGenerator.h"
+#include "../MethodSolver.h"
+#include "../Puzzle.h"
+#include "../PuzzleMarker.h"
+#include "../SimpleValidator.h"
+#include "../SolutionMethodFactory.h"
+#include "../SolverHelper.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+class PuzzleGeneratorTest : public ::testing::Test
+{
+protected:
+    PuzzleGeneratorTest()
+    {
+    }
+
+    virtual ~PuzzleGeneratorTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    size_t CountGivens( const Sudoku::Grid &g )
+    {
+        size_t n = 0;
+        for ( size_t i = 0; i < Sudoku::Grid::ARRAY_SIZE; i++ )
+        {
+            if ( g[i].given )
+            {
+                EXPECT_NE( 0, g[i].value );
+                n++;
+            }
+            else
+            {
+                EXPECT_EQ( 0, g[i].value );
+            }
+        }
+        return n;
+    }
+
+    Sudoku::SolutionCounter _counter;
+};
+
+// Givens are part of the solution and have exactly one solution
+TEST_F( PuzzleGeneratorTest, MakesUniquePuzzles )
+{
+    Sudoku::PuzzleGenerator generator( 11 );
+    EXPECT_EQ( Sudoku::DIFFICULTY_EXPERT, generator.GetTarget() );
+    for ( size_t n = 0; n < 3; n++ )
+    {
+        Sudoku::Grid givens, solution;
+        generator.Generate( givens, &solution );
+        size_t count = CountGivens( givens );
+        EXPECT_GE( count, 17u );
+        EXPECT_LT( count, 40u );
+        EXPECT_EQ( 1u, _counter.CountSolutions( givens, 2 ) );
+        for ( size_t i = 0; i < Sudoku::Grid::ARRAY_SIZE; i++ )
+        {
+            if ( givens[i].given )
+            {
+                EXPECT_EQ( solution[i].value, givens[i].value );
+            }
+        }
+    }
+}
+
+// Same seed gives the same Puzzle
+TEST_F( PuzzleGeneratorTest, SeedIsReproducible )
+{
+    Sudoku::PuzzleGenerator a( 5 );
+    Sudoku::PuzzleGenerator b( 9 );
+    Sudoku::Grid ga, gb;
+    a.Generate( ga, NULL );
+    b.Seed( 5 );
+    b.Generate( gb, NULL );
+    EXPECT_TRUE( ga == gb );
+}
+
+// An easy Puzzle can be solved without the harder Methods
+TEST_F( PuzzleGeneratorTest, RespectsTargetDifficulty )
+{
+    Sudoku::PuzzleGenerator generator( 3, Sudoku::DIFFICULTY_EASY );
+    std::shared_ptr<Sudoku::Puzzle> p = generator.Generate();
+
+    std::shared_ptr<Sudoku::SolutionMethodFactory> factory(
+        new Sudoku::SolutionMethodFactory );
+    std::shared_ptr<Sudoku::IValidator> validator =
+        Sudoku::SimpleValidator::CreateGuessValidator();
+    Sudoku::MethodSolver solver(
+        std::shared_ptr<Sudoku::SolverHelper>(
+            new Sudoku::SolverHelper( factory ) ),
+        std::shared_ptr<Sudoku::IPuzzleMarker>( new Sudoku::PuzzleMarker ),
+        validator );
+    solver.SetMaxDifficulty( Sudoku::DIFFICULTY_EASY );
+    EXPECT_NO_THROW( solver.Solve( p ) );
+    EXPECT_TRUE( validator->IsValid( p ) );
+    // the hidden solution is what the solver found
+    EXPECT_TRUE( Sudoku::SimpleValidator::CreateCorrectValidator()->IsValid( p ) );
+    EXPECT_EQ( p->GetCell( 5, 5 )->GetCorrectValue(),
+               p->GetCell( 5, 5 )->DisplayedValue() );
+}
+
+// Batches do not depend on the number of threads
+TEST_F( PuzzleGeneratorTest, BatchIsDeterministic )
+{
+    std::vector<Sudoku::Grid> one =
+        Sudoku::PuzzleGenerator::GenerateBatch(
+            6, 77, Sudoku::DIFFICULTY_EXPERT, 1 );
+    std::vector<Sudoku::Grid> three =
+        Sudoku::PuzzleGenerator::GenerateBatch(
+            6, 77, Sudoku::DIFFICULTY_EXPERT, 3 );
+    ASSERT_EQ( 6u, one.size() );
+    ASSERT_EQ( 6u, three.size() );
+    for ( size_t n = 0; n < one.size(); n++ )
+    {
+        EXPECT_TRUE( one[n] == three[n] );
+        EXPECT_EQ( 1u, _counter.CountSolutions( one[n], 2 ) );
+    }
+    EXPECT_FALSE( one[0] == one[1] );
+}
+
+}  // namespace
@@ -1,4 +1,5 @@
 #include "../Puzzle.h"
+#include "MockCellObserver.h"
 #include "gtest/gtest.h"
 
 #include <algorithm>
@@ -62,7 +63,7 @@ TEST_F( PuzzleTest, GetCellPositionsCorrect )
 TEST_F( PuzzleTest, GetCellConstVersionSame )
 {
     Sudoku::Puzzle p;
-    const Sudoku::Puzzle const_p( p );
+    const Sudoku::Puzzle &const_p( p );
     for ( size_t x = 1; x < 10; x++ )
     {
         for ( size_t y = 1; y < 10; y++ )
@@ -76,7 +77,7 @@ TEST_F( PuzzleTest, GetCellConstVersionSame )
 TEST_F( PuzzleTest, GetCellFromConstWorks )
 {
     Sudoku::Puzzle p;
-    const Sudoku::Puzzle const_p( p );
+    const Sudoku::Puzzle &const_p( p );
     for ( size_t x = 1; x < 10; x++ )
     {
         for ( size_t y = 1; y < 10; y++ )
@@ -480,7 +481,7 @@ TEST_F( PuzzleTest, GetNeighborsContainsRowColBlock )
 TEST_F( PuzzleTest, GetNeighborsReturnsSameCellsConstNonConst )
 {
     Sudoku::Puzzle p;
-    const Sudoku::Puzzle cp( p );
+    const Sudoku::Puzzle &cp( p );
     for ( size_t x = 1; x < 10; x++ )
     {
         for ( size_t y = 1; y < 10; y++ )
@@ -606,4 +607,278 @@ TEST_F( PuzzleTest, AssignmentOperatorReturnsExactCopy )
     EXPECT_EQ( original, copy );
 }
 
+// Unit views hold the same Cells as the containers
+TEST_F( PuzzleTest, UnitViewsSameAsContainers )
+{
+    Sudoku::Puzzle p;
+    for ( size_t n = 1; n <= 9; n++ )
+    {
+        Sudoku::Puzzle::Container row = p.GetRow( n );
+        Sudoku::Puzzle::View rowView = p.GetRowView( n );
+        EXPECT_EQ( 9u, rowView.size() );
+        EXPECT_TRUE( std::equal( rowView.begin(), rowView.end(),
+                                 row.begin() ) );
+        Sudoku::Puzzle::Container col = p.GetCol( n );
+        Sudoku::Puzzle::View colView = p.GetColView( n );
+        EXPECT_TRUE( std::equal( colView.begin(), colView.end(),
+                                 col.begin() ) );
+    }
+    for ( size_t x = 1; x <= 3; x++ )
+    {
+        for ( size_t y = 1; y <= 3; y++ )
+        {
+            Sudoku::Puzzle::Container block = p.GetBlock( x, y );
+            Sudoku::Puzzle::View blockView = p.GetBlockView( x, y );
+            EXPECT_TRUE( std::equal( blockView.begin(), blockView.end(),
+                                     block.begin() ) );
+        }
+    }
+    EXPECT_ANY_THROW( p.GetRowView( 0 ) );
+    EXPECT_ANY_THROW( p.GetColView( 10 ) );
+    EXPECT_ANY_THROW( p.GetBlockView( 4, 1 ) );
+    EXPECT_ANY_THROW( p.GetUnitView( 27 ) );
+}
+
+// Peer views are the neighbors without the Cell itself
+TEST_F( PuzzleTest, PeerViewIsNeighborsWithoutCell )
+{
+    const Sudoku::Puzzle p;
+    for ( size_t x = 1; x <= 9; x++ )
+    {
+        for ( size_t y = 1; y <= 9; y++ )
+        {
+            Sudoku::Puzzle::ConstContainer N = p.GetNeighbors( x, y );
+            N.erase( p.GetCell( x, y ) );
+            Sudoku::Puzzle::ConstView peers = p.GetPeerView( x, y );
+            ASSERT_EQ( 20u, peers.size() );
+            EXPECT_TRUE( std::equal( peers.begin(), peers.end(),
+                                     N.begin() ) );
+        }
+    }
+    EXPECT_ANY_THROW( p.GetPeerView( 0, 1 ) );
+}
+
+// The all view walks every Cell in order
+TEST_F( PuzzleTest, AllViewSameAsAllCells )
+{
+    Sudoku::Puzzle p;
+    Sudoku::Puzzle::Container all = p.GetAllCells();
+    Sudoku::Puzzle::View view = p.GetAllView();
+    EXPECT_EQ( 81u, view.size() );
+    EXPECT_TRUE( std::equal( view.begin(), view.end(), all.begin() ) );
+    EXPECT_EQ( p.GetCell( 2, 3 ), view[19] );
+}
+
+// Randomize gives a hidden, valid solution which depends on the seed
+TEST_F( PuzzleTest, RandomizeMakesHiddenSolution )
+{
+    Sudoku::Puzzle p;
+    Modify( p );
+    p.Randomize( 5 );
+    for ( size_t u = 0; u < Sudoku::Units::UNIT_COUNT; u++ )
+    {
+        unsigned short seen = 0;
+        Sudoku::Puzzle::ConstView unit =
+            static_cast<const Sudoku::Puzzle&>( p ).GetUnitView( u );
+        for ( Sudoku::Puzzle::ConstView::iterator it = unit.begin();
+              it != unit.end();
+              ++it )
+        {
+            EXPECT_TRUE( (*it)->CanGuess() );
+            EXPECT_EQ( 0, (*it)->DisplayedValue() );
+            EXPECT_FALSE( (*it)->GetMarkContainer().any() );
+            seen |= 1 << (*it)->GetCorrectValue();
+        }
+        EXPECT_EQ( 0x3FE, seen );
+    }
+
+    Sudoku::Puzzle same;
+    same.Randomize( 5 );
+    EXPECT_EQ( p.GetCell( 4, 4 )->GetCorrectValue(),
+               same.GetCell( 4, 4 )->GetCorrectValue() );
+    EXPECT_NO_THROW( same.Randomize() );
+}
+
+// Cells changed in a transaction notify once when it ends
+TEST_F( PuzzleTest, ChangeTransactionCoalesces )
+{
+    std::shared_ptr<Sudoku::Puzzle> p( new Sudoku::Puzzle );
+    std::shared_ptr<Sudoku::MockCellObserver> observer(
+        new Sudoku::MockCellObserver );
+    std::shared_ptr<Sudoku::Cell> a = p->GetCell( 1, 1 );
+    std::shared_ptr<Sudoku::Cell> b = p->GetCell( 9, 2 );
+    a->AddObserver( observer );
+    b->AddObserver( observer );
+    p->GetCell( 5, 5 )->AddObserver( observer );
+
+    EXPECT_FALSE( p->IsChanging() );
+    {
+        Sudoku::Puzzle::ChangeTransaction changes( p );
+        EXPECT_TRUE( p->IsChanging() );
+        // nothing is heard while changing
+        EXPECT_CALL( *observer, Update( ::testing::_ ) ).Times( 0 );
+        a->SetGuess( 3 );
+        a->Mark( 4 );
+        a->Unmark( 4 );
+        b->SetCorrect( 7 );
+        p->GetCell( 2, 2 )->SetGuess( 1 );
+        ::testing::Mock::VerifyAndClearExpectations( observer.get() );
+
+        EXPECT_CALL( *observer, Update( ::testing::Ref( *a ) ) ).Times( 1 );
+        EXPECT_CALL( *observer, Update( ::testing::Ref( *b ) ) ).Times( 1 );
+    }
+    EXPECT_FALSE( p->IsChanging() );
+    ::testing::Mock::VerifyAndClearExpectations( observer.get() );
+
+    // back to notifying right away
+    EXPECT_CALL( *observer, Update( ::testing::Ref( *a ) ) ).Times( 1 );
+    a->SetGuess( 4 );
+}
+
+// Only the outermost transaction notifies and reports the changed Cells
+TEST_F( PuzzleTest, ChangeTransactionsNest )
+{
+    Sudoku::Puzzle p;
+    EXPECT_THROW( p.EndChanges(), std::logic_error );
+    p.BeginChanges();
+    p.BeginChanges();
+    p.GetCell( 2, 1 )->SetGuess( 5 );
+    EXPECT_TRUE( p.EndChanges().Empty() );
+    EXPECT_TRUE( p.IsChanging() );
+    p.GetCell( 3, 4 )->Mark( 2 );
+    Sudoku::Bitboard changed = p.EndChanges();
+    EXPECT_EQ( 2u, changed.Count() );
+    EXPECT_TRUE( changed.Test( 1 ) );
+    EXPECT_TRUE( changed.Test( 29 ) );
+    EXPECT_FALSE( p.IsChanging() );
+
+    std::shared_ptr<Sudoku::Puzzle> shared( new Sudoku::Puzzle );
+    Sudoku::Puzzle::ChangeTransaction changes( shared );
+    shared->GetCell( 1, 1 )->SetGuess( 1 );
+    EXPECT_EQ( 1u, changes.End().Count() );
+    EXPECT_TRUE( changes.End().Empty() );
+    EXPECT_FALSE( shared->IsChanging() );
+    EXPECT_THROW( Sudoku::Puzzle::ChangeTransaction(
+                      std::shared_ptr<Sudoku::Puzzle>() ),
+                  std::runtime_error );
+}
+
+// Changes can be taken step by step, the end still reports them all
+TEST_F( PuzzleTest, TakeChangesSinceLastCall )
+{
+    Sudoku::Puzzle p;
+    EXPECT_THROW( p.TakeChanges(), std::logic_error );
+    p.BeginChanges();
+    p.GetCell( 2, 1 )->SetGuess( 5 );
+    Sudoku::Bitboard first = p.TakeChanges();
+    EXPECT_EQ( 1u, first.Count() );
+    EXPECT_TRUE( first.Test( 1 ) );
+    EXPECT_TRUE( p.TakeChanges().Empty() );
+
+    // the same Cell again is reported again
+    p.GetCell( 2, 1 )->Mark( 3 );
+    p.GetCell( 3, 4 )->Mark( 2 );
+    Sudoku::Bitboard second = p.TakeChanges();
+    EXPECT_EQ( 2u, second.Count() );
+    EXPECT_TRUE( second.Test( 1 ) );
+    EXPECT_TRUE( second.Test( 29 ) );
+
+    p.GetCell( 9, 9 )->Mark( 1 );
+    Sudoku::Bitboard changed = p.EndChanges();
+    EXPECT_EQ( 3u, changed.Count() );
+    EXPECT_TRUE( changed.Test( 80 ) );
+}
+
+// Copies do not share Cells
+TEST_F( PuzzleTest, CopyIsIndependent )
+{
+    Sudoku::Puzzle original;
+    Modify( original );
+    Sudoku::Puzzle copy( original );
+    original.GetCell( 2, 2 )->Mark( 7 );
+    EXPECT_FALSE( copy.GetCell( 2, 2 )->GetMarkContainer()[7] );
+    EXPECT_NE( original.GetCell( 2, 2 ), copy.GetCell( 2, 2 ) );
+
+    // assigning keeps the Cells (and their observers)
+    std::shared_ptr<Sudoku::Cell> cell = copy.GetCell( 2, 2 );
+    copy = original;
+    EXPECT_EQ( cell, copy.GetCell( 2, 2 ) );
+    EXPECT_EQ( original, copy );
+}
+
+// Restoring a snapshot puts back only the Cells which changed
+TEST_F( PuzzleTest, SnapshotRestore )
+{
+    std::shared_ptr<Sudoku::Puzzle> p( new Sudoku::Puzzle );
+    Modify( *p );
+    Sudoku::Puzzle before( *p );
+    std::shared_ptr<const Sudoku::PuzzleSnapshot> s = p->TakeSnapshot();
+    EXPECT_TRUE( s->IsValid() );
+    EXPECT_TRUE( p->ChangedSince( s ).Empty() );
+
+    p->GetCell( 1, 2 )->SetCorrect( 9 );
+    p->GetCell( 1, 2 )->SetCorrect( 8 );
+    p->GetCell( 4, 3 )->Mark( 1 );
+    Sudoku::Bitboard changed = p->ChangedSince( s );
+    EXPECT_EQ( 2u, changed.Count() );
+    EXPECT_TRUE( changed.Test( 9 ) );
+    EXPECT_TRUE( changed.Test( 21 ) );
+
+    std::shared_ptr<Sudoku::MockCellObserver> observer(
+        new Sudoku::MockCellObserver );
+    for ( size_t x = 1; x <= 9; x++ )
+    {
+        p->GetCell( x, 2 )->AddObserver( observer );
+    }
+    EXPECT_CALL( *observer, Update( ::testing::Ref( *p->GetCell( 1, 2 ) ) ) )
+        .Times( 1 );
+    p->Restore( s );
+    EXPECT_EQ( before, *p );
+    ::testing::Mock::VerifyAndClearExpectations( observer.get() );
+
+    // the snapshot can be used again
+    EXPECT_TRUE( s->IsValid() );
+    p->GetCell( 4, 3 )->Unmark( 3 );
+    p->Restore( s );
+    EXPECT_EQ( before, *p );
+
+    Sudoku::Puzzle other;
+    EXPECT_THROW( other.Restore( s ), std::logic_error );
+    EXPECT_THROW( p->Restore( std::shared_ptr<const Sudoku::PuzzleSnapshot>() ),
+                  std::logic_error );
+}
+
+// Snapshots stack, restoring an old one drops the newer ones
+TEST_F( PuzzleTest, NestedSnapshots )
+{
+    Sudoku::Puzzle p;
+    Sudoku::Puzzle first( p );
+    std::shared_ptr<const Sudoku::PuzzleSnapshot> a = p.TakeSnapshot();
+    p.GetCell( 1, 1 )->SetGuess( 1 );
+    Sudoku::Puzzle second( p );
+    std::shared_ptr<const Sudoku::PuzzleSnapshot> b = p.TakeSnapshot();
+    p.GetCell( 1, 1 )->SetGuess( 2 );
+    p.GetCell( 2, 1 )->SetGuess( 3 );
+    std::shared_ptr<const Sudoku::PuzzleSnapshot> c = p.TakeSnapshot();
+    p.GetCell( 3, 1 )->SetGuess( 4 );
+
+    // dropping the middle one keeps what the older one needs
+    b.reset();
+    EXPECT_EQ( 3u, p.ChangedSince( a ).Count() );
+    p.Restore( a );
+    EXPECT_EQ( first, p );
+    EXPECT_FALSE( c->IsValid() );
+    EXPECT_THROW( p.Restore( c ), std::logic_error );
+    EXPECT_THROW( p.ChangedSince( c ), std::logic_error );
+
+    p.GetCell( 1, 1 )->SetGuess( 1 );
+    b = p.TakeSnapshot();
+    EXPECT_EQ( second, p );
+    p.GetCell( 1, 1 )->SetGuess( 5 );
+    p.Restore( b );
+    EXPECT_EQ( second, p );
+    p.Restore( a );
+    EXPECT_EQ( first, p );
+}
+
 }  // namespace
@@ -1,7 +1,11 @@
+#include "../MappedGridImporter.h"
 #include "../SimpleValidator.h"
 #include "../Puzzle.h"
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace {
 
 class SimpleValidatorTest : public ::testing::Test
@@ -78,6 +82,18 @@ protected:
         }
     }
 
+    // the same values as MakeCorrect, packed in index order
+    void MakeCorrectValues( unsigned char *values )
+    {
+        for ( size_t i = 0; i < 9; i++ )
+        {
+            for ( size_t j = 0; j < 9; j++ )
+            {
+                values[j * 9 + i] = (i * 3 + i / 3 + j) % 9 + 1;
+            }
+        }
+    }
+
     std::shared_ptr<Sudoku::Puzzle> _puzzle;
     std::shared_ptr<Sudoku::SimpleValidator> _validator;
 };
@@ -146,4 +162,52 @@ TEST_F( SimpleValidatorTest , GuessValidatorReturnsFalseIfOneCellChanged )
     EXPECT_FALSE( _validator->IsValid( _puzzle ) );
 }
 
+//////////////// Packed values
+
+// Test the kernel on packed values, including values out of range
+TEST_F( SimpleValidatorTest , PackedValues )
+{
+    unsigned char values[81];
+    MakeCorrectValues( values );
+    EXPECT_TRUE( Sudoku::SimpleValidator::IsValid( values ) );
+
+    // swapping two values in a row keeps rows valid but breaks columns
+    std::swap( values[0], values[1] );
+    EXPECT_FALSE( Sudoku::SimpleValidator::IsValid( values ) );
+    std::swap( values[0], values[1] );
+
+    values[40] = 0;
+    EXPECT_FALSE( Sudoku::SimpleValidator::IsValid( values ) );
+    MakeCorrectValues( values );
+    unsigned char v = values[40];
+    values[40] = v + 16;
+    EXPECT_FALSE( Sudoku::SimpleValidator::IsValid( values ) );
+    values[40] = 10;
+    EXPECT_FALSE( Sudoku::SimpleValidator::IsValid( values ) );
+}
+
+// Test the batch entry point on an array of GridRecords
+TEST_F( SimpleValidatorTest , BatchOfRecords )
+{
+    ASSERT_EQ( 81u, sizeof( Sudoku::GridRecord ) );
+    std::vector<Sudoku::GridRecord> records( 5 );
+    for ( size_t g = 0; g < records.size(); g++ )
+    {
+        MakeCorrectValues( records[g].values );
+    }
+    records[1].values[7] = 0;
+    records[3].values[80] = records[3].values[79];
+
+    unsigned char results[5];
+    EXPECT_EQ( 3u, Sudoku::SimpleValidator::IsValid(
+                   records[0].values, records.size(), results ) );
+    EXPECT_EQ( 1, results[0] );
+    EXPECT_EQ( 0, results[1] );
+    EXPECT_EQ( 1, results[2] );
+    EXPECT_EQ( 0, results[3] );
+    EXPECT_EQ( 1, results[4] );
+    EXPECT_EQ( 3u, Sudoku::SimpleValidator::IsValid(
+                   records[0].values, records.size(), NULL ) );
+}
+
 }  // namespace
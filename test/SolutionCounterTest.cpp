@@ -0,0 +1,94 @@
+#include "../SolutionCounter.h"
+#include "../Grid.h"
+#include "../Puzzle.h"
+#include "TestGrids.h"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+using Sudoku::TestGrids::HARD;
+using Sudoku::TestGrids::MakeGrid;
+
+class SolutionCounterTest : public ::testing::Test
+{
+protected:
+    SolutionCounterTest()
+    {
+        _puzzle.reset( new Sudoku::Puzzle );
+        _counter.reset( new Sudoku::SolutionCounter );
+    }
+
+    virtual ~SolutionCounterTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    std::shared_ptr<Sudoku::Puzzle> _puzzle;
+    std::shared_ptr<Sudoku::ISolutionCounter> _counter;
+};
+
+// A proper puzzle has exactly one solution
+TEST_F( SolutionCounterTest, UniquePuzzle )
+{
+    MakeGrid( HARD ).CopyTo( *_puzzle );
+    EXPECT_EQ( 1u, _counter->CountSolutions( _puzzle, 2 ) );
+    EXPECT_EQ( 1u, _counter->CountSolutions( MakeGrid( HARD ), 2 ) );
+}
+
+// Counting stops at the limit
+TEST_F( SolutionCounterTest, StopsAtLimit )
+{
+    EXPECT_EQ( 2u, _counter->CountSolutions( _puzzle, 2 ) );
+    EXPECT_EQ( 10u, _counter->CountSolutions( _puzzle, 10 ) );
+
+    // removing a given from a proper puzzle opens it up
+    std::string loose( HARD );
+    loose[0] = '0';
+    EXPECT_EQ( 2u, _counter->CountSolutions( MakeGrid( loose ), 2 ) );
+}
+
+// Conflicting givens have no solution
+TEST_F( SolutionCounterTest, NoSolution )
+{
+    std::string bad( HARD );
+    bad[1] = '8';
+    EXPECT_EQ( 0u, _counter->CountSolutions( MakeGrid( bad ), 2 ) );
+
+    // consistent givens can still be a dead end
+    std::string dead( HARD );
+    dead[1] = '2';
+    EXPECT_EQ( 0u, _counter->CountSolutions( MakeGrid( dead ), 2 ) );
+}
+
+// Guesses and hidden correct values are not givens
+TEST_F( SolutionCounterTest, OnlyGivensCount )
+{
+    MakeGrid( HARD ).CopyTo( *_puzzle );
+    _puzzle->GetCell( 2, 1 )->SetGuess( 8 );
+    _puzzle->GetCell( 3, 1 )->SetCorrect( 8 );
+    EXPECT_EQ( 1u, _counter->CountSolutions( _puzzle, 2 ) );
+
+    Sudoku::Grid g = MakeGrid( HARD );
+    g[1].value = 8;
+    EXPECT_EQ( 1u, _counter->CountSolutions( g, 2 ) );
+}
+
+// The Puzzle is required
+TEST_F( SolutionCounterTest, ThrowsOnNull )
+{
+    EXPECT_THROW( _counter->CountSolutions(
+                      std::shared_ptr<const Sudoku::Puzzle>(), 2 ),
+                  std::runtime_error );
+}
+
+}  // namespace
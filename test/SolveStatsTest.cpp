@@ -0,0 +1,75 @@
+#include "../SolveStats.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+class SolveStatsTest : public ::testing::Test
+{
+protected:
+    SolveStatsTest()
+    {
+    }
+
+    virtual ~SolveStatsTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    Sudoku::SolveStats _stats;
+};
+
+// Everything starts at 0
+TEST_F( SolveStatsTest, ZeroByDefault )
+{
+    for ( size_t k = 0; k < Sudoku::PropagationQueue::RULE_COUNT; k++ )
+    {
+        const Sudoku::SolveStats::Method &m = _stats.methods[k];
+        EXPECT_EQ( 0u, m.runs + m.found + m.verified + m.executed +
+                   m.eliminated );
+        EXPECT_EQ( 0u, m.findNanos + m.executeNanos );
+    }
+    EXPECT_EQ( 0u, _stats.passes );
+    EXPECT_EQ( 0u, _stats.validations );
+}
+
+// Adding sums every counter, Reset clears them again
+TEST_F( SolveStatsTest, AddSumsAndResetClears )
+{
+    Sudoku::SolveStats other;
+    other.methods[Sudoku::PropagationQueue::FISH].found = 3;
+    other.methods[Sudoku::PropagationQueue::FISH].executeNanos = 100;
+    other.passes = 7;
+    other.validations = 1;
+    _stats += other;
+    _stats += other;
+    EXPECT_EQ( 6u, _stats.methods[Sudoku::PropagationQueue::FISH].found );
+    EXPECT_EQ( 200u,
+               _stats.methods[Sudoku::PropagationQueue::FISH].executeNanos );
+    EXPECT_EQ( 14u, _stats.passes );
+    EXPECT_EQ( 2u, _stats.validations );
+
+    _stats.Reset();
+    EXPECT_EQ( 0u, _stats.methods[Sudoku::PropagationQueue::FISH].found );
+    EXPECT_EQ( 0u, _stats.passes );
+}
+
+// Every kind of Method has a name
+TEST_F( SolveStatsTest, NamesMethods )
+{
+    EXPECT_STREQ( "single_candidate", Sudoku::SolveStats::GetName(
+                      Sudoku::PropagationQueue::SINGLE_CANDIDATE ) );
+    EXPECT_STREQ( "chain", Sudoku::SolveStats::GetName(
+                      Sudoku::PropagationQueue::CHAIN ) );
+    EXPECT_THROW( Sudoku::SolveStats::GetName(
+                      Sudoku::PropagationQueue::RULE_COUNT ),
+                  std::invalid_argument );
+}
+
+}  // namespace
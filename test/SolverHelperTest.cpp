@@ -1,4 +1,5 @@
 #include "../SolverHelper.h"
+#include "../LinkGraph.h"
 #include "../PuzzleMarker.h"
 #include "MockSolutionMethodFactory.h"
 #include "gtest/gtest.h"
@@ -29,6 +30,12 @@ protected:
             .WillByDefault( Return( _method ) );
         ON_CALL( *_factory, CreateCoveringSetMethod(_,_) )
             .WillByDefault( Return( _method ) );
+        ON_CALL( *_factory, CreateHiddenSingleMethod(_,_,_) )
+            .WillByDefault( Return( _method ) );
+        ON_CALL( *_factory, CreateFishMethod(_,_,_,_) )
+            .WillByDefault( Return( _method ) );
+        ON_CALL( *_factory, CreateChainMethod(_,_) )
+            .WillByDefault( Return( _method ) );
     }
 
     virtual ~SolverHelperTest()
@@ -143,6 +150,57 @@ TEST_F( SolverHelperTest, ExclusionDoesNotReturnGuessedCellIfNeighborsUnmark )
     EXPECT_TRUE( m.empty() );
 }
 
+///////////// Hidden Single Method
+
+TEST_F( SolverHelperTest, HiddenSingleReturnsNothingIfAllMarked )
+{
+    EXPECT_CALL( *_factory, CreateHiddenSingleMethod(_,_,_) )
+        .Times( 0 );
+    _marker->UpdateMarks( _puzzle );
+    Sudoku::SolverHelper::MethodContainer m =
+        _helper->GetAllHiddenSingle( _puzzle );
+    EXPECT_TRUE( m.empty() );
+}
+
+// A Cell hidden in its row and its block is only returned once
+TEST_F( SolverHelperTest, HiddenSingleReturnsCellOnce )
+{
+    _marker->UpdateMarks( _puzzle );
+    std::shared_ptr<Sudoku::Cell> c = _puzzle->GetCell( 4, 1 );
+    for ( size_t x = 1; x <= 9; x++ )
+    {
+        _puzzle->GetCell( x, 1 )->Unmark( 5 );
+        _puzzle->GetCell( 4 + ( x - 1 ) % 3, 1 + ( x - 1 ) / 3 )->Unmark( 5 );
+    }
+    c->Mark( 5 );
+    EXPECT_CALL( *_factory, CreateHiddenSingleMethod( c, 5u, _ ) )
+        .Times( 1 );
+
+    Sudoku::SolverHelper::MethodContainer m =
+        _helper->GetAllHiddenSingle( _puzzle );
+    EXPECT_EQ( 1u, m.size() );
+    m = _helper->GetAllHiddenSingle( _puzzle, Sudoku::Units::Col( 4 ) );
+    EXPECT_TRUE( m.empty() );
+}
+
+// A value already in the unit is not hidden
+TEST_F( SolverHelperTest, HiddenSingleIgnoresPlacedValue )
+{
+    _marker->UpdateMarks( _puzzle );
+    for ( size_t y = 1; y <= 9; y++ )
+    {
+        _puzzle->GetCell( 2, y )->Unmark( 7 );
+    }
+    _puzzle->GetCell( 2, 3 )->Mark( 7 );
+    _puzzle->GetCell( 2, 8 )->SetGuess( 7 );
+    EXPECT_CALL( *_factory, CreateHiddenSingleMethod(_,_,_) )
+        .Times( 0 );
+
+    Sudoku::SolverHelper::MethodContainer m =
+        _helper->GetAllHiddenSingle( _puzzle, Sudoku::Units::Col( 2 ) );
+    EXPECT_TRUE( m.empty() );
+}
+
 ///////////// Block Intersection Method
 
 TEST_F( SolverHelperTest, BlockIntersectionReturnsNothingDefault )
@@ -335,4 +393,137 @@ TEST_F( SolverHelperTest, CoveringSetJoinsGroupsOfFour )
 }
 
 
+TEST_F( SolverHelperTest, CoveringSetFindsHiddenPair )
+{
+    // 1 and 2 are only on the first two, so the other 7 make a covering set
+    Sudoku::Puzzle::Container sector = _puzzle->GetRow( 4 );
+    Sudoku::Puzzle::Container::iterator it = sector.begin();
+    (*it)->Mark( 1 );
+    (*it)->Mark( 2 );
+    (*it)->Mark( 3 );
+    ++it;
+    (*it)->Mark( 1 );
+    (*it)->Mark( 2 );
+    (*it)->Mark( 9 );
+    for ( ++it; it != sector.end(); ++it )
+    {
+        for ( int v = 3; v <= 9; v++ )
+        {
+            (*it)->Mark( v );
+        }
+    }
+
+    EXPECT_CALL( *_factory, CreateCoveringSetMethod(_,_) )
+        .Times( 0 );
+    EXPECT_CALL( *_factory, CreateCoveringSetMethod(
+                     ContainerEq(sector),
+                     Property( &Sudoku::Puzzle::Container::size, 7 ) ) )
+        .Times( 1 );
+
+    Sudoku::SolverHelper::MethodContainer m =
+        _helper->GetAllCoveringSet( _puzzle, sector );
+    EXPECT_EQ( 1u, m.size() );
+}
+
+TEST_F( SolverHelperTest, CoveringSetByUnitPassesWholeUnit )
+{
+    Sudoku::Puzzle::Container sector = _puzzle->GetBlock( 1, 2 );
+    Sudoku::Puzzle::Container::iterator it = sector.begin();
+    (*it)->Mark( 1 );
+    (*it)->Mark( 2 );
+    ++it;
+    (*it)->Mark( 1 );
+    (*it)->Mark( 2 );
+    ++it;
+    (*it)->Mark( 1 );
+    (*it)->Mark( 3 );
+
+    EXPECT_CALL( *_factory, CreateCoveringSetMethod(_,_) )
+        .Times( 0 );
+    EXPECT_CALL( *_factory, CreateCoveringSetMethod(
+                     ContainerEq(sector),
+                     Property( &Sudoku::Puzzle::Container::size, 2 ) ) )
+        .Times( 1 );
+
+    Sudoku::SolverHelper::MethodContainer m =
+        _helper->GetAllCoveringSet( _puzzle, Sudoku::Units::Block( 1, 2 ) );
+    EXPECT_EQ( 1u, m.size() );
+}
+
+///////////// Fish Method
+
+TEST_F( SolverHelperTest, FishReturnsNothingIfAllMarked )
+{
+    EXPECT_CALL( *_factory, CreateFishMethod(_,_,_,_) )
+        .Times( 0 );
+    _marker->UpdateMarks( _puzzle );
+    Sudoku::SolverHelper::MethodContainer m = _helper->GetAllFish( _puzzle );
+    EXPECT_TRUE( m.empty() );
+}
+
+TEST_F( SolverHelperTest, FishReturnsXWing )
+{
+    _marker->UpdateMarks( _puzzle );
+    for ( size_t x = 2; x <= 9; x++ )
+    {
+        if ( x != 8 )
+        {
+            _puzzle->GetCell( x, 2 )->Unmark( 3 );
+            _puzzle->GetCell( x, 6 )->Unmark( 3 );
+        }
+    }
+    Sudoku::Bitboard rows =
+        Sudoku::Units::UNIT_BOARDS[Sudoku::Units::Row( 2 )] |
+        Sudoku::Units::UNIT_BOARDS[Sudoku::Units::Row( 6 )];
+    Sudoku::Bitboard cols =
+        Sudoku::Units::UNIT_BOARDS[Sudoku::Units::Col( 1 )] |
+        Sudoku::Units::UNIT_BOARDS[Sudoku::Units::Col( 8 )];
+
+    EXPECT_CALL( *_factory, CreateFishMethod(_,_,_,_) )
+        .Times( 0 );
+    EXPECT_CALL( *_factory, CreateFishMethod( _puzzle, 3u, rows, cols ) )
+        .Times( 1 );
+
+    Sudoku::SolverHelper::MethodContainer m = _helper->GetAllFish( _puzzle );
+    EXPECT_EQ( 1u, m.size() );
+    // only the digits asked for are looked at
+    m = _helper->GetAllFish( _puzzle, 0x1FF & ~( 1 << 2 ) );
+    EXPECT_TRUE( m.empty() );
+}
+
+///////////// Chain Method
+
+TEST_F( SolverHelperTest, ChainReturnsXYWing )
+{
+    // pivot 12 at (1,1), wings 13 at (4,1) and 23 at (1,3), so (5,3)
+    // cannot have 3
+    _puzzle->GetCell( 1, 1 )->Mark( 1 );
+    _puzzle->GetCell( 1, 1 )->Mark( 2 );
+    _puzzle->GetCell( 4, 1 )->Mark( 1 );
+    _puzzle->GetCell( 4, 1 )->Mark( 3 );
+    _puzzle->GetCell( 1, 3 )->Mark( 2 );
+    _puzzle->GetCell( 1, 3 )->Mark( 3 );
+    _puzzle->GetCell( 5, 3 )->Mark( 3 );
+    _puzzle->GetCell( 5, 3 )->Mark( 4 );
+    _puzzle->GetCell( 5, 3 )->Mark( 5 );
+    unsigned short candidates[Sudoku::Units::CELL_COUNT];
+    for ( size_t i = 0; i < Sudoku::Units::CELL_COUNT; i++ )
+    {
+        candidates[i] = ( _puzzle->GetCell( i % 9 + 1, i / 9 + 1 )
+                          ->GetMarkContainer().to_ulong() >> 1 ) & 0x1FF;
+    }
+    Sudoku::LinkGraph graph;
+    graph.Update( candidates );
+
+    EXPECT_CALL( *_factory, CreateChainMethod(_,_) )
+        .Times( 1 );
+
+    Sudoku::SolverHelper::MethodContainer m = _helper->GetAllChains(
+        _puzzle, graph, Sudoku::Chains::XY_WING, 0x1FF );
+    EXPECT_EQ( 1u, m.size() );
+    // nothing changed, nothing to look at
+    m = _helper->GetAllChains( _puzzle, graph, Sudoku::Chains::XY_WING, 0 );
+    EXPECT_TRUE( m.empty() );
+}
+
 }  // namespace
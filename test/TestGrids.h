@@ -0,0 +1,51 @@
+#ifndef SUDOKU_TEST_GRIDS_H
+#define SUDOKU_TEST_GRIDS_H
+
+#include <string>
+
+#include "../Grid.h"
+
+namespace Sudoku
+{
+
+/**
+ * Puzzles shared by the tests, as 81 digits with 0 for blank
+ */
+namespace TestGrids
+{
+
+/// Solved by singles alone
+const char * const EASY =
+    "003020600900305001001806400008102900700000008"
+    "006708200002609500800203009005010300";
+const char * const EASY_SOLUTION =
+    "483921657967345821251876493548132976729564138"
+    "136798245372689514814253769695417382";
+
+/// Needs more than the logical Methods (a guess) to finish
+const char * const HARD =
+    "800000000003600000070090200050007000000045700"
+    "000100030001000068008500010090000400";
+const char * const HARD_SOLUTION =
+    "812753649943682175675491283154237896369845721"
+    "287169534521974368438526917796318452";
+
+/**
+ * Load 81 digits (0 for blank) as givens
+ */
+inline Grid MakeGrid( const std::string &s )
+{
+    Grid g;
+    for ( size_t i = 0; i < Grid::ARRAY_SIZE; i++ )
+    {
+        g[i].value = s[i] - '0';
+        g[i].given = ( g[i].value != 0 );
+    }
+    return g;
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,151 @@
+#include "../UndoHistory.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <stdexcept>
+
+namespace {
+
+class UndoHistoryTest : public ::testing::Test
+{
+protected:
+    typedef Sudoku::UndoHistory::DeltaContainer DeltaContainer;
+
+    UndoHistoryTest()
+    {
+    }
+
+    virtual ~UndoHistoryTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    /**
+     * A step changing count Cells, tagged so steps can be told apart
+     */
+    DeltaContainer MakeStep( size_t count, Sudoku::Cell::State tag )
+    {
+        DeltaContainer step;
+        for ( size_t i = 0; i < count; i++ )
+        {
+            step.push_back( Sudoku::UndoHistory::MakeDelta( i, tag, tag + 1 ) );
+        }
+        return step;
+    }
+};
+
+// Make sure a delta keeps all of its parts
+TEST_F( UndoHistoryTest, DeltaPacking )
+{
+    Sudoku::UndoHistory::Delta d =
+        Sudoku::UndoHistory::MakeDelta( 80, 0x7FFFF, 0x40201 );
+    EXPECT_EQ( 80u, Sudoku::UndoHistory::GetIndex( d ) );
+    EXPECT_EQ( 0x7FFFFu, Sudoku::UndoHistory::GetBefore( d ) );
+    EXPECT_EQ( 0x40201u, Sudoku::UndoHistory::GetAfter( d ) );
+}
+
+// Make sure steps come back in order and recording clears redo
+TEST_F( UndoHistoryTest, UndoRedo )
+{
+    Sudoku::UndoHistory h;
+    DeltaContainer out;
+    EXPECT_FALSE( h.CanUndo() );
+    EXPECT_FALSE( h.Undo( out ) );
+
+    h.Record( MakeStep( 3, 10 ) );
+    h.Record( DeltaContainer() );
+    h.Record( MakeStep( 2, 20 ) );
+    EXPECT_EQ( 3u, h.CountUndo() );
+
+    ASSERT_TRUE( h.Undo( out ) );
+    EXPECT_EQ( MakeStep( 2, 20 ), out );
+    ASSERT_TRUE( h.Undo( out ) );
+    EXPECT_TRUE( out.empty() );
+    EXPECT_TRUE( h.CanRedo() );
+    ASSERT_TRUE( h.Redo( out ) );
+    EXPECT_TRUE( out.empty() );
+    EXPECT_EQ( 1u, h.CountRedo() );
+
+    h.Record( MakeStep( 1, 30 ) );
+    EXPECT_FALSE( h.CanRedo() );
+    ASSERT_TRUE( h.Undo( out ) );
+    EXPECT_EQ( MakeStep( 1, 30 ), out );
+    ASSERT_TRUE( h.Undo( out ) );
+    ASSERT_TRUE( h.Undo( out ) );
+    EXPECT_EQ( MakeStep( 3, 10 ), out );
+    EXPECT_FALSE( h.CanUndo() );
+}
+
+// Make sure old steps are dropped to stay under the cap
+TEST_F( UndoHistoryTest, EvictsOldestAtCap )
+{
+    Sudoku::UndoHistory h( Sudoku::UndoHistory::MIN_MAX_BYTES );
+    for ( Sudoku::Cell::State tag = 0; tag < 100; tag++ )
+    {
+        h.Record( MakeStep( 30, tag ) );
+        EXPECT_LE( h.GetMemoryUsage(), h.GetMaxBytes() );
+    }
+    EXPECT_LT( h.CountUndo(), 100u );
+    EXPECT_GT( h.CountUndo(), 0u );
+
+    // the newest steps survive, even where they wrap around the ring
+    DeltaContainer out;
+    for ( Sudoku::Cell::State tag = 99; h.Undo( out ); tag-- )
+    {
+        EXPECT_EQ( MakeStep( 30, tag ), out );
+    }
+}
+
+// Make sure a full step fits the smallest cap and smaller caps are refused
+TEST_F( UndoHistoryTest, MinimumCap )
+{
+    EXPECT_THROW( Sudoku::UndoHistory h(
+                      Sudoku::UndoHistory::MIN_MAX_BYTES - 1 ),
+                  std::invalid_argument );
+    Sudoku::UndoHistory h( Sudoku::UndoHistory::MIN_MAX_BYTES );
+    h.Record( MakeStep( 81, 1 ) );
+    h.Record( MakeStep( 81, 2 ) );
+    EXPECT_EQ( 1u, h.CountUndo() );
+}
+
+// Make sure spilled steps come back from the file
+TEST_F( UndoHistoryTest, SpillsToFile )
+{
+    const char *filename = "undo_history_test.spill";
+    {
+        Sudoku::UndoHistory h( Sudoku::UndoHistory::MIN_MAX_BYTES );
+        h.SetSpillFile( filename );
+        for ( Sudoku::Cell::State tag = 0; tag < 50; tag++ )
+        {
+            h.Record( MakeStep( tag % 7 == 0 ? 0 : 40, tag ) );
+        }
+        EXPECT_GT( h.CountSpilled(), 0u );
+        EXPECT_EQ( 50u, h.CountUndo() );
+
+        DeltaContainer out;
+        for ( Sudoku::Cell::State tag = 50; tag-- > 0; )
+        {
+            ASSERT_TRUE( h.Undo( out ) );
+            EXPECT_EQ( MakeStep( tag % 7 == 0 ? 0 : 40, tag ), out );
+        }
+        // steps read back can be redone
+        ASSERT_TRUE( h.Redo( out ) );
+        EXPECT_EQ( MakeStep( 0, 0 ), out );
+        ASSERT_TRUE( h.Redo( out ) );
+        EXPECT_EQ( MakeStep( 40, 1 ), out );
+        ASSERT_TRUE( h.Undo( out ) );
+        ASSERT_TRUE( h.Undo( out ) );
+        EXPECT_FALSE( h.CanUndo() );
+        EXPECT_LE( h.GetMemoryUsage(), h.GetMaxBytes() );
+    }
+    std::remove( filename );
+}
+
+}  // namespace
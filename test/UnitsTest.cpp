@@ -0,0 +1,115 @@
+#include "../Units.h"
+#include "gtest/gtest.h"
+
+#include <set>
+
+namespace {
+
+class UnitsTest : public ::testing::Test
+{
+protected:
+    UnitsTest()
+    {
+    }
+
+    virtual ~UnitsTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    size_t Row( size_t i ) { return i / 9; }
+    size_t Col( size_t i ) { return i % 9; }
+    size_t Block( size_t i ) { return ( Row( i ) / 3 ) * 3 + Col( i ) / 3; }
+};
+
+// Each unit holds the cells of one row, column, or block in sorted order
+TEST_F( UnitsTest, UnitCellsMatchGeometry )
+{
+    for ( size_t u = 0; u < 27; u++ )
+    {
+        for ( size_t i = 0; i < 9; i++ )
+        {
+            size_t cell = Sudoku::Units::UNIT_CELLS[u][i];
+            if ( u < 9 )
+            {
+                EXPECT_EQ( u, Row( cell ) );
+            }
+            else if ( u < 18 )
+            {
+                EXPECT_EQ( u - 9, Col( cell ) );
+            }
+            else
+            {
+                EXPECT_EQ( u - 18, Block( cell ) );
+            }
+            if ( i > 0 )
+            {
+                EXPECT_LT( Sudoku::Units::UNIT_CELLS[u][i - 1], cell );
+            }
+        }
+    }
+}
+
+// Each cell knows its row, column and block
+TEST_F( UnitsTest, CellUnitsMatchGeometry )
+{
+    for ( size_t i = 0; i < 81; i++ )
+    {
+        EXPECT_EQ( Row( i ), Sudoku::Units::CELL_UNITS[i][0] );
+        EXPECT_EQ( Col( i ) + 9, Sudoku::Units::CELL_UNITS[i][1] );
+        EXPECT_EQ( Block( i ) + 18, Sudoku::Units::CELL_UNITS[i][2] );
+    }
+}
+
+// Peers are exactly the other cells sharing a unit, sorted
+TEST_F( UnitsTest, PeersMatchGeometry )
+{
+    for ( size_t i = 0; i < 81; i++ )
+    {
+        std::set<size_t> expected;
+        for ( size_t j = 0; j < 81; j++ )
+        {
+            if ( j != i && ( Row( i ) == Row( j ) || Col( i ) == Col( j ) ||
+                             Block( i ) == Block( j ) ) )
+            {
+                expected.insert( j );
+            }
+        }
+        ASSERT_EQ( 20u, expected.size() );
+        std::set<size_t>::iterator it = expected.begin();
+        for ( size_t p = 0; p < 20; p++, ++it )
+        {
+            EXPECT_EQ( *it, Sudoku::Units::PEERS[i][p] );
+        }
+    }
+}
+
+// Index and unit helpers agree with the tables
+TEST_F( UnitsTest, HelpersMatchTables )
+{
+    EXPECT_EQ( 0u, Sudoku::Units::Index( 1, 1 ) );
+    EXPECT_EQ( 80u, Sudoku::Units::Index( 9, 9 ) );
+    EXPECT_EQ( 17u, Sudoku::Units::Index( 9, 2 ) );
+    for ( size_t n = 1; n <= 9; n++ )
+    {
+        EXPECT_EQ( Sudoku::Units::Index( 1, n ),
+                   Sudoku::Units::UNIT_CELLS[Sudoku::Units::Row( n )][0] );
+        EXPECT_EQ( Sudoku::Units::Index( n, 1 ),
+                   Sudoku::Units::UNIT_CELLS[Sudoku::Units::Col( n )][0] );
+    }
+    EXPECT_EQ( Sudoku::Units::Index( 4, 7 ),
+               Sudoku::Units::UNIT_CELLS[Sudoku::Units::Block( 2, 3 )][0] );
+    for ( size_t i = 0; i < 81; i++ )
+    {
+        EXPECT_EQ( i, Sudoku::Units::ALL_CELLS[i] );
+    }
+}
+
+}  // namespace
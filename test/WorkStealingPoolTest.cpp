@@ -0,0 +1,105 @@
+#include "../WorkStealingPool.h"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+/**
+ * Records which worker ran each item, some items take longer
+ */
+class RecordTask : public Sudoku::WorkStealingPool::Task
+{
+public:
+    RecordTask( size_t count )
+        : runs( count, 0 ), workers( count, 0 ), failAt( count ) {}
+
+    virtual void Execute( size_t worker, size_t item )
+    {
+        if ( item == failAt )
+        {
+            throw std::runtime_error( "failed" );
+        }
+        if ( item % 7 == 0 )
+        {
+            std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+        }
+        runs[item]++;
+        workers[item] = worker;
+    }
+
+    std::vector<int> runs;
+    std::vector<size_t> workers;
+    size_t failAt;
+};
+
+class WorkStealingPoolTest : public ::testing::Test
+{
+protected:
+    WorkStealingPoolTest()
+    {
+    }
+
+    virtual ~WorkStealingPoolTest()
+    {
+    }
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+};
+
+// Every item runs exactly once, on a valid worker
+TEST_F( WorkStealingPoolTest, RunsEveryItemOnce )
+{
+    Sudoku::WorkStealingPool pool( 4 );
+    EXPECT_EQ( 4u, pool.GetThreadCount() );
+    RecordTask task( 500 );
+    pool.Run( 500, task );
+    for ( size_t i = 0; i < 500; i++ )
+    {
+        EXPECT_EQ( 1, task.runs[i] ) << "item " << i;
+        EXPECT_LT( task.workers[i], 4u );
+    }
+}
+
+// Fewer items than workers, and no items at all
+TEST_F( WorkStealingPoolTest, SmallBatches )
+{
+    Sudoku::WorkStealingPool pool( 8 );
+    RecordTask task( 3 );
+    pool.Run( 3, task );
+    EXPECT_EQ( 1, task.runs[0] );
+    EXPECT_EQ( 1, task.runs[1] );
+    EXPECT_EQ( 1, task.runs[2] );
+    RecordTask none( 0 );
+    pool.Run( 0, none );
+}
+
+// Default pool has at least one thread and can be reused
+TEST_F( WorkStealingPoolTest, DefaultThreadsAndReuse )
+{
+    Sudoku::WorkStealingPool pool;
+    EXPECT_GE( pool.GetThreadCount(), 1u );
+    RecordTask first( 50 );
+    pool.Run( 50, first );
+    RecordTask second( 50 );
+    pool.Run( 50, second );
+    EXPECT_EQ( 1, second.runs[49] );
+}
+
+// An exception in a task comes back to the caller
+TEST_F( WorkStealingPoolTest, RethrowsTaskException )
+{
+    Sudoku::WorkStealingPool pool( 3 );
+    RecordTask task( 100 );
+    task.failAt = 42;
+    EXPECT_THROW( pool.Run( 100, task ), std::runtime_error );
+}
+
+}  // namespace